@@ -57,6 +57,7 @@ typedef enum {
     MSG_TYPE_DATA_REQUEST      = 0x20,   /* Edge -> Sensors: Request data */
     MSG_TYPE_DATA_RESPONSE     = 0x21,   /* Sensors -> Edge: Send data */
     MSG_TYPE_DATA_STREAM       = 0x22,   /* Sensors -> Edge: Stream data */
+    MSG_TYPE_DATA_BURST        = 0x23,   /* Sensors -> Edge: Triggered capture, in chunks */
 
     /* Control messages */
     MSG_TYPE_COMMAND           = 0x30,   /* Edge -> Sensors: Execute command */
@@ -150,6 +151,33 @@ typedef struct {
     uint16_t total_samples;              /* Total number of samples */
 } __attribute__((packed)) esocore_sensor_data_header_t;
 
+/**
+ * @brief Burst transfer chunk header (MSG_TYPE_DATA_BURST)
+ *
+ * Chunk 0 carries an esocore_burst_descriptor_t followed by one float
+ * scale per channel; the remaining chunks carry the int16 samples channel
+ * by channel, oldest first.
+ */
+typedef struct {
+    uint16_t burst_id;                   /* Burst identifier */
+    uint16_t chunk_index;                /* Chunk number (0 = descriptor) */
+    uint16_t chunk_count;                /* Total chunks including the descriptor */
+} __attribute__((packed)) esocore_burst_chunk_header_t;
+
+/**
+ * @brief Burst descriptor
+ */
+typedef struct {
+    uint32_t trigger_timestamp;          /* Trigger time in ms */
+    uint32_t sample_rate_hz;             /* Sample rate in Hz */
+    uint16_t pre_trigger_samples;        /* Samples per channel before the trigger */
+    uint16_t post_trigger_samples;       /* Samples per channel from the trigger on */
+    uint8_t num_channels;                /* Number of channels */
+    uint8_t trigger_type;                /* Trigger that fired */
+    uint8_t trigger_channel;             /* Channel or digital input that fired */
+    uint8_t sample_format;               /* 0 = int16 raw counts */
+} __attribute__((packed)) esocore_burst_descriptor_t;
+
 /* ============================================================================
  * Function Prototypes
  * ============================================================================ */
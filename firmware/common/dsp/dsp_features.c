@@ -0,0 +1,532 @@
+/**
+ * @file dsp_features.c
+ * @brief Shared Feature-Extraction Cache Implementation
+ *
+ * This file contains the lazily evaluated feature store shared by the
+ * TinyML engine and the sensor drivers. Each feature family is computed at
+ * most once per published capture.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "dsp_features.h"
+#include "dsp_stats.h"
+#include <string.h>
+#include <math.h>
+
+#if DSP_FEATURE_MAX_SAMPLES > DSP_FFT_MAX_SIZE
+#error "DSP_FEATURE_MAX_SAMPLES must not exceed DSP_FFT_MAX_SIZE"
+#endif
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+#define FEATURE_STATS                 (1U << 0)
+#define FEATURE_SPECTRUM              (1U << 1)
+#define FEATURE_ENVELOPE              (1U << 2)
+#define FEATURE_BAND_POWERS           (1U << 3)
+
+#define HANNING_COHERENT_GAIN_INV     2.0f  /* 1 / mean(hanning) */
+#define HANNING_NOISE_BANDWIDTH       1.5f  /* Equivalent noise bandwidth in bins */
+
+typedef struct {
+    bool valid;
+    uint8_t sensor_id;
+    uint32_t capture_seq;
+    const float *samples;
+    uint16_t num_samples;
+    uint16_t fft_size;
+    float sample_rate_hz;
+    uint32_t last_used;
+    uint8_t computed;                       /* FEATURE_* mask */
+    dsp_feature_stats_t stats;
+    float spectrum[DSP_FEATURE_MAX_BINS];
+    float envelope[DSP_FEATURE_MAX_BINS];
+    float band_powers[DSP_FEATURE_MAX_BANDS];
+} feature_entry_t;
+
+static feature_entry_t entries[DSP_FEATURE_MAX_CAPTURES];
+static uint32_t use_counter = 0;
+static dsp_feature_cache_stats_t cache_stats;
+
+/* Complex transform scratch shared by all entries */
+static float scratch[2 * DSP_FEATURE_MAX_SAMPLES];
+
+/* Periodic Hanning window for DSP_FEATURE_MAX_SAMPLES; smaller sizes stride it */
+static float hanning[DSP_FEATURE_MAX_SAMPLES];
+
+/* Band configuration; equal-width bands up to Nyquist until set */
+static float band_edges_hz[DSP_FEATURE_MAX_BANDS + 1];
+static uint8_t band_count = DSP_FEATURE_MAX_BANDS;
+static bool bands_auto = true;
+
+/* Envelope demodulation band; upper half of the spectrum until set */
+static float envelope_low_hz = 0.0f;
+static float envelope_high_hz = 0.0f;
+static bool envelope_auto = true;
+
+static bool store_initialized = false;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Find the entry holding a key and mark it used
+ */
+static feature_entry_t *find_entry(uint8_t sensor_id, uint32_t capture_seq) {
+    for (uint8_t i = 0; i < DSP_FEATURE_MAX_CAPTURES; i++) {
+        if (entries[i].valid && entries[i].sensor_id == sensor_id &&
+            entries[i].capture_seq == capture_seq) {
+            entries[i].last_used = ++use_counter;
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Bin width of an entry's spectra in Hz (0 if rate unknown)
+ */
+static float entry_bin_width(const feature_entry_t *entry) {
+    return entry->sample_rate_hz / (float)entry->fft_size;
+}
+
+/**
+ * @brief Window the mean-removed capture into scratch and take its amplitude spectrum
+ */
+static void compute_windowed_spectrum(const float *signal, float mean, uint16_t size, float *output) {
+    uint16_t stride = (uint16_t)(DSP_FEATURE_MAX_SAMPLES / size);
+
+    for (uint16_t i = 0; i < size; i++) {
+        scratch[i] = (signal[i] - mean) * hanning[i * stride];
+    }
+
+    dsp_fft_magnitude(scratch, output, scratch, size);
+
+    output[0] = 0.0f;
+    for (uint16_t k = 1; k < size / 2; k++) {
+        output[k] *= HANNING_COHERENT_GAIN_INV;
+    }
+}
+
+/**
+ * @brief Compute time-domain statistics
+ */
+static void compute_stats(feature_entry_t *entry) {
+    dsp_running_stats_t running;
+
+    /* One pass over the capture yields every moment */
+    dsp_stats_reset(&running);
+    dsp_stats_update_block(&running, entry->samples, entry->num_samples);
+
+    float mean = running.mean;
+    float m2 = dsp_stats_variance(&running);
+    float peak = fmaxf(running.max - mean, mean - running.min);
+
+    dsp_feature_stats_t *stats = &entry->stats;
+    stats->mean = mean;
+    stats->std_dev = sqrtf(m2);
+    stats->rms = sqrtf(m2 + mean * mean);
+    stats->peak = peak;
+    stats->crest_factor = (m2 > 0.0f) ? peak / stats->std_dev : 0.0f;
+    stats->skewness = dsp_stats_skewness(&running);
+    stats->kurtosis = dsp_stats_kurtosis(&running);
+
+    entry->computed |= FEATURE_STATS;
+    cache_stats.stats_computed++;
+}
+
+/**
+ * @brief Make sure statistics are available
+ */
+static void require_stats(feature_entry_t *entry) {
+    if (entry->computed & FEATURE_STATS) {
+        cache_stats.cache_hits++;
+    } else {
+        compute_stats(entry);
+    }
+}
+
+/**
+ * @brief Compute the envelope spectrum through the analytic signal
+ */
+static void compute_envelope(feature_entry_t *entry) {
+    uint16_t n = entry->fft_size;
+    float mean = entry->stats.mean;
+
+    for (uint16_t i = 0; i < n; i++) {
+        scratch[2 * i] = entry->samples[i] - mean;
+        scratch[2 * i + 1] = 0.0f;
+    }
+    dsp_fft_complex(scratch, n, false);
+
+    /* Keep doubled positive frequencies inside the band, drop the rest */
+    uint16_t low_bin = (uint16_t)(n / 4);
+    uint16_t high_bin = (uint16_t)(n / 2 - 1);
+    if (!envelope_auto && entry->sample_rate_hz > 0.0f) {
+        float bin_width = entry_bin_width(entry);
+        low_bin = (uint16_t)fmaxf(1.0f, ceilf(envelope_low_hz / bin_width));
+        if (envelope_high_hz > 0.0f && envelope_high_hz / bin_width < (float)high_bin) {
+            high_bin = (uint16_t)(envelope_high_hz / bin_width);
+        }
+    }
+    for (uint16_t k = 0; k < n; k++) {
+        float gain = (k >= low_bin && k <= high_bin) ? 2.0f : 0.0f;
+        scratch[2 * k] *= gain;
+        scratch[2 * k + 1] *= gain;
+    }
+    dsp_fft_complex(scratch, n, true);
+
+    /* Envelope magnitudes compacted into the front of scratch */
+    float envelope_mean = 0.0f;
+    for (uint16_t i = 0; i < n; i++) {
+        float re = scratch[2 * i];
+        float im = scratch[2 * i + 1];
+        scratch[i] = sqrtf(re * re + im * im);
+        envelope_mean += scratch[i];
+    }
+    envelope_mean /= (float)n;
+
+    compute_windowed_spectrum(scratch, envelope_mean, n, entry->envelope);
+
+    entry->computed |= FEATURE_ENVELOPE;
+    cache_stats.envelopes_computed++;
+}
+
+/**
+ * @brief Compute band powers from the spectrum
+ */
+static void compute_band_powers(feature_entry_t *entry) {
+    float bin_width = entry_bin_width(entry);
+    float nyquist = entry->sample_rate_hz * 0.5f;
+    uint16_t bins = (uint16_t)(entry->fft_size / 2);
+
+    for (uint8_t b = 0; b < band_count; b++) {
+        float low = bands_auto ? nyquist * (float)b / (float)band_count : band_edges_hz[b];
+        float high = bands_auto ? nyquist * (float)(b + 1) / (float)band_count : band_edges_hz[b + 1];
+        float power = 0.0f;
+
+        for (uint16_t k = 1; k < bins; k++) {
+            float frequency = (float)k * bin_width;
+            if (frequency >= low && frequency < high) {
+                /* Amplitude A is a mean square of A^2 / 2; divide out the
+                 * window's noise bandwidth so broadband power adds up */
+                power += entry->spectrum[k] * entry->spectrum[k];
+            }
+        }
+
+        entry->band_powers[b] = power * 0.5f / HANNING_NOISE_BANDWIDTH;
+    }
+
+    entry->computed |= FEATURE_BAND_POWERS;
+    cache_stats.band_powers_computed++;
+}
+
+/**
+ * @brief Make sure the spectrum is available
+ */
+static void require_spectrum(feature_entry_t *entry) {
+    require_stats(entry);
+
+    if (entry->computed & FEATURE_SPECTRUM) {
+        cache_stats.cache_hits++;
+        return;
+    }
+
+    compute_windowed_spectrum(entry->samples, entry->stats.mean, entry->fft_size, entry->spectrum);
+    entry->computed |= FEATURE_SPECTRUM;
+    cache_stats.spectra_computed++;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Initialize the feature store
+ */
+bool dsp_feature_init(void) {
+    if (!dsp_fft_init()) {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < DSP_FEATURE_MAX_SAMPLES; i++) {
+        hanning[i] = 0.5f - 0.5f * cosf((float)(2.0 * M_PI) * (float)i / (float)DSP_FEATURE_MAX_SAMPLES);
+    }
+
+    memset(entries, 0, sizeof(entries));
+    memset(&cache_stats, 0, sizeof(cache_stats));
+    use_counter = 0;
+    band_count = DSP_FEATURE_MAX_BANDS;
+    bands_auto = true;
+    envelope_auto = true;
+
+    store_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Set band-power band edges
+ */
+bool dsp_feature_set_bands(const float *edges_hz, uint8_t num_bands) {
+    if (!edges_hz || num_bands == 0 || num_bands > DSP_FEATURE_MAX_BANDS) {
+        return false;
+    }
+
+    for (uint8_t b = 0; b < num_bands; b++) {
+        if (!(edges_hz[b] < edges_hz[b + 1]) || edges_hz[b] < 0.0f) {
+            return false;
+        }
+    }
+
+    memcpy(band_edges_hz, edges_hz, (size_t)(num_bands + 1) * sizeof(float));
+    band_count = num_bands;
+    bands_auto = false;
+
+    /* Cached band powers used the old edges */
+    for (uint8_t i = 0; i < DSP_FEATURE_MAX_CAPTURES; i++) {
+        entries[i].computed &= (uint8_t)~FEATURE_BAND_POWERS;
+    }
+    return true;
+}
+
+/**
+ * @brief Set the demodulation band used for the envelope spectrum
+ */
+bool dsp_feature_set_envelope_band(float low_hz, float high_hz) {
+    if (low_hz < 0.0f || (high_hz > 0.0f && high_hz <= low_hz)) {
+        return false;
+    }
+
+    envelope_low_hz = low_hz;
+    envelope_high_hz = high_hz;
+    envelope_auto = false;
+
+    for (uint8_t i = 0; i < DSP_FEATURE_MAX_CAPTURES; i++) {
+        entries[i].computed &= (uint8_t)~FEATURE_ENVELOPE;
+    }
+    return true;
+}
+
+/**
+ * @brief Publish a capture
+ */
+bool dsp_feature_publish(uint8_t sensor_id, uint32_t capture_seq, const float *samples,
+                         uint16_t num_samples, float sample_rate_hz) {
+    if (!samples || num_samples < DSP_FFT_MIN_SIZE || sample_rate_hz < 0.0f) {
+        return false;
+    }
+
+    if (!store_initialized && !dsp_feature_init()) {
+        return false;
+    }
+
+    /* Same key or same sensor buffer: the old features are stale */
+    feature_entry_t *entry = NULL;
+    for (uint8_t i = 0; i < DSP_FEATURE_MAX_CAPTURES && !entry; i++) {
+        if (entries[i].valid && entries[i].sensor_id == sensor_id &&
+            (entries[i].capture_seq == capture_seq || entries[i].samples == samples)) {
+            entry = &entries[i];
+        }
+    }
+
+    /* Otherwise a free slot, else the least recently used one */
+    if (!entry) {
+        for (uint8_t i = 0; i < DSP_FEATURE_MAX_CAPTURES; i++) {
+            if (!entries[i].valid) {
+                entry = &entries[i];
+                break;
+            }
+            if (!entry || entries[i].last_used < entry->last_used) {
+                entry = &entries[i];
+            }
+        }
+        if (entry->valid) {
+            cache_stats.evictions++;
+        }
+    }
+
+    uint16_t fft_size = DSP_FEATURE_MAX_SAMPLES;
+    while (fft_size > num_samples) {
+        fft_size >>= 1;
+    }
+
+    entry->valid = true;
+    entry->sensor_id = sensor_id;
+    entry->capture_seq = capture_seq;
+    entry->samples = samples;
+    entry->num_samples = num_samples;
+    entry->fft_size = fft_size;
+    entry->sample_rate_hz = sample_rate_hz;
+    entry->last_used = ++use_counter;
+    entry->computed = 0;
+
+    cache_stats.captures_published++;
+    return true;
+}
+
+/**
+ * @brief Find a cached capture by its sample buffer
+ */
+bool dsp_feature_find(const float *samples, uint16_t num_samples,
+                      uint8_t *sensor_id, uint32_t *capture_seq) {
+    if (!samples || !sensor_id || !capture_seq) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < DSP_FEATURE_MAX_CAPTURES; i++) {
+        /* Ad hoc buffers may be refilled without a new publish */
+        if (entries[i].valid && entries[i].sensor_id != DSP_FEATURE_SENSOR_ADHOC &&
+            entries[i].samples == samples && entries[i].num_samples == num_samples) {
+            *sensor_id = entries[i].sensor_id;
+            *capture_seq = entries[i].capture_seq;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Get the newest cached capture of a sensor
+ */
+bool dsp_feature_get_latest(uint8_t sensor_id, uint32_t *capture_seq) {
+    const feature_entry_t *latest = NULL;
+
+    if (!capture_seq) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < DSP_FEATURE_MAX_CAPTURES; i++) {
+        if (entries[i].valid && entries[i].sensor_id == sensor_id &&
+            (!latest || (int32_t)(entries[i].capture_seq - latest->capture_seq) > 0)) {
+            latest = &entries[i];
+        }
+    }
+
+    if (!latest) {
+        return false;
+    }
+    *capture_seq = latest->capture_seq;
+    return true;
+}
+
+/**
+ * @brief Get the samples of a cached capture
+ */
+bool dsp_feature_get_capture(uint8_t sensor_id, uint32_t capture_seq, const float **samples,
+                             uint16_t *num_samples, float *sample_rate_hz) {
+    if (!samples || !num_samples) {
+        return false;
+    }
+
+    const feature_entry_t *entry = find_entry(sensor_id, capture_seq);
+    if (!entry) {
+        return false;
+    }
+
+    *samples = entry->samples;
+    *num_samples = entry->num_samples;
+    if (sample_rate_hz) {
+        *sample_rate_hz = entry->sample_rate_hz;
+    }
+    return true;
+}
+
+/**
+ * @brief Get time-domain statistics of a capture
+ */
+const dsp_feature_stats_t *dsp_feature_get_stats(uint8_t sensor_id, uint32_t capture_seq) {
+    feature_entry_t *entry = find_entry(sensor_id, capture_seq);
+    if (!entry) {
+        return NULL;
+    }
+
+    require_stats(entry);
+    return &entry->stats;
+}
+
+/**
+ * @brief Get the Hanning-windowed amplitude spectrum of a capture
+ */
+const float *dsp_feature_get_spectrum(uint8_t sensor_id, uint32_t capture_seq,
+                                      uint16_t *num_bins, float *bin_width_hz) {
+    feature_entry_t *entry = find_entry(sensor_id, capture_seq);
+    if (!entry) {
+        return NULL;
+    }
+
+    require_spectrum(entry);
+
+    if (num_bins) {
+        *num_bins = (uint16_t)(entry->fft_size / 2);
+    }
+    if (bin_width_hz) {
+        *bin_width_hz = entry_bin_width(entry);
+    }
+    return entry->spectrum;
+}
+
+/**
+ * @brief Get the envelope spectrum of a capture
+ */
+const float *dsp_feature_get_envelope_spectrum(uint8_t sensor_id, uint32_t capture_seq,
+                                               uint16_t *num_bins, float *bin_width_hz) {
+    feature_entry_t *entry = find_entry(sensor_id, capture_seq);
+    if (!entry) {
+        return NULL;
+    }
+
+    require_stats(entry);
+    if (entry->computed & FEATURE_ENVELOPE) {
+        cache_stats.cache_hits++;
+    } else {
+        compute_envelope(entry);
+    }
+
+    if (num_bins) {
+        *num_bins = (uint16_t)(entry->fft_size / 2);
+    }
+    if (bin_width_hz) {
+        *bin_width_hz = entry_bin_width(entry);
+    }
+    return entry->envelope;
+}
+
+/**
+ * @brief Get band powers (mean square per band) of a capture
+ */
+const float *dsp_feature_get_band_powers(uint8_t sensor_id, uint32_t capture_seq,
+                                         uint8_t *num_bands) {
+    feature_entry_t *entry = find_entry(sensor_id, capture_seq);
+    if (!entry || entry->sample_rate_hz <= 0.0f) {
+        return NULL;
+    }
+
+    require_spectrum(entry);
+    if (entry->computed & FEATURE_BAND_POWERS) {
+        cache_stats.cache_hits++;
+    } else {
+        compute_band_powers(entry);
+    }
+
+    if (num_bands) {
+        *num_bands = band_count;
+    }
+    return entry->band_powers;
+}
+
+/**
+ * @brief Get cache effectiveness counters
+ */
+bool dsp_feature_get_cache_stats(dsp_feature_cache_stats_t *stats) {
+    if (!stats) {
+        return false;
+    }
+
+    *stats = cache_stats;
+    return true;
+}
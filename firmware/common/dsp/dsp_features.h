@@ -0,0 +1,228 @@
+/**
+ * @file dsp_features.h
+ * @brief Shared Feature-Extraction Cache
+ *
+ * This header defines the feature store that lets one capture feed every
+ * analysis. A capture is published once under a (sensor, capture sequence)
+ * key; its statistics, windowed amplitude spectrum, envelope spectrum and
+ * band powers are computed lazily on first request and served from the
+ * cache afterwards, so CPU cost scales with captures rather than with
+ * captures times analyses.
+ *
+ * Captures are referenced, not copied: the sample buffer must stay
+ * unchanged until the capture is superseded by a newer publish for the same
+ * sensor or evicted. The least recently used capture is evicted when all
+ * DSP_FEATURE_MAX_CAPTURES slots are taken.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_DSP_FEATURES_H
+#define ESOCORE_DSP_FEATURES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_fft.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Feature Store Configuration
+ * ============================================================================ */
+
+#ifndef DSP_FEATURE_MAX_SAMPLES
+#define DSP_FEATURE_MAX_SAMPLES       512   /* Largest transform per capture (power of 2) */
+#endif
+
+#ifndef DSP_FEATURE_MAX_CAPTURES
+#define DSP_FEATURE_MAX_CAPTURES      2     /* Captures cached at once */
+#endif
+
+#define DSP_FEATURE_MAX_BINS          (DSP_FEATURE_MAX_SAMPLES / 2)
+#define DSP_FEATURE_MAX_BANDS         8     /* Band power outputs */
+#define DSP_FEATURE_SENSOR_ADHOC      0xFF  /* Sensor ID for anonymous buffers */
+
+/* ============================================================================
+ * Feature Data Types
+ * ============================================================================ */
+
+/* Time-domain statistics of a capture */
+typedef struct {
+    float mean;                             /* Mean (DC offset) */
+    float std_dev;                          /* Standard deviation */
+    float rms;                              /* RMS including DC */
+    float peak;                             /* Largest absolute deviation from the mean */
+    float crest_factor;                     /* Peak / standard deviation */
+    float skewness;                         /* Third standardized moment */
+    float kurtosis;                         /* Fourth standardized moment (3 = Gaussian) */
+} dsp_feature_stats_t;
+
+/* Cache effectiveness counters */
+typedef struct {
+    uint32_t captures_published;            /* Captures published */
+    uint32_t cache_hits;                    /* Feature requests served from cache */
+    uint32_t stats_computed;                /* Statistics computations */
+    uint32_t spectra_computed;              /* Spectrum computations */
+    uint32_t envelopes_computed;            /* Envelope spectrum computations */
+    uint32_t band_powers_computed;          /* Band power computations */
+    uint32_t evictions;                     /* Captures evicted before being superseded */
+} dsp_feature_cache_stats_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Initialize the feature store
+ *
+ * Default bands split 0 Hz to Nyquist into DSP_FEATURE_MAX_BANDS equal bands;
+ * the default envelope band is the upper half of the spectrum.
+ *
+ * @return true if initialization successful, false otherwise
+ */
+bool dsp_feature_init(void);
+
+/**
+ * @brief Set band-power band edges
+ *
+ * @param edges_hz Ascending band edges in Hz (num_bands + 1 values)
+ * @param num_bands Number of bands (1 to DSP_FEATURE_MAX_BANDS)
+ * @return true if bands set successfully, false otherwise
+ */
+bool dsp_feature_set_bands(const float *edges_hz, uint8_t num_bands);
+
+/**
+ * @brief Set the demodulation band used for the envelope spectrum
+ *
+ * Bearing impacts excite structural resonances; demodulating around them
+ * exposes the defect repetition rate. A zero high edge means Nyquist.
+ *
+ * @param low_hz Lower band edge in Hz
+ * @param high_hz Upper band edge in Hz (0 = Nyquist)
+ * @return true if band set successfully, false otherwise
+ */
+bool dsp_feature_set_envelope_band(float low_hz, float high_hz);
+
+/**
+ * @brief Publish a capture
+ *
+ * Publishing an existing key, or a new sequence for the same sensor and
+ * buffer, replaces the cached features.
+ *
+ * @param sensor_id Sensor bus address or DSP_FEATURE_SENSOR_ADHOC
+ * @param capture_seq Capture sequence number
+ * @param samples Sample buffer (referenced, not copied)
+ * @param num_samples Number of samples (at least DSP_FFT_MIN_SIZE)
+ * @param sample_rate_hz Sample rate in Hz (0 if unknown; band powers unavailable)
+ * @return true if capture published successfully, false otherwise
+ */
+bool dsp_feature_publish(uint8_t sensor_id, uint32_t capture_seq, const float *samples,
+                         uint16_t num_samples, float sample_rate_hz);
+
+/**
+ * @brief Find a cached capture by its sample buffer
+ *
+ * Lets APIs that take raw arrays reuse features already computed for them.
+ * Only sensor captures match; ad hoc captures are never returned because
+ * their buffers may have been refilled since they were published.
+ *
+ * @param samples Sample buffer
+ * @param num_samples Number of samples
+ * @param sensor_id Pointer to store sensor ID
+ * @param capture_seq Pointer to store capture sequence
+ * @return true if a capture with this buffer is cached, false otherwise
+ */
+bool dsp_feature_find(const float *samples, uint16_t num_samples,
+                      uint8_t *sensor_id, uint32_t *capture_seq);
+
+/**
+ * @brief Get the newest cached capture of a sensor
+ *
+ * @param sensor_id Sensor ID
+ * @param capture_seq Pointer to store capture sequence
+ * @return true if the sensor has a cached capture, false otherwise
+ */
+bool dsp_feature_get_latest(uint8_t sensor_id, uint32_t *capture_seq);
+
+/**
+ * @brief Get the samples of a cached capture
+ *
+ * @param sensor_id Sensor ID
+ * @param capture_seq Capture sequence
+ * @param samples Pointer to store the published sample buffer
+ * @param num_samples Pointer to store number of samples
+ * @param sample_rate_hz Pointer to store sample rate in Hz (may be NULL)
+ * @return true if capture cached, false otherwise
+ */
+bool dsp_feature_get_capture(uint8_t sensor_id, uint32_t capture_seq, const float **samples,
+                             uint16_t *num_samples, float *sample_rate_hz);
+
+/**
+ * @brief Get time-domain statistics of a capture
+ *
+ * @param sensor_id Sensor ID
+ * @param capture_seq Capture sequence
+ * @return Pointer to statistics, or NULL if capture not cached
+ */
+const dsp_feature_stats_t *dsp_feature_get_stats(uint8_t sensor_id, uint32_t capture_seq);
+
+/**
+ * @brief Get the Hanning-windowed amplitude spectrum of a capture
+ *
+ * The transform covers the first power-of-two samples of the capture (at
+ * most DSP_FEATURE_MAX_SAMPLES) with the mean removed. Amplitudes are
+ * corrected for the window's coherent gain, so a sinusoid of amplitude A
+ * reads A on its bin.
+ *
+ * @param sensor_id Sensor ID
+ * @param capture_seq Capture sequence
+ * @param num_bins Pointer to store number of bins (may be NULL)
+ * @param bin_width_hz Pointer to store bin width in Hz (may be NULL; 0 if rate unknown)
+ * @return Pointer to amplitudes, or NULL if capture not cached
+ */
+const float *dsp_feature_get_spectrum(uint8_t sensor_id, uint32_t capture_seq,
+                                      uint16_t *num_bins, float *bin_width_hz);
+
+/**
+ * @brief Get the envelope spectrum of a capture
+ *
+ * The capture is band-limited to the envelope band, demodulated through
+ * its analytic signal, and the envelope's amplitude spectrum returned.
+ *
+ * @param sensor_id Sensor ID
+ * @param capture_seq Capture sequence
+ * @param num_bins Pointer to store number of bins (may be NULL)
+ * @param bin_width_hz Pointer to store bin width in Hz (may be NULL; 0 if rate unknown)
+ * @return Pointer to amplitudes, or NULL if capture not cached
+ */
+const float *dsp_feature_get_envelope_spectrum(uint8_t sensor_id, uint32_t capture_seq,
+                                               uint16_t *num_bins, float *bin_width_hz);
+
+/**
+ * @brief Get band powers (mean square per band) of a capture
+ *
+ * @param sensor_id Sensor ID
+ * @param capture_seq Capture sequence
+ * @param num_bands Pointer to store number of bands (may be NULL)
+ * @return Pointer to band powers, or NULL if capture not cached or rate unknown
+ */
+const float *dsp_feature_get_band_powers(uint8_t sensor_id, uint32_t capture_seq,
+                                         uint8_t *num_bands);
+
+/**
+ * @brief Get cache effectiveness counters
+ *
+ * @param stats Pointer to statistics structure to fill
+ * @return true if statistics retrieved successfully, false otherwise
+ */
+bool dsp_feature_get_cache_stats(dsp_feature_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_DSP_FEATURES_H */
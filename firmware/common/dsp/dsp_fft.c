@@ -0,0 +1,264 @@
+/**
+ * @file dsp_fft.c
+ * @brief Fast Fourier Transform Implementation
+ *
+ * This file contains the radix-2 FFT routines shared by the EsoCore sensor
+ * drivers. A single twiddle table covering DSP_FFT_MAX_SIZE points serves
+ * every smaller transform by striding.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "dsp_fft.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+/* Twiddle factors W_N^k = exp(-2*pi*i*k/N) for N = DSP_FFT_MAX_SIZE */
+static float twiddle_cos[DSP_FFT_MAX_SIZE / 2];
+static float twiddle_sin[DSP_FFT_MAX_SIZE / 2];
+static bool twiddle_ready = false;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Check for a power of two
+ */
+static bool is_power_of_two(uint32_t value) {
+    return (value != 0) && ((value & (value - 1)) == 0);
+}
+
+/**
+ * @brief Reorder complex data into bit-reversed index order
+ */
+static void bit_reverse_permute(float *data, uint16_t size) {
+    uint16_t j = 0;
+
+    for (uint16_t i = 0; i < size - 1; i++) {
+        if (i < j) {
+            float re = data[2 * i];
+            float im = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+
+        uint16_t bit = size >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j |= bit;
+    }
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Initialize the shared twiddle table
+ */
+bool dsp_fft_init(void) {
+    if (twiddle_ready) {
+        return true;
+    }
+
+    for (uint16_t k = 0; k < DSP_FFT_MAX_SIZE / 2; k++) {
+        float angle = (float)(2.0 * M_PI) * (float)k / (float)DSP_FFT_MAX_SIZE;
+        twiddle_cos[k] = cosf(angle);
+        twiddle_sin[k] = -sinf(angle);
+    }
+
+    twiddle_ready = true;
+    return true;
+}
+
+/**
+ * @brief Check whether a transform size is supported
+ */
+bool dsp_fft_is_valid_size(uint32_t size) {
+    return is_power_of_two(size) && size >= DSP_FFT_MIN_SIZE && size <= DSP_FFT_MAX_SIZE;
+}
+
+/**
+ * @brief In-place complex FFT
+ */
+bool dsp_fft_complex(float *data, uint16_t size, bool inverse) {
+    if (!data || size < 2 || size > DSP_FFT_MAX_SIZE || !is_power_of_two(size)) {
+        return false;
+    }
+
+    dsp_fft_init();
+    bit_reverse_permute(data, size);
+
+    /* Iterative radix-2 decimation-in-time butterflies */
+    for (uint16_t span = 1; span < size; span <<= 1) {
+        uint16_t stride = (uint16_t)(DSP_FFT_MAX_SIZE / (2U * span));
+
+        for (uint16_t k = 0; k < span; k++) {
+            float wr = twiddle_cos[k * stride];
+            float wi = inverse ? -twiddle_sin[k * stride] : twiddle_sin[k * stride];
+
+            for (uint16_t i = k; i < size; i = (uint16_t)(i + 2U * span)) {
+                uint16_t j = (uint16_t)(i + span);
+                float tr = wr * data[2 * j] - wi * data[2 * j + 1];
+                float ti = wr * data[2 * j + 1] + wi * data[2 * j];
+
+                data[2 * j] = data[2 * i] - tr;
+                data[2 * j + 1] = data[2 * i + 1] - ti;
+                data[2 * i] += tr;
+                data[2 * i + 1] += ti;
+            }
+        }
+    }
+
+    if (inverse) {
+        float scale = 1.0f / (float)size;
+        for (uint32_t i = 0; i < 2U * size; i++) {
+            data[i] *= scale;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Real-input FFT
+ */
+bool dsp_fft_real(const float *input, float *spectrum, uint16_t size) {
+    if (!input || !spectrum || !dsp_fft_is_valid_size(size)) {
+        return false;
+    }
+
+    /* Even/odd samples become the real/imaginary parts of a half-size signal */
+    if (spectrum != input) {
+        memcpy(spectrum, input, size * sizeof(float));
+    }
+
+    uint16_t half = size / 2;
+    if (!dsp_fft_complex(spectrum, half, false)) {
+        return false;
+    }
+
+    /* DC and Nyquist are both real; pack them into the first bin */
+    float z0_re = spectrum[0];
+    float z0_im = spectrum[1];
+    spectrum[0] = z0_re + z0_im;
+    spectrum[1] = z0_re - z0_im;
+
+    /* Split Z[k] and Z[half-k] into the even and odd spectra, then recombine */
+    uint16_t stride = (uint16_t)(DSP_FFT_MAX_SIZE / size);
+    for (uint16_t k = 1; k <= half / 2; k++) {
+        uint16_t j = (uint16_t)(half - k);
+        float a = spectrum[2 * k];
+        float b = spectrum[2 * k + 1];
+        float c = spectrum[2 * j];
+        float d = spectrum[2 * j + 1];
+
+        float er = 0.5f * (a + c);
+        float ei = 0.5f * (b - d);
+        float or_ = 0.5f * (a - c);
+        float oi = 0.5f * (b + d);
+
+        float wr = twiddle_cos[k * stride];
+        float wi = twiddle_sin[k * stride];
+        float p = wr * oi + wi * or_;
+        float q = wr * or_ - wi * oi;
+
+        spectrum[2 * k] = er + p;
+        spectrum[2 * k + 1] = ei - q;
+        if (j != k) {
+            spectrum[2 * j] = er - p;
+            spectrum[2 * j + 1] = -ei - q;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Inverse of the real-input FFT
+ */
+bool dsp_fft_real_inverse(const float *spectrum, float *output, uint16_t size) {
+    if (!spectrum || !output || !dsp_fft_is_valid_size(size)) {
+        return false;
+    }
+
+    if (output != spectrum) {
+        memcpy(output, spectrum, size * sizeof(float));
+    }
+
+    dsp_fft_init();
+
+    /* Rebuild the half-size spectrum Z[k] = E[k] + j O[k] from X[k] and X[half-k] */
+    float dc = output[0];
+    float nyquist = output[1];
+    output[0] = 0.5f * (dc + nyquist);
+    output[1] = 0.5f * (dc - nyquist);
+
+    uint16_t half = size / 2;
+    uint16_t stride = (uint16_t)(DSP_FFT_MAX_SIZE / size);
+    for (uint16_t k = 1; k <= half / 2; k++) {
+        uint16_t j = (uint16_t)(half - k);
+        float a = output[2 * k];
+        float b = output[2 * k + 1];
+        float c = output[2 * j];
+        float d = output[2 * j + 1];
+
+        float er = 0.5f * (a + c);
+        float ei = 0.5f * (b - d);
+        float dr = 0.5f * (a - c);
+        float di = 0.5f * (b + d);
+
+        /* O[k] = conj(W^k) (X[k] - conj X[half-k]) / 2 */
+        float wr = twiddle_cos[k * stride];
+        float wi = twiddle_sin[k * stride];
+        float or_ = wr * dr + wi * di;
+        float oi = wr * di - wi * dr;
+
+        output[2 * k] = er - oi;
+        output[2 * k + 1] = ei + or_;
+        if (j != k) {
+            output[2 * j] = er + oi;
+            output[2 * j + 1] = or_ - ei;
+        }
+    }
+
+    /* The half-size inverse yields the even/odd samples as (re, im) pairs */
+    return dsp_fft_complex(output, half, true);
+}
+
+/**
+ * @brief Single-sided amplitude spectrum of a real signal
+ */
+bool dsp_fft_magnitude(const float *input, float *magnitude, float *scratch, uint16_t size) {
+    if (!input || !magnitude || !scratch) {
+        return false;
+    }
+
+    if (!dsp_fft_real(input, scratch, size)) {
+        return false;
+    }
+
+    float scale = 2.0f / (float)size;
+
+    /* Bin 0 is written last because magnitude may alias scratch */
+    float dc = fabsf(scratch[0]) * 0.5f * scale;
+    for (uint16_t k = 1; k < size / 2; k++) {
+        float re = scratch[2 * k];
+        float im = scratch[2 * k + 1];
+        magnitude[k] = sqrtf(re * re + im * im) * scale;
+    }
+    magnitude[0] = dc;
+
+    return true;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file dsp_fft.h
+ * @brief Fast Fourier Transform Routines for EsoCore Signal Processing
+ *
+ * This file defines the shared FFT routines used by the sensor drivers and
+ * the edge intelligence layer. All transforms operate in place on
+ * single-precision data and share one twiddle table sized for
+ * DSP_FFT_MAX_SIZE, so smaller transforms cost no additional memory.
+ *
+ * Features:
+ * - Iterative radix-2 complex FFT (forward and inverse)
+ * - Real FFT and its inverse computed through a half-size complex transform
+ * - Single-sided amplitude spectrum helper
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_DSP_FFT_H
+#define ESOCORE_DSP_FFT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * FFT Configuration
+ * ============================================================================ */
+
+#ifndef DSP_FFT_MAX_SIZE
+#define DSP_FFT_MAX_SIZE              1024  /* Largest supported real FFT size */
+#endif
+
+#define DSP_FFT_MIN_SIZE              4     /* Smallest supported real FFT size */
+
+#ifndef M_PI
+#define M_PI                          3.14159265358979323846
+#endif
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Initialize the shared twiddle table
+ *
+ * Called implicitly by every transform; calling it once at start-up moves the
+ * table generation out of the first measurement.
+ *
+ * @return true if initialization successful, false otherwise
+ */
+bool dsp_fft_init(void);
+
+/**
+ * @brief Check whether a transform size is supported
+ *
+ * @param size Transform size in points
+ * @return true if size is a power of two within the supported range
+ */
+bool dsp_fft_is_valid_size(uint32_t size);
+
+/**
+ * @brief In-place complex FFT
+ *
+ * @param data Interleaved complex data (re, im), 2 * size floats
+ * @param size Number of complex points (power of two, <= DSP_FFT_MAX_SIZE)
+ * @param inverse true for the inverse transform (scaled by 1/size)
+ * @return true if transform successful, false otherwise
+ */
+bool dsp_fft_complex(float *data, uint16_t size, bool inverse);
+
+/**
+ * @brief Real-input FFT
+ *
+ * The output uses the packed layout of the CMSIS-DSP real FFT: spectrum[0]
+ * holds the DC term, spectrum[1] the Nyquist term, and bins 1..size/2-1 follow
+ * as interleaved (re, im) pairs. Input and output may alias.
+ *
+ * @param input Real time-domain input (size floats)
+ * @param spectrum Packed complex output (size floats)
+ * @param size Transform size (power of two, <= DSP_FFT_MAX_SIZE)
+ * @return true if transform successful, false otherwise
+ */
+bool dsp_fft_real(const float *input, float *spectrum, uint16_t size);
+
+/**
+ * @brief Inverse of the real-input FFT
+ *
+ * Takes the packed layout produced by dsp_fft_real() and returns the real
+ * time-domain signal, scaled by 1/size so that a forward/inverse pair is the
+ * identity. Spectrum and output may alias.
+ *
+ * @param spectrum Packed complex input (size floats)
+ * @param output Real time-domain output (size floats)
+ * @param size Transform size (power of two, <= DSP_FFT_MAX_SIZE)
+ * @return true if transform successful, false otherwise
+ */
+bool dsp_fft_real_inverse(const float *spectrum, float *output, uint16_t size);
+
+/**
+ * @brief Single-sided amplitude spectrum of a real signal
+ *
+ * Magnitudes are scaled so that a sinusoid of amplitude A that falls on a bin
+ * centre reads A. Input and output may alias; the input is clobbered when
+ * they do.
+ *
+ * @param input Real time-domain input (size floats)
+ * @param magnitude Output magnitudes for bins 0..size/2-1 (size/2 floats)
+ * @param scratch Work buffer of size floats (may equal input)
+ * @param size Transform size (power of two, <= DSP_FFT_MAX_SIZE)
+ * @return true if calculation successful, false otherwise
+ */
+bool dsp_fft_magnitude(const float *input, float *magnitude, float *scratch, uint16_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_DSP_FFT_H */
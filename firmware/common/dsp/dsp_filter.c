@@ -0,0 +1,306 @@
+/**
+ * @file dsp_filter.c
+ * @brief Stateful IIR and FIR Filters Implementation
+ *
+ * This file contains the transposed direct form II biquad cascade, the
+ * Butterworth designer, the frequency response evaluation and the
+ * decimating FIR filter.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "dsp_filter.h"
+#include "dsp_fft.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Run one section over a block
+ */
+static void biquad_single(const dsp_biquad_coeffs_t *c, float *state, const float *input, float *output,
+                          uint32_t num_samples) {
+    float b0 = c->b0, b1 = c->b1, b2 = c->b2, a1 = c->a1, a2 = c->a2;
+    float d1 = state[0];
+    float d2 = state[1];
+
+    for (uint32_t i = 0; i < num_samples; i++) {
+        float x = input[i];
+        float y = b0 * x + d1;
+        d1 = b1 * x - a1 * y + d2;
+        d2 = b2 * x - a2 * y;
+        output[i] = y;
+    }
+
+    state[0] = d1;
+    state[1] = d2;
+}
+
+/**
+ * @brief Run two consecutive sections over a block in one pass
+ */
+static void biquad_pair(const dsp_biquad_coeffs_t *c, float (*state)[2], const float *input, float *output,
+                        uint32_t num_samples) {
+    float b0 = c[0].b0, b1 = c[0].b1, b2 = c[0].b2, a1 = c[0].a1, a2 = c[0].a2;
+    float e0 = c[1].b0, e1 = c[1].b1, e2 = c[1].b2, f1 = c[1].a1, f2 = c[1].a2;
+    float d1 = state[0][0], d2 = state[0][1];
+    float g1 = state[1][0], g2 = state[1][1];
+
+    for (uint32_t i = 0; i < num_samples; i++) {
+        float x = input[i];
+        float y = b0 * x + d1;
+        d1 = b1 * x - a1 * y + d2;
+        d2 = b2 * x - a2 * y;
+        float z = e0 * y + g1;
+        g1 = e1 * y - f1 * z + g2;
+        g2 = e2 * y - f2 * z;
+        output[i] = z;
+    }
+
+    state[0][0] = d1;
+    state[0][1] = d2;
+    state[1][0] = g1;
+    state[1][1] = g2;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Initialize a biquad cascade at rest
+ */
+bool dsp_biquad_cascade_init(dsp_biquad_cascade_t *cascade, const dsp_biquad_coeffs_t *coeffs,
+                             uint8_t num_stages) {
+    if (!cascade || num_stages > DSP_BIQUAD_MAX_STAGES || (num_stages && !coeffs)) {
+        return false;
+    }
+
+    memset(cascade, 0, sizeof(dsp_biquad_cascade_t));
+    cascade->num_stages = num_stages;
+    if (num_stages) {
+        memcpy(cascade->coeffs, coeffs, num_stages * sizeof(dsp_biquad_coeffs_t));
+    }
+    return true;
+}
+
+/**
+ * @brief Clear the state of a biquad cascade
+ */
+void dsp_biquad_cascade_reset(dsp_biquad_cascade_t *cascade) {
+    if (cascade) {
+        memset(cascade->state, 0, sizeof(cascade->state));
+    }
+}
+
+/**
+ * @brief Filter a block of samples
+ */
+void dsp_biquad_cascade_process(dsp_biquad_cascade_t *cascade, const float *input, float *output,
+                                uint32_t num_samples) {
+    if (!cascade || !input || !output) {
+        return;
+    }
+
+    const float *source = input;
+    if (cascade->num_stages == 0 && output != input) {
+        memmove(output, input, num_samples * sizeof(float));
+    }
+
+    /* Pairs of sections per pass halve the loads and stores of the block */
+    uint8_t s = 0;
+    for (; s + 1 < cascade->num_stages; s += 2) {
+        biquad_pair(&cascade->coeffs[s], &cascade->state[s], source, output, num_samples);
+        source = output;
+    }
+    if (s < cascade->num_stages) {
+        biquad_single(&cascade->coeffs[s], cascade->state[s], source, output, num_samples);
+    }
+}
+
+/**
+ * @brief Design a Butterworth low-pass or high-pass cascade
+ */
+bool dsp_butterworth_design(dsp_filter_response_t response, uint8_t order, float cutoff_hz,
+                            float sample_rate_hz, dsp_biquad_coeffs_t *coeffs, uint8_t *num_stages) {
+    if (!coeffs || !num_stages || order == 0 || order > DSP_BUTTERWORTH_MAX_ORDER ||
+        !(cutoff_hz > 0.0f) || !(cutoff_hz < 0.5f * sample_rate_hz) ||
+        (response != DSP_FILTER_LOWPASS && response != DSP_FILTER_HIGHPASS)) {
+        return false;
+    }
+
+    bool lowpass = (response == DSP_FILTER_LOWPASS);
+    double k = tan(M_PI * (double)cutoff_hz / (double)sample_rate_hz);
+    uint8_t pairs = order / 2;
+    uint8_t stage = 0;
+
+    /* Pole pairs at pi (2i + 1 + order % 2) / (2 order) from the negative real axis */
+    for (uint8_t i = 0; i < pairs; i++) {
+        double theta = M_PI * (double)(2 * i + 1 + (order & 1)) / (2.0 * (double)order);
+        double inv_q = 2.0 * cos(theta);
+        double norm = 1.0 / (1.0 + k * inv_q + k * k);
+        double b0 = lowpass ? k * k * norm : norm;
+        coeffs[stage].b0 = (float)b0;
+        coeffs[stage].b1 = (float)(lowpass ? 2.0 * b0 : -2.0 * b0);
+        coeffs[stage].b2 = (float)b0;
+        coeffs[stage].a1 = (float)(2.0 * (k * k - 1.0) * norm);
+        coeffs[stage].a2 = (float)((1.0 - k * inv_q + k * k) * norm);
+        stage++;
+    }
+
+    /* Odd orders keep one real pole */
+    if (order & 1) {
+        double norm = 1.0 / (1.0 + k);
+        double b0 = lowpass ? k * norm : norm;
+        coeffs[stage].b0 = (float)b0;
+        coeffs[stage].b1 = (float)(lowpass ? b0 : -b0);
+        coeffs[stage].b2 = 0.0f;
+        coeffs[stage].a1 = (float)((k - 1.0) * norm);
+        coeffs[stage].a2 = 0.0f;
+        stage++;
+    }
+
+    *num_stages = stage;
+    return true;
+}
+
+/**
+ * @brief Magnitude response of a section list at one frequency
+ */
+float dsp_biquad_gain(const dsp_biquad_coeffs_t *coeffs, uint8_t num_stages,
+                      float freq_hz, float sample_rate_hz) {
+    if (!coeffs || sample_rate_hz <= 0.0f) {
+        return 0.0f;
+    }
+
+    double w = 2.0 * M_PI * (double)freq_hz / (double)sample_rate_hz;
+    double c1 = cos(w), s1 = sin(w), c2 = cos(2.0 * w), s2 = sin(2.0 * w);
+    double gain = 1.0;
+
+    /* |B(e^-jw)| / |A(e^-jw)| per section */
+    for (uint8_t s = 0; s < num_stages; s++) {
+        const dsp_biquad_coeffs_t *c = &coeffs[s];
+        double num_re = c->b0 + c->b1 * c1 + c->b2 * c2;
+        double num_im = -(c->b1 * s1 + c->b2 * s2);
+        double den_re = 1.0 + c->a1 * c1 + c->a2 * c2;
+        double den_im = -(c->a1 * s1 + c->a2 * s2);
+        gain *= sqrt((num_re * num_re + num_im * num_im) / (den_re * den_re + den_im * den_im));
+    }
+
+    return (float)gain;
+}
+
+/**
+ * @brief Design a linear-phase FIR low-pass (Blackman-windowed sinc)
+ */
+bool dsp_fir_design_lowpass(float *coeffs, uint16_t num_taps, float cutoff_hz, float sample_rate_hz) {
+    if (!coeffs || num_taps < 3 || num_taps > DSP_FIR_MAX_TAPS || !(cutoff_hz > 0.0f) ||
+        !(cutoff_hz < 0.5f * sample_rate_hz)) {
+        return false;
+    }
+
+    double fc = (double)cutoff_hz / (double)sample_rate_hz;
+    double centre = 0.5 * (double)(num_taps - 1);
+    double sum = 0.0;
+
+    for (uint16_t n = 0; n < num_taps; n++) {
+        double t = (double)n - centre;
+        double sinc = (fabs(t) < 1e-9) ? 2.0 * fc : sin(2.0 * M_PI * fc * t) / (M_PI * t);
+        double ratio = (double)n / (double)(num_taps - 1);
+        double window = 0.42 - 0.5 * cos(2.0 * M_PI * ratio) + 0.08 * cos(4.0 * M_PI * ratio);
+        coeffs[n] = (float)(sinc * window);
+        sum += sinc * window;
+    }
+
+    /* Unity gain at DC */
+    if (!(sum > 0.0)) {
+        return false;
+    }
+    for (uint16_t n = 0; n < num_taps; n++) {
+        coeffs[n] = (float)((double)coeffs[n] / sum);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Initialize a decimating FIR filter at rest
+ */
+bool dsp_fir_decimator_init(dsp_fir_decimator_t *fir, const float *coeffs, uint16_t num_taps,
+                            uint8_t factor) {
+    if (!fir || !coeffs || num_taps == 0 || num_taps > DSP_FIR_MAX_TAPS || factor == 0 ||
+        factor > DSP_FIR_MAX_DECIMATION) {
+        return false;
+    }
+
+    memset(fir, 0, sizeof(dsp_fir_decimator_t));
+    fir->num_taps = num_taps;
+    fir->factor = factor;
+    memcpy(fir->coeffs, coeffs, num_taps * sizeof(float));
+    return true;
+}
+
+/**
+ * @brief Clear the delay line and output phase of a decimating FIR filter
+ */
+void dsp_fir_decimator_reset(dsp_fir_decimator_t *fir) {
+    if (fir) {
+        memset(fir->delay, 0, sizeof(fir->delay));
+        fir->phase = 0;
+        fir->position = 0;
+    }
+}
+
+/**
+ * @brief Filter and decimate a block of samples
+ */
+uint32_t dsp_fir_decimator_process(dsp_fir_decimator_t *fir, const float *input, float *output,
+                                   uint32_t num_samples) {
+    if (!fir || !input || !output || fir->num_taps == 0) {
+        return 0;
+    }
+
+    const uint16_t taps = fir->num_taps;
+    const float *h = fir->coeffs;
+    uint16_t position = fir->position;
+    uint8_t phase = fir->phase;
+    uint32_t produced = 0;
+
+    for (uint32_t i = 0; i < num_samples; i++) {
+        /* Newest first: delay[position + k] holds x[n - k] for k < taps */
+        position = (position == 0) ? (uint16_t)(taps - 1) : (uint16_t)(position - 1);
+        fir->delay[position] = input[i];
+        fir->delay[position + taps] = input[i];
+
+        if (++phase < fir->factor) {
+            continue;
+        }
+        phase = 0;
+
+        /* Independent accumulators keep the multiply-accumulate pipeline full */
+        const float *x = &fir->delay[position];
+        float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+        uint16_t k = 0;
+        for (; k + 4 <= taps; k += 4) {
+            acc0 += h[k] * x[k];
+            acc1 += h[k + 1] * x[k + 1];
+            acc2 += h[k + 2] * x[k + 2];
+            acc3 += h[k + 3] * x[k + 3];
+        }
+        for (; k < taps; k++) {
+            acc0 += h[k] * x[k];
+        }
+
+        /* produced <= i, so the input sample is read before its slot is reused */
+        output[produced++] = (acc0 + acc1) + (acc2 + acc3);
+    }
+
+    fir->position = position;
+    fir->phase = phase;
+    return produced;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file dsp_filter.h
+ * @brief Stateful IIR and FIR Filters for EsoCore Signal Processing
+ *
+ * This file defines the biquad cascades shared by the sensor drivers.
+ * Sections run in transposed direct form II, which needs two state values
+ * per section and keeps its state between calls, so a continuous stream can
+ * be filtered block by block without edge transients.
+ *
+ * Blocks are processed two sections at a time over the whole block, keeping
+ * both sections' coefficients and state in registers for the inner loop, so
+ * the block is loaded and stored once per pair of sections. Butterworth
+ * low-pass and high-pass cascades of any order up to twice the section
+ * limit are designed by the bilinear transform.
+ *
+ * A decimating FIR filter complements the cascades where linear phase or
+ * rate reduction is wanted: only the retained outputs are computed, and the
+ * delay line is stored twice so every output is one contiguous dot product.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_DSP_FILTER_H
+#define ESOCORE_DSP_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Filter Configuration
+ * ============================================================================ */
+
+#define DSP_BIQUAD_MAX_STAGES         8     /* Sections per cascade */
+#define DSP_BUTTERWORTH_MAX_ORDER     (2 * DSP_BIQUAD_MAX_STAGES)
+#define DSP_FIR_MAX_TAPS              64    /* Taps per FIR filter */
+#define DSP_FIR_MAX_DECIMATION        16    /* Largest FIR decimation factor */
+
+/* ============================================================================
+ * Filter Data Types
+ * ============================================================================ */
+
+/* Biquad section coefficients (a0 normalized to 1) */
+typedef struct {
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+} dsp_biquad_coeffs_t;
+
+/* Biquad cascade with its state */
+typedef struct {
+    uint8_t num_stages;                     /* Sections in use */
+    dsp_biquad_coeffs_t coeffs[DSP_BIQUAD_MAX_STAGES];
+    float state[DSP_BIQUAD_MAX_STAGES][2];  /* Transposed direct form II delays */
+} dsp_biquad_cascade_t;
+
+/* Filter response for the designers */
+typedef enum {
+    DSP_FILTER_LOWPASS = 0,
+    DSP_FILTER_HIGHPASS,
+} dsp_filter_response_t;
+
+/* Decimating FIR filter with its state */
+typedef struct {
+    uint16_t num_taps;                      /* Taps in use */
+    uint8_t factor;                         /* One output per factor inputs (1 = plain FIR) */
+    uint8_t phase;                          /* Inputs since the last output */
+    uint16_t position;                      /* Newest sample in the delay line */
+    float coeffs[DSP_FIR_MAX_TAPS];         /* h[0] applies to the newest sample */
+    float delay[2 * DSP_FIR_MAX_TAPS];      /* Delay line, stored twice */
+} dsp_fir_decimator_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Initialize a biquad cascade at rest
+ *
+ * @param cascade Pointer to cascade
+ * @param coeffs Section coefficients [num_stages]
+ * @param num_stages Number of sections (0 passes samples through)
+ * @return true if initialization successful, false otherwise
+ */
+bool dsp_biquad_cascade_init(dsp_biquad_cascade_t *cascade, const dsp_biquad_coeffs_t *coeffs,
+                             uint8_t num_stages);
+
+/**
+ * @brief Clear the state of a biquad cascade
+ *
+ * @param cascade Pointer to cascade
+ */
+void dsp_biquad_cascade_reset(dsp_biquad_cascade_t *cascade);
+
+/**
+ * @brief Filter a block of samples
+ *
+ * @param cascade Pointer to cascade
+ * @param input Input samples
+ * @param output Output samples (may equal input)
+ * @param num_samples Number of samples
+ */
+void dsp_biquad_cascade_process(dsp_biquad_cascade_t *cascade, const float *input, float *output,
+                                uint32_t num_samples);
+
+/**
+ * @brief Design a Butterworth low-pass or high-pass cascade
+ *
+ * Even orders use order / 2 second-order sections; odd orders add one
+ * first-order section (b2 = a2 = 0).
+ *
+ * @param response Low-pass or high-pass
+ * @param order Filter order (1 .. DSP_BUTTERWORTH_MAX_ORDER)
+ * @param cutoff_hz -3 dB frequency in Hz (below Nyquist)
+ * @param sample_rate_hz Sample rate in Hz
+ * @param coeffs Section coefficients to fill [(order + 1) / 2]
+ * @param num_stages Pointer to store the number of sections
+ * @return true if design successful, false otherwise
+ */
+bool dsp_butterworth_design(dsp_filter_response_t response, uint8_t order, float cutoff_hz,
+                            float sample_rate_hz, dsp_biquad_coeffs_t *coeffs, uint8_t *num_stages);
+
+/**
+ * @brief Magnitude response of a section list at one frequency
+ *
+ * @param coeffs Section coefficients [num_stages]
+ * @param num_stages Number of sections
+ * @param freq_hz Frequency in Hz
+ * @param sample_rate_hz Sample rate in Hz
+ * @return Linear gain
+ */
+float dsp_biquad_gain(const dsp_biquad_coeffs_t *coeffs, uint8_t num_stages,
+                      float freq_hz, float sample_rate_hz);
+
+/**
+ * @brief Design a linear-phase FIR low-pass (Blackman-windowed sinc)
+ *
+ * @param coeffs Taps to fill [num_taps], normalized to unity gain at DC
+ * @param num_taps Number of taps (3 .. DSP_FIR_MAX_TAPS, odd for a whole-sample delay)
+ * @param cutoff_hz -6 dB frequency in Hz (below Nyquist)
+ * @param sample_rate_hz Sample rate in Hz
+ * @return true if design successful, false otherwise
+ */
+bool dsp_fir_design_lowpass(float *coeffs, uint16_t num_taps, float cutoff_hz, float sample_rate_hz);
+
+/**
+ * @brief Initialize a decimating FIR filter at rest
+ *
+ * @param fir Pointer to filter
+ * @param coeffs Taps [num_taps]
+ * @param num_taps Number of taps (1 .. DSP_FIR_MAX_TAPS)
+ * @param factor Decimation factor (1 .. DSP_FIR_MAX_DECIMATION)
+ * @return true if initialization successful, false otherwise
+ */
+bool dsp_fir_decimator_init(dsp_fir_decimator_t *fir, const float *coeffs, uint16_t num_taps,
+                            uint8_t factor);
+
+/**
+ * @brief Clear the delay line and output phase of a decimating FIR filter
+ *
+ * @param fir Pointer to filter
+ */
+void dsp_fir_decimator_reset(dsp_fir_decimator_t *fir);
+
+/**
+ * @brief Filter and decimate a block of samples
+ *
+ * The output phase carries over between calls, so blocks of any length
+ * yield one output per factor inputs overall.
+ *
+ * @param fir Pointer to filter
+ * @param input Input samples
+ * @param output Output samples (may equal input)
+ * @param num_samples Number of input samples
+ * @return Number of output samples written
+ */
+uint32_t dsp_fir_decimator_process(dsp_fir_decimator_t *fir, const float *input, float *output,
+                                   uint32_t num_samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_DSP_FILTER_H */
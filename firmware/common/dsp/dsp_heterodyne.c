@@ -0,0 +1,288 @@
+/**
+ * @file dsp_heterodyne.c
+ * @brief Ultrasonic Heterodyne Down-Converter Implementation
+ *
+ * This file contains the oscillator table, the mixer and CIC decimator
+ * loop, and the per-block low-pass, envelope and audio shift.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "dsp_heterodyne.h"
+#include "dsp_sound_level.h"
+#include "dsp_fft.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+#define TABLE_SHIFT                   24    /* Phase bits above the table index */
+#define QUARTER_TABLE                 (DSP_HETERODYNE_TABLE_SIZE / 4)
+
+/* Butterworth fourth-order section Q values */
+static const float LOWPASS_Q[2] = {0.54119610f, 1.3065630f};
+
+/* Q15 sine over one period, shared by all receivers */
+static int16_t sine_table[DSP_HETERODYNE_TABLE_SIZE];
+static bool sine_table_ready = false;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Build the oscillator table once
+ */
+static void build_sine_table(void) {
+    if (sine_table_ready) {
+        return;
+    }
+
+    for (uint16_t i = 0; i < DSP_HETERODYNE_TABLE_SIZE; i++) {
+        double value = sin(2.0 * M_PI * (double)i / (double)DSP_HETERODYNE_TABLE_SIZE);
+        sine_table[i] = (int16_t)lrint(value * 32767.0);
+    }
+    sine_table_ready = true;
+}
+
+/**
+ * @brief Oscillator phase increment for a frequency
+ */
+static uint32_t phase_step(double freq_hz, double sample_rate_hz) {
+    return (uint32_t)llround(freq_hz / sample_rate_hz * 4294967296.0);
+}
+
+/**
+ * @brief Low-pass biquad (bilinear transform, RBJ form)
+ */
+static dsp_biquad_coeffs_t lowpass_section(float cutoff_hz, float sample_rate_hz, float q) {
+    float w0 = 2.0f * (float)M_PI * cutoff_hz / sample_rate_hz;
+    float cos_w0 = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
+    float a0 = 1.0f + alpha;
+    dsp_biquad_coeffs_t c = {
+        .b0 = 0.5f * (1.0f - cos_w0) / a0,
+        .b1 = (1.0f - cos_w0) / a0,
+        .b2 = 0.5f * (1.0f - cos_w0) / a0,
+        .a1 = -2.0f * cos_w0 / a0,
+        .a2 = (1.0f - alpha) / a0
+    };
+    return c;
+}
+
+/**
+ * @brief Low-pass a block of decimated I/Q samples and accumulate the measurements
+ *
+ * @param heterodyne Pointer to receiver
+ * @param baseband_i In-phase samples (filtered in place)
+ * @param baseband_q Quadrature samples (filtered in place)
+ * @param count Number of samples
+ * @param audio Audio output for this block (may be NULL)
+ * @param audio_count Entries of audio to fill
+ */
+static void process_block(dsp_heterodyne_t *heterodyne, float *baseband_i, float *baseband_q, uint32_t count,
+                          int16_t *audio, uint32_t audio_count) {
+    dsp_biquad_cascade_process(&heterodyne->lowpass[0], baseband_i, baseband_i, count);
+    dsp_biquad_cascade_process(&heterodyne->lowpass[1], baseband_q, baseband_q, count);
+
+    float prev_i = heterodyne->previous[0], prev_q = heterodyne->previous[1];
+    float energy = 0.0f, phase_re = 0.0f, phase_im = 0.0f;
+    float peak = heterodyne->envelope_peak;
+
+    for (uint32_t n = 0; n < count; n++) {
+        float i = baseband_i[n], q = baseband_q[n];
+        float power = i * i + q * q;
+
+        /* A real tone of amplitude A leaves |z| = A / 2 */
+        energy += power;
+        float envelope = 2.0f * sqrtf(power);
+        if (envelope > peak) {
+            peak = envelope;
+        }
+
+        /* z[n] * conj(z[n-1]) accumulates the phase advance weighted by power */
+        phase_re += i * prev_i + q * prev_q;
+        phase_im += q * prev_i - i * prev_q;
+        prev_i = i;
+        prev_q = q;
+
+        if (n < audio_count) {
+            uint32_t index = heterodyne->shift_phase >> TABLE_SHIFT;
+            float s = (float)sine_table[index] * (1.0f / 32768.0f);
+            float c = (float)sine_table[(index + QUARTER_TABLE) % DSP_HETERODYNE_TABLE_SIZE] * (1.0f / 32768.0f);
+            float sample = 2.0f * (i * c - q * s);
+            audio[n] = (int16_t)((sample > 32767.0f) ? 32767.0f : ((sample < -32768.0f) ? -32768.0f : sample));
+        }
+        heterodyne->shift_phase += heterodyne->shift_step;
+    }
+
+    heterodyne->previous[0] = prev_i;
+    heterodyne->previous[1] = prev_q;
+    heterodyne->envelope_peak = peak;
+    heterodyne->energy += (double)energy;
+    heterodyne->phase_re += (double)phase_re;
+    heterodyne->phase_im += (double)phase_im;
+    heterodyne->samples += count;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Initialize a heterodyne receiver at rest
+ */
+bool dsp_heterodyne_init(dsp_heterodyne_t *heterodyne, uint32_t input_rate_hz,
+                         float center_hz, float bandwidth_hz, float input_scale) {
+    if (!heterodyne || !(bandwidth_hz > 0.0f) || !(input_scale > 0.0f) ||
+        center_hz <= 0.5f * bandwidth_hz ||
+        (float)input_rate_hz <= 2.0f * (center_hz + 0.5f * bandwidth_hz)) {
+        return false;
+    }
+
+    build_sine_table();
+    memset(heterodyne, 0, sizeof(dsp_heterodyne_t));
+
+    uint32_t decimation = (uint32_t)((float)input_rate_hz / (2.0f * bandwidth_hz));
+    if (decimation > DSP_HETERODYNE_MAX_DECIMATION) {
+        decimation = DSP_HETERODYNE_MAX_DECIMATION;
+    }
+    if (decimation < 1) {
+        decimation = 1;
+    }
+
+    heterodyne->input_rate_hz = input_rate_hz;
+    heterodyne->decimation = (uint16_t)decimation;
+    heterodyne->output_rate_hz = input_rate_hz / decimation;
+    heterodyne->center_hz = center_hz;
+    heterodyne->bandwidth_hz = bandwidth_hz;
+    heterodyne->input_scale = input_scale;
+    heterodyne->cic_scale = 1.0f / (float)(decimation * decimation * decimation);
+    heterodyne->lo_step = phase_step(center_hz, input_rate_hz);
+    heterodyne->shift_step = phase_step(0.5 * bandwidth_hz, heterodyne->output_rate_hz);
+
+    /* Passband is +/- bandwidth / 2 around the centre */
+    dsp_biquad_coeffs_t coeffs[2];
+    for (uint8_t s = 0; s < 2; s++) {
+        coeffs[s] = lowpass_section(0.5f * bandwidth_hz, (float)heterodyne->output_rate_hz, LOWPASS_Q[s]);
+    }
+    return dsp_biquad_cascade_init(&heterodyne->lowpass[0], coeffs, 2) &&
+           dsp_biquad_cascade_init(&heterodyne->lowpass[1], coeffs, 2);
+}
+
+/**
+ * @brief Start a new measurement interval, keeping the filter state
+ */
+void dsp_heterodyne_reset(dsp_heterodyne_t *heterodyne) {
+    if (!heterodyne) {
+        return;
+    }
+
+    heterodyne->energy = 0.0;
+    heterodyne->phase_re = 0.0;
+    heterodyne->phase_im = 0.0;
+    heterodyne->envelope_peak = 0.0f;
+    heterodyne->samples = 0;
+}
+
+/**
+ * @brief Push input samples through the receiver
+ */
+uint32_t dsp_heterodyne_process(dsp_heterodyne_t *heterodyne, const int16_t *samples, uint32_t num_samples,
+                                int16_t *audio, uint32_t audio_capacity) {
+    if (!heterodyne || !samples || heterodyne->decimation == 0) {
+        return 0;
+    }
+
+    float baseband[2][DSP_HETERODYNE_BLOCK];
+    uint32_t block_count = 0;
+    uint32_t produced = 0;
+    uint32_t *integ_i = heterodyne->integrator[0];
+    uint32_t *integ_q = heterodyne->integrator[1];
+
+    for (uint32_t n = 0; n < num_samples; n++) {
+        /* Mix with exp(-j w n); products back to 16 bits */
+        uint32_t index = heterodyne->lo_phase >> TABLE_SHIFT;
+        int32_t s = sine_table[index];
+        int32_t c = sine_table[(index + QUARTER_TABLE) % DSP_HETERODYNE_TABLE_SIZE];
+        int32_t x = samples[n];
+        heterodyne->lo_phase += heterodyne->lo_step;
+
+        /* Integrators wrap modulo 2^32; the combs undo the wrap exactly */
+        integ_i[0] += (uint32_t)((x * c) >> 15);
+        integ_i[1] += integ_i[0];
+        integ_i[2] += integ_i[1];
+        integ_q[0] += (uint32_t)(-((x * s) >> 15));
+        integ_q[1] += integ_q[0];
+        integ_q[2] += integ_q[1];
+
+        if (++heterodyne->phase_count < heterodyne->decimation) {
+            continue;
+        }
+        heterodyne->phase_count = 0;
+
+        for (uint8_t ch = 0; ch < 2; ch++) {
+            uint32_t value = heterodyne->integrator[ch][DSP_HETERODYNE_CIC_ORDER - 1];
+            for (uint8_t k = 0; k < DSP_HETERODYNE_CIC_ORDER; k++) {
+                uint32_t delayed = heterodyne->comb[ch][k];
+                heterodyne->comb[ch][k] = value;
+                value -= delayed;
+            }
+            baseband[ch][block_count] = (float)(int32_t)value * heterodyne->cic_scale;
+        }
+
+        if (++block_count == DSP_HETERODYNE_BLOCK) {
+            uint32_t audio_count = (audio && produced < audio_capacity) ? audio_capacity - produced : 0;
+            process_block(heterodyne, baseband[0], baseband[1], block_count,
+                          audio_count ? &audio[produced] : NULL, audio_count);
+            produced += block_count;
+            block_count = 0;
+        }
+    }
+
+    if (block_count) {
+        uint32_t audio_count = (audio && produced < audio_capacity) ? audio_capacity - produced : 0;
+        process_block(heterodyne, baseband[0], baseband[1], block_count,
+                      audio_count ? &audio[produced] : NULL, audio_count);
+        produced += block_count;
+    }
+
+    return produced;
+}
+
+/**
+ * @brief Get the band measurements since the last reset
+ */
+bool dsp_heterodyne_get_levels(const dsp_heterodyne_t *heterodyne, dsp_heterodyne_levels_t *levels) {
+    if (!heterodyne || !levels) {
+        return false;
+    }
+
+    memset(levels, 0, sizeof(dsp_heterodyne_levels_t));
+    levels->frequency_hz = heterodyne->center_hz;
+    if (heterodyne->samples == 0) {
+        return true;
+    }
+
+    /* Band mean square of the real signal is 2 |z|^2 */
+    double scale_sq = (double)heterodyne->input_scale * (double)heterodyne->input_scale;
+    double mean_power = heterodyne->energy / (double)heterodyne->samples;
+    double band_ms = 2.0 * mean_power * scale_sq;
+    double ref_sq = (double)DSP_SOUND_LEVEL_REF_PA * (double)DSP_SOUND_LEVEL_REF_PA;
+
+    levels->duration_s = (float)heterodyne->samples / (float)heterodyne->output_rate_hz;
+    if (band_ms <= 0.0) {
+        return true;
+    }
+
+    levels->level_db = (float)(10.0 * log10(band_ms / ref_sq));
+    levels->envelope_peak = heterodyne->envelope_peak * heterodyne->input_scale;
+    levels->envelope_crest_factor = (float)((double)heterodyne->envelope_peak / (2.0 * sqrt(mean_power)));
+    levels->frequency_hz = heterodyne->center_hz + (float)(atan2(heterodyne->phase_im, heterodyne->phase_re) *
+                                                           (double)heterodyne->output_rate_hz / (2.0 * M_PI));
+    return true;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file dsp_heterodyne.h
+ * @brief Ultrasonic Heterodyne Down-Converter
+ *
+ * This file defines a digital heterodyne receiver that moves a narrow
+ * ultrasonic band (typically 38-42 kHz around a 40 kHz transducer) to
+ * audio as the samples stream in:
+ * - Quadrature mixing with a table-driven oscillator at the band centre
+ * - Third-order CIC decimation in 32-bit integer arithmetic (three adds
+ *   per sample and channel), followed by a fourth-order Butterworth
+ *   low-pass at the output rate that sets the band edges
+ * - Band level, envelope peak and crest factor, and the power-weighted
+ *   mean frequency from the phase advance of the baseband signal
+ * - Optional audio output: the baseband is shifted up by half the
+ *   bandwidth, so the band maps to 0 Hz .. bandwidth without images
+ *
+ * Only the mixer and integrators run at the input rate; everything else
+ * runs after decimation to about twice the bandwidth (8 kHz for a 4 kHz
+ * band), so neither a full-band capture buffer nor a large FFT is needed.
+ * At the band edges the CIC droop adds up to 3 dB to the 3 dB of the
+ * low-pass.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_DSP_HETERODYNE_H
+#define ESOCORE_DSP_HETERODYNE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_filter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Heterodyne Configuration
+ * ============================================================================ */
+
+#define DSP_HETERODYNE_CIC_ORDER      3     /* Integrator/comb pairs */
+#define DSP_HETERODYNE_MAX_DECIMATION 32    /* Keeps the CIC gain within 32 bits */
+#define DSP_HETERODYNE_BLOCK          32    /* Output samples filtered per pass */
+#define DSP_HETERODYNE_TABLE_SIZE     256   /* Oscillator sine table entries */
+
+/* ============================================================================
+ * Heterodyne Data Types
+ * ============================================================================ */
+
+/* Band measurements since the last reset */
+typedef struct {
+    float level_db;                         /* Band level (dB re 20 uPa with a Pascal scale) */
+    float envelope_peak;                    /* Largest envelope value (physical units) */
+    float envelope_crest_factor;            /* Envelope peak / envelope RMS */
+    float frequency_hz;                     /* Power-weighted mean frequency in the band */
+    float duration_s;                       /* Integration time */
+} dsp_heterodyne_levels_t;
+
+/* Heterodyne receiver state */
+typedef struct {
+    uint32_t input_rate_hz;
+    uint32_t output_rate_hz;                /* input_rate_hz / decimation */
+    uint16_t decimation;
+    uint16_t phase_count;                   /* Input samples into the current output */
+    float center_hz;
+    float bandwidth_hz;
+    float input_scale;                      /* Physical unit per input unit */
+    float cic_scale;                        /* 1 / decimation^3 */
+    uint32_t lo_phase;                      /* Mixer oscillator phase */
+    uint32_t lo_step;
+    uint32_t shift_phase;                   /* Audio shift oscillator phase */
+    uint32_t shift_step;
+    uint32_t integrator[2][DSP_HETERODYNE_CIC_ORDER];   /* I, Q (wrapping) */
+    uint32_t comb[2][DSP_HETERODYNE_CIC_ORDER];         /* Previous comb inputs */
+    dsp_biquad_cascade_t lowpass[2];        /* I, Q */
+    float previous[2];                      /* Last baseband sample (I, Q) */
+    double energy;                          /* Sum of squared band signal since reset */
+    double phase_re;                        /* Sum of z[n] * conj(z[n-1]) since reset */
+    double phase_im;
+    float envelope_peak;
+    uint32_t samples;                       /* Output samples since reset */
+} dsp_heterodyne_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Initialize a heterodyne receiver at rest
+ *
+ * The decimation is the largest that keeps the output rate at or above
+ * twice the bandwidth, capped at DSP_HETERODYNE_MAX_DECIMATION.
+ *
+ * @param heterodyne Pointer to receiver
+ * @param input_rate_hz Input sample rate in Hz (above twice the upper band edge)
+ * @param center_hz Band centre in Hz
+ * @param bandwidth_hz Band width in Hz
+ * @param input_scale Physical unit per input unit (e.g. Pascal per ADC count)
+ * @return true if initialization successful, false otherwise
+ */
+bool dsp_heterodyne_init(dsp_heterodyne_t *heterodyne, uint32_t input_rate_hz,
+                         float center_hz, float bandwidth_hz, float input_scale);
+
+/**
+ * @brief Start a new measurement interval, keeping the filter state
+ *
+ * @param heterodyne Pointer to receiver
+ */
+void dsp_heterodyne_reset(dsp_heterodyne_t *heterodyne);
+
+/**
+ * @brief Push input samples through the receiver
+ *
+ * @param heterodyne Pointer to receiver
+ * @param samples Input samples at input_rate_hz
+ * @param num_samples Number of samples
+ * @param audio Down-converted audio at output_rate_hz in input units (may be NULL)
+ * @param audio_capacity Entries available in audio
+ * @return Number of output samples produced (audio holds the first audio_capacity)
+ */
+uint32_t dsp_heterodyne_process(dsp_heterodyne_t *heterodyne, const int16_t *samples, uint32_t num_samples,
+                                int16_t *audio, uint32_t audio_capacity);
+
+/**
+ * @brief Get the band measurements since the last reset
+ *
+ * Silence reads 0 dB and the band centre.
+ *
+ * @param heterodyne Pointer to receiver
+ * @param levels Pointer to measurements to fill
+ * @return true if measurements retrieved, false otherwise
+ */
+bool dsp_heterodyne_get_levels(const dsp_heterodyne_t *heterodyne, dsp_heterodyne_levels_t *levels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_DSP_HETERODYNE_H */
@@ -0,0 +1,315 @@
+/**
+ * @file dsp_integrate.c
+ * @brief Band-Limited Integration Implementation
+ *
+ * This file contains the spectral integrator, the band RMS from an
+ * amplitude spectrum and the streaming high-pass-stabilised integrator.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "dsp_integrate.h"
+#include "dsp_fft.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+#define BUTTERWORTH_Q                 0.70710678f
+#define LOWPASS_LIMIT                 0.45f  /* Low-pass omitted above this fraction of the sample rate */
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Check a band against its sample rate
+ */
+static bool band_valid(const dsp_integrate_band_t *band) {
+    return band && band->sample_rate_hz > 0.0f && band->low_hz > 0.0f &&
+           band->high_hz > band->low_hz && band->low_hz < 0.5f * band->sample_rate_hz &&
+           band->scale != 0.0f;
+}
+
+/**
+ * @brief Remove the least-squares straight line from a block
+ *
+ * Offset and slow drift would otherwise leak from the block edges into the
+ * lowest bins of the band.
+ */
+static void remove_trend(float *data, uint16_t size) {
+    /* With the time axis centred, the slope and mean fit independently */
+    float centre = 0.5f * (float)(size - 1);
+    float sum = 0.0f, sum_t = 0.0f, sum_tt = 0.0f;
+    for (uint16_t n = 0; n < size; n++) {
+        float t = (float)n - centre;
+        sum += data[n];
+        sum_t += t * data[n];
+        sum_tt += t * t;
+    }
+
+    float mean = sum / (float)size;
+    float slope = (sum_tt > 0.0f) ? sum_t / sum_tt : 0.0f;
+    for (uint16_t n = 0; n < size; n++) {
+        data[n] -= mean + slope * ((float)n - centre);
+    }
+}
+
+/**
+ * @brief Low-pass biquad (bilinear transform, RBJ form)
+ */
+static dsp_biquad_coeffs_t lowpass_section(float cutoff_hz, float sample_rate_hz, float q) {
+    float w0 = 2.0f * (float)M_PI * cutoff_hz / sample_rate_hz;
+    float cos_w0 = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
+    float a0 = 1.0f + alpha;
+    dsp_biquad_coeffs_t c = {
+        .b0 = 0.5f * (1.0f - cos_w0) / a0,
+        .b1 = (1.0f - cos_w0) / a0,
+        .b2 = 0.5f * (1.0f - cos_w0) / a0,
+        .a1 = -2.0f * cos_w0 / a0,
+        .a2 = (1.0f - alpha) / a0
+    };
+    return c;
+}
+
+/**
+ * @brief High-pass biquad (bilinear transform, RBJ form)
+ */
+static dsp_biquad_coeffs_t highpass_section(float cutoff_hz, float sample_rate_hz, float q) {
+    float w0 = 2.0f * (float)M_PI * cutoff_hz / sample_rate_hz;
+    float cos_w0 = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
+    float a0 = 1.0f + alpha;
+    dsp_biquad_coeffs_t c = {
+        .b0 = 0.5f * (1.0f + cos_w0) / a0,
+        .b1 = -(1.0f + cos_w0) / a0,
+        .b2 = 0.5f * (1.0f + cos_w0) / a0,
+        .a1 = -2.0f * cos_w0 / a0,
+        .a2 = (1.0f - alpha) / a0
+    };
+    return c;
+}
+
+/**
+ * @brief Leaky trapezoidal integrator, (scale T / 2) (1 + z^-1) / (1 - p z^-1)
+ */
+static dsp_biquad_coeffs_t integrator_section(float leak_hz, float sample_rate_hz, float scale) {
+    float pole = expf(-2.0f * (float)M_PI * leak_hz / sample_rate_hz);
+    float gain = 0.5f * scale / sample_rate_hz;
+    dsp_biquad_coeffs_t c = {
+        .b0 = gain, .b1 = gain, .b2 = 0.0f,
+        .a1 = -pole, .a2 = 0.0f
+    };
+    return c;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Integrate one block in the frequency domain
+ */
+bool dsp_integrate_spectral(const dsp_integrate_band_t *band, dsp_integrate_order_t order,
+                            const float *input, float *output, float *scratch, uint16_t size,
+                            float *rms) {
+    if (!band_valid(band) || !input || !scratch || !dsp_fft_is_valid_size(size) ||
+        (order != DSP_INTEGRATE_VELOCITY && order != DSP_INTEGRATE_DISPLACEMENT)) {
+        return false;
+    }
+
+    if (scratch != input) {
+        memcpy(scratch, input, size * sizeof(float));
+    }
+    remove_trend(scratch, size);
+    if (!dsp_fft_real(scratch, scratch, size)) {
+        return false;
+    }
+
+    /* DC and Nyquist always lie outside the band */
+    scratch[0] = 0.0f;
+    scratch[1] = 0.0f;
+
+    float bin_width = band->sample_rate_hz / (float)size;
+    uint16_t first = (uint16_t)ceilf(band->low_hz / bin_width);
+    uint16_t last = (uint16_t)fminf(floorf(band->high_hz / bin_width), (float)(size / 2 - 1));
+    if (first < 1) {
+        first = 1;
+    }
+
+    /* Zero outside the band, divide by (j w)^order inside it */
+    float w_step = 2.0f * (float)M_PI * bin_width;
+    float power = 0.0f;
+    for (uint16_t k = 1; k < size / 2; k++) {
+        float re = scratch[2 * k];
+        float im = scratch[2 * k + 1];
+        if (k < first || k > last) {
+            scratch[2 * k] = 0.0f;
+            scratch[2 * k + 1] = 0.0f;
+            continue;
+        }
+
+        float inv_w = band->scale / (w_step * (float)k);
+        if (order == DSP_INTEGRATE_VELOCITY) {
+            /* (re + j im) / (j w) = (im - j re) / w */
+            scratch[2 * k] = im * inv_w;
+            scratch[2 * k + 1] = -re * inv_w;
+        } else {
+            inv_w /= w_step * (float)k;
+            scratch[2 * k] = -re * inv_w;
+            scratch[2 * k + 1] = -im * inv_w;
+        }
+        power += scratch[2 * k] * scratch[2 * k] + scratch[2 * k + 1] * scratch[2 * k + 1];
+    }
+
+    /* Parseval: each interior bin stands for itself and its mirror */
+    if (rms) {
+        *rms = sqrtf(2.0f * power) / (float)size;
+    }
+
+    if (!output) {
+        return true;
+    }
+    return dsp_fft_real_inverse(scratch, output, size);
+}
+
+/**
+ * @brief Band-limited velocity and displacement RMS from an amplitude spectrum
+ */
+bool dsp_integrate_spectrum_rms(const dsp_integrate_band_t *band, const float *amplitude,
+                                uint16_t num_bins, float bin_width_hz, float noise_bandwidth,
+                                float *velocity_rms, float *displacement_rms) {
+    if (!band || !(band->low_hz > 0.0f) || !(band->high_hz > band->low_hz) || !amplitude ||
+        num_bins == 0 || !(bin_width_hz > 0.0f) || !(noise_bandwidth > 0.0f)) {
+        return false;
+    }
+
+    uint16_t first = (uint16_t)ceilf(band->low_hz / bin_width_hz);
+    uint16_t last = (uint16_t)fminf(floorf(band->high_hz / bin_width_hz), (float)(num_bins - 1));
+    if (first < 1) {
+        first = 1;
+    }
+
+    float w_step = 2.0f * (float)M_PI * bin_width_hz;
+    float velocity_power = 0.0f, displacement_power = 0.0f;
+    for (uint16_t k = first; k <= last; k++) {
+        float v = amplitude[k] / (w_step * (float)k);
+        float v2 = v * v;
+        velocity_power += v2;
+        displacement_power += v2 / ((w_step * (float)k) * (w_step * (float)k));
+    }
+
+    /* A sinusoid of amplitude A has mean square A^2 / 2 */
+    float norm = 0.5f / noise_bandwidth;
+    if (velocity_rms) {
+        *velocity_rms = fabsf(band->scale) * sqrtf(velocity_power * norm);
+    }
+    if (displacement_rms) {
+        *displacement_rms = fabsf(band->scale) * sqrtf(displacement_power * norm);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Initialize a streaming integrator at rest
+ */
+bool dsp_integrator_init(dsp_integrator_t *integrator, const dsp_integrate_band_t *band) {
+    if (!integrator || !band_valid(band)) {
+        return false;
+    }
+
+    memset(integrator, 0, sizeof(dsp_integrator_t));
+    integrator->band = *band;
+
+    float fs = band->sample_rate_hz;
+    float leak_hz = band->low_hz / DSP_INTEGRATE_LEAK_RATIO;
+    dsp_biquad_coeffs_t coeffs[3];
+    uint8_t stages = 0;
+
+    /* The high-pass removes the offset before it can reach the integrator */
+    coeffs[stages++] = highpass_section(band->low_hz, fs, BUTTERWORTH_Q);
+    if (band->high_hz < LOWPASS_LIMIT * fs) {
+        coeffs[stages++] = lowpass_section(band->high_hz, fs, BUTTERWORTH_Q);
+    }
+    coeffs[stages++] = integrator_section(leak_hz, fs, band->scale);
+    if (!dsp_biquad_cascade_init(&integrator->velocity, coeffs, stages)) {
+        return false;
+    }
+
+    /* Velocity is already in output units, so the second stage integrates with unit scale */
+    coeffs[0] = highpass_section(band->low_hz, fs, BUTTERWORTH_Q);
+    coeffs[1] = integrator_section(leak_hz, fs, 1.0f);
+    if (!dsp_biquad_cascade_init(&integrator->displacement, coeffs, 2)) {
+        return false;
+    }
+
+    integrator->settle_samples = (uint32_t)ceilf(DSP_INTEGRATE_SETTLE_TAU * fs /
+                                                 (2.0f * (float)M_PI * leak_hz));
+    return true;
+}
+
+/**
+ * @brief Clear the state of a streaming integrator and restart settling
+ */
+void dsp_integrator_reset(dsp_integrator_t *integrator) {
+    if (!integrator) {
+        return;
+    }
+
+    dsp_biquad_cascade_reset(&integrator->velocity);
+    dsp_biquad_cascade_reset(&integrator->displacement);
+    integrator->processed = 0;
+}
+
+/**
+ * @brief Integrate a block of acceleration samples
+ */
+bool dsp_integrator_process(dsp_integrator_t *integrator, const float *acceleration, float *velocity,
+                            float *displacement, uint32_t num_samples,
+                            float *velocity_rms, float *displacement_rms) {
+    if (!integrator || !acceleration || !velocity || num_samples == 0) {
+        return false;
+    }
+
+    dsp_biquad_cascade_process(&integrator->velocity, acceleration, velocity, num_samples);
+    if (displacement) {
+        dsp_biquad_cascade_process(&integrator->displacement, velocity, displacement, num_samples);
+    }
+
+    /* Only samples after the settling period count towards the RMS */
+    uint32_t start = 0;
+    if (integrator->processed < integrator->settle_samples) {
+        start = integrator->settle_samples - integrator->processed;
+    }
+    integrator->processed = (integrator->processed > UINT32_MAX - num_samples) ?
+                            UINT32_MAX : integrator->processed + num_samples;
+    if (start >= num_samples) {
+        return false;
+    }
+
+    float velocity_square = 0.0f, displacement_square = 0.0f;
+    for (uint32_t n = start; n < num_samples; n++) {
+        velocity_square += velocity[n] * velocity[n];
+    }
+    if (displacement) {
+        for (uint32_t n = start; n < num_samples; n++) {
+            displacement_square += displacement[n] * displacement[n];
+        }
+    }
+
+    float count = (float)(num_samples - start);
+    if (velocity_rms) {
+        *velocity_rms = sqrtf(velocity_square / count);
+    }
+    if (displacement_rms) {
+        *displacement_rms = displacement ? sqrtf(displacement_square / count) : 0.0f;
+    }
+
+    return true;
+}
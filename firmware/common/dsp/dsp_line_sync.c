@@ -0,0 +1,388 @@
+/**
+ * @file dsp_line_sync.c
+ * @brief Line-Synchronous Resampling and Per-Cycle Harmonic Analysis Implementation
+ *
+ * This file contains the crossing detector and loop filter, the cubic
+ * resampler and the per-cycle transform and running averages.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "dsp_line_sync.h"
+#include "dsp_fft.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+#define PREFILTER_Q                   1.0f  /* Crossing band-pass quality factor */
+#define PREFILTER_STAGES              2
+#define LOOP_PHASE_GAIN               0.3f  /* Phase error removed per cycle */
+#define LOOP_FREQ_GAIN                0.05f /* Frequency correction per cycle of phase error */
+#define FILTER_BLOCK                  64    /* Reference samples band-passed per pass */
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Constant-peak band-pass biquad at the nominal frequency (RBJ form)
+ */
+static dsp_biquad_coeffs_t bandpass_section(float center_hz, float sample_rate_hz) {
+    float w0 = 2.0f * (float)M_PI * center_hz / sample_rate_hz;
+    float alpha = sinf(w0) / (2.0f * PREFILTER_Q);
+    float a0 = 1.0f + alpha;
+    dsp_biquad_coeffs_t c = {
+        .b0 = alpha / a0, .b1 = 0.0f, .b2 = -alpha / a0,
+        .a1 = -2.0f * cosf(w0) / a0, .a2 = (1.0f - alpha) / a0
+    };
+    return c;
+}
+
+/**
+ * @brief Fold a value into a running average (the first cycle seeds it)
+ */
+static float running_average(float average, float value, float alpha, bool first) {
+    return first ? value : average + alpha * (value - average);
+}
+
+/**
+ * @brief Wrap an angle to (-180, 180] degrees
+ */
+static float wrap_degrees(float degrees) {
+    degrees = fmodf(degrees, 360.0f);
+    if (degrees > 180.0f) {
+        degrees -= 360.0f;
+    } else if (degrees <= -180.0f) {
+        degrees += 360.0f;
+    }
+    return degrees;
+}
+
+/**
+ * @brief Transform one synchronous cycle and update the running averages
+ *
+ * @param sync Pointer to line sync
+ */
+static void analyze_cycle(dsp_line_sync_t *sync) {
+    uint16_t size = sync->config.samples_per_cycle;
+    float alpha = 1.0f / (float)sync->config.average_cycles;
+    bool first = (sync->cycles == 0);
+    float inv_size = 1.0f / (float)size;
+
+    /* A bin magnitude |X| is an RMS of sqrt(2) |X| / N */
+    float phasor_scale = sqrtf(2.0f) * inv_size;
+
+    for (uint8_t ch = 0; ch < sync->num_channels; ch++) {
+        const float *samples = sync->cycle[ch];
+        float ms = 0.0f;
+        for (uint16_t i = 0; i < size; i++) {
+            ms += samples[i] * samples[i];
+        }
+        sync->avg_ms[ch] = running_average(sync->avg_ms[ch], ms * inv_size, alpha, first);
+
+        dsp_fft_real(samples, sync->spectrum, size);
+        for (uint8_t h = 1; h <= sync->config.max_harmonic; h++) {
+            float re = sync->spectrum[2 * h] * phasor_scale;
+            float im = sync->spectrum[2 * h + 1] * phasor_scale;
+            sync->avg_harmonic_ms[ch][h] = running_average(sync->avg_harmonic_ms[ch][h], re * re + im * im,
+                                                           alpha, first);
+            sync->avg_phasor[ch][h][0] = running_average(sync->avg_phasor[ch][h][0], re, alpha, first);
+            sync->avg_phasor[ch][h][1] = running_average(sync->avg_phasor[ch][h][1], im, alpha, first);
+        }
+    }
+
+    if (sync->num_channels > 1) {
+        float power = 0.0f;
+        for (uint16_t i = 0; i < size; i++) {
+            power += sync->cycle[0][i] * sync->cycle[1][i];
+        }
+        sync->avg_power = running_average(sync->avg_power, power * inv_size, alpha, first);
+    }
+
+    sync->cycles++;
+}
+
+/**
+ * @brief Handle a positive-going zero crossing of the band-passed reference
+ *
+ * @param sync Pointer to line sync
+ * @param crossing_phase Cycle phase at the interpolated crossing
+ */
+static void handle_crossing(dsp_line_sync_t *sync, float crossing_phase) {
+    if (!sync->acquired) {
+        /* Start the first cycle at this crossing */
+        for (uint8_t i = 0; i < 4; i++) {
+            sync->phase_history[i] -= crossing_phase;
+        }
+        sync->next_index = 0;
+        sync->acquired = true;
+        return;
+    }
+
+    /* Error against the nearest cycle boundary, in cycles */
+    float error = crossing_phase - roundf(crossing_phase);
+
+    sync->step -= LOOP_FREQ_GAIN * error * sync->step;
+    if (sync->step < sync->step_min) {
+        sync->step = sync->step_min;
+    } else if (sync->step > sync->step_max) {
+        sync->step = sync->step_max;
+    }
+
+    /* Spread the phase correction over the next cycle to keep the phase monotonic */
+    sync->phase_adjust = -LOOP_PHASE_GAIN * error * sync->step;
+
+    if (fabsf(error) < DSP_LINE_SYNC_LOCK_ERROR) {
+        if (sync->good_crossings < DSP_LINE_SYNC_LOCK_CYCLES) {
+            sync->good_crossings++;
+        }
+    } else {
+        sync->good_crossings = 0;
+    }
+    sync->locked = (sync->good_crossings >= DSP_LINE_SYNC_LOCK_CYCLES);
+}
+
+/**
+ * @brief Emit the synchronous samples between the two middle history samples
+ *
+ * @param sync Pointer to line sync
+ * @return Number of cycles analysed
+ */
+static uint32_t emit_samples(dsp_line_sync_t *sync) {
+    uint16_t size = sync->config.samples_per_cycle;
+    float inv_size = 1.0f / (float)size;
+    uint32_t cycles = 0;
+
+    while ((float)sync->next_index * inv_size <= sync->phase_history[2]) {
+        float target = (float)sync->next_index * inv_size;
+        float span = sync->phase_history[2] - sync->phase_history[1];
+        float t = (span > 0.0f) ? (target - sync->phase_history[1]) / span : 1.0f;
+        if (t < 0.0f) {
+            t = 0.0f;
+        }
+
+        /* Catmull-Rom between history[1] and history[2] */
+        for (uint8_t ch = 0; ch < sync->num_channels; ch++) {
+            const float *x = sync->history[ch];
+            sync->cycle[ch][sync->next_index] = x[1] + 0.5f * t * (x[2] - x[0] +
+                t * (2.0f * x[0] - 5.0f * x[1] + 4.0f * x[2] - x[3] +
+                t * (3.0f * (x[1] - x[2]) + x[3] - x[0])));
+        }
+
+        if (++sync->next_index == size) {
+            if (sync->locked) {
+                analyze_cycle(sync);
+                cycles++;
+            }
+            sync->next_index = 0;
+            for (uint8_t i = 0; i < 4; i++) {
+                sync->phase_history[i] -= 1.0f;
+            }
+        }
+    }
+
+    return cycles;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Fill a configuration with the default settings
+ */
+void dsp_line_sync_default_config(dsp_line_sync_config_t *config, uint32_t sample_rate_hz, float nominal_hz) {
+    if (!config) {
+        return;
+    }
+
+    memset(config, 0, sizeof(dsp_line_sync_config_t));
+    config->sample_rate_hz = sample_rate_hz;
+    config->nominal_hz = nominal_hz;
+    config->samples_per_cycle = 64;
+    config->average_cycles = 10;
+
+    /* Stay below both the resampled and the input Nyquist frequency */
+    uint32_t max_harmonic = 25;
+    if (max_harmonic > config->samples_per_cycle / 2U - 1U) {
+        max_harmonic = config->samples_per_cycle / 2U - 1U;
+    }
+    if (nominal_hz > 0.0f) {
+        uint32_t input_limit = (uint32_t)((float)sample_rate_hz / (2.0f * nominal_hz * (1.0f + DSP_LINE_SYNC_FREQ_RANGE)));
+        if (max_harmonic > input_limit) {
+            max_harmonic = input_limit;
+        }
+    }
+    config->max_harmonic = (uint8_t)max_harmonic;
+}
+
+/**
+ * @brief Initialize line sync, unlocked
+ */
+bool dsp_line_sync_init(dsp_line_sync_t *sync, const dsp_line_sync_config_t *config) {
+    if (!sync || !config || config->sample_rate_hz == 0 || !(config->nominal_hz > 0.0f) ||
+        config->nominal_hz * (1.0f + DSP_LINE_SYNC_FREQ_RANGE) * 4.0f > (float)config->sample_rate_hz ||
+        config->samples_per_cycle < DSP_LINE_SYNC_MIN_SAMPLES ||
+        config->samples_per_cycle > DSP_LINE_SYNC_MAX_SAMPLES ||
+        !dsp_fft_is_valid_size(config->samples_per_cycle) ||
+        config->max_harmonic == 0 || config->max_harmonic >= config->samples_per_cycle / 2U ||
+        config->max_harmonic >= DSP_LINE_SYNC_MAX_HARMONICS || config->average_cycles == 0) {
+        return false;
+    }
+
+    if (!dsp_fft_init()) {
+        return false;
+    }
+
+    memset(sync, 0, sizeof(dsp_line_sync_t));
+    sync->config = *config;
+    sync->num_channels = 1;
+
+    float nominal_step = config->nominal_hz / (float)config->sample_rate_hz;
+    sync->step = nominal_step;
+    sync->step_min = nominal_step * (1.0f - DSP_LINE_SYNC_FREQ_RANGE);
+    sync->step_max = nominal_step * (1.0f + DSP_LINE_SYNC_FREQ_RANGE);
+
+    dsp_biquad_coeffs_t coeffs[PREFILTER_STAGES];
+    for (uint8_t s = 0; s < PREFILTER_STAGES; s++) {
+        coeffs[s] = bandpass_section(config->nominal_hz, (float)config->sample_rate_hz);
+    }
+    return dsp_biquad_cascade_init(&sync->prefilter, coeffs, PREFILTER_STAGES);
+}
+
+/**
+ * @brief Clear the running averages, keeping the lock
+ */
+void dsp_line_sync_reset(dsp_line_sync_t *sync) {
+    if (!sync) {
+        return;
+    }
+
+    memset(sync->avg_ms, 0, sizeof(sync->avg_ms));
+    memset(sync->avg_harmonic_ms, 0, sizeof(sync->avg_harmonic_ms));
+    memset(sync->avg_phasor, 0, sizeof(sync->avg_phasor));
+    sync->avg_power = 0.0f;
+    sync->cycles = 0;
+}
+
+/**
+ * @brief Push samples through the PLL and analyse every completed cycle
+ */
+uint32_t dsp_line_sync_process(dsp_line_sync_t *sync, const float *reference, const float *other,
+                               uint32_t num_samples) {
+    if (!sync || !reference || sync->config.samples_per_cycle == 0) {
+        return 0;
+    }
+
+    uint8_t num_channels = other ? 2 : 1;
+    if (num_channels != sync->num_channels) {
+        sync->num_channels = num_channels;
+        dsp_line_sync_reset(sync);
+    }
+
+    float filtered[FILTER_BLOCK];
+    float min_spacing = 0.5f / sync->step_max;
+    uint32_t cycles = 0;
+
+    for (uint32_t offset = 0; offset < num_samples; offset += FILTER_BLOCK) {
+        uint32_t count = num_samples - offset;
+        if (count > FILTER_BLOCK) {
+            count = FILTER_BLOCK;
+        }
+        dsp_biquad_cascade_process(&sync->prefilter, &reference[offset], filtered, count);
+
+        for (uint32_t n = 0; n < count; n++) {
+            float phase_prev = sync->phase_history[3];
+            float step = sync->step + sync->phase_adjust;
+            float phase = phase_prev + step;
+            float y = filtered[n];
+
+            /* Shift the history; the newest sample sits at index 3 */
+            for (uint8_t ch = 0; ch < num_channels; ch++) {
+                const float *input = (ch == 0) ? reference : other;
+                float *x = sync->history[ch];
+                x[0] = x[1];
+                x[1] = x[2];
+                x[2] = x[3];
+                x[3] = input[offset + n];
+            }
+            sync->phase_history[0] = sync->phase_history[1];
+            sync->phase_history[1] = sync->phase_history[2];
+            sync->phase_history[2] = phase_prev;
+            sync->phase_history[3] = phase;
+            if (sync->history_count < 4) {
+                sync->history_count++;
+            }
+
+            sync->samples_since_crossing += 1.0f;
+            if (sync->filtered_prev < 0.0f && y >= 0.0f && sync->samples_since_crossing >= min_spacing) {
+                float fraction = sync->filtered_prev / (sync->filtered_prev - y);
+                handle_crossing(sync, phase_prev + fraction * step);
+                sync->samples_since_crossing = 1.0f - fraction;
+            }
+            sync->filtered_prev = y;
+
+            if (sync->acquired && sync->history_count == 4) {
+                cycles += emit_samples(sync);
+            }
+        }
+    }
+
+    return cycles;
+}
+
+/**
+ * @brief Get the averaged results
+ */
+bool dsp_line_sync_get_results(const dsp_line_sync_t *sync, dsp_line_sync_results_t *results) {
+    if (!sync || !results) {
+        return false;
+    }
+
+    memset(results, 0, sizeof(dsp_line_sync_results_t));
+    results->locked = sync->locked;
+    results->frequency_hz = sync->step * (float)sync->config.sample_rate_hz;
+    results->locked_rate_hz = results->frequency_hz * (float)sync->config.samples_per_cycle;
+    results->cycles = sync->cycles;
+    results->max_harmonic = sync->config.max_harmonic;
+    if (sync->cycles == 0) {
+        return false;
+    }
+
+    /* Phases are referred to the reference fundamental, scaled by order */
+    float reference_deg = atan2f(sync->avg_phasor[0][1][1], sync->avg_phasor[0][1][0]) * (float)(180.0 / M_PI);
+
+    for (uint8_t ch = 0; ch < sync->num_channels; ch++) {
+        float distortion_ms = 0.0f;
+        for (uint8_t h = 1; h <= sync->config.max_harmonic; h++) {
+            const float *phasor = sync->avg_phasor[ch][h];
+            results->harmonic_rms[ch][h] = sqrtf(sync->avg_harmonic_ms[ch][h]);
+            results->harmonic_phase_deg[ch][h] = wrap_degrees(atan2f(phasor[1], phasor[0]) * (float)(180.0 / M_PI) -
+                                                              (float)h * reference_deg);
+            if (h > 1) {
+                distortion_ms += sync->avg_harmonic_ms[ch][h];
+            }
+        }
+
+        results->rms[ch] = sqrtf(sync->avg_ms[ch]);
+        float distortion = sqrtf(distortion_ms);
+        results->thd_f[ch] = (results->harmonic_rms[ch][1] > 0.0f) ?
+                             distortion / results->harmonic_rms[ch][1] * 100.0f : 0.0f;
+        results->thd_r[ch] = (results->rms[ch] > 0.0f) ? distortion / results->rms[ch] * 100.0f : 0.0f;
+    }
+
+    if (sync->num_channels > 1) {
+        results->active_power = sync->avg_power;
+        results->apparent_power = results->rms[0] * results->rms[1];
+        results->power_factor = (results->apparent_power > 0.0f) ?
+                                results->active_power / results->apparent_power : 0.0f;
+        results->displacement_power_factor = cosf(results->harmonic_phase_deg[1][1] * (float)(M_PI / 180.0));
+    }
+
+    return true;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file dsp_line_sync.h
+ * @brief Line-Synchronous Resampling and Per-Cycle Harmonic Analysis
+ *
+ * This file defines a software PLL that locks to the mains fundamental and
+ * resamples one or two channels to an exact power-of-two number of samples
+ * per line cycle, so harmonic h of every cycle lands on FFT bin h with no
+ * leakage regardless of how far the line frequency drifts from nominal:
+ * - Zero crossings of the reference channel, band-pass filtered at the
+ *   nominal frequency (zero phase shift there), are interpolated to a
+ *   fraction of a sample
+ * - A second-order loop (phase and frequency correction once per cycle)
+ *   drives a cycle phase accumulator; crossings closer than half a cycle
+ *   are rejected as noise
+ * - Four-point cubic interpolation produces the synchronous samples
+ * - Every completed cycle is transformed with an N-point real FFT; harmonic
+ *   magnitudes, phases, RMS and active power are folded into exponential
+ *   running averages over average_cycles cycles, from which THD and power
+ *   factor are derived
+ *
+ * The locked rate N * f is also reported, for hardware that can retune the
+ * ADC timer instead of resampling.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_DSP_LINE_SYNC_H
+#define ESOCORE_DSP_LINE_SYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_filter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Line Sync Configuration
+ * ============================================================================ */
+
+#define DSP_LINE_SYNC_MAX_SAMPLES     128   /* Largest samples per cycle (power of 2) */
+#define DSP_LINE_SYNC_MIN_SAMPLES     16    /* Smallest samples per cycle */
+#define DSP_LINE_SYNC_MAX_HARMONICS   32    /* Harmonic orders tracked (index = order) */
+#define DSP_LINE_SYNC_CHANNELS        2     /* Reference plus one optional channel */
+#define DSP_LINE_SYNC_LOCK_CYCLES     4     /* Consecutive good crossings to declare lock */
+#define DSP_LINE_SYNC_LOCK_ERROR      0.02f /* Largest phase error in lock (cycles) */
+#define DSP_LINE_SYNC_FREQ_RANGE      0.1f  /* Tracking range, fraction of nominal */
+
+/* ============================================================================
+ * Line Sync Data Types
+ * ============================================================================ */
+
+/* Line sync configuration */
+typedef struct {
+    uint32_t sample_rate_hz;                /* Input sample rate */
+    float nominal_hz;                       /* Nominal line frequency (50 or 60 Hz) */
+    uint16_t samples_per_cycle;             /* Synchronous samples per cycle (power of 2) */
+    uint8_t max_harmonic;                   /* Highest harmonic order analysed */
+    uint16_t average_cycles;                /* Running average time constant in cycles */
+} dsp_line_sync_config_t;
+
+/* Averaged results */
+typedef struct {
+    bool locked;                            /* PLL locked to the fundamental */
+    float frequency_hz;                     /* Tracked line frequency */
+    float locked_rate_hz;                   /* samples_per_cycle * frequency_hz */
+    uint32_t cycles;                        /* Cycles analysed since reset */
+    uint8_t max_harmonic;                   /* Valid entries in the harmonic arrays */
+    float rms[DSP_LINE_SYNC_CHANNELS];      /* True RMS per channel */
+    float harmonic_rms[DSP_LINE_SYNC_CHANNELS][DSP_LINE_SYNC_MAX_HARMONICS];
+    float harmonic_phase_deg[DSP_LINE_SYNC_CHANNELS][DSP_LINE_SYNC_MAX_HARMONICS];
+                                            /* Relative to the reference fundamental */
+    float thd_f[DSP_LINE_SYNC_CHANNELS];    /* THD relative to the fundamental (%) */
+    float thd_r[DSP_LINE_SYNC_CHANNELS];    /* THD relative to the RMS (%) */
+    float active_power;                     /* Mean of channel 0 * channel 1 */
+    float apparent_power;                   /* RMS 0 * RMS 1 */
+    float power_factor;                     /* Active / apparent */
+    float displacement_power_factor;        /* cos of the fundamental phase difference */
+} dsp_line_sync_results_t;
+
+/* Line sync state (caller-owned) */
+typedef struct {
+    dsp_line_sync_config_t config;
+    uint8_t num_channels;                   /* Channels seen by the last process call */
+    dsp_biquad_cascade_t prefilter;         /* Band-pass for crossing detection */
+    float filtered_prev;                    /* Previous band-passed reference sample */
+    float step;                             /* Cycle phase advance per input sample */
+    float step_min;
+    float step_max;
+    float phase_adjust;                     /* Phase correction spread over the next cycle */
+    float history[DSP_LINE_SYNC_CHANNELS][4];   /* Last four input samples */
+    float phase_history[4];                 /* Cycle phase at those samples */
+    uint8_t history_count;
+    float samples_since_crossing;
+    bool acquired;                          /* A crossing has set the cycle phase */
+    uint8_t good_crossings;
+    bool locked;
+    uint16_t next_index;                    /* Next synchronous sample of the cycle */
+    float cycle[DSP_LINE_SYNC_CHANNELS][DSP_LINE_SYNC_MAX_SAMPLES];
+    float spectrum[DSP_LINE_SYNC_MAX_SAMPLES];
+    /* Running averages */
+    float avg_ms[DSP_LINE_SYNC_CHANNELS];
+    float avg_harmonic_ms[DSP_LINE_SYNC_CHANNELS][DSP_LINE_SYNC_MAX_HARMONICS];
+    float avg_phasor[DSP_LINE_SYNC_CHANNELS][DSP_LINE_SYNC_MAX_HARMONICS][2];
+    float avg_power;
+    uint32_t cycles;
+} dsp_line_sync_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Fill a configuration with the default settings
+ *
+ * 64 samples per cycle, harmonics up to the 25th (or the resampled
+ * Nyquist limit), 10-cycle averaging.
+ *
+ * @param config Configuration to fill
+ * @param sample_rate_hz Input sample rate in Hz
+ * @param nominal_hz Nominal line frequency in Hz
+ */
+void dsp_line_sync_default_config(dsp_line_sync_config_t *config, uint32_t sample_rate_hz, float nominal_hz);
+
+/**
+ * @brief Initialize line sync, unlocked
+ *
+ * @param sync Pointer to line sync
+ * @param config Configuration
+ * @return true if initialization successful, false otherwise
+ */
+bool dsp_line_sync_init(dsp_line_sync_t *sync, const dsp_line_sync_config_t *config);
+
+/**
+ * @brief Clear the running averages, keeping the lock
+ *
+ * @param sync Pointer to line sync
+ */
+void dsp_line_sync_reset(dsp_line_sync_t *sync);
+
+/**
+ * @brief Push samples through the PLL and analyse every completed cycle
+ *
+ * @param sync Pointer to line sync
+ * @param reference Reference channel (tracked by the PLL)
+ * @param other Second channel sampled with the reference (may be NULL)
+ * @param num_samples Number of samples per channel
+ * @return Number of cycles analysed
+ */
+uint32_t dsp_line_sync_process(dsp_line_sync_t *sync, const float *reference, const float *other,
+                               uint32_t num_samples);
+
+/**
+ * @brief Get the averaged results
+ *
+ * @param sync Pointer to line sync
+ * @param results Pointer to results to fill
+ * @return true if at least one cycle has been analysed, false otherwise
+ */
+bool dsp_line_sync_get_results(const dsp_line_sync_t *sync, dsp_line_sync_results_t *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_DSP_LINE_SYNC_H */
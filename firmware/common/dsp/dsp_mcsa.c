@@ -0,0 +1,474 @@
+/**
+ * @file dsp_mcsa.c
+ * @brief Motor Current Signature Analysis (MCSA) Implementation
+ *
+ * This file contains the zoom front-end (mixer, low-pass and decimator),
+ * the windowed zoom FFT and the sideband searches.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "dsp_mcsa.h"
+#include "dsp_fft.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+#define ZOOM_OVERSAMPLING             2.5f  /* Output rate per span */
+#define MAIN_LOBE_BINS                4     /* Blackman-Harris main lobe half-width */
+#define GUARD_BINS                    6     /* Exclusion around a known component */
+#define LEVEL_FLOOR                   1e-12f
+
+/* Butterworth eighth-order section Q values */
+static const float LOWPASS_Q[DSP_MCSA_FILTER_STAGES] = {0.50979558f, 0.60134489f, 0.89997622f, 2.5629154f};
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Low-pass biquad (bilinear transform, RBJ form)
+ */
+static dsp_biquad_coeffs_t lowpass_section(float cutoff_hz, float sample_rate_hz, float q) {
+    float w0 = 2.0f * (float)M_PI * cutoff_hz / sample_rate_hz;
+    float cos_w0 = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
+    float a0 = 1.0f + alpha;
+    dsp_biquad_coeffs_t c = {
+        .b0 = 0.5f * (1.0f - cos_w0) / a0,
+        .b1 = (1.0f - cos_w0) / a0,
+        .b2 = 0.5f * (1.0f - cos_w0) / a0,
+        .a1 = -2.0f * cos_w0 / a0,
+        .a2 = (1.0f - alpha) / a0
+    };
+    return c;
+}
+
+/**
+ * @brief Set the mixer step for the current line frequency, keeping its phase
+ */
+static void set_mixer(dsp_mcsa_t *mcsa) {
+    float w = 2.0f * (float)M_PI * mcsa->mixer_hz / (float)mcsa->config.sample_rate_hz;
+    mcsa->osc_step[0] = cosf(w);
+    mcsa->osc_step[1] = -sinf(w);
+}
+
+/**
+ * @brief Magnitude at a signed zoom bin (magnitudes stored in FFT order)
+ */
+static float bin_magnitude(const dsp_mcsa_t *mcsa, int32_t bin) {
+    return mcsa->buffer[(uint32_t)(bin + DSP_MCSA_FFT_SIZE) & (DSP_MCSA_FFT_SIZE - 1)];
+}
+
+/**
+ * @brief Find the strongest local maximum within a window of bins
+ *
+ * @param mcsa Pointer to analyser
+ * @param center Window centre in signed bins
+ * @param tolerance Window half-width in bins
+ * @param limit Largest usable |bin|
+ * @param peak_bin Interpolated peak position in bins
+ * @return Interpolated peak amplitude (0 if the window is empty)
+ */
+static float find_peak(const dsp_mcsa_t *mcsa, float center, float tolerance, int32_t limit, float *peak_bin) {
+    int32_t first = (int32_t)floorf(center - tolerance);
+    int32_t last = (int32_t)ceilf(center + tolerance);
+    if (first < -limit) {
+        first = -limit;
+    }
+    if (last > limit) {
+        last = limit;
+    }
+
+    int32_t best = first;
+    float best_mag = -1.0f;
+    bool best_is_peak = false;
+    for (int32_t k = first; k <= last; k++) {
+        float mag = bin_magnitude(mcsa, k);
+        bool is_peak = (mag >= bin_magnitude(mcsa, k - 1)) && (mag >= bin_magnitude(mcsa, k + 1));
+        /* A true peak always beats the skirt of a neighbouring component */
+        if ((is_peak && !best_is_peak) || (is_peak == best_is_peak && mag > best_mag)) {
+            best = k;
+            best_mag = mag;
+            best_is_peak = is_peak;
+        }
+    }
+
+    *peak_bin = (float)best;
+    if (best_mag <= 0.0f) {
+        return 0.0f;
+    }
+    if (!best_is_peak) {
+        return best_mag;
+    }
+
+    /* Parabolic interpolation of the log magnitudes */
+    float a = logf(bin_magnitude(mcsa, best - 1) + LEVEL_FLOOR);
+    float b = logf(best_mag + LEVEL_FLOOR);
+    float c = logf(bin_magnitude(mcsa, best + 1) + LEVEL_FLOOR);
+    float denom = a - 2.0f * b + c;
+    float p = (denom < 0.0f) ? 0.5f * (a - c) / denom : 0.0f;
+    *peak_bin = (float)best + p;
+    return expf(b - 0.25f * (a - c) * p);
+}
+
+/**
+ * @brief Level of a component relative to the fundamental, corrected for the low-pass
+ */
+static float relative_db(const dsp_mcsa_t *mcsa, float amplitude, float offset_hz) {
+    float gain = dsp_biquad_gain(mcsa->lowpass[0].coeffs, DSP_MCSA_FILTER_STAGES, fabsf(offset_hz),
+                                 (float)mcsa->config.sample_rate_hz);
+    float fundamental = mcsa->results.fundamental;
+    if (gain <= 0.0f || fundamental <= 0.0f) {
+        return 20.0f * log10f(LEVEL_FLOOR);
+    }
+    return 20.0f * log10f(amplitude / gain / fundamental + LEVEL_FLOOR);
+}
+
+/**
+ * @brief Grade the rotor from the lower broken-bar sideband
+ */
+static dsp_mcsa_rotor_grade_t grade_rotor(float lower_db) {
+    if (lower_db < -60.0f) {
+        return DSP_MCSA_ROTOR_EXCELLENT;
+    } else if (lower_db < -54.0f) {
+        return DSP_MCSA_ROTOR_GOOD;
+    } else if (lower_db < -48.0f) {
+        return DSP_MCSA_ROTOR_MODERATE;
+    } else if (lower_db < -42.0f) {
+        return DSP_MCSA_ROTOR_CRACKED;
+    } else if (lower_db < -36.0f) {
+        return DSP_MCSA_ROTOR_BROKEN;
+    }
+    return DSP_MCSA_ROTOR_MULTIPLE_BROKEN;
+}
+
+/**
+ * @brief Check whether a bin lies within the guard band of a component
+ */
+static bool near_component(float bin, float component) {
+    return fabsf(bin - component) <= (float)GUARD_BINS;
+}
+
+/**
+ * @brief Transform the capture and evaluate the fault signatures
+ *
+ * @param mcsa Pointer to analyser
+ */
+static void analyze_capture(dsp_mcsa_t *mcsa) {
+    dsp_mcsa_results_t *r = &mcsa->results;
+    float *data = mcsa->buffer;
+    const uint16_t size = DSP_MCSA_FFT_SIZE;
+
+    /* Four-term Blackman-Harris window: sidelobes below -92 dB */
+    float window_sum = 0.0f;
+    for (uint16_t n = 0; n < size; n++) {
+        float x = 2.0f * (float)M_PI * (float)n / (float)size;
+        float w = 0.35875f - 0.48829f * cosf(x) + 0.14128f * cosf(2.0f * x) - 0.01168f * cosf(3.0f * x);
+        data[2 * n] *= w;
+        data[2 * n + 1] *= w;
+        window_sum += w;
+    }
+
+    if (!dsp_fft_complex(data, size, false)) {
+        return;
+    }
+
+    /* A real tone of amplitude A leaves A / 2 after mixing */
+    float scale = 2.0f / window_sum;
+    for (uint16_t k = 0; k < size; k++) {
+        data[k] = sqrtf(data[2 * k] * data[2 * k] + data[2 * k + 1] * data[2 * k + 1]) * scale;
+    }
+
+    float resolution = mcsa->output_rate_hz / (float)size;
+    int32_t limit = (int32_t)(mcsa->span_hz / resolution);
+    if (limit > size / 2 - 2) {
+        limit = size / 2 - 2;
+    }
+
+    memset(r, 0, sizeof(dsp_mcsa_results_t));
+    r->resolution_hz = resolution;
+
+    /* Fundamental within 1 Hz of the mixer frequency */
+    float f_bin;
+    float tolerance = fmaxf(1.0f / resolution, 2.0f);
+    r->fundamental = find_peak(mcsa, 0.0f, tolerance, limit, &f_bin);
+    r->line_hz = mcsa->mixer_hz + f_bin * resolution;
+    if (r->fundamental <= LEVEL_FLOOR) {
+        return;
+    }
+
+    /* Log-average level outside the fundamental, so a few strong sidebands barely move it */
+    float floor_log = 0.0f;
+    uint32_t floor_bins = 0;
+    for (int32_t k = -limit; k <= limit; k++) {
+        if (!near_component((float)k, f_bin)) {
+            floor_log += logf(bin_magnitude(mcsa, k) + LEVEL_FLOOR);
+            floor_bins++;
+        }
+    }
+    float floor_amplitude = floor_bins ? expf(floor_log / (float)floor_bins) : 0.0f;
+    r->noise_floor_db = 20.0f * log10f(floor_amplitude / r->fundamental + LEVEL_FLOOR);
+
+    float pole_pairs = (float)(mcsa->config.poles / 2);
+    float f1 = r->line_hz;
+
+    /* Slip: configured speed, then the f +/- fr sidebands, then the rated speed */
+    if (mcsa->config.speed_rpm > 0.0f) {
+        r->slip = 1.0f - mcsa->config.speed_rpm * pole_pairs / (60.0f * f1);
+        r->slip_source = DSP_MCSA_SLIP_CONFIGURED;
+    } else {
+        float fr_low = f1 * (1.0f - DSP_MCSA_SLIP_MAX) / pole_pairs / resolution;
+        float fr_high = f1 * (1.0f - DSP_MCSA_SLIP_MIN) / pole_pairs / resolution;
+        if (fr_high + (float)GUARD_BINS < (float)limit) {
+            int32_t best = 0;
+            float best_score = 0.0f;
+            for (int32_t b = (int32_t)floorf(fr_low); b <= (int32_t)ceilf(fr_high); b++) {
+                float score = bin_magnitude(mcsa, (int32_t)lroundf(f_bin) - b) +
+                              bin_magnitude(mcsa, (int32_t)lroundf(f_bin) + b);
+                if (score > best_score) {
+                    best_score = score;
+                    best = b;
+                }
+            }
+
+            float lower_bin, upper_bin;
+            float lower = find_peak(mcsa, f_bin - (float)best, 1.5f, limit, &lower_bin);
+            float upper = find_peak(mcsa, f_bin + (float)best, 1.5f, limit, &upper_bin);
+            float fr_hz = 0.5f * (upper_bin - lower_bin) * resolution;
+            float slip = 1.0f - fr_hz * pole_pairs / f1;
+            float threshold = floor_amplitude * powf(10.0f, DSP_MCSA_DETECT_DB / 20.0f);
+            if (best > 0 && 0.5f * (lower + upper) > threshold &&
+                slip >= 0.5f * DSP_MCSA_SLIP_MIN && slip <= DSP_MCSA_SLIP_MAX) {
+                r->slip = slip;
+                r->slip_source = DSP_MCSA_SLIP_SPECTRUM;
+            }
+        }
+
+        if (r->slip_source == DSP_MCSA_SLIP_NONE && mcsa->config.rated_speed_rpm > 0.0f) {
+            r->slip = 1.0f - mcsa->config.rated_speed_rpm * pole_pairs / (60.0f * f1);
+            r->slip_source = DSP_MCSA_SLIP_RATED;
+        }
+    }
+
+    bool slip_known = (r->slip_source != DSP_MCSA_SLIP_NONE);
+    if (slip_known) {
+        r->rotor_hz = f1 * (1.0f - r->slip) / pole_pairs;
+    }
+
+    /* The rated slip is a full-load figure: search from no load to 20% above it */
+    bool rated = (r->slip_source == DSP_MCSA_SLIP_RATED);
+
+    /* Broken rotor bars: (1 +/- 2s) f, searched clear of the fundamental main lobe */
+    float bar_bins = 2.0f * fabsf(r->slip) * f1 / resolution;
+    float bar_low = rated ? 0.0f : fminf(0.85f * bar_bins, bar_bins - 2.0f);
+    float bar_high = rated ? 1.2f * bar_bins : fmaxf(1.15f * bar_bins, bar_bins + 2.0f);
+    bar_low = fmaxf(bar_low, (float)MAIN_LOBE_BINS + 1.0f);
+    r->rotor_resolved = slip_known && (bar_bins >= (float)GUARD_BINS) && (bar_high + (float)GUARD_BINS < (float)limit);
+    if (r->rotor_resolved) {
+        float center = 0.5f * (bar_low + bar_high);
+        float bar_tolerance = 0.5f * (bar_high - bar_low);
+        float lower_bin, upper_bin;
+        float lower = find_peak(mcsa, f_bin - center, bar_tolerance, limit, &lower_bin);
+        float upper = find_peak(mcsa, f_bin + center, bar_tolerance, limit, &upper_bin);
+        bar_bins = 0.5f * (upper_bin - lower_bin);
+        r->rotor_lower_db = relative_db(mcsa, lower, (lower_bin - f_bin) * resolution);
+        r->rotor_upper_db = relative_db(mcsa, upper, (upper_bin - f_bin) * resolution);
+        r->rotor_grade = grade_rotor(r->rotor_lower_db);
+    }
+
+    /* Eccentricity: f +/- fr */
+    float rotor_bins = r->rotor_hz / resolution;
+    float rotor_low = rated ? f1 * (1.0f - 1.2f * r->slip) / pole_pairs / resolution : rotor_bins - 2.0f;
+    float rotor_high = rated ? f1 / pole_pairs / resolution : rotor_bins + 2.0f;
+    r->eccentricity_resolved = slip_known && (rotor_high + (float)GUARD_BINS < (float)limit);
+    if (r->eccentricity_resolved) {
+        float center = 0.5f * (rotor_low + rotor_high);
+        float rotor_tolerance = 0.5f * (rotor_high - rotor_low);
+        float lower_bin, upper_bin;
+        float lower = find_peak(mcsa, f_bin - center, rotor_tolerance, limit, &lower_bin);
+        float upper = find_peak(mcsa, f_bin + center, rotor_tolerance, limit, &upper_bin);
+        rotor_bins = 0.5f * (upper_bin - lower_bin);
+        r->eccentricity_lower_db = relative_db(mcsa, lower, (lower_bin - f_bin) * resolution);
+        r->eccentricity_upper_db = relative_db(mcsa, upper, (upper_bin - f_bin) * resolution);
+        r->eccentricity_alert = (fmaxf(r->eccentricity_lower_db, r->eccentricity_upper_db) >
+                                 DSP_MCSA_ECCENTRICITY_ALERT_DB);
+    }
+
+    /* The +/-2f products (fundamental image, third harmonic) fold back at 2f modulo the output rate */
+    float fold_bins = fmodf(2.0f * f1, mcsa->output_rate_hz) / resolution;
+
+    /* Load oscillation: strongest local maximum away from the known components */
+    int32_t best = 0;
+    float best_mag = 0.0f;
+    for (int32_t k = -limit + 1; k < limit; k++) {
+        float bin = (float)k;
+        if (near_component(bin, f_bin) || near_component(fabsf(bin), fold_bins) ||
+            near_component(fabsf(bin), (float)size - fold_bins) ||
+            (r->rotor_resolved && (near_component(bin, f_bin - bar_bins) ||
+                                   near_component(bin, f_bin + bar_bins))) ||
+            (r->eccentricity_resolved && (near_component(bin, f_bin - rotor_bins) ||
+                                          near_component(bin, f_bin + rotor_bins)))) {
+            continue;
+        }
+        float mag = bin_magnitude(mcsa, k);
+        if (mag > best_mag && mag >= bin_magnitude(mcsa, k - 1) && mag >= bin_magnitude(mcsa, k + 1)) {
+            best_mag = mag;
+            best = k;
+        }
+    }
+    if (best_mag > 0.0f) {
+        float peak_bin;
+        float peak = find_peak(mcsa, (float)best, 0.0f, limit, &peak_bin);
+        r->oscillation_hz = fabsf(peak_bin - f_bin) * resolution;
+        r->oscillation_db = relative_db(mcsa, peak, (peak_bin - f_bin) * resolution);
+        r->oscillation_alert = (r->oscillation_db > DSP_MCSA_OSCILLATION_ALERT_DB);
+    }
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Initialize the analyser with an empty capture
+ */
+bool dsp_mcsa_init(dsp_mcsa_t *mcsa, const dsp_mcsa_config_t *config) {
+    if (!mcsa || !config || config->poles < 2 || !(config->line_hz > 0.0f) ||
+        (float)config->sample_rate_hz < 4.0f * config->line_hz) {
+        return false;
+    }
+
+    memset(mcsa, 0, sizeof(dsp_mcsa_t));
+    mcsa->config = *config;
+
+    /* Cover f +/- fr, but keep the -2f image at least 68 dB into the stopband */
+    float pole_pairs = (float)(config->poles / 2);
+    mcsa->span_hz = fminf(config->line_hz / pole_pairs + DSP_MCSA_SPAN_MARGIN_HZ, 0.75f * config->line_hz);
+
+    uint32_t decimation = (uint32_t)((float)config->sample_rate_hz / (ZOOM_OVERSAMPLING * mcsa->span_hz));
+    if (decimation < 1) {
+        decimation = 1;
+    } else if (decimation > UINT16_MAX) {
+        decimation = UINT16_MAX;
+    }
+    mcsa->decimation = (uint16_t)decimation;
+    mcsa->output_rate_hz = (float)config->sample_rate_hz / (float)decimation;
+
+    dsp_biquad_coeffs_t coeffs[DSP_MCSA_FILTER_STAGES];
+    for (uint8_t s = 0; s < DSP_MCSA_FILTER_STAGES; s++) {
+        coeffs[s] = lowpass_section(mcsa->span_hz, (float)config->sample_rate_hz, LOWPASS_Q[s]);
+    }
+    if (!dsp_biquad_cascade_init(&mcsa->lowpass[0], coeffs, DSP_MCSA_FILTER_STAGES) ||
+        !dsp_biquad_cascade_init(&mcsa->lowpass[1], coeffs, DSP_MCSA_FILTER_STAGES)) {
+        return false;
+    }
+
+    mcsa->mixer_hz = config->line_hz;
+    mcsa->osc[0] = 1.0f;
+    mcsa->osc[1] = 0.0f;
+    set_mixer(mcsa);
+    return true;
+}
+
+/**
+ * @brief Update the line frequency, applied from the next capture
+ */
+void dsp_mcsa_set_line_frequency(dsp_mcsa_t *mcsa, float line_hz) {
+    if (!mcsa || !(line_hz > 0.0f)) {
+        return;
+    }
+
+    mcsa->config.line_hz = line_hz;
+}
+
+/**
+ * @brief Update the known shaft speed, applied from the next analysis
+ */
+void dsp_mcsa_set_speed(dsp_mcsa_t *mcsa, float speed_rpm) {
+    if (!mcsa) {
+        return;
+    }
+
+    mcsa->config.speed_rpm = (speed_rpm > 0.0f) ? speed_rpm : 0.0f;
+}
+
+/**
+ * @brief Push current samples through the analyser
+ */
+bool dsp_mcsa_process(dsp_mcsa_t *mcsa, const float *samples, uint32_t num_samples) {
+    if (!mcsa || !samples || mcsa->decimation == 0) {
+        return false;
+    }
+
+    float baseband[2][DSP_MCSA_BLOCK];
+    bool analysed = false;
+
+    for (uint32_t offset = 0; offset < num_samples; offset += DSP_MCSA_BLOCK) {
+        uint32_t count = num_samples - offset;
+        if (count > DSP_MCSA_BLOCK) {
+            count = DSP_MCSA_BLOCK;
+        }
+
+        /* Mix with exp(-j w n) by phasor rotation */
+        float osc_re = mcsa->osc[0], osc_im = mcsa->osc[1];
+        const float step_re = mcsa->osc_step[0], step_im = mcsa->osc_step[1];
+        for (uint32_t n = 0; n < count; n++) {
+            float x = samples[offset + n];
+            baseband[0][n] = x * osc_re;
+            baseband[1][n] = x * osc_im;
+            float re = osc_re * step_re - osc_im * step_im;
+            osc_im = osc_re * step_im + osc_im * step_re;
+            osc_re = re;
+        }
+
+        /* Renormalize so rounding cannot grow or shrink the phasor */
+        float norm = 1.5f - 0.5f * (osc_re * osc_re + osc_im * osc_im);
+        mcsa->osc[0] = osc_re * norm;
+        mcsa->osc[1] = osc_im * norm;
+
+        dsp_biquad_cascade_process(&mcsa->lowpass[0], baseband[0], baseband[0], count);
+        dsp_biquad_cascade_process(&mcsa->lowpass[1], baseband[1], baseband[1], count);
+
+        for (uint32_t n = 0; n < count; n++) {
+            if (++mcsa->phase_count < mcsa->decimation) {
+                continue;
+            }
+            mcsa->phase_count = 0;
+
+            mcsa->buffer[2 * mcsa->count] = baseband[0][n];
+            mcsa->buffer[2 * mcsa->count + 1] = baseband[1][n];
+            if (++mcsa->count == DSP_MCSA_FFT_SIZE) {
+                analyze_capture(mcsa);
+                mcsa->results.valid = (mcsa->results.fundamental > LEVEL_FLOOR);
+                analysed = true;
+                mcsa->count = 0;
+
+                /* Follow the line frequency from capture to capture */
+                if (mcsa->mixer_hz != mcsa->config.line_hz) {
+                    mcsa->mixer_hz = mcsa->config.line_hz;
+                    set_mixer(mcsa);
+                }
+            }
+        }
+    }
+
+    return analysed;
+}
+
+/**
+ * @brief Get the results of the last analysis
+ */
+bool dsp_mcsa_get_results(const dsp_mcsa_t *mcsa, dsp_mcsa_results_t *results) {
+    if (!mcsa || !results) {
+        return false;
+    }
+
+    *results = mcsa->results;
+    return mcsa->results.valid;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file dsp_mcsa.h
+ * @brief Motor Current Signature Analysis (MCSA)
+ *
+ * This file defines a zoom-FFT analyser for induction motor faults in the
+ * stator current of one phase:
+ * - The current is mixed down by the line frequency, low-passed with an
+ *   eighth-order Butterworth filter and decimated to a few times the zoom
+ *   span, so a 1024-point complex FFT resolves better than 0.1 Hz around
+ *   the fundamental (about ten seconds of current per analysis)
+ * - Slip comes from a configured shaft speed, or is estimated from the
+ *   rotational-frequency sidebands f +/- fr in the spectrum, or falls back
+ *   to the rated speed
+ * - Broken rotor bars: sidebands at (1 +/- 2s) f, graded on the lower
+ *   sideband relative to the fundamental
+ * - Air-gap eccentricity: sidebands at f +/- fr
+ * - Load oscillation: the strongest remaining sideband within the span
+ *
+ * Sideband levels are in dB relative to the fundamental. The zoom span is
+ * f / pole pairs plus a margin, capped at three quarters of the line
+ * frequency so the image of the fundamental at -2f stays in the filter
+ * stopband; eccentricity of two-pole motors therefore lies outside the span.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_DSP_MCSA_H
+#define ESOCORE_DSP_MCSA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_filter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * MCSA Configuration
+ * ============================================================================ */
+
+#define DSP_MCSA_FFT_SIZE             1024  /* Zoom FFT points (complex) */
+#define DSP_MCSA_FILTER_STAGES        4     /* Low-pass biquad sections per channel */
+#define DSP_MCSA_BLOCK                64    /* Input samples mixed and filtered per pass */
+#define DSP_MCSA_SPAN_MARGIN_HZ       10.0f /* Span beyond the rotational frequency */
+#define DSP_MCSA_SLIP_MIN             0.002f
+#define DSP_MCSA_SLIP_MAX             0.1f
+#define DSP_MCSA_DETECT_DB            12.0f /* Sideband prominence over the floor for slip estimation */
+#define DSP_MCSA_ECCENTRICITY_ALERT_DB -40.0f /* Eccentricity sideband alert level */
+#define DSP_MCSA_OSCILLATION_ALERT_DB -40.0f  /* Load oscillation alert level */
+
+/* ============================================================================
+ * MCSA Data Types
+ * ============================================================================ */
+
+/* Source of the slip used for the sideband predictions */
+typedef enum {
+    DSP_MCSA_SLIP_NONE = 0,                 /* Slip unknown, rotor sidebands not evaluated */
+    DSP_MCSA_SLIP_CONFIGURED,               /* From the configured shaft speed */
+    DSP_MCSA_SLIP_SPECTRUM,                 /* From the f +/- fr sidebands */
+    DSP_MCSA_SLIP_RATED,                    /* From the rated speed */
+} dsp_mcsa_slip_source_t;
+
+/* Broken rotor bar grading from the lower sideband level */
+typedef enum {
+    DSP_MCSA_ROTOR_EXCELLENT = 0,           /* Below -60 dB */
+    DSP_MCSA_ROTOR_GOOD,                    /* -60 .. -54 dB */
+    DSP_MCSA_ROTOR_MODERATE,                /* -54 .. -48 dB */
+    DSP_MCSA_ROTOR_CRACKED,                 /* -48 .. -42 dB: cracked bar or high-resistance joint */
+    DSP_MCSA_ROTOR_BROKEN,                  /* -42 .. -36 dB: broken bar */
+    DSP_MCSA_ROTOR_MULTIPLE_BROKEN,         /* Above -36 dB: several broken bars */
+} dsp_mcsa_rotor_grade_t;
+
+/* Analyser configuration */
+typedef struct {
+    uint32_t sample_rate_hz;                /* Input sample rate */
+    float line_hz;                          /* Line frequency (mixer frequency) */
+    uint8_t poles;                          /* Motor poles (2, 4, 6, ...) */
+    float speed_rpm;                        /* Known shaft speed (0 = estimate slip) */
+    float rated_speed_rpm;                  /* Fallback when no sidebands are found (0 = none) */
+} dsp_mcsa_config_t;
+
+/* Results of the last analysis */
+typedef struct {
+    bool valid;                             /* An analysis has completed */
+    float line_hz;                          /* Measured fundamental frequency */
+    float fundamental;                      /* Fundamental amplitude (input units) */
+    float resolution_hz;                    /* Zoom FFT bin spacing */
+    float noise_floor_db;                   /* Mean level away from the fundamental */
+    dsp_mcsa_slip_source_t slip_source;
+    float slip;                             /* Per unit */
+    float rotor_hz;                         /* Shaft frequency fr = f (1 - s) / pole pairs */
+    bool rotor_resolved;                    /* 2sf clear of the fundamental main lobe */
+    float rotor_lower_db;                   /* (1 - 2s) f sideband */
+    float rotor_upper_db;                   /* (1 + 2s) f sideband */
+    dsp_mcsa_rotor_grade_t rotor_grade;
+    bool eccentricity_resolved;             /* f +/- fr inside the zoom span */
+    float eccentricity_lower_db;            /* f - fr sideband */
+    float eccentricity_upper_db;            /* f + fr sideband */
+    bool eccentricity_alert;
+    float oscillation_hz;                   /* Offset of the strongest other sideband */
+    float oscillation_db;
+    bool oscillation_alert;
+} dsp_mcsa_results_t;
+
+/* Analyser state (caller-owned) */
+typedef struct {
+    dsp_mcsa_config_t config;
+    float span_hz;                          /* Zoom half-width */
+    uint16_t decimation;
+    uint16_t phase_count;                   /* Input samples into the current output */
+    float output_rate_hz;                   /* sample_rate_hz / decimation */
+    float mixer_hz;                         /* Mixer frequency of the current capture */
+    float osc[2];                           /* Mixer phasor (cos, -sin) */
+    float osc_step[2];
+    dsp_biquad_cascade_t lowpass[2];        /* I, Q */
+    uint16_t count;                         /* Complex samples captured */
+    float buffer[2 * DSP_MCSA_FFT_SIZE];    /* Interleaved capture, then magnitudes */
+    dsp_mcsa_results_t results;
+} dsp_mcsa_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Initialize the analyser with an empty capture
+ *
+ * @param mcsa Pointer to analyser
+ * @param config Configuration
+ * @return true if initialization successful, false otherwise
+ */
+bool dsp_mcsa_init(dsp_mcsa_t *mcsa, const dsp_mcsa_config_t *config);
+
+/**
+ * @brief Update the line frequency, applied from the next capture
+ *
+ * @param mcsa Pointer to analyser
+ * @param line_hz Line frequency in Hz (e.g. tracked by the line sync PLL)
+ */
+void dsp_mcsa_set_line_frequency(dsp_mcsa_t *mcsa, float line_hz);
+
+/**
+ * @brief Update the known shaft speed, applied from the next analysis
+ *
+ * @param mcsa Pointer to analyser
+ * @param speed_rpm Shaft speed in rpm (0 = estimate slip from the spectrum)
+ */
+void dsp_mcsa_set_speed(dsp_mcsa_t *mcsa, float speed_rpm);
+
+/**
+ * @brief Push current samples through the analyser
+ *
+ * @param mcsa Pointer to analyser
+ * @param samples Current samples at sample_rate_hz
+ * @param num_samples Number of samples
+ * @return true if an analysis completed during this call, false otherwise
+ */
+bool dsp_mcsa_process(dsp_mcsa_t *mcsa, const float *samples, uint32_t num_samples);
+
+/**
+ * @brief Get the results of the last analysis
+ *
+ * @param mcsa Pointer to analyser
+ * @param results Pointer to results to fill
+ * @return true if an analysis has completed, false otherwise
+ */
+bool dsp_mcsa_get_results(const dsp_mcsa_t *mcsa, dsp_mcsa_results_t *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_DSP_MCSA_H */
@@ -0,0 +1,328 @@
+/**
+ * @file dsp_mel.c
+ * @brief Streaming Log-Mel / MFCC Feature Front-End Implementation
+ *
+ * This file contains the filterbank and DCT table generation, the per-hop
+ * frame computation and the rolling int8 feature map.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "dsp_mel.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Convert a frequency to the mel scale (HTK)
+ */
+static float hz_to_mel(float hz) {
+    return 2595.0f * log10f(1.0f + hz / 700.0f);
+}
+
+/**
+ * @brief Convert a mel-scale value to a frequency (HTK)
+ */
+static float mel_to_hz(float mel) {
+    return 700.0f * (powf(10.0f, mel / 2595.0f) - 1.0f);
+}
+
+/**
+ * @brief Build the sparse triangular filterbank
+ *
+ * Band edges are equally spaced on the mel scale. A band narrower than one
+ * bin keeps the bin nearest its centre so that no band is always empty.
+ *
+ * @param mel Pointer to front-end
+ * @return true if the weights fit the pool, false otherwise
+ */
+static bool build_filterbank(dsp_mel_t *mel) {
+    const dsp_mel_config_t *config = &mel->config;
+    float max_freq = (config->max_freq_hz > 0.0f) ? config->max_freq_hz : 0.5f * (float)config->sample_rate_hz;
+    float mel_low = hz_to_mel(config->min_freq_hz);
+    float mel_step = (hz_to_mel(max_freq) - mel_low) / (float)(config->num_bands + 1);
+    float bin_hz = (float)config->sample_rate_hz / (float)mel->fft_size;
+    uint16_t num_bins = (uint16_t)(mel->fft_size / 2 + 1);
+    uint16_t pool = 0;
+
+    for (uint8_t b = 0; b < config->num_bands; b++) {
+        float left = mel_to_hz(mel_low + mel_step * (float)b);
+        float centre = mel_to_hz(mel_low + mel_step * (float)(b + 1));
+        float right = mel_to_hz(mel_low + mel_step * (float)(b + 2));
+        dsp_mel_band_t *band = &mel->bands[b];
+
+        band->first_bin = 0;
+        band->num_weights = 0;
+        band->weight_offset = pool;
+
+        for (uint16_t k = 0; k < num_bins; k++) {
+            float freq = (float)k * bin_hz;
+            float weight = 0.0f;
+            if (freq > left && freq < right) {
+                weight = (freq <= centre) ? (freq - left) / (centre - left) : (right - freq) / (right - centre);
+            }
+            if (weight <= 0.0f) {
+                continue;
+            }
+            if (band->num_weights == 0) {
+                band->first_bin = k;
+            }
+            if (pool >= DSP_MEL_MAX_WEIGHTS) {
+                return false;
+            }
+            mel->weights[pool++] = weight;
+            band->num_weights++;
+        }
+
+        if (band->num_weights == 0) {
+            uint16_t k = (uint16_t)(centre / bin_hz + 0.5f);
+            if (pool >= DSP_MEL_MAX_WEIGHTS) {
+                return false;
+            }
+            band->first_bin = (k < num_bins) ? k : (uint16_t)(num_bins - 1);
+            band->num_weights = 1;
+            mel->weights[pool++] = 1.0f;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Build the orthonormal DCT-II basis
+ *
+ * @param mel Pointer to front-end
+ */
+static void build_dct(dsp_mel_t *mel) {
+    uint8_t num_bands = mel->config.num_bands;
+    float scale0 = sqrtf(1.0f / (float)num_bands);
+    float scale = sqrtf(2.0f / (float)num_bands);
+
+    for (uint8_t c = 0; c < mel->config.num_mfcc; c++) {
+        for (uint8_t b = 0; b < num_bands; b++) {
+            mel->dct[c * num_bands + b] = (c ? scale : scale0) *
+                cosf((float)M_PI * (float)c * ((float)b + 0.5f) / (float)num_bands);
+        }
+    }
+}
+
+/**
+ * @brief Compute one feature frame from the buffered samples
+ *
+ * @param mel Pointer to front-end
+ */
+static void compute_frame(dsp_mel_t *mel) {
+    uint16_t fft_size = mel->fft_size;
+    float *spectrum = mel->spectrum;
+
+    for (uint16_t i = 0; i < mel->window_length; i++) {
+        spectrum[i] = mel->samples[i] * mel->window[i];
+    }
+    memset(&spectrum[mel->window_length], 0, (size_t)(fft_size - mel->window_length) * sizeof(float));
+
+    dsp_fft_real(spectrum, spectrum, fft_size);
+
+    /* Unpack to power in place; bin k only reads entries at or above 2k */
+    float nyquist = spectrum[1];
+    float norm = 1.0f / (float)fft_size;
+    spectrum[0] = spectrum[0] * spectrum[0] * norm;
+    for (uint16_t k = 1; k < fft_size / 2; k++) {
+        float re = spectrum[2 * k];
+        float im = spectrum[2 * k + 1];
+        spectrum[k] = (re * re + im * im) * norm;
+    }
+    spectrum[fft_size / 2] = nyquist * nyquist * norm;
+
+    /* Sparse filterbank and log compression */
+    float log_energy[DSP_MEL_MAX_BANDS];
+    for (uint8_t b = 0; b < mel->config.num_bands; b++) {
+        const dsp_mel_band_t *band = &mel->bands[b];
+        const float *weight = &mel->weights[band->weight_offset];
+        const float *power = &spectrum[band->first_bin];
+        float energy = 0.0f;
+        for (uint16_t i = 0; i < band->num_weights; i++) {
+            energy += weight[i] * power[i];
+        }
+        log_energy[b] = logf(energy + DSP_MEL_LOG_FLOOR);
+    }
+
+    if (mel->config.num_mfcc == 0) {
+        memcpy(mel->features, log_energy, mel->config.num_bands * sizeof(float));
+    } else {
+        for (uint8_t c = 0; c < mel->config.num_mfcc; c++) {
+            const float *basis = &mel->dct[c * mel->config.num_bands];
+            float sum = 0.0f;
+            for (uint8_t b = 0; b < mel->config.num_bands; b++) {
+                sum += basis[b] * log_energy[b];
+            }
+            mel->features[c] = sum;
+        }
+    }
+
+    /* Quantize into the rolling map */
+    int8_t *row = mel->feature_map[mel->map_head];
+    float inv_scale = 1.0f / mel->config.output_scale;
+    for (uint8_t c = 0; c < mel->num_coeffs; c++) {
+        float q = roundf(mel->features[c] * inv_scale) + (float)mel->config.output_zero_point;
+        row[c] = (int8_t)((q > 127.0f) ? 127.0f : ((q < -128.0f) ? -128.0f : q));
+    }
+
+    mel->map_head = (uint8_t)((mel->map_head + 1) % mel->config.num_frames);
+    if (mel->map_count < mel->config.num_frames) {
+        mel->map_count++;
+    }
+    mel->frames_computed++;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Fill a configuration with the default front-end settings
+ */
+void dsp_mel_default_config(dsp_mel_config_t *config, uint32_t sample_rate_hz) {
+    if (!config) {
+        return;
+    }
+
+    memset(config, 0, sizeof(dsp_mel_config_t));
+    config->sample_rate_hz = sample_rate_hz;
+    config->num_bands = DSP_MEL_MAX_BANDS;
+    config->num_mfcc = 0;
+    config->num_frames = DSP_MEL_MAX_FRAMES;
+    config->min_freq_hz = 20.0f;
+    config->max_freq_hz = 0.0f;
+    config->output_scale = 0.1f;
+    config->output_zero_point = 0;
+}
+
+/**
+ * @brief Initialize a front-end and precompute its tables
+ */
+bool dsp_mel_init(dsp_mel_t *mel, const dsp_mel_config_t *config) {
+    if (!mel || !config ||
+        config->sample_rate_hz < DSP_MEL_MIN_SAMPLE_RATE_HZ || config->sample_rate_hz > DSP_MEL_MAX_SAMPLE_RATE_HZ ||
+        config->num_bands == 0 || config->num_bands > DSP_MEL_MAX_BANDS ||
+        config->num_mfcc > DSP_MEL_MAX_MFCC || config->num_mfcc > config->num_bands ||
+        config->num_frames == 0 || config->num_frames > DSP_MEL_MAX_FRAMES ||
+        !(config->output_scale > 0.0f) || config->min_freq_hz < 0.0f ||
+        config->max_freq_hz > 0.5f * (float)config->sample_rate_hz ||
+        (config->max_freq_hz > 0.0f && config->max_freq_hz <= config->min_freq_hz) ||
+        config->min_freq_hz >= 0.5f * (float)config->sample_rate_hz) {
+        return false;
+    }
+
+    if (!dsp_fft_init()) {
+        return false;
+    }
+
+    memset(mel, 0, sizeof(dsp_mel_t));
+    mel->config = *config;
+
+    uint32_t window_length = config->sample_rate_hz * DSP_MEL_WINDOW_MS / 1000U;
+    mel->window_length = (uint16_t)((window_length < DSP_MEL_MAX_FFT_SIZE) ? window_length : DSP_MEL_MAX_FFT_SIZE);
+    mel->hop_length = (uint16_t)(config->sample_rate_hz * DSP_MEL_HOP_MS / 1000U);
+    mel->fft_size = DSP_FFT_MIN_SIZE;
+    while (mel->fft_size < mel->window_length) {
+        mel->fft_size = (uint16_t)(mel->fft_size * 2U);
+    }
+    mel->num_coeffs = config->num_mfcc ? config->num_mfcc : config->num_bands;
+
+    /* Periodic Hann window over the frame */
+    for (uint16_t i = 0; i < mel->window_length; i++) {
+        mel->window[i] = 0.5f - 0.5f * cosf((float)(2.0 * M_PI) * (float)i / (float)mel->window_length);
+    }
+
+    if (!build_filterbank(mel)) {
+        return false;
+    }
+    build_dct(mel);
+    return true;
+}
+
+/**
+ * @brief Discard buffered samples and feature frames, keeping the tables
+ */
+void dsp_mel_reset(dsp_mel_t *mel) {
+    if (!mel) {
+        return;
+    }
+
+    mel->fill = 0;
+    mel->frames_computed = 0;
+    mel->map_head = 0;
+    mel->map_count = 0;
+}
+
+/**
+ * @brief Push audio samples through the front-end
+ */
+uint16_t dsp_mel_process(dsp_mel_t *mel, const int16_t *samples, uint32_t num_samples) {
+    if (!mel || !samples || mel->fft_size == 0) {
+        return 0;
+    }
+
+    uint16_t frames = 0;
+    uint32_t index = 0;
+
+    while (index < num_samples) {
+        uint32_t take = mel->window_length - mel->fill;
+        if (take > num_samples - index) {
+            take = num_samples - index;
+        }
+        for (uint32_t i = 0; i < take; i++) {
+            mel->samples[mel->fill + i] = (float)samples[index + i] * (1.0f / 32768.0f);
+        }
+        mel->fill = (uint16_t)(mel->fill + take);
+        index += take;
+
+        if (mel->fill == mel->window_length) {
+            compute_frame(mel);
+            frames++;
+
+            /* Keep the overlap for the next frame */
+            uint16_t keep = (uint16_t)(mel->window_length - mel->hop_length);
+            memmove(mel->samples, &mel->samples[mel->hop_length], keep * sizeof(float));
+            mel->fill = keep;
+        }
+    }
+
+    return frames;
+}
+
+/**
+ * @brief Get the latest feature frame before quantization
+ */
+const float *dsp_mel_get_frame(const dsp_mel_t *mel) {
+    return (mel && mel->frames_computed) ? mel->features : NULL;
+}
+
+/**
+ * @brief Check whether the feature map holds num_frames frames
+ */
+bool dsp_mel_is_ready(const dsp_mel_t *mel) {
+    return mel && mel->config.num_frames && mel->map_count == mel->config.num_frames;
+}
+
+/**
+ * @brief Copy the feature map, oldest frame first
+ */
+bool dsp_mel_get_feature_map(const dsp_mel_t *mel, int8_t *output, uint32_t output_size) {
+    if (!dsp_mel_is_ready(mel) || !output ||
+        output_size < (uint32_t)mel->config.num_frames * mel->num_coeffs) {
+        return false;
+    }
+
+    /* Once full, the row written next is the oldest */
+    for (uint8_t f = 0; f < mel->config.num_frames; f++) {
+        uint8_t row = (uint8_t)((mel->map_head + f) % mel->config.num_frames);
+        memcpy(&output[f * mel->num_coeffs], mel->feature_map[row], mel->num_coeffs);
+    }
+    return true;
+}
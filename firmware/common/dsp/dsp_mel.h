@@ -0,0 +1,172 @@
+/**
+ * @file dsp_mel.h
+ * @brief Streaming Log-Mel / MFCC Feature Front-End
+ *
+ * This file defines the acoustic feature front-end that turns microphone
+ * samples into the int8 feature maps consumed by the acoustic classifier:
+ * - 25 ms frames advanced every 10 ms (window capped at DSP_MEL_MAX_FFT_SIZE)
+ * - Hann window and real FFT into the power spectrum
+ * - Sparse triangular mel filterbank: only the non-zero weights of each
+ *   band are stored, so a band costs as many multiplies as bins it covers
+ * - Natural-log compression and, optionally, an orthonormal DCT-II to MFCCs
+ * - A rolling [frames][coefficients] map quantized to the model's int8
+ *   input scale and zero point
+ *
+ * Samples are pushed as they arrive in blocks of any length. Exactly one
+ * frame is computed per hop, so the cost per 10 ms of audio is bounded by
+ * one FFT of at most DSP_MEL_MAX_FFT_SIZE points plus O(bins + bands * mfcc)
+ * multiplies at every supported sample rate (8-48 kHz). All tables are
+ * precomputed by dsp_mel_init() inside the caller-owned front-end.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_DSP_MEL_H
+#define ESOCORE_DSP_MEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_fft.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Front-End Configuration
+ * ============================================================================ */
+
+#define DSP_MEL_MAX_FFT_SIZE          DSP_FFT_MAX_SIZE  /* Largest frame transform */
+#define DSP_MEL_MAX_BANDS             40    /* Mel bands */
+#define DSP_MEL_MAX_MFCC              20    /* Cepstral coefficients */
+#define DSP_MEL_MAX_FRAMES            49    /* Frames in a feature map (~0.5 s) */
+#define DSP_MEL_WINDOW_MS             25    /* Frame length */
+#define DSP_MEL_HOP_MS                10    /* Frame advance */
+#define DSP_MEL_MIN_SAMPLE_RATE_HZ    8000
+#define DSP_MEL_MAX_SAMPLE_RATE_HZ    48000
+#define DSP_MEL_LOG_FLOOR             1e-6f /* Band energy floor before the log */
+
+/* Each bin is shared by at most two triangles, plus one forced bin per band */
+#define DSP_MEL_MAX_WEIGHTS           (DSP_MEL_MAX_FFT_SIZE + 2 + DSP_MEL_MAX_BANDS)
+
+/* ============================================================================
+ * Front-End Data Types
+ * ============================================================================ */
+
+/* Feature front-end configuration */
+typedef struct {
+    uint32_t sample_rate_hz;                /* Input sample rate (8-48 kHz) */
+    uint8_t num_bands;                      /* Mel bands */
+    uint8_t num_mfcc;                       /* Cepstral coefficients (0 = log-mel features) */
+    uint8_t num_frames;                     /* Frames in the feature map */
+    float min_freq_hz;                      /* Lower edge of the first band */
+    float max_freq_hz;                      /* Upper edge of the last band (0 = Nyquist) */
+    float output_scale;                     /* int8 quantization scale */
+    int32_t output_zero_point;              /* int8 quantization zero point */
+} dsp_mel_config_t;
+
+/* Non-zero span of one mel band */
+typedef struct {
+    uint16_t first_bin;                     /* First power bin with a non-zero weight */
+    uint16_t num_weights;                   /* Consecutive weighted bins */
+    uint16_t weight_offset;                 /* Index of the first weight in the pool */
+} dsp_mel_band_t;
+
+/* Feature front-end state (caller-owned, ~21 KB at the maximum sizes) */
+typedef struct {
+    dsp_mel_config_t config;
+    uint16_t window_length;                 /* Samples per frame */
+    uint16_t hop_length;                    /* Samples per hop */
+    uint16_t fft_size;                      /* Zero-padded frame transform */
+    uint8_t num_coeffs;                     /* Features per frame */
+    uint16_t fill;                          /* Samples buffered for the next frame */
+    uint32_t frames_computed;               /* Frames since the last reset */
+    uint8_t map_head;                       /* Feature map row written next */
+    uint8_t map_count;                      /* Valid feature map rows */
+    float window[DSP_MEL_MAX_FFT_SIZE];     /* Hann window [window_length] */
+    float samples[DSP_MEL_MAX_FFT_SIZE];    /* Frame being filled */
+    float spectrum[DSP_MEL_MAX_FFT_SIZE];   /* Transform and power spectrum */
+    dsp_mel_band_t bands[DSP_MEL_MAX_BANDS];
+    float weights[DSP_MEL_MAX_WEIGHTS];     /* Non-zero filterbank weights */
+    float dct[DSP_MEL_MAX_MFCC * DSP_MEL_MAX_BANDS]; /* DCT-II basis [mfcc][bands] */
+    float features[DSP_MEL_MAX_BANDS];      /* Latest frame before quantization */
+    int8_t feature_map[DSP_MEL_MAX_FRAMES][DSP_MEL_MAX_BANDS]; /* Rolling int8 frames */
+} dsp_mel_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Fill a configuration with the default front-end settings
+ *
+ * 40 log-mel bands from 20 Hz to Nyquist, 49 frames, int8 scale 0.1 with
+ * zero point 0.
+ *
+ * @param config Pointer to configuration to fill
+ * @param sample_rate_hz Input sample rate in Hz
+ */
+void dsp_mel_default_config(dsp_mel_config_t *config, uint32_t sample_rate_hz);
+
+/**
+ * @brief Initialize a front-end and precompute its tables
+ *
+ * @param mel Pointer to front-end
+ * @param config Pointer to configuration
+ * @return true if initialization successful, false if the configuration is invalid
+ */
+bool dsp_mel_init(dsp_mel_t *mel, const dsp_mel_config_t *config);
+
+/**
+ * @brief Discard buffered samples and feature frames, keeping the tables
+ *
+ * @param mel Pointer to front-end
+ */
+void dsp_mel_reset(dsp_mel_t *mel);
+
+/**
+ * @brief Push audio samples through the front-end
+ *
+ * Computes one feature frame for every completed hop and appends it to the
+ * feature map.
+ *
+ * @param mel Pointer to front-end
+ * @param samples 16-bit PCM samples (full scale = 1.0)
+ * @param num_samples Number of samples
+ * @return Number of feature frames computed
+ */
+uint16_t dsp_mel_process(dsp_mel_t *mel, const int16_t *samples, uint32_t num_samples);
+
+/**
+ * @brief Get the latest feature frame before quantization
+ *
+ * @param mel Pointer to front-end
+ * @return Features [num_mfcc or num_bands], or NULL if no frame was computed
+ */
+const float *dsp_mel_get_frame(const dsp_mel_t *mel);
+
+/**
+ * @brief Check whether the feature map holds num_frames frames
+ *
+ * @param mel Pointer to front-end
+ * @return true if a full feature map is available
+ */
+bool dsp_mel_is_ready(const dsp_mel_t *mel);
+
+/**
+ * @brief Copy the feature map, oldest frame first
+ *
+ * @param mel Pointer to front-end
+ * @param output Output [num_frames][num_mfcc or num_bands]
+ * @param output_size Output capacity in bytes
+ * @return true if a full map was copied, false otherwise
+ */
+bool dsp_mel_get_feature_map(const dsp_mel_t *mel, int8_t *output, uint32_t output_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_DSP_MEL_H */
@@ -0,0 +1,327 @@
+/**
+ * @file dsp_octave.c
+ * @brief Octave and Third-Octave Band Analysis Implementation
+ *
+ * This file contains the band selection, the bin plan and slice sums, and
+ * the Butterworth band-pass design and integration loop of the filterbank.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "dsp_octave.h"
+#include "dsp_fft.h"
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+#define OCTAVE_RATIO_LOG10            0.3   /* log10(G), base-10 octave ratio */
+#define OCTAVE_REF_HZ                 1000.0
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Edge of a band, half a band from its mid-band frequency
+ *
+ * @param fraction Bandwidth designator
+ * @param index Band index x
+ * @param upper true for the upper edge, false for the lower edge
+ * @return Edge frequency in Hz
+ */
+static double band_edge_hz(dsp_octave_fraction_t fraction, int index, bool upper) {
+    double b = (double)fraction;
+    double half = upper ? 0.5 : -0.5;
+    return OCTAVE_REF_HZ * pow(10.0, OCTAVE_RATIO_LOG10 * ((double)index + half) / b);
+}
+
+/**
+ * @brief Band index whose mid-band frequency is nearest a frequency
+ */
+static int nearest_index(dsp_octave_fraction_t fraction, float freq_hz) {
+    return (int)lround((double)fraction * log10((double)freq_hz / OCTAVE_REF_HZ) / OCTAVE_RATIO_LOG10);
+}
+
+/**
+ * @brief Select the bands between two nominal frequencies below a limit
+ *
+ * @param fraction Bandwidth designator
+ * @param min_hz Nominal mid-band frequency of the first band
+ * @param max_hz Nominal mid-band frequency of the last band
+ * @param limit_hz Upper edges must stay below this frequency
+ * @param first_index Pointer to store x of the first band
+ * @param num_bands Pointer to store the number of bands
+ * @return true if 1 to DSP_OCTAVE_MAX_BANDS bands were selected, false otherwise
+ */
+static bool select_bands(dsp_octave_fraction_t fraction, float min_hz, float max_hz, double limit_hz,
+                         int8_t *first_index, uint8_t *num_bands) {
+    if ((fraction != DSP_OCTAVE_FULL && fraction != DSP_OCTAVE_THIRD) ||
+        !(min_hz > 0.0f) || max_hz < min_hz) {
+        return false;
+    }
+
+    int first = nearest_index(fraction, min_hz);
+    int last = nearest_index(fraction, max_hz);
+    while (last >= first && band_edge_hz(fraction, last, true) >= limit_hz) {
+        last--;
+    }
+
+    if (last < first || last - first + 1 > DSP_OCTAVE_MAX_BANDS || first < INT8_MIN || last > INT8_MAX) {
+        return false;
+    }
+
+    *first_index = (int8_t)first;
+    *num_bands = (uint8_t)(last - first + 1);
+    return true;
+}
+
+/**
+ * @brief Biquad for a conjugate pair of analog poles after the bilinear transform
+ *
+ * The numerator (1 - z^-2) places one zero at DC and one at Nyquist, the
+ * band-pass share of each section.
+ */
+static dsp_biquad_coeffs_t bandpass_section(double complex s, double k) {
+    double complex z = (k + s) / (k - s);
+    dsp_biquad_coeffs_t c = {
+        .b0 = 1.0f, .b1 = 0.0f, .b2 = -1.0f,
+        .a1 = (float)(-2.0 * creal(z)), .a2 = (float)(creal(z) * creal(z) + cimag(z) * cimag(z))
+    };
+    return c;
+}
+
+/**
+ * @brief Design the sixth-order Butterworth band-pass of one band
+ *
+ * The third-order low-pass prototype is moved to the prewarped band edges;
+ * each prototype pole yields two band-pass poles. The response is
+ * normalized to unity at the mid-band frequency, spread over the sections.
+ *
+ * @param lower_hz Lower band edge in Hz
+ * @param upper_hz Upper band edge in Hz
+ * @param sample_rate_hz Sample rate in Hz
+ * @param coeffs Output sections [DSP_OCTAVE_FILTER_STAGES]
+ * @return true if design successful, false otherwise
+ */
+static bool design_bandpass(double lower_hz, double upper_hz, double sample_rate_hz,
+                            dsp_biquad_coeffs_t *coeffs) {
+    double k = 2.0 * sample_rate_hz;
+    double w1 = k * tan(M_PI * lower_hz / sample_rate_hz);
+    double w2 = k * tan(M_PI * upper_hz / sample_rate_hz);
+    double w0_sq = w1 * w2;
+    double half_bw = 0.5 * (w2 - w1);
+    uint8_t stage = 0;
+
+    /* Prototype poles in the upper half plane: 2pi/3 and pi */
+    for (int i = 0; i < 2; i++) {
+        double angle = M_PI * (double)(2 * i + DSP_OCTAVE_FILTER_STAGES + 1) / (2.0 * DSP_OCTAVE_FILTER_STAGES);
+        double complex p = cos(angle) + sin(angle) * I;
+        double complex h = p * half_bw;
+        double complex r = csqrt(h * h - w0_sq);
+
+        coeffs[stage++] = bandpass_section(h + r, k);
+        if (i == 0) {
+            coeffs[stage++] = bandpass_section(h - r, k);
+        }
+    }
+
+    float center_hz = (float)sqrt(lower_hz * upper_hz);
+    float gain = dsp_biquad_gain(coeffs, DSP_OCTAVE_FILTER_STAGES, center_hz, (float)sample_rate_hz);
+    if (!(gain > 0.0f)) {
+        return false;
+    }
+
+    float stage_gain = cbrtf(gain);
+    for (uint8_t s = 0; s < DSP_OCTAVE_FILTER_STAGES; s++) {
+        coeffs[s].b0 /= stage_gain;
+        coeffs[s].b2 /= stage_gain;
+    }
+    return true;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Exact mid-band frequency of a band
+ */
+float dsp_octave_center_hz(dsp_octave_fraction_t fraction, int8_t index) {
+    return (float)(OCTAVE_REF_HZ * pow(10.0, OCTAVE_RATIO_LOG10 * (double)index / (double)fraction));
+}
+
+/**
+ * @brief Build a bin plan
+ */
+bool dsp_octave_plan_init(dsp_octave_plan_t *plan, dsp_octave_fraction_t fraction,
+                          float min_hz, float max_hz, uint32_t sample_rate_hz, uint16_t fft_size) {
+    if (!plan || sample_rate_hz == 0 || fft_size < 2) {
+        return false;
+    }
+
+    memset(plan, 0, sizeof(dsp_octave_plan_t));
+    if (!select_bands(fraction, min_hz, max_hz, 0.5 * (double)sample_rate_hz,
+                      &plan->first_index, &plan->num_bands)) {
+        return false;
+    }
+
+    plan->fraction = fraction;
+    plan->sample_rate_hz = sample_rate_hz;
+    plan->fft_size = fft_size;
+
+    /* A bin is in a band when lower <= k * fs / N < upper */
+    double bins_per_hz = (double)fft_size / (double)sample_rate_hz;
+    uint32_t num_bins = fft_size / 2U;
+    for (uint8_t b = 0; b < plan->num_bands; b++) {
+        int index = plan->first_index + b;
+        uint32_t first = (uint32_t)ceil(band_edge_hz(fraction, index, false) * bins_per_hz);
+        uint32_t end = (uint32_t)ceil(band_edge_hz(fraction, index, true) * bins_per_hz);
+        if (first < 1) {
+            first = 1;
+        }
+        if (end > num_bins) {
+            end = num_bins;
+        }
+        plan->slices[b].first_bin = (uint16_t)first;
+        plan->slices[b].num_bins = (uint16_t)((end > first) ? end - first : 0);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Sum a power spectrum into band powers
+ */
+uint8_t dsp_octave_sum_power(const dsp_octave_plan_t *plan, const float *power, float *band_power) {
+    if (!plan || !power || !band_power) {
+        return 0;
+    }
+
+    for (uint8_t b = 0; b < plan->num_bands; b++) {
+        const float *bin = &power[plan->slices[b].first_bin];
+        float sum = 0.0f;
+        for (uint16_t i = 0; i < plan->slices[b].num_bins; i++) {
+            sum += bin[i];
+        }
+        band_power[b] = sum;
+    }
+    return plan->num_bands;
+}
+
+/**
+ * @brief Sum a magnitude spectrum into band powers
+ */
+uint8_t dsp_octave_sum_magnitude(const dsp_octave_plan_t *plan, const float *magnitude, float *band_power) {
+    if (!plan || !magnitude || !band_power) {
+        return 0;
+    }
+
+    for (uint8_t b = 0; b < plan->num_bands; b++) {
+        const float *bin = &magnitude[plan->slices[b].first_bin];
+        float sum = 0.0f;
+        for (uint16_t i = 0; i < plan->slices[b].num_bins; i++) {
+            sum += bin[i] * bin[i];
+        }
+        band_power[b] = sum;
+    }
+    return plan->num_bands;
+}
+
+/**
+ * @brief Initialize a time-domain filterbank at rest
+ */
+bool dsp_octave_filterbank_init(dsp_octave_filterbank_t *filterbank, dsp_octave_fraction_t fraction,
+                                float min_hz, float max_hz, uint32_t sample_rate_hz, float input_scale) {
+    if (!filterbank || sample_rate_hz == 0 || !(input_scale > 0.0f)) {
+        return false;
+    }
+
+    memset(filterbank, 0, sizeof(dsp_octave_filterbank_t));
+    if (!select_bands(fraction, min_hz, max_hz, DSP_OCTAVE_FILTER_LIMIT * (double)sample_rate_hz,
+                      &filterbank->first_index, &filterbank->num_bands)) {
+        return false;
+    }
+
+    filterbank->fraction = fraction;
+    filterbank->sample_rate_hz = sample_rate_hz;
+    filterbank->input_scale = input_scale;
+
+    for (uint8_t b = 0; b < filterbank->num_bands; b++) {
+        int index = filterbank->first_index + b;
+        dsp_biquad_coeffs_t coeffs[DSP_OCTAVE_FILTER_STAGES];
+        if (!design_bandpass(band_edge_hz(fraction, index, false), band_edge_hz(fraction, index, true),
+                             (double)sample_rate_hz, coeffs) ||
+            !dsp_biquad_cascade_init(&filterbank->filters[b], coeffs, DSP_OCTAVE_FILTER_STAGES)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Start a new Leq interval, keeping the filter state
+ */
+void dsp_octave_filterbank_reset(dsp_octave_filterbank_t *filterbank) {
+    if (!filterbank) {
+        return;
+    }
+
+    memset(filterbank->energy, 0, sizeof(filterbank->energy));
+    filterbank->samples = 0;
+}
+
+/**
+ * @brief Add 16-bit PCM samples to a filterbank
+ */
+void dsp_octave_filterbank_process(dsp_octave_filterbank_t *filterbank, const int16_t *samples,
+                                   uint32_t num_samples) {
+    if (!filterbank || !samples) {
+        return;
+    }
+
+    float block[DSP_OCTAVE_BLOCK];
+    float band[DSP_OCTAVE_BLOCK];
+    float scale = filterbank->input_scale;
+
+    for (uint32_t offset = 0; offset < num_samples; offset += DSP_OCTAVE_BLOCK) {
+        uint32_t count = num_samples - offset;
+        if (count > DSP_OCTAVE_BLOCK) {
+            count = DSP_OCTAVE_BLOCK;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            block[i] = (float)samples[offset + i] * scale;
+        }
+
+        for (uint8_t b = 0; b < filterbank->num_bands; b++) {
+            dsp_biquad_cascade_process(&filterbank->filters[b], block, band, count);
+            float energy = 0.0f;
+            for (uint32_t i = 0; i < count; i++) {
+                energy += band[i] * band[i];
+            }
+            filterbank->energy[b] += (double)energy;
+        }
+
+        filterbank->samples += count;
+    }
+}
+
+/**
+ * @brief Get the mean square of every band since the last reset
+ */
+uint8_t dsp_octave_filterbank_get_mean_square(const dsp_octave_filterbank_t *filterbank, float *mean_square) {
+    if (!filterbank || !mean_square || filterbank->samples == 0) {
+        return 0;
+    }
+
+    for (uint8_t b = 0; b < filterbank->num_bands; b++) {
+        mean_square[b] = (float)(filterbank->energy[b] / (double)filterbank->samples);
+    }
+    return filterbank->num_bands;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file dsp_octave.h
+ * @brief Octave and Third-Octave Band Analysis (IEC 61260)
+ *
+ * This file defines two band engines over the base-10 octave series
+ * (G = 10^0.3, mid-band frequencies 1000 * G^(x/b) Hz, band edges a half
+ * band either side):
+ * - A bin plan that converts the band edges of one sample rate and
+ *   transform size into contiguous bin slices once, so band powers are
+ *   plain slice sums with no per-bin frequency computation or search.
+ * - A time-domain filterbank of sixth-order Butterworth band-pass filters
+ *   (three biquad sections per band) that integrates a true per-band Leq
+ *   on the raw stream without any FFT.
+ *
+ * Bands are indexed by x, the distance from 1 kHz in bands (0 = 1 kHz,
+ * -16 = 25 Hz third-octave, -5 = 31.5 Hz octave). Because the series is
+ * exact, three adjacent third-octave bands span one octave band.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_DSP_OCTAVE_H
+#define ESOCORE_DSP_OCTAVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_filter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Band Analysis Configuration
+ * ============================================================================ */
+
+#define DSP_OCTAVE_MAX_BANDS          32    /* Bands per plan or filterbank */
+#define DSP_OCTAVE_FILTER_STAGES      3     /* Biquad sections per filterbank band */
+#define DSP_OCTAVE_FILTER_LIMIT       0.45f /* Highest filterbank band edge, fraction of fs */
+#define DSP_OCTAVE_BLOCK              64    /* Samples filtered per pass */
+
+/* ============================================================================
+ * Band Analysis Data Types
+ * ============================================================================ */
+
+/* Bandwidth designator b: bands are 1/b octave wide */
+typedef enum {
+    DSP_OCTAVE_FULL = 1,                    /* Octave bands */
+    DSP_OCTAVE_THIRD = 3,                   /* Third-octave bands */
+} dsp_octave_fraction_t;
+
+/* Bins of one band */
+typedef struct {
+    uint16_t first_bin;                     /* First bin inside the band */
+    uint16_t num_bins;                      /* Consecutive bins (0 = band narrower than a bin) */
+} dsp_octave_slice_t;
+
+/* Bin plan for one band set, sample rate and transform size */
+typedef struct {
+    dsp_octave_fraction_t fraction;
+    int8_t first_index;                     /* x of the first band */
+    uint8_t num_bands;                      /* Bands in the plan */
+    uint32_t sample_rate_hz;
+    uint16_t fft_size;
+    dsp_octave_slice_t slices[DSP_OCTAVE_MAX_BANDS];
+} dsp_octave_plan_t;
+
+/* Time-domain filterbank with per-band Leq integrators */
+typedef struct {
+    dsp_octave_fraction_t fraction;
+    int8_t first_index;                     /* x of the first band */
+    uint8_t num_bands;                      /* Bands in the filterbank */
+    uint32_t sample_rate_hz;
+    float input_scale;                      /* Physical unit per input unit */
+    dsp_biquad_cascade_t filters[DSP_OCTAVE_MAX_BANDS];
+    double energy[DSP_OCTAVE_MAX_BANDS];    /* Sum of squared band output since reset */
+    uint64_t samples;                       /* Samples since reset */
+} dsp_octave_filterbank_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Exact mid-band frequency of a band
+ *
+ * @param fraction Bandwidth designator
+ * @param index Band index x (0 = 1 kHz)
+ * @return Mid-band frequency in Hz
+ */
+float dsp_octave_center_hz(dsp_octave_fraction_t fraction, int8_t index);
+
+/**
+ * @brief Build a bin plan
+ *
+ * Covers the bands whose nominal mid-band frequency lies between min_hz and
+ * max_hz and whose upper edge is below Nyquist. A bin belongs to the band
+ * whose edges enclose its centre frequency; DC is never included.
+ *
+ * @param plan Pointer to plan
+ * @param fraction Bandwidth designator
+ * @param min_hz Nominal mid-band frequency of the first band
+ * @param max_hz Nominal mid-band frequency of the last band
+ * @param sample_rate_hz Sample rate in Hz
+ * @param fft_size Transform size (spectrum bins are fft_size / 2)
+ * @return true if at least one band fits, false otherwise
+ */
+bool dsp_octave_plan_init(dsp_octave_plan_t *plan, dsp_octave_fraction_t fraction,
+                          float min_hz, float max_hz, uint32_t sample_rate_hz, uint16_t fft_size);
+
+/**
+ * @brief Sum a power spectrum into band powers
+ *
+ * @param plan Pointer to plan
+ * @param power Power spectrum [fft_size / 2]
+ * @param band_power Output band powers [num_bands]
+ * @return Number of bands written
+ */
+uint8_t dsp_octave_sum_power(const dsp_octave_plan_t *plan, const float *power, float *band_power);
+
+/**
+ * @brief Sum a magnitude spectrum into band powers
+ *
+ * @param plan Pointer to plan
+ * @param magnitude Magnitude spectrum [fft_size / 2]
+ * @param band_power Output band powers (sum of squared magnitudes) [num_bands]
+ * @return Number of bands written
+ */
+uint8_t dsp_octave_sum_magnitude(const dsp_octave_plan_t *plan, const float *magnitude, float *band_power);
+
+/**
+ * @brief Initialize a time-domain filterbank at rest
+ *
+ * Covers the bands whose nominal mid-band frequency lies between min_hz and
+ * max_hz and whose upper edge is below DSP_OCTAVE_FILTER_LIMIT * fs. Each
+ * band reads 0 dB at its mid-band frequency.
+ *
+ * @param filterbank Pointer to filterbank
+ * @param fraction Bandwidth designator
+ * @param min_hz Nominal mid-band frequency of the first band
+ * @param max_hz Nominal mid-band frequency of the last band
+ * @param sample_rate_hz Sample rate in Hz
+ * @param input_scale Physical unit per input unit (e.g. Pascal per PCM count)
+ * @return true if initialization successful, false otherwise
+ */
+bool dsp_octave_filterbank_init(dsp_octave_filterbank_t *filterbank, dsp_octave_fraction_t fraction,
+                                float min_hz, float max_hz, uint32_t sample_rate_hz, float input_scale);
+
+/**
+ * @brief Start a new Leq interval, keeping the filter state
+ *
+ * @param filterbank Pointer to filterbank
+ */
+void dsp_octave_filterbank_reset(dsp_octave_filterbank_t *filterbank);
+
+/**
+ * @brief Add 16-bit PCM samples to a filterbank
+ *
+ * @param filterbank Pointer to filterbank
+ * @param samples PCM samples
+ * @param num_samples Number of samples
+ */
+void dsp_octave_filterbank_process(dsp_octave_filterbank_t *filterbank, const int16_t *samples,
+                                   uint32_t num_samples);
+
+/**
+ * @brief Get the mean square of every band since the last reset
+ *
+ * @param filterbank Pointer to filterbank
+ * @param mean_square Output mean squares in squared physical units [num_bands]
+ * @return Number of bands written (0 before any samples)
+ */
+uint8_t dsp_octave_filterbank_get_mean_square(const dsp_octave_filterbank_t *filterbank, float *mean_square);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_DSP_OCTAVE_H */
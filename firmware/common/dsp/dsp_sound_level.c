@@ -0,0 +1,277 @@
+/**
+ * @file dsp_sound_level.c
+ * @brief Frequency-Weighted Sound Level Meter Implementation
+ *
+ * This file contains the A/C-weighting design for a sample rate, the block
+ * filter and integrator loop and the level conversions.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "dsp_sound_level.h"
+#include "dsp_fft.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+/* IEC 61672-1 weighting pole frequencies */
+#define WEIGHTING_F1_HZ               20.598997
+#define WEIGHTING_F2_HZ               107.65265
+#define WEIGHTING_F3_HZ               737.86223
+#define WEIGHTING_F4_HZ               12194.217
+#define WEIGHTING_NORM_HZ             1000.0f  /* Weightings read 0 dB here */
+#define WEIGHTING_PREWARP_LIMIT       0.45     /* Highest prewarped pole, fraction of fs */
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Map a real analog pole to the z-plane with the bilinear transform
+ *
+ * @param pole_hz Pole frequency in Hz
+ * @param sample_rate_hz Sample rate in Hz
+ * @param prewarp true to place the pole at its analog frequency exactly
+ * @return Digital pole
+ */
+static double bilinear_pole(double pole_hz, double sample_rate_hz, bool prewarp) {
+    double k = 2.0 * sample_rate_hz;
+    double w = prewarp ? k * tan(M_PI * pole_hz / sample_rate_hz) : 2.0 * M_PI * pole_hz;
+    return (k - w) / (k + w);
+}
+
+/**
+ * @brief Section with a double zero at DC and two real poles (high-pass)
+ */
+static dsp_biquad_coeffs_t highpass_section(double p1, double p2) {
+    dsp_biquad_coeffs_t c = {
+        .b0 = 1.0f, .b1 = -2.0f, .b2 = 1.0f,
+        .a1 = (float)(-(p1 + p2)), .a2 = (float)(p1 * p2)
+    };
+    return c;
+}
+
+/**
+ * @brief Section for the 12.2 kHz double pole (low-pass)
+ *
+ * Prewarped with a double zero at Nyquist while the pole lies well below
+ * Nyquist; otherwise the pole is matched (z = exp(-w/fs)) without zeros.
+ */
+static dsp_biquad_coeffs_t lowpass_section(double sample_rate_hz) {
+    dsp_biquad_coeffs_t c;
+    if (WEIGHTING_F4_HZ < WEIGHTING_PREWARP_LIMIT * sample_rate_hz) {
+        double p = bilinear_pole(WEIGHTING_F4_HZ, sample_rate_hz, true);
+        c.b0 = 1.0f;
+        c.b1 = 2.0f;
+        c.b2 = 1.0f;
+        c.a1 = (float)(-2.0 * p);
+        c.a2 = (float)(p * p);
+    } else {
+        double p = exp(-2.0 * M_PI * WEIGHTING_F4_HZ / sample_rate_hz);
+        c.b0 = 1.0f;
+        c.b1 = 0.0f;
+        c.b2 = 0.0f;
+        c.a1 = (float)(-2.0 * p);
+        c.a2 = (float)(p * p);
+    }
+    return c;
+}
+
+/**
+ * @brief Convert a mean square pressure to a level
+ */
+static float ms_to_db(double mean_square) {
+    double ref_sq = (double)DSP_SOUND_LEVEL_REF_PA * (double)DSP_SOUND_LEVEL_REF_PA;
+    return (mean_square > 0.0) ? (float)(10.0 * log10(mean_square / ref_sq)) : 0.0f;
+}
+
+/**
+ * @brief Weight and integrate one block of scaled samples in place
+ *
+ * @param meter Pointer to meter
+ * @param block Samples in Pascal (overwritten with the weighted signal)
+ * @param count Number of samples (at most DSP_SOUND_LEVEL_BLOCK)
+ */
+static void process_block(dsp_sound_level_t *meter, float *block, uint32_t count) {
+    dsp_biquad_cascade_process(&meter->filter, block, block, count);
+
+    float fast = meter->fast_ms, slow = meter->slow_ms;
+    float fast_coeff = meter->fast_coeff, slow_coeff = meter->slow_coeff;
+    float max_fast = meter->max_fast_ms, peak = meter->peak_pa;
+    float energy = 0.0f;
+
+    for (uint32_t i = 0; i < count; i++) {
+        float y = block[i];
+        float sq = y * y;
+        energy += sq;
+        fast += fast_coeff * (sq - fast);
+        slow += slow_coeff * (sq - slow);
+        if (fast > max_fast) {
+            max_fast = fast;
+        }
+        if (fabsf(y) > peak) {
+            peak = fabsf(y);
+        }
+    }
+
+    meter->fast_ms = fast;
+    meter->slow_ms = slow;
+    meter->max_fast_ms = max_fast;
+    meter->peak_pa = peak;
+
+    /* Double precision only once per block */
+    meter->energy += (double)energy;
+    meter->samples += count;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Design a frequency weighting for a sample rate
+ */
+bool dsp_weighting_design(dsp_weighting_t weighting, uint32_t sample_rate_hz,
+                          dsp_biquad_coeffs_t *coeffs, uint8_t *num_stages) {
+    if (!coeffs || !num_stages ||
+        sample_rate_hz < DSP_SOUND_LEVEL_MIN_RATE_HZ || sample_rate_hz > DSP_SOUND_LEVEL_MAX_RATE_HZ) {
+        return false;
+    }
+
+    double fs = (double)sample_rate_hz;
+    double p1 = bilinear_pole(WEIGHTING_F1_HZ, fs, false);
+
+    switch (weighting) {
+        case DSP_WEIGHTING_Z:
+            *num_stages = 0;
+            return true;
+        case DSP_WEIGHTING_A:
+            coeffs[0] = highpass_section(p1, p1);
+            coeffs[1] = highpass_section(bilinear_pole(WEIGHTING_F2_HZ, fs, false),
+                                         bilinear_pole(WEIGHTING_F3_HZ, fs, false));
+            coeffs[2] = lowpass_section(fs);
+            *num_stages = 3;
+            break;
+        case DSP_WEIGHTING_C:
+            coeffs[0] = highpass_section(p1, p1);
+            coeffs[1] = lowpass_section(fs);
+            *num_stages = 2;
+            break;
+        default:
+            return false;
+    }
+
+    /* 0 dB at 1 kHz, folded into the first section */
+    float gain = dsp_biquad_gain(coeffs, *num_stages, WEIGHTING_NORM_HZ, (float)sample_rate_hz);
+    if (!(gain > 0.0f)) {
+        return false;
+    }
+    coeffs[0].b0 /= gain;
+    coeffs[0].b1 /= gain;
+    coeffs[0].b2 /= gain;
+    return true;
+}
+
+/**
+ * @brief Initialize a sound level meter
+ */
+bool dsp_sound_level_init(dsp_sound_level_t *meter, dsp_weighting_t weighting,
+                          uint32_t sample_rate_hz, float input_scale) {
+    dsp_biquad_coeffs_t coeffs[DSP_SOUND_LEVEL_MAX_STAGES];
+    uint8_t num_stages = 0;
+
+    if (!meter || !(input_scale > 0.0f) ||
+        !dsp_weighting_design(weighting, sample_rate_hz, coeffs, &num_stages)) {
+        return false;
+    }
+
+    memset(meter, 0, sizeof(dsp_sound_level_t));
+    meter->weighting = weighting;
+    meter->sample_rate_hz = (float)sample_rate_hz;
+    meter->input_scale = input_scale;
+    meter->fast_coeff = 1.0f - expf(-1.0f / (DSP_SOUND_LEVEL_FAST_TAU_S * (float)sample_rate_hz));
+    meter->slow_coeff = 1.0f - expf(-1.0f / (DSP_SOUND_LEVEL_SLOW_TAU_S * (float)sample_rate_hz));
+    return dsp_biquad_cascade_init(&meter->filter, coeffs, num_stages);
+}
+
+/**
+ * @brief Start a new Leq, maximum and peak interval
+ */
+void dsp_sound_level_reset(dsp_sound_level_t *meter) {
+    if (!meter) {
+        return;
+    }
+
+    meter->energy = 0.0;
+    meter->samples = 0;
+    meter->max_fast_ms = meter->fast_ms;
+    meter->peak_pa = 0.0f;
+}
+
+/**
+ * @brief Add 16-bit PCM samples to a meter
+ */
+void dsp_sound_level_process(dsp_sound_level_t *meter, const int16_t *samples, uint32_t num_samples) {
+    if (!meter || !samples) {
+        return;
+    }
+
+    float block[DSP_SOUND_LEVEL_BLOCK];
+    float scale = meter->input_scale;
+
+    for (uint32_t offset = 0; offset < num_samples; offset += DSP_SOUND_LEVEL_BLOCK) {
+        uint32_t count = num_samples - offset;
+        if (count > DSP_SOUND_LEVEL_BLOCK) {
+            count = DSP_SOUND_LEVEL_BLOCK;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            block[i] = (float)samples[offset + i] * scale;
+        }
+        process_block(meter, block, count);
+    }
+}
+
+/**
+ * @brief Add float samples to a meter
+ */
+void dsp_sound_level_process_float(dsp_sound_level_t *meter, const float *samples, uint32_t num_samples) {
+    if (!meter || !samples) {
+        return;
+    }
+
+    float block[DSP_SOUND_LEVEL_BLOCK];
+    float scale = meter->input_scale;
+
+    for (uint32_t offset = 0; offset < num_samples; offset += DSP_SOUND_LEVEL_BLOCK) {
+        uint32_t count = num_samples - offset;
+        if (count > DSP_SOUND_LEVEL_BLOCK) {
+            count = DSP_SOUND_LEVEL_BLOCK;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            block[i] = samples[offset + i] * scale;
+        }
+        process_block(meter, block, count);
+    }
+}
+
+/**
+ * @brief Get the current levels of a meter
+ */
+bool dsp_sound_level_get(const dsp_sound_level_t *meter, dsp_sound_levels_t *levels) {
+    if (!meter || !levels) {
+        return false;
+    }
+
+    levels->fast_db = ms_to_db(meter->fast_ms);
+    levels->slow_db = ms_to_db(meter->slow_ms);
+    levels->leq_db = meter->samples ? ms_to_db(meter->energy / (double)meter->samples) : 0.0f;
+    levels->max_fast_db = ms_to_db(meter->max_fast_ms);
+    levels->peak_db = ms_to_db((double)meter->peak_pa * (double)meter->peak_pa);
+    levels->duration_s = (float)((double)meter->samples / (double)meter->sample_rate_hz);
+    return true;
+}
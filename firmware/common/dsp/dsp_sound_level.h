@@ -0,0 +1,156 @@
+/**
+ * @file dsp_sound_level.h
+ * @brief Frequency-Weighted Sound Level Meter (IEC 61672)
+ *
+ * This file defines a continuous sound level meter that runs on the raw
+ * microphone stream without an FFT:
+ * - A- and C-weighting as biquad cascades designed for the sample rate from
+ *   the IEC 61672-1 analog poles (20.6 Hz, 107.7 Hz, 737.9 Hz, 12.2 kHz),
+ *   normalized to 0 dB at 1 kHz. Low poles use the bilinear transform; the
+ *   12.2 kHz pair is prewarped, or pole-matched when it lies near or above
+ *   Nyquist. Class 1 tolerances hold up to 20 kHz at 32-48 kHz and up to
+ *   about a third of the sample rate below that.
+ * - Fast (125 ms) and Slow (1 s) exponential time weighting
+ * - Equivalent continuous level (Leq/LAeq), maximum Fast level and peak
+ *   level since the last reset
+ *
+ * Per sample the A meter costs three biquad sections, a square and two
+ * one-pole updates; blocks are filtered section by section.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_DSP_SOUND_LEVEL_H
+#define ESOCORE_DSP_SOUND_LEVEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_filter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Sound Level Configuration
+ * ============================================================================ */
+
+#define DSP_SOUND_LEVEL_MAX_STAGES    3         /* Biquad sections of a weighting */
+#define DSP_SOUND_LEVEL_BLOCK         64        /* Samples filtered per pass */
+#define DSP_SOUND_LEVEL_FAST_TAU_S    0.125f    /* Fast time constant */
+#define DSP_SOUND_LEVEL_SLOW_TAU_S    1.0f      /* Slow time constant */
+#define DSP_SOUND_LEVEL_REF_PA        20e-6f    /* Reference sound pressure */
+#define DSP_SOUND_LEVEL_MIN_RATE_HZ   8000
+#define DSP_SOUND_LEVEL_MAX_RATE_HZ   96000
+
+/* ============================================================================
+ * Sound Level Data Types
+ * ============================================================================ */
+
+/* Frequency weighting */
+typedef enum {
+    DSP_WEIGHTING_Z = 0,                    /* Unweighted */
+    DSP_WEIGHTING_A = 1,                    /* A-weighting */
+    DSP_WEIGHTING_C = 2,                    /* C-weighting */
+} dsp_weighting_t;
+
+/* Levels of one meter in dB re 20 uPa */
+typedef struct {
+    float fast_db;                          /* Fast time-weighted level (LxF) */
+    float slow_db;                          /* Slow time-weighted level (LxS) */
+    float leq_db;                           /* Equivalent continuous level since reset (Lxeq) */
+    float max_fast_db;                      /* Largest Fast level since reset (LxFmax) */
+    float peak_db;                          /* Largest weighted instantaneous pressure since reset (Lxpeak) */
+    float duration_s;                       /* Integration time of leq_db */
+} dsp_sound_levels_t;
+
+/* Sound level meter state */
+typedef struct {
+    dsp_weighting_t weighting;
+    float sample_rate_hz;
+    float input_scale;                      /* Pascal per input unit */
+    dsp_biquad_cascade_t filter;            /* Frequency weighting */
+    float fast_coeff;                       /* 1 - exp(-1 / (tau_fast * fs)) */
+    float slow_coeff;                       /* 1 - exp(-1 / (tau_slow * fs)) */
+    float fast_ms;                          /* Fast mean square pressure (Pa^2) */
+    float slow_ms;                          /* Slow mean square pressure (Pa^2) */
+    float max_fast_ms;                      /* Largest fast_ms since reset */
+    float peak_pa;                          /* Largest absolute weighted pressure since reset */
+    double energy;                          /* Sum of squared pressure since reset */
+    uint64_t samples;                       /* Samples since reset */
+} dsp_sound_level_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Design a frequency weighting for a sample rate
+ *
+ * @param weighting Frequency weighting
+ * @param sample_rate_hz Sample rate in Hz
+ * @param coeffs Output sections [DSP_SOUND_LEVEL_MAX_STAGES]
+ * @param num_stages Pointer to store the number of sections (0 for Z)
+ * @return true if design successful, false otherwise
+ */
+bool dsp_weighting_design(dsp_weighting_t weighting, uint32_t sample_rate_hz,
+                          dsp_biquad_coeffs_t *coeffs, uint8_t *num_stages);
+
+/**
+ * @brief Initialize a sound level meter
+ *
+ * @param meter Pointer to meter
+ * @param weighting Frequency weighting
+ * @param sample_rate_hz Sample rate in Hz
+ * @param input_scale Pascal per input unit (e.g. per PCM count)
+ * @return true if initialization successful, false otherwise
+ */
+bool dsp_sound_level_init(dsp_sound_level_t *meter, dsp_weighting_t weighting,
+                          uint32_t sample_rate_hz, float input_scale);
+
+/**
+ * @brief Start a new Leq, maximum and peak interval
+ *
+ * Filter and time-weighting state carry on, so Fast and Slow levels stay
+ * continuous.
+ *
+ * @param meter Pointer to meter
+ */
+void dsp_sound_level_reset(dsp_sound_level_t *meter);
+
+/**
+ * @brief Add 16-bit PCM samples to a meter
+ *
+ * @param meter Pointer to meter
+ * @param samples PCM samples
+ * @param num_samples Number of samples
+ */
+void dsp_sound_level_process(dsp_sound_level_t *meter, const int16_t *samples, uint32_t num_samples);
+
+/**
+ * @brief Add float samples to a meter
+ *
+ * @param meter Pointer to meter
+ * @param samples Samples in input units
+ * @param num_samples Number of samples
+ */
+void dsp_sound_level_process_float(dsp_sound_level_t *meter, const float *samples, uint32_t num_samples);
+
+/**
+ * @brief Get the current levels of a meter
+ *
+ * Silence reads 0 dB, as elsewhere in the acoustic driver.
+ *
+ * @param meter Pointer to meter
+ * @param levels Pointer to levels to fill
+ * @return true if levels retrieved, false otherwise
+ */
+bool dsp_sound_level_get(const dsp_sound_level_t *meter, dsp_sound_levels_t *levels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_DSP_SOUND_LEVEL_H */
@@ -0,0 +1,373 @@
+/**
+ * @file dsp_stats.c
+ * @brief Streaming Statistics Implementation
+ *
+ * This file contains the one-pass moment accumulators and exponentially
+ * weighted baselines used by the feature store and anomaly scoring, and the
+ * P-square quantile estimates used for latency profiling.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "dsp_stats.h"
+#include <math.h>
+
+/* ============================================================================
+ * Running Moments
+ * ============================================================================ */
+
+/**
+ * @brief Reset a running accumulator
+ */
+void dsp_stats_reset(dsp_running_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+
+    stats->count = 0;
+    stats->mean = 0.0f;
+    stats->m2 = 0.0f;
+    stats->m3 = 0.0f;
+    stats->m4 = 0.0f;
+    stats->min = INFINITY;
+    stats->max = -INFINITY;
+}
+
+/**
+ * @brief Add one sample to a running accumulator
+ */
+void dsp_stats_update(dsp_running_stats_t *stats, float sample) {
+    if (!stats) {
+        return;
+    }
+
+    float n1 = (float)stats->count;
+    float n = n1 + 1.0f;
+    float delta = sample - stats->mean;
+    float delta_n = delta / n;
+    float delta_n2 = delta_n * delta_n;
+    float term1 = delta * delta_n * n1;
+
+    /* Higher moments first: they use the previous lower moments */
+    stats->mean += delta_n;
+    stats->m4 += term1 * delta_n2 * (n * n - 3.0f * n + 3.0f) +
+                 6.0f * delta_n2 * stats->m2 - 4.0f * delta_n * stats->m3;
+    stats->m3 += term1 * delta_n * (n - 2.0f) - 3.0f * delta_n * stats->m2;
+    stats->m2 += term1;
+    stats->count++;
+
+    if (sample < stats->min) {
+        stats->min = sample;
+    }
+    if (sample > stats->max) {
+        stats->max = sample;
+    }
+}
+
+/**
+ * @brief Add a sample block to a running accumulator in one pass
+ */
+void dsp_stats_update_block(dsp_running_stats_t *stats, const float *samples, uint32_t num_samples) {
+    if (!stats || !samples || num_samples == 0) {
+        return;
+    }
+
+    /* Power sums around a pivot near the mean stay well conditioned in float */
+    float pivot = (stats->count > 0) ? stats->mean : samples[0];
+    float s1 = 0.0f;
+    float s2 = 0.0f;
+    float s3 = 0.0f;
+    float s4 = 0.0f;
+    float min = samples[0];
+    float max = samples[0];
+
+    for (uint32_t i = 0; i < num_samples; i++) {
+        float d = samples[i] - pivot;
+        float d2 = d * d;
+        s1 += d;
+        s2 += d2;
+        s3 += d2 * d;
+        s4 += d2 * d2;
+        if (samples[i] < min) {
+            min = samples[i];
+        }
+        if (samples[i] > max) {
+            max = samples[i];
+        }
+    }
+
+    /* Convert pivot sums to central moments of the block */
+    float n = (float)num_samples;
+    float mu = s1 / n;
+    float mu2 = mu * mu;
+
+    dsp_running_stats_t block;
+    block.count = num_samples;
+    block.mean = pivot + mu;
+    block.m2 = fmaxf(s2 - n * mu2, 0.0f);
+    block.m3 = s3 - 3.0f * mu * s2 + 2.0f * n * mu2 * mu;
+    block.m4 = fmaxf(s4 - 4.0f * mu * s3 + 6.0f * mu2 * s2 - 3.0f * n * mu2 * mu2, 0.0f);
+    block.min = min;
+    block.max = max;
+
+    dsp_stats_merge(stats, &block);
+}
+
+/**
+ * @brief Merge one accumulator into another
+ */
+void dsp_stats_merge(dsp_running_stats_t *stats, const dsp_running_stats_t *other) {
+    if (!stats || !other || other->count == 0) {
+        return;
+    }
+
+    if (stats->count == 0) {
+        *stats = *other;
+        return;
+    }
+
+    float na = (float)stats->count;
+    float nb = (float)other->count;
+    float n = na + nb;
+    float delta = other->mean - stats->mean;
+    float delta2 = delta * delta;
+    float delta_n = delta / n;
+    float delta_n2 = delta_n * delta_n;
+
+    float m2 = stats->m2 + other->m2 + delta2 * na * nb / n;
+    float m3 = stats->m3 + other->m3 +
+               delta * delta_n2 * na * nb * (na - nb) +
+               3.0f * delta_n * (na * other->m2 - nb * stats->m2);
+    float m4 = stats->m4 + other->m4 +
+               delta2 * delta_n2 * na * nb * (na * na - na * nb + nb * nb) / n +
+               6.0f * delta_n2 * (na * na * other->m2 + nb * nb * stats->m2) +
+               4.0f * delta_n * (na * other->m3 - nb * stats->m3);
+
+    stats->mean += delta_n * nb;
+    stats->m2 = m2;
+    stats->m3 = m3;
+    stats->m4 = m4;
+    stats->count += other->count;
+
+    if (other->min < stats->min) {
+        stats->min = other->min;
+    }
+    if (other->max > stats->max) {
+        stats->max = other->max;
+    }
+}
+
+/**
+ * @brief Get the population variance
+ */
+float dsp_stats_variance(const dsp_running_stats_t *stats) {
+    if (!stats || stats->count < 2) {
+        return 0.0f;
+    }
+    return stats->m2 / (float)stats->count;
+}
+
+/**
+ * @brief Get the population standard deviation
+ */
+float dsp_stats_std_dev(const dsp_running_stats_t *stats) {
+    return sqrtf(dsp_stats_variance(stats));
+}
+
+/**
+ * @brief Get the skewness
+ */
+float dsp_stats_skewness(const dsp_running_stats_t *stats) {
+    if (!stats || stats->count < 2 || stats->m2 <= 0.0f) {
+        return 0.0f;
+    }
+    return sqrtf((float)stats->count) * stats->m3 / (stats->m2 * sqrtf(stats->m2));
+}
+
+/**
+ * @brief Get the kurtosis
+ */
+float dsp_stats_kurtosis(const dsp_running_stats_t *stats) {
+    if (!stats || stats->count < 2 || stats->m2 <= 0.0f) {
+        return 0.0f;
+    }
+    return (float)stats->count * stats->m4 / (stats->m2 * stats->m2);
+}
+
+/* ============================================================================
+ * Exponentially Weighted Baselines
+ * ============================================================================ */
+
+/**
+ * @brief Initialize an exponentially weighted accumulator
+ */
+bool dsp_ewma_init(dsp_ewma_t *ewma, float alpha) {
+    if (!ewma || !(alpha > 0.0f) || alpha > 1.0f) {
+        return false;
+    }
+
+    ewma->alpha = alpha;
+    ewma->mean = 0.0f;
+    ewma->variance = 0.0f;
+    ewma->primed = false;
+    return true;
+}
+
+/**
+ * @brief Add one value to an exponentially weighted accumulator
+ */
+void dsp_ewma_update(dsp_ewma_t *ewma, float value) {
+    if (!ewma) {
+        return;
+    }
+
+    if (!ewma->primed) {
+        ewma->mean = value;
+        ewma->variance = 0.0f;
+        ewma->primed = true;
+        return;
+    }
+
+    float diff = value - ewma->mean;
+    float increment = ewma->alpha * diff;
+    ewma->mean += increment;
+    ewma->variance = (1.0f - ewma->alpha) * (ewma->variance + diff * increment);
+}
+
+/**
+ * @brief Get the z-score of a value against an exponentially weighted accumulator
+ */
+float dsp_ewma_z_score(const dsp_ewma_t *ewma, float value) {
+    if (!ewma || !ewma->primed || ewma->variance <= 0.0f) {
+        return 0.0f;
+    }
+    return (value - ewma->mean) / sqrtf(ewma->variance);
+}
+
+/* ============================================================================
+ * Streaming Quantiles
+ * ============================================================================ */
+
+/**
+ * @brief Desired position of a marker after count samples
+ *
+ * @param estimate Pointer to estimate
+ * @param marker Marker index (0-4)
+ * @return Desired 1-based marker position
+ */
+static float quantile_desired_position(const dsp_quantile_t *estimate, uint8_t marker) {
+    static const float marker_fraction[5] = { 0.0f, 0.5f, 1.0f, 1.5f, 2.0f };
+    float fraction = (marker <= 2) ? marker_fraction[marker] * estimate->quantile :
+                     estimate->quantile + (marker_fraction[marker] - 1.0f) * (1.0f - estimate->quantile);
+    return 1.0f + (float)(estimate->count - 1U) * fraction;
+}
+
+/**
+ * @brief Initialize a streaming quantile estimate
+ */
+bool dsp_quantile_init(dsp_quantile_t *estimate, float quantile) {
+    if (!estimate || !(quantile > 0.0f) || !(quantile < 1.0f)) {
+        return false;
+    }
+
+    estimate->quantile = quantile;
+    estimate->count = 0;
+    for (uint8_t i = 0; i < 5; i++) {
+        estimate->height[i] = 0.0f;
+        estimate->position[i] = i + 1U;
+    }
+    return true;
+}
+
+/**
+ * @brief Add one value to a streaming quantile estimate
+ */
+void dsp_quantile_update(dsp_quantile_t *estimate, float value) {
+    if (!estimate || isnan(value)) {
+        return;
+    }
+
+    /* Collect the first five values sorted; they become the markers */
+    if (estimate->count < 5) {
+        uint8_t i = (uint8_t)estimate->count;
+        while (i > 0 && estimate->height[i - 1] > value) {
+            estimate->height[i] = estimate->height[i - 1];
+            i--;
+        }
+        estimate->height[i] = value;
+        estimate->count++;
+        return;
+    }
+
+    /* Find the cell holding the value, extending the extremes if needed */
+    uint8_t cell;
+    if (value < estimate->height[0]) {
+        estimate->height[0] = value;
+        cell = 0;
+    } else if (value >= estimate->height[4]) {
+        estimate->height[4] = value;
+        cell = 3;
+    } else {
+        cell = 0;
+        while (value >= estimate->height[cell + 1]) {
+            cell++;
+        }
+    }
+
+    for (uint8_t i = (uint8_t)(cell + 1); i < 5; i++) {
+        estimate->position[i]++;
+    }
+    estimate->count++;
+
+    /* Move the middle markers toward their desired positions */
+    for (uint8_t i = 1; i < 4; i++) {
+        float n = (float)estimate->position[i];
+        float n_below = (float)estimate->position[i - 1];
+        float n_above = (float)estimate->position[i + 1];
+        float offset = quantile_desired_position(estimate, i) - n;
+
+        if (!((offset >= 1.0f && n_above - n > 1.0f) || (offset <= -1.0f && n_below - n < -1.0f))) {
+            continue;
+        }
+
+        float step = (offset > 0.0f) ? 1.0f : -1.0f;
+        float h = estimate->height[i];
+        float h_below = estimate->height[i - 1];
+        float h_above = estimate->height[i + 1];
+
+        /* Piecewise-parabolic prediction; fall back to linear if it leaves the cell */
+        float parabolic = h + step / (n_above - n_below) *
+                          ((n - n_below + step) * (h_above - h) / (n_above - n) +
+                           (n_above - n - step) * (h - h_below) / (n - n_below));
+        if (h_below < parabolic && parabolic < h_above) {
+            estimate->height[i] = parabolic;
+        } else if (step > 0.0f) {
+            estimate->height[i] = h + (h_above - h) / (n_above - n);
+        } else {
+            estimate->height[i] = h - (h_below - h) / (n_below - n);
+        }
+
+        if (step > 0.0f) {
+            estimate->position[i]++;
+        } else {
+            estimate->position[i]--;
+        }
+    }
+}
+
+/**
+ * @brief Get the current quantile estimate
+ */
+float dsp_quantile_value(const dsp_quantile_t *estimate) {
+    if (!estimate || estimate->count == 0) {
+        return 0.0f;
+    }
+
+    if (estimate->count < 5) {
+        uint32_t index = (uint32_t)(estimate->quantile * (float)(estimate->count - 1U) + 0.5f);
+        return estimate->height[index];
+    }
+    return estimate->height[2];
+}
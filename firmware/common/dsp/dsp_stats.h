@@ -0,0 +1,190 @@
+/**
+ * @file dsp_stats.h
+ * @brief Streaming Statistics for EsoCore Signal Processing
+ *
+ * This file defines one-pass, constant-memory statistics that can run on
+ * every sample block:
+ * - Running mean, variance, skewness and kurtosis (Welford/Terriberry
+ *   update per sample, Pebay merge per block)
+ * - Exponentially weighted mean and variance for slowly adapting baselines
+ * - Single quantile estimates (P-square algorithm) for tail latencies
+ *
+ * A running accumulator costs 28 bytes regardless of how many samples it
+ * has seen; accumulators from different blocks or cores can be merged
+ * exactly.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_DSP_STATS_H
+#define ESOCORE_DSP_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Statistics Data Types
+ * ============================================================================ */
+
+/* Running central moments */
+typedef struct {
+    uint32_t count;                         /* Samples accumulated */
+    float mean;                             /* Running mean */
+    float m2;                               /* Sum of squared deviations */
+    float m3;                               /* Sum of cubed deviations */
+    float m4;                               /* Sum of fourth-power deviations */
+    float min;                              /* Smallest sample */
+    float max;                              /* Largest sample */
+} dsp_running_stats_t;
+
+/* Exponentially weighted mean and variance */
+typedef struct {
+    float alpha;                            /* Smoothing factor (0 < alpha <= 1) */
+    float mean;                             /* Weighted mean */
+    float variance;                         /* Weighted variance */
+    bool primed;                            /* First sample seen */
+} dsp_ewma_t;
+
+/* Streaming quantile estimate (Jain/Chlamtac P-square, five markers) */
+typedef struct {
+    float quantile;                         /* Target quantile (0 < quantile < 1) */
+    uint32_t count;                         /* Samples seen */
+    float height[5];                        /* Marker heights; first samples until five are seen */
+    uint32_t position[5];                   /* Marker positions (1-based) */
+} dsp_quantile_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Reset a running accumulator
+ *
+ * @param stats Pointer to accumulator
+ */
+void dsp_stats_reset(dsp_running_stats_t *stats);
+
+/**
+ * @brief Add one sample to a running accumulator
+ *
+ * @param stats Pointer to accumulator
+ * @param sample Sample value
+ */
+void dsp_stats_update(dsp_running_stats_t *stats, float sample);
+
+/**
+ * @brief Add a sample block to a running accumulator in one pass
+ *
+ * The block's moments are accumulated around a pivot without per-sample
+ * division and then merged, which is cheaper than per-sample updates.
+ *
+ * @param stats Pointer to accumulator
+ * @param samples Sample block
+ * @param num_samples Number of samples
+ */
+void dsp_stats_update_block(dsp_running_stats_t *stats, const float *samples, uint32_t num_samples);
+
+/**
+ * @brief Merge one accumulator into another
+ *
+ * @param stats Pointer to destination accumulator
+ * @param other Pointer to accumulator to merge
+ */
+void dsp_stats_merge(dsp_running_stats_t *stats, const dsp_running_stats_t *other);
+
+/**
+ * @brief Get the population variance
+ *
+ * @param stats Pointer to accumulator
+ * @return Variance (0 if fewer than 2 samples)
+ */
+float dsp_stats_variance(const dsp_running_stats_t *stats);
+
+/**
+ * @brief Get the population standard deviation
+ *
+ * @param stats Pointer to accumulator
+ * @return Standard deviation (0 if fewer than 2 samples)
+ */
+float dsp_stats_std_dev(const dsp_running_stats_t *stats);
+
+/**
+ * @brief Get the skewness (third standardized moment)
+ *
+ * @param stats Pointer to accumulator
+ * @return Skewness (0 if variance is zero)
+ */
+float dsp_stats_skewness(const dsp_running_stats_t *stats);
+
+/**
+ * @brief Get the kurtosis (fourth standardized moment, 3 = Gaussian)
+ *
+ * @param stats Pointer to accumulator
+ * @return Kurtosis (0 if variance is zero)
+ */
+float dsp_stats_kurtosis(const dsp_running_stats_t *stats);
+
+/**
+ * @brief Initialize an exponentially weighted accumulator
+ *
+ * @param ewma Pointer to accumulator
+ * @param alpha Smoothing factor (0 < alpha <= 1; larger adapts faster)
+ * @return true if initialization successful, false otherwise
+ */
+bool dsp_ewma_init(dsp_ewma_t *ewma, float alpha);
+
+/**
+ * @brief Add one value to an exponentially weighted accumulator
+ *
+ * @param ewma Pointer to accumulator
+ * @param value Value
+ */
+void dsp_ewma_update(dsp_ewma_t *ewma, float value);
+
+/**
+ * @brief Get the z-score of a value against an exponentially weighted accumulator
+ *
+ * @param ewma Pointer to accumulator
+ * @param value Value
+ * @return Z-score (0 if not primed or variance is zero)
+ */
+float dsp_ewma_z_score(const dsp_ewma_t *ewma, float value);
+
+/**
+ * @brief Initialize a streaming quantile estimate
+ *
+ * @param estimate Pointer to estimate
+ * @param quantile Target quantile (e.g. 0.99 for p99)
+ * @return true if initialization successful, false otherwise
+ */
+bool dsp_quantile_init(dsp_quantile_t *estimate, float quantile);
+
+/**
+ * @brief Add one value to a streaming quantile estimate
+ *
+ * @param estimate Pointer to estimate
+ * @param value Value
+ */
+void dsp_quantile_update(dsp_quantile_t *estimate, float value);
+
+/**
+ * @brief Get the current quantile estimate
+ *
+ * Exact for fewer than five values.
+ *
+ * @param estimate Pointer to estimate
+ * @return Quantile estimate (0 if no values seen)
+ */
+float dsp_quantile_value(const dsp_quantile_t *estimate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_DSP_STATS_H */
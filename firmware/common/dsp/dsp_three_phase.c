@@ -0,0 +1,278 @@
+/**
+ * @file dsp_three_phase.c
+ * @brief Three-Phase Power Analysis Implementation
+ *
+ * This file contains the scan deinterleaver, the blocked single-pass
+ * accumulation and the derivation of the symmetrical components and
+ * powers.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "dsp_three_phase.h"
+#include "dsp_fft.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+#define BLOCK_SIZE                    32    /* Samples per accumulation block */
+#define SQRT3_2                       0.86602540f
+
+/* Sums for one channel over the capture */
+typedef struct {
+    double square;                          /* Sum of x^2 */
+    double phasor_re;                       /* Sum of x cos(w n) */
+    double phasor_im;                       /* Sum of -x sin(w n) */
+} channel_sums_t;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Accumulate one block of one channel against the reference
+ */
+static void accumulate_channel(const float *x, const float *ref_cos, const float *ref_sin, uint32_t count,
+                               channel_sums_t *sums) {
+    float square = 0.0f, re = 0.0f, im = 0.0f;
+    for (uint32_t n = 0; n < count; n++) {
+        float v = x[n];
+        square += v * v;
+        re += v * ref_cos[n];
+        im += v * ref_sin[n];
+    }
+    sums->square += (double)square;
+    sums->phasor_re += (double)re;
+    sums->phasor_im += (double)im;
+}
+
+/**
+ * @brief Sum of the products of two blocks
+ */
+static float dot_product(const float *a, const float *b, uint32_t count) {
+    float sum = 0.0f;
+    for (uint32_t n = 0; n < count; n++) {
+        sum += a[n] * b[n];
+    }
+    return sum;
+}
+
+/**
+ * @brief Wrap an angle to (-180, 180] degrees
+ */
+static float wrap_degrees(float degrees) {
+    degrees = fmodf(degrees, 360.0f);
+    if (degrees > 180.0f) {
+        degrees -= 360.0f;
+    } else if (degrees <= -180.0f) {
+        degrees += 360.0f;
+    }
+    return degrees;
+}
+
+/**
+ * @brief Derive the per-quantity results from the channel sums
+ *
+ * @param sums Channel sums [3]
+ * @param residual_square Sum of the squared phase sum
+ * @param samples Samples analysed
+ * @param phasors Fundamental RMS phasors to fill [3][2]
+ * @param set Results to fill (angles are filled by the caller)
+ */
+static void derive_set(const channel_sums_t *sums, double residual_square, uint32_t samples,
+                       float phasors[DSP_THREE_PHASE_PHASES][2], dsp_three_phase_set_t *set) {
+    /* A bin sum of magnitude |X| is a fundamental RMS of sqrt(2) |X| / N */
+    float phasor_scale = sqrtf(2.0f) / (float)samples;
+    float mean_rms = 0.0f, mean_square = 0.0f;
+
+    for (uint8_t p = 0; p < DSP_THREE_PHASE_PHASES; p++) {
+        float ms = (float)(sums[p].square / (double)samples);
+        set->rms[p] = sqrtf(ms);
+        phasors[p][0] = (float)sums[p].phasor_re * phasor_scale;
+        phasors[p][1] = (float)sums[p].phasor_im * phasor_scale;
+        set->fundamental[p] = sqrtf(phasors[p][0] * phasors[p][0] + phasors[p][1] * phasors[p][1]);
+        mean_rms += set->rms[p];
+        mean_square += ms;
+    }
+    mean_rms /= (float)DSP_THREE_PHASE_PHASES;
+    set->effective = sqrtf(mean_square / (float)DSP_THREE_PHASE_PHASES);
+    set->residual = sqrtf((float)(residual_square / (double)samples));
+
+    float deviation = 0.0f;
+    for (uint8_t p = 0; p < DSP_THREE_PHASE_PHASES; p++) {
+        deviation = fmaxf(deviation, fabsf(set->rms[p] - mean_rms));
+    }
+    set->imbalance_percent = (mean_rms > 0.0f) ? deviation / mean_rms * 100.0f : 0.0f;
+
+    /* Fortescue with a = 1 at 120 degrees: X1 = (A + aB + a^2 C) / 3, X2 = (A + a^2 B + aC) / 3 */
+    const float *a = phasors[0], *b = phasors[1], *c = phasors[2];
+    float zero_re = (a[0] + b[0] + c[0]) / 3.0f;
+    float zero_im = (a[1] + b[1] + c[1]) / 3.0f;
+    float pos_re = (a[0] - 0.5f * (b[0] + c[0]) - SQRT3_2 * (b[1] - c[1])) / 3.0f;
+    float pos_im = (a[1] - 0.5f * (b[1] + c[1]) + SQRT3_2 * (b[0] - c[0])) / 3.0f;
+    float neg_re = (a[0] - 0.5f * (b[0] + c[0]) + SQRT3_2 * (b[1] - c[1])) / 3.0f;
+    float neg_im = (a[1] - 0.5f * (b[1] + c[1]) - SQRT3_2 * (b[0] - c[0])) / 3.0f;
+    set->zero = sqrtf(zero_re * zero_re + zero_im * zero_im);
+    set->positive = sqrtf(pos_re * pos_re + pos_im * pos_im);
+    set->negative = sqrtf(neg_re * neg_re + neg_im * neg_im);
+    set->unbalance_percent = (set->positive > 0.0f) ? set->negative / set->positive * 100.0f : 0.0f;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Split an interleaved scan buffer into one array per channel
+ */
+bool dsp_three_phase_deinterleave(const int16_t *scan, uint8_t num_channels, uint32_t num_frames,
+                                  const float *offset, const float *scale, float *const *channels) {
+    if (!scan || !offset || !scale || !channels || num_channels == 0 ||
+        num_channels > DSP_THREE_PHASE_MAX_CHANNELS) {
+        return false;
+    }
+
+    /* One channel at a time: strided reads, contiguous writes */
+    for (uint8_t k = 0; k < num_channels; k++) {
+        float *out = channels[k];
+        if (!out) {
+            return false;
+        }
+        const int16_t *in = &scan[k];
+        const float channel_offset = offset[k];
+        const float channel_scale = scale[k];
+        for (uint32_t n = 0; n < num_frames; n++) {
+            out[n] = ((float)in[n * num_channels] - channel_offset) * channel_scale;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Analyse one synchronous three-phase capture in a single pass
+ */
+bool dsp_three_phase_analyze(const float *const *current, const float *const *voltage, uint32_t num_samples,
+                             uint32_t sample_rate_hz, float line_hz, dsp_three_phase_results_t *results) {
+    if (!current || !results || sample_rate_hz == 0 || !(line_hz > 0.0f)) {
+        return false;
+    }
+    for (uint8_t p = 0; p < DSP_THREE_PHASE_PHASES; p++) {
+        if (!current[p] || (voltage && !voltage[p])) {
+            return false;
+        }
+    }
+
+    memset(results, 0, sizeof(dsp_three_phase_results_t));
+
+    /* Whole line cycles only, so the harmonics are orthogonal to the reference */
+    float samples_per_cycle = (float)sample_rate_hz / line_hz;
+    uint32_t cycles = (uint32_t)((float)num_samples / samples_per_cycle);
+    uint32_t samples = (uint32_t)lroundf((float)cycles * samples_per_cycle);
+    if (cycles == 0 || samples == 0) {
+        return false;
+    }
+    if (samples > num_samples) {
+        samples = num_samples;
+    }
+
+    channel_sums_t current_sums[DSP_THREE_PHASE_PHASES];
+    channel_sums_t voltage_sums[DSP_THREE_PHASE_PHASES];
+    double active[DSP_THREE_PHASE_PHASES] = {0.0, 0.0, 0.0};
+    double current_residual = 0.0, voltage_residual = 0.0;
+    memset(current_sums, 0, sizeof(current_sums));
+    memset(voltage_sums, 0, sizeof(voltage_sums));
+
+    float ref_cos[BLOCK_SIZE], ref_sin[BLOCK_SIZE], phase_sum[BLOCK_SIZE];
+    float w = 2.0f * (float)M_PI * line_hz / (float)sample_rate_hz;
+    const float step_re = cosf(w), step_im = -sinf(w);
+    float osc_re = 1.0f, osc_im = 0.0f;
+
+    for (uint32_t offset = 0; offset < samples; offset += BLOCK_SIZE) {
+        uint32_t count = samples - offset;
+        if (count > BLOCK_SIZE) {
+            count = BLOCK_SIZE;
+        }
+
+        /* Reference exp(-j w n) for the block by phasor rotation */
+        for (uint32_t n = 0; n < count; n++) {
+            ref_cos[n] = osc_re;
+            ref_sin[n] = osc_im;
+            float re = osc_re * step_re - osc_im * step_im;
+            osc_im = osc_re * step_im + osc_im * step_re;
+            osc_re = re;
+        }
+        float norm = 1.5f - 0.5f * (osc_re * osc_re + osc_im * osc_im);
+        osc_re *= norm;
+        osc_im *= norm;
+
+        for (uint8_t p = 0; p < DSP_THREE_PHASE_PHASES; p++) {
+            accumulate_channel(&current[p][offset], ref_cos, ref_sin, count, &current_sums[p]);
+        }
+        for (uint32_t n = 0; n < count; n++) {
+            phase_sum[n] = current[0][offset + n] + current[1][offset + n] + current[2][offset + n];
+        }
+        current_residual += (double)dot_product(phase_sum, phase_sum, count);
+
+        if (voltage) {
+            for (uint8_t p = 0; p < DSP_THREE_PHASE_PHASES; p++) {
+                accumulate_channel(&voltage[p][offset], ref_cos, ref_sin, count, &voltage_sums[p]);
+                active[p] += (double)dot_product(&voltage[p][offset], &current[p][offset], count);
+            }
+            for (uint32_t n = 0; n < count; n++) {
+                phase_sum[n] = voltage[0][offset + n] + voltage[1][offset + n] + voltage[2][offset + n];
+            }
+            voltage_residual += (double)dot_product(phase_sum, phase_sum, count);
+        }
+    }
+
+    results->samples = samples;
+    float current_phasors[DSP_THREE_PHASE_PHASES][2];
+    float voltage_phasors[DSP_THREE_PHASE_PHASES][2];
+    derive_set(current_sums, current_residual, samples, current_phasors, &results->current);
+    results->abc_rotation = (results->current.positive >= results->current.negative);
+
+    const float *reference = current_phasors[0];
+    if (voltage) {
+        results->has_voltage = true;
+        derive_set(voltage_sums, voltage_residual, samples, voltage_phasors, &results->voltage);
+        results->abc_rotation = (results->voltage.positive >= results->voltage.negative);
+        reference = voltage_phasors[0];
+    }
+
+    float reference_deg = atan2f(reference[1], reference[0]) * (180.0f / (float)M_PI);
+    for (uint8_t p = 0; p < DSP_THREE_PHASE_PHASES; p++) {
+        results->current.angle_deg[p] = wrap_degrees(atan2f(current_phasors[p][1], current_phasors[p][0]) *
+                                                     (180.0f / (float)M_PI) - reference_deg);
+    }
+
+    if (!voltage) {
+        return true;
+    }
+
+    for (uint8_t p = 0; p < DSP_THREE_PHASE_PHASES; p++) {
+        const float *v = voltage_phasors[p], *i = current_phasors[p];
+        results->voltage.angle_deg[p] = wrap_degrees(atan2f(v[1], v[0]) * (180.0f / (float)M_PI) -
+                                                     reference_deg);
+
+        /* V conj(I): the imaginary part is positive when the current lags */
+        results->active_power[p] = (float)(active[p] / (double)samples);
+        results->reactive_power[p] = v[1] * i[0] - v[0] * i[1];
+        results->apparent_power[p] = results->voltage.rms[p] * results->current.rms[p];
+        results->power_factor[p] = (results->apparent_power[p] > 0.0f) ?
+                                   results->active_power[p] / results->apparent_power[p] : 0.0f;
+
+        results->total_active_power += results->active_power[p];
+        results->total_reactive_power += results->reactive_power[p];
+        results->total_apparent_power += results->apparent_power[p];
+    }
+    results->total_power_factor = (results->total_apparent_power > 0.0f) ?
+                                  results->total_active_power / results->total_apparent_power : 0.0f;
+
+    return true;
+}
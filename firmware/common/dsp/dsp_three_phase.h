@@ -0,0 +1,122 @@
+/**
+ * @file dsp_three_phase.h
+ * @brief Three-Phase Power Analysis
+ *
+ * This file defines the analysis of one synchronous capture of the three
+ * phase currents and, when they are sampled too, the three phase-to-neutral
+ * voltages:
+ * - Deinterleaving of an ADC scan buffer (frame = one conversion of every
+ *   channel) into one contiguous float array per channel, with per-channel
+ *   offset and scale
+ * - A single pass over the whole capture that accumulates, per channel,
+ *   the mean square and the fundamental phasor (correlation with a rotating
+ *   reference at the line frequency) and, per phase, the mean of v * i
+ * - Per-phase and effective RMS, the RMS of the phase sum (neutral or
+ *   residual current), imbalance as maximum deviation from the mean (NEMA)
+ *   and symmetrical components with the negative/positive sequence ratio
+ * - Active power from v * i, fundamental reactive power from the phasors,
+ *   apparent power from the RMS values, per phase and in total
+ *
+ * The capture is trimmed to a whole number of line cycles. Inner loops run
+ * over contiguous arrays with independent accumulators and no branches, so
+ * they map onto dual-issue and SIMD load/multiply-accumulate sequences.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_DSP_THREE_PHASE_H
+#define ESOCORE_DSP_THREE_PHASE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Three-Phase Configuration
+ * ============================================================================ */
+
+#define DSP_THREE_PHASE_PHASES        3
+#define DSP_THREE_PHASE_MAX_CHANNELS  8     /* Channels per scan frame */
+
+/* ============================================================================
+ * Three-Phase Data Types
+ * ============================================================================ */
+
+/* Results for one quantity (current or voltage) over the three phases */
+typedef struct {
+    float rms[DSP_THREE_PHASE_PHASES];              /* True RMS per phase */
+    float fundamental[DSP_THREE_PHASE_PHASES];      /* Fundamental RMS per phase */
+    float angle_deg[DSP_THREE_PHASE_PHASES];        /* Fundamental angle relative to the reference */
+    float effective;                                /* sqrt of the mean of the phase mean squares */
+    float residual;                                 /* RMS of the phase sum */
+    float imbalance_percent;                        /* Largest deviation from the mean RMS / mean RMS */
+    float positive;                                 /* Fundamental positive sequence (RMS) */
+    float negative;                                 /* Fundamental negative sequence (RMS) */
+    float zero;                                     /* Fundamental zero sequence (RMS) */
+    float unbalance_percent;                        /* Negative / positive sequence */
+} dsp_three_phase_set_t;
+
+/* Analysis results */
+typedef struct {
+    uint32_t samples;                               /* Samples analysed (whole cycles) */
+    bool has_voltage;                               /* Voltage set and powers are valid */
+    bool abc_rotation;                              /* Positive sequence dominates (phase order A-B-C) */
+    dsp_three_phase_set_t current;
+    dsp_three_phase_set_t voltage;
+    float active_power[DSP_THREE_PHASE_PHASES];     /* Mean of v * i */
+    float reactive_power[DSP_THREE_PHASE_PHASES];   /* Fundamental, positive when inductive */
+    float apparent_power[DSP_THREE_PHASE_PHASES];   /* V RMS * I RMS */
+    float power_factor[DSP_THREE_PHASE_PHASES];
+    float total_active_power;
+    float total_reactive_power;
+    float total_apparent_power;                     /* Arithmetic sum */
+    float total_power_factor;
+} dsp_three_phase_results_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Split an interleaved scan buffer into one array per channel
+ *
+ * channels[k][n] = (scan[n * num_channels + k] - offset[k]) * scale[k]
+ *
+ * @param scan Interleaved scan frames (num_frames * num_channels values)
+ * @param num_channels Channels per frame (<= DSP_THREE_PHASE_MAX_CHANNELS)
+ * @param num_frames Number of frames
+ * @param offset Per-channel offset in ADC counts [num_channels]
+ * @param scale Per-channel physical unit per count [num_channels]
+ * @param channels Per-channel outputs of num_frames floats [num_channels]
+ * @return true if the buffer was split, false otherwise
+ */
+bool dsp_three_phase_deinterleave(const int16_t *scan, uint8_t num_channels, uint32_t num_frames,
+                                  const float *offset, const float *scale, float *const *channels);
+
+/**
+ * @brief Analyse one synchronous three-phase capture in a single pass
+ *
+ * Angles are relative to the phase A voltage, or to the phase A current
+ * when no voltages are given.
+ *
+ * @param current Phase currents [3]
+ * @param voltage Phase-to-neutral voltages [3] (NULL if not sampled)
+ * @param num_samples Samples per channel
+ * @param sample_rate_hz Sample rate in Hz
+ * @param line_hz Line frequency in Hz
+ * @param results Pointer to results to fill
+ * @return true if at least one whole line cycle was analysed, false otherwise
+ */
+bool dsp_three_phase_analyze(const float *const *current, const float *const *voltage, uint32_t num_samples,
+                             uint32_t sample_rate_hz, float line_hz, dsp_three_phase_results_t *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_DSP_THREE_PHASE_H */
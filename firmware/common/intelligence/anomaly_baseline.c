@@ -0,0 +1,451 @@
+/**
+ * @file anomaly_baseline.c
+ * @brief Learned Per-Machine Baselines Implementation
+ *
+ * This file contains the commissioning learner, Mahalanobis scoring and
+ * configuration-backed persistence of anomaly baselines.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "anomaly_baseline.h"
+#include "config_manager.h"
+#include "dsp_stats.h"
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+#define FEATURES                      ANOMALY_FEATURE_COUNT
+#define TRIANGLE_SIZE                 (FEATURES * (FEATURES + 1) / 2)
+#define TRI(i, j)                     ((i) * ((i) + 1) / 2 + (j))   /* Packed lower triangle, j <= i */
+
+#define BASELINE_MAGIC                0x314C4241  /* "ABL1" */
+#define BASELINE_RIDGE                1e-3f       /* Relative diagonal loading of the covariance */
+#define BASELINE_VARIANCE_FLOOR       1e-9f       /* Absolute diagonal loading */
+
+#if (FEATURES % 2) != 0
+#error "Chi-square CDF below assumes an even number of features"
+#endif
+
+/* Persisted baseline; must fit one configuration value */
+typedef struct {
+    uint32_t magic;
+    uint32_t count;
+    float mean[FEATURES];
+    float covariance[TRIANGLE_SIZE];
+} baseline_record_t;
+
+_Static_assert(sizeof(baseline_record_t) <= ESOCORE_MAX_PARAMETER_VALUE_SIZE,
+               "Baseline record does not fit one configuration value");
+
+typedef struct {
+    /* Baseline used for scoring */
+    bool ready;
+    uint32_t count;
+    float mean[FEATURES];
+    float covariance[TRIANGLE_SIZE];
+    float cholesky[TRIANGLE_SIZE];          /* Lower factor of the regularized covariance */
+    float std_dev[FEATURES];                /* Regularized per-feature standard deviations */
+    bool persisted;
+
+    /* Commissioning learner */
+    bool commissioning;
+    uint32_t learn_target;
+    uint32_t learn_count;
+    float learn_mean[FEATURES];
+    float learn_comoment[TRIANGLE_SIZE];
+
+    /* Adaptive per-feature baselines */
+    dsp_ewma_t ewma[FEATURES];
+    uint32_t blocks_seen;                   /* Adaptive baselines settle after MIN_BLOCKS */
+} baseline_channel_t;
+
+static baseline_channel_t channels[ANOMALY_BASELINE_MAX_CHANNELS];
+static bool baseline_initialized = false;
+
+static const char *const feature_names[FEATURES] = {
+    "RMS", "peak", "crest factor", "kurtosis"
+};
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Factor the regularized covariance into its Cholesky factor
+ */
+static bool baseline_factor(baseline_channel_t *ch) {
+    float a[TRIANGLE_SIZE];
+
+    memcpy(a, ch->covariance, sizeof(a));
+    for (uint8_t i = 0; i < FEATURES; i++) {
+        a[TRI(i, i)] += BASELINE_RIDGE * a[TRI(i, i)] + BASELINE_VARIANCE_FLOOR;
+        ch->std_dev[i] = sqrtf(a[TRI(i, i)]);
+    }
+
+    for (uint8_t i = 0; i < FEATURES; i++) {
+        for (uint8_t j = 0; j <= i; j++) {
+            float sum = a[TRI(i, j)];
+            for (uint8_t k = 0; k < j; k++) {
+                sum -= ch->cholesky[TRI(i, k)] * ch->cholesky[TRI(j, k)];
+            }
+            if (i == j) {
+                if (!(sum > 0.0f)) {
+                    return false;
+                }
+                ch->cholesky[TRI(i, i)] = sqrtf(sum);
+            } else {
+                ch->cholesky[TRI(i, j)] = sum / ch->cholesky[TRI(j, j)];
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Squared Mahalanobis distance through forward substitution
+ */
+static float baseline_distance_sq(const baseline_channel_t *ch, const float *features) {
+    float y[FEATURES];
+    float distance_sq = 0.0f;
+
+    for (uint8_t i = 0; i < FEATURES; i++) {
+        float sum = features[i] - ch->mean[i];
+        for (uint8_t k = 0; k < i; k++) {
+            sum -= ch->cholesky[TRI(i, k)] * y[k];
+        }
+        y[i] = sum / ch->cholesky[TRI(i, i)];
+        distance_sq += y[i] * y[i];
+    }
+    return distance_sq;
+}
+
+/**
+ * @brief Chi-square CDF for an even number of degrees of freedom
+ */
+static float chi_square_cdf(float x) {
+    float half = 0.5f * x;
+    float term = 1.0f;
+    float sum = 1.0f;
+
+    for (uint8_t k = 1; k < FEATURES / 2; k++) {
+        term *= half / (float)k;
+        sum += term;
+    }
+    return 1.0f - expf(-half) * sum;
+}
+
+/**
+ * @brief Configuration parameter ID of a channel
+ */
+static uint16_t baseline_param_id(uint8_t channel) {
+    return (uint16_t)(ANOMALY_BASELINE_CONFIG_PARAM_BASE + channel);
+}
+
+/**
+ * @brief Store a channel's baseline through the configuration manager
+ */
+static bool baseline_persist(uint8_t channel) {
+    const baseline_channel_t *ch = &channels[channel];
+    esocore_config_value_t value;
+    baseline_record_t record;
+
+    memset(&value, 0, sizeof(value));
+    value.parameter_id = baseline_param_id(channel);
+    value.data_type = ESOCORE_CONFIG_TYPE_BINARY;
+
+    if (ch->ready) {
+        record.magic = BASELINE_MAGIC;
+        record.count = ch->count;
+        memcpy(record.mean, ch->mean, sizeof(record.mean));
+        memcpy(record.covariance, ch->covariance, sizeof(record.covariance));
+        memcpy(value.value, &record, sizeof(record));
+        value.value_size = sizeof(record);
+    }
+
+    if (!esocore_config_set_value(value.parameter_id, &value, 0)) {
+        return false;
+    }
+    return esocore_config_save();
+}
+
+/**
+ * @brief Restore a channel's baseline from the configuration manager
+ */
+static bool baseline_restore(uint8_t channel) {
+    baseline_channel_t *ch = &channels[channel];
+    esocore_config_value_t value;
+    baseline_record_t record;
+
+    if (!esocore_config_get_value(baseline_param_id(channel), &value) ||
+        value.value_size != sizeof(record)) {
+        return false;
+    }
+
+    memcpy(&record, value.value, sizeof(record));
+    if (record.magic != BASELINE_MAGIC || record.count < ANOMALY_BASELINE_MIN_BLOCKS) {
+        return false;
+    }
+
+    ch->count = record.count;
+    memcpy(ch->mean, record.mean, sizeof(ch->mean));
+    memcpy(ch->covariance, record.covariance, sizeof(ch->covariance));
+    ch->ready = baseline_factor(ch);
+    ch->persisted = ch->ready;
+    return ch->ready;
+}
+
+/**
+ * @brief Turn the commissioning accumulators into the scoring baseline
+ */
+static bool baseline_commit(uint8_t channel) {
+    baseline_channel_t *ch = &channels[channel];
+
+    ch->commissioning = false;
+    if (ch->learn_count < ANOMALY_BASELINE_MIN_BLOCKS) {
+        return false;
+    }
+
+    baseline_channel_t candidate = *ch;
+    float scale = 1.0f / (float)(ch->learn_count - 1);
+    candidate.count = ch->learn_count;
+    memcpy(candidate.mean, ch->learn_mean, sizeof(candidate.mean));
+    for (uint8_t i = 0; i < TRIANGLE_SIZE; i++) {
+        candidate.covariance[i] = ch->learn_comoment[i] * scale;
+    }
+
+    if (!baseline_factor(&candidate)) {
+        return false;
+    }
+
+    candidate.ready = true;
+    *ch = candidate;
+    ch->persisted = baseline_persist(channel);
+    return ch->persisted;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Initialize the baseline learner
+ */
+bool anomaly_baseline_init(void) {
+    memset(channels, 0, sizeof(channels));
+
+    for (uint8_t c = 0; c < ANOMALY_BASELINE_MAX_CHANNELS; c++) {
+        for (uint8_t f = 0; f < FEATURES; f++) {
+            dsp_ewma_init(&channels[c].ewma[f], ANOMALY_BASELINE_EWMA_ALPHA);
+        }
+
+        /* Already registered after a re-init; restoring still applies */
+        esocore_config_parameter_t parameter;
+        memset(&parameter, 0, sizeof(parameter));
+        parameter.parameter_id = baseline_param_id(c);
+        snprintf(parameter.name, sizeof(parameter.name), "anomaly_baseline_%u", (unsigned)c);
+        parameter.data_type = ESOCORE_CONFIG_TYPE_BINARY;
+        parameter.access_level = ESOCORE_ACCESS_SYSTEM_ONLY;
+        parameter.category = ESOCORE_CATEGORY_DIAGNOSTIC;
+        parameter.max_value_size = sizeof(baseline_record_t);
+        parameter.is_persistent = true;
+        strcpy(parameter.description, "Learned vibration feature mean and covariance");
+        esocore_config_register_parameter(&parameter);
+
+        baseline_restore(c);
+    }
+
+    baseline_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Extract the baseline feature vector from capture statistics
+ */
+bool anomaly_baseline_extract_features(const dsp_feature_stats_t *stats, float *features) {
+    if (!stats || !features) {
+        return false;
+    }
+
+    features[ANOMALY_FEATURE_RMS] = stats->std_dev;
+    features[ANOMALY_FEATURE_PEAK] = stats->peak;
+    features[ANOMALY_FEATURE_CREST_FACTOR] = stats->crest_factor;
+    features[ANOMALY_FEATURE_KURTOSIS] = stats->kurtosis;
+    return true;
+}
+
+/**
+ * @brief Start learning a new baseline
+ */
+bool anomaly_baseline_start_commissioning(uint8_t channel, uint32_t num_blocks) {
+    if (!baseline_initialized || channel >= ANOMALY_BASELINE_MAX_CHANNELS) {
+        return false;
+    }
+
+    if (num_blocks == 0) {
+        num_blocks = ANOMALY_BASELINE_DEFAULT_BLOCKS;
+    }
+    if (num_blocks < ANOMALY_BASELINE_MIN_BLOCKS) {
+        return false;
+    }
+
+    baseline_channel_t *ch = &channels[channel];
+    ch->commissioning = true;
+    ch->learn_target = num_blocks;
+    ch->learn_count = 0;
+    memset(ch->learn_mean, 0, sizeof(ch->learn_mean));
+    memset(ch->learn_comoment, 0, sizeof(ch->learn_comoment));
+    return true;
+}
+
+/**
+ * @brief Finish commissioning early
+ */
+bool anomaly_baseline_finish_commissioning(uint8_t channel) {
+    if (!baseline_initialized || channel >= ANOMALY_BASELINE_MAX_CHANNELS ||
+        !channels[channel].commissioning) {
+        return false;
+    }
+
+    return baseline_commit(channel);
+}
+
+/**
+ * @brief Score a feature vector and feed it to the learner
+ */
+bool anomaly_baseline_update(uint8_t channel, const float *features, anomaly_baseline_score_t *score) {
+    if (!baseline_initialized || channel >= ANOMALY_BASELINE_MAX_CHANNELS || !features) {
+        return false;
+    }
+
+    baseline_channel_t *ch = &channels[channel];
+
+    /* Score against the current baseline before learning from the vector */
+    bool settled = ch->blocks_seen >= ANOMALY_BASELINE_MIN_BLOCKS;
+    if (score) {
+        float max_z = 0.0f;
+        uint8_t dominant = 0;
+
+        for (uint8_t f = 0; f < FEATURES; f++) {
+            float z = 0.0f;
+            if (ch->ready) {
+                z = (features[f] - ch->mean[f]) / ch->std_dev[f];
+            } else if (settled) {
+                z = dsp_ewma_z_score(&ch->ewma[f], features[f]);
+            }
+            if (fabsf(z) > max_z) {
+                max_z = fabsf(z);
+                dominant = f;
+            }
+        }
+
+        score->max_z_score = max_z;
+        score->dominant_feature = dominant;
+        if (ch->ready) {
+            score->state = ANOMALY_BASELINE_READY;
+            score->distance_sq = baseline_distance_sq(ch, features);
+            score->probability = chi_square_cdf(score->distance_sq);
+        } else {
+            score->state = ch->commissioning ? ANOMALY_BASELINE_COMMISSIONING :
+                                               ANOMALY_BASELINE_UNTRAINED;
+            score->distance_sq = 0.0f;
+            score->probability = erff(max_z * 0.70710678f);
+        }
+    }
+
+    for (uint8_t f = 0; f < FEATURES; f++) {
+        dsp_ewma_update(&ch->ewma[f], features[f]);
+    }
+    if (!settled) {
+        ch->blocks_seen++;
+    }
+
+    if (ch->commissioning) {
+        /* Multivariate Welford update of mean and co-moments */
+        float delta[FEATURES];
+        ch->learn_count++;
+        for (uint8_t i = 0; i < FEATURES; i++) {
+            delta[i] = features[i] - ch->learn_mean[i];
+            ch->learn_mean[i] += delta[i] / (float)ch->learn_count;
+        }
+        for (uint8_t i = 0; i < FEATURES; i++) {
+            for (uint8_t j = 0; j <= i; j++) {
+                ch->learn_comoment[TRI(i, j)] += delta[i] * (features[j] - ch->learn_mean[j]);
+            }
+        }
+
+        if (ch->learn_count >= ch->learn_target) {
+            baseline_commit(channel);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Discard a channel's baseline
+ */
+bool anomaly_baseline_reset(uint8_t channel) {
+    if (!baseline_initialized || channel >= ANOMALY_BASELINE_MAX_CHANNELS) {
+        return false;
+    }
+
+    baseline_channel_t *ch = &channels[channel];
+    bool was_persisted = ch->persisted;
+
+    memset(ch, 0, sizeof(*ch));
+    for (uint8_t f = 0; f < FEATURES; f++) {
+        dsp_ewma_init(&ch->ewma[f], ANOMALY_BASELINE_EWMA_ALPHA);
+    }
+
+    /* An empty record invalidates the stored copy */
+    return was_persisted ? baseline_persist(channel) : true;
+}
+
+/**
+ * @brief Get channel status
+ */
+bool anomaly_baseline_get_status(uint8_t channel, anomaly_baseline_status_t *status) {
+    if (!baseline_initialized || channel >= ANOMALY_BASELINE_MAX_CHANNELS || !status) {
+        return false;
+    }
+
+    const baseline_channel_t *ch = &channels[channel];
+
+    memset(status, 0, sizeof(anomaly_baseline_status_t));
+    if (ch->commissioning) {
+        status->state = ANOMALY_BASELINE_COMMISSIONING;
+        status->blocks_learned = ch->learn_count;
+        status->commissioning_blocks = ch->learn_target;
+    } else if (ch->ready) {
+        status->state = ANOMALY_BASELINE_READY;
+        status->blocks_learned = ch->count;
+    } else {
+        status->state = ANOMALY_BASELINE_UNTRAINED;
+    }
+
+    if (ch->ready) {
+        for (uint8_t f = 0; f < FEATURES; f++) {
+            status->mean[f] = ch->mean[f];
+            status->std_dev[f] = sqrtf(ch->covariance[TRI(f, f)]);
+            if (ch->ewma[f].primed) {
+                status->drift_z[f] = (ch->ewma[f].mean - ch->mean[f]) / ch->std_dev[f];
+            }
+        }
+    }
+    status->persisted = ch->persisted;
+    return true;
+}
+
+/**
+ * @brief Get the display name of a feature
+ */
+const char *anomaly_baseline_feature_name(uint8_t feature) {
+    return (feature < FEATURES) ? feature_names[feature] : "unknown";
+}
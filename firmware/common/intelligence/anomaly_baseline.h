@@ -0,0 +1,169 @@
+/**
+ * @file anomaly_baseline.h
+ * @brief Learned Per-Machine Baselines for Anomaly Scoring
+ *
+ * This header defines the baseline learner that turns per-block vibration
+ * features into calibrated anomaly scores. During a commissioning window
+ * the mean and covariance of the feature vector are learned in one pass
+ * (multivariate Welford update); afterwards every block is scored by its
+ * Mahalanobis distance to that baseline. Learned baselines are persisted
+ * through the configuration manager so a reboot does not restart
+ * commissioning.
+ *
+ * Each feature also carries an exponentially weighted baseline. Before
+ * commissioning completes, blocks are scored by their largest z-score
+ * against these adaptive baselines instead.
+ *
+ * Memory per channel is constant: no samples or feature history are kept.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_ANOMALY_BASELINE_H
+#define ESOCORE_ANOMALY_BASELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_features.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Baseline Configuration
+ * ============================================================================ */
+
+#define ANOMALY_BASELINE_MAX_CHANNELS       4       /* Independently learned machines/axes */
+#define ANOMALY_BASELINE_DEFAULT_BLOCKS     256     /* Default commissioning window in blocks */
+#define ANOMALY_BASELINE_MIN_BLOCKS         16      /* Fewest blocks accepted as a baseline */
+#define ANOMALY_BASELINE_EWMA_ALPHA         0.05f   /* Adaptive baseline smoothing factor */
+#define ANOMALY_BASELINE_CONFIG_PARAM_BASE  96      /* Config parameter ID of channel 0 */
+
+/* Baseline feature vector */
+typedef enum {
+    ANOMALY_FEATURE_RMS             = 0,    /* AC RMS (standard deviation) */
+    ANOMALY_FEATURE_PEAK            = 1,    /* Peak deviation from the mean */
+    ANOMALY_FEATURE_CREST_FACTOR    = 2,    /* Peak / RMS */
+    ANOMALY_FEATURE_KURTOSIS        = 3,    /* Impulsiveness */
+    ANOMALY_FEATURE_COUNT
+} anomaly_feature_t;
+
+typedef enum {
+    ANOMALY_BASELINE_UNTRAINED      = 0,    /* Adaptive z-scores only */
+    ANOMALY_BASELINE_COMMISSIONING  = 1,    /* Learning the baseline */
+    ANOMALY_BASELINE_READY          = 2,    /* Mahalanobis scoring active */
+} anomaly_baseline_state_t;
+
+/* ============================================================================
+ * Baseline Data Structures
+ * ============================================================================ */
+
+/* Score of one feature vector */
+typedef struct {
+    anomaly_baseline_state_t state;         /* Baseline state used for scoring */
+    float distance_sq;                      /* Squared Mahalanobis distance (READY) */
+    float max_z_score;                      /* Largest per-feature |z| */
+    uint8_t dominant_feature;               /* Feature with the largest |z| */
+    float probability;                      /* Probability the vector is anomalous (0-1) */
+} anomaly_baseline_score_t;
+
+/* Channel status */
+typedef struct {
+    anomaly_baseline_state_t state;         /* Current state */
+    uint32_t blocks_learned;                /* Blocks in the learned (or learning) baseline */
+    uint32_t commissioning_blocks;          /* Commissioning window length */
+    float mean[ANOMALY_FEATURE_COUNT];      /* Baseline feature means */
+    float std_dev[ANOMALY_FEATURE_COUNT];   /* Baseline feature standard deviations */
+    float drift_z[ANOMALY_FEATURE_COUNT];   /* Adaptive mean versus learned mean, in baseline std devs */
+    bool persisted;                         /* Baseline stored in configuration */
+} anomaly_baseline_status_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Initialize the baseline learner
+ *
+ * Registers the persistence parameters and restores any baselines stored by
+ * an earlier commissioning. The configuration manager must be initialized
+ * for persistence; without it baselines are kept in RAM only.
+ *
+ * @return true if initialization successful, false otherwise
+ */
+bool anomaly_baseline_init(void);
+
+/**
+ * @brief Extract the baseline feature vector from capture statistics
+ *
+ * @param stats Capture statistics from the feature store
+ * @param features Feature vector to fill [ANOMALY_FEATURE_COUNT]
+ * @return true if features extracted successfully, false otherwise
+ */
+bool anomaly_baseline_extract_features(const dsp_feature_stats_t *stats, float *features);
+
+/**
+ * @brief Start learning a new baseline
+ *
+ * The current baseline stays in use for scoring until the window completes.
+ *
+ * @param channel Channel index
+ * @param num_blocks Commissioning window in blocks (0 = ANOMALY_BASELINE_DEFAULT_BLOCKS)
+ * @return true if commissioning started, false otherwise
+ */
+bool anomaly_baseline_start_commissioning(uint8_t channel, uint32_t num_blocks);
+
+/**
+ * @brief Finish commissioning early with the blocks seen so far
+ *
+ * @param channel Channel index
+ * @return true if a baseline was learned and persisted, false otherwise
+ */
+bool anomaly_baseline_finish_commissioning(uint8_t channel);
+
+/**
+ * @brief Score a feature vector and feed it to the learner
+ *
+ * The vector is scored before it updates any baseline, so an anomalous
+ * block cannot hide itself.
+ *
+ * @param channel Channel index
+ * @param features Feature vector [ANOMALY_FEATURE_COUNT]
+ * @param score Pointer to score to fill (may be NULL)
+ * @return true if update successful, false otherwise
+ */
+bool anomaly_baseline_update(uint8_t channel, const float *features, anomaly_baseline_score_t *score);
+
+/**
+ * @brief Discard a channel's baseline, including its persisted copy
+ *
+ * @param channel Channel index
+ * @return true if baseline cleared, false otherwise
+ */
+bool anomaly_baseline_reset(uint8_t channel);
+
+/**
+ * @brief Get channel status
+ *
+ * @param channel Channel index
+ * @param status Pointer to status structure to fill
+ * @return true if status retrieved successfully, false otherwise
+ */
+bool anomaly_baseline_get_status(uint8_t channel, anomaly_baseline_status_t *status);
+
+/**
+ * @brief Get the display name of a feature
+ *
+ * @param feature Feature index (anomaly_feature_t)
+ * @return Feature name
+ */
+const char *anomaly_baseline_feature_name(uint8_t feature);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_ANOMALY_BASELINE_H */
@@ -0,0 +1,480 @@
+/**
+ * @file tinyml_calibration.c
+ * @brief On-Device Calibration Implementation
+ *
+ * This file contains the incremental output correction and streaming
+ * k-means learner, one-class scoring and configuration-backed persistence
+ * of calibration records.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "tinyml_calibration.h"
+#include "tinyml_model.h"
+#include "tinyml_engine.h"
+#include "config_manager.h"
+#include "dsp_stats.h"
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+#define DIMS                          TINYML_CALIBRATION_MAX_DIMS
+#define CLUSTERS                      TINYML_CALIBRATION_CLUSTERS
+#define CALIBRATION_STD_FLOOR         0.01f   /* Smallest output spread; int8 steps of a flat output are not anomalies */
+#define CALIBRATION_RADIUS_FLOOR      0.01f   /* Smallest cluster spread in corrected units */
+#define CALIBRATION_SEED_DISTANCE     0.25f   /* Corrected distance below which a seed candidate joins a cluster */
+
+_Static_assert(sizeof(tinyml_calibration_record_t) <= TINYML_CALIBRATION_CONFIG_CHUNKS * ESOCORE_MAX_PARAMETER_VALUE_SIZE,
+               "Calibration record does not fit its configuration chunks");
+
+typedef struct {
+    bool in_use;
+    uint8_t model_type;
+
+    /* Record used for scoring */
+    bool calibrated;
+    bool persisted;
+    tinyml_calibration_record_t record;
+
+    /* Learning session, in raw output units */
+    bool collecting;
+    uint32_t session_checksum;
+    uint8_t session_dims;
+    uint32_t frames;
+    dsp_running_stats_t output_stats[DIMS];
+    uint8_t num_seeded;
+    float centroid[CLUSTERS][DIMS];
+    uint32_t members[CLUSTERS];
+    float distance_mean[CLUSTERS];          /* Mean corrected squared distance of later members */
+} calibration_slot_t;
+
+static calibration_slot_t slots[TINYML_CALIBRATION_MAX_MODELS];
+static bool calibration_initialized = false;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Configuration parameter ID of a record chunk
+ */
+static uint16_t calibration_param_id(uint8_t slot, uint8_t chunk) {
+    return (uint16_t)(TINYML_CALIBRATION_CONFIG_PARAM_BASE + slot * TINYML_CALIBRATION_CONFIG_CHUNKS + chunk);
+}
+
+/**
+ * @brief CRC-32 of a record up to its checksum field
+ */
+static uint32_t record_crc(const tinyml_calibration_record_t *record) {
+    return tinyml_model_crc32(0, (const uint8_t *)record, offsetof(tinyml_calibration_record_t, checksum));
+}
+
+/**
+ * @brief Check a record's header, checksum and values
+ */
+static bool record_valid(const tinyml_calibration_record_t *record) {
+    if (record->magic != TINYML_CALIBRATION_MAGIC || record->reserved != 0 ||
+        record->model_type >= TINYML_MAX_MODELS ||
+        record->num_dims == 0 || record->num_dims > DIMS ||
+        record->num_clusters == 0 || record->num_clusters > CLUSTERS ||
+        record->checksum != record_crc(record)) {
+        return false;
+    }
+
+    for (uint8_t d = 0; d < record->num_dims; d++) {
+        if (!isfinite(record->offset[d]) || !(record->scale[d] > 0.0f) || !isfinite(record->scale[d])) {
+            return false;
+        }
+    }
+    for (uint8_t k = 0; k < record->num_clusters; k++) {
+        if (!(record->radius_sq[k] > 0.0f) || !isfinite(record->radius_sq[k])) {
+            return false;
+        }
+        for (uint8_t d = 0; d < record->num_dims; d++) {
+            if (!isfinite(record->centroid[k][d])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Find the slot of a model type
+ */
+static int8_t find_slot(uint8_t model_type) {
+    for (uint8_t i = 0; i < TINYML_CALIBRATION_MAX_MODELS; i++) {
+        if (slots[i].in_use && slots[i].model_type == model_type) {
+            return (int8_t)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Find or claim the slot of a model type
+ */
+static int8_t claim_slot(uint8_t model_type) {
+    int8_t slot = find_slot(model_type);
+    if (slot >= 0) {
+        return slot;
+    }
+
+    for (uint8_t i = 0; i < TINYML_CALIBRATION_MAX_MODELS; i++) {
+        if (!slots[i].in_use) {
+            memset(&slots[i], 0, sizeof(calibration_slot_t));
+            slots[i].in_use = true;
+            slots[i].model_type = model_type;
+            return (int8_t)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Store a slot's record through the configuration manager
+ *
+ * An inactive slot stores empty chunks, which invalidates an older copy.
+ */
+static bool calibration_persist(uint8_t slot) {
+    const calibration_slot_t *s = &slots[slot];
+    uint8_t bytes[TINYML_CALIBRATION_CONFIG_CHUNKS * ESOCORE_MAX_PARAMETER_VALUE_SIZE];
+
+    memset(bytes, 0, sizeof(bytes));
+    if (s->calibrated) {
+        memcpy(bytes, &s->record, sizeof(tinyml_calibration_record_t));
+    }
+
+    for (uint8_t chunk = 0; chunk < TINYML_CALIBRATION_CONFIG_CHUNKS; chunk++) {
+        esocore_config_value_t value;
+        memset(&value, 0, sizeof(value));
+        value.parameter_id = calibration_param_id(slot, chunk);
+        value.data_type = ESOCORE_CONFIG_TYPE_BINARY;
+        if (s->calibrated) {
+            memcpy(value.value, &bytes[chunk * ESOCORE_MAX_PARAMETER_VALUE_SIZE], ESOCORE_MAX_PARAMETER_VALUE_SIZE);
+            value.value_size = ESOCORE_MAX_PARAMETER_VALUE_SIZE;
+        }
+        if (!esocore_config_set_value(value.parameter_id, &value, 0)) {
+            return false;
+        }
+    }
+    return esocore_config_save();
+}
+
+/**
+ * @brief Restore a slot's record from the configuration manager
+ */
+static bool calibration_restore(uint8_t slot) {
+    uint8_t bytes[TINYML_CALIBRATION_CONFIG_CHUNKS * ESOCORE_MAX_PARAMETER_VALUE_SIZE];
+    tinyml_calibration_record_t record;
+
+    for (uint8_t chunk = 0; chunk < TINYML_CALIBRATION_CONFIG_CHUNKS; chunk++) {
+        esocore_config_value_t value;
+        if (!esocore_config_get_value(calibration_param_id(slot, chunk), &value) ||
+            value.value_size != ESOCORE_MAX_PARAMETER_VALUE_SIZE) {
+            return false;
+        }
+        memcpy(&bytes[chunk * ESOCORE_MAX_PARAMETER_VALUE_SIZE], value.value, ESOCORE_MAX_PARAMETER_VALUE_SIZE);
+    }
+
+    memcpy(&record, bytes, sizeof(record));
+    if (!record_valid(&record)) {
+        return false;
+    }
+
+    calibration_slot_t *s = &slots[slot];
+    memset(s, 0, sizeof(calibration_slot_t));
+    s->in_use = true;
+    s->model_type = record.model_type;
+    s->record = record;
+    s->calibrated = true;
+    s->persisted = true;
+    return true;
+}
+
+/**
+ * @brief Standard deviation of one output in the current session
+ */
+static float session_std_dev(const calibration_slot_t *s, uint8_t dim) {
+    float std_dev = dsp_stats_std_dev(&s->output_stats[dim]);
+    return (std_dev > CALIBRATION_STD_FLOOR) ? std_dev : CALIBRATION_STD_FLOOR;
+}
+
+/**
+ * @brief Corrected squared distance per output between a frame and a session centroid
+ */
+static float session_distance_sq(const calibration_slot_t *s, const float *outputs, uint8_t cluster) {
+    float distance_sq = 0.0f;
+    for (uint8_t d = 0; d < s->session_dims; d++) {
+        float z = (outputs[d] - s->centroid[cluster][d]) / session_std_dev(s, d);
+        distance_sq += z * z;
+    }
+    return distance_sq / (float)s->session_dims;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Initialize calibration and restore persisted records
+ */
+bool tinyml_calibration_init(void) {
+    memset(slots, 0, sizeof(slots));
+
+    for (uint8_t slot = 0; slot < TINYML_CALIBRATION_MAX_MODELS; slot++) {
+        /* Already registered after a re-init; restoring still applies */
+        for (uint8_t chunk = 0; chunk < TINYML_CALIBRATION_CONFIG_CHUNKS; chunk++) {
+            esocore_config_parameter_t parameter;
+            memset(&parameter, 0, sizeof(parameter));
+            parameter.parameter_id = calibration_param_id(slot, chunk);
+            snprintf(parameter.name, sizeof(parameter.name), "tinyml_calibration_%u_%u",
+                     (unsigned)slot, (unsigned)chunk);
+            parameter.data_type = ESOCORE_CONFIG_TYPE_BINARY;
+            parameter.access_level = ESOCORE_ACCESS_SYSTEM_ONLY;
+            parameter.category = ESOCORE_CATEGORY_DIAGNOSTIC;
+            parameter.max_value_size = ESOCORE_MAX_PARAMETER_VALUE_SIZE;
+            parameter.is_persistent = true;
+            strcpy(parameter.description, "Learned TinyML output correction and clusters");
+            esocore_config_register_parameter(&parameter);
+        }
+
+        calibration_restore(slot);
+    }
+
+    calibration_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Add one frame of normal-operation outputs
+ */
+bool tinyml_calibration_add_frame(uint8_t model_type, uint32_t model_checksum,
+                                  const float *outputs, uint8_t num_dims) {
+    if (!calibration_initialized || !outputs || num_dims == 0 || num_dims > DIMS) {
+        return false;
+    }
+
+    for (uint8_t d = 0; d < num_dims; d++) {
+        if (!isfinite(outputs[d])) {
+            return false;
+        }
+    }
+
+    int8_t slot = claim_slot(model_type);
+    if (slot < 0) {
+        return false;
+    }
+
+    calibration_slot_t *s = &slots[slot];
+    if (!s->collecting || s->session_checksum != model_checksum || s->session_dims != num_dims) {
+        s->collecting = true;
+        s->session_checksum = model_checksum;
+        s->session_dims = num_dims;
+        s->frames = 0;
+        s->num_seeded = 0;
+        for (uint8_t d = 0; d < DIMS; d++) {
+            dsp_stats_reset(&s->output_stats[d]);
+        }
+    }
+
+    for (uint8_t d = 0; d < num_dims; d++) {
+        dsp_stats_update(&s->output_stats[d], outputs[d]);
+    }
+    s->frames++;
+
+    /* Nearest cluster under the current output spread */
+    uint8_t nearest = 0;
+    float nearest_distance_sq = INFINITY;
+    for (uint8_t k = 0; k < s->num_seeded; k++) {
+        float distance_sq = session_distance_sq(s, outputs, k);
+        if (distance_sq < nearest_distance_sq) {
+            nearest_distance_sq = distance_sq;
+            nearest = k;
+        }
+    }
+
+    /* Distinct early frames seed the clusters */
+    if (s->num_seeded < CLUSTERS && nearest_distance_sq > CALIBRATION_SEED_DISTANCE) {
+        uint8_t k = s->num_seeded++;
+        memcpy(s->centroid[k], outputs, num_dims * sizeof(float));
+        s->members[k] = 1;
+        s->distance_mean[k] = 0.0f;
+        return true;
+    }
+
+    /* Sequential (MacQueen) k-means update */
+    s->members[nearest]++;
+    for (uint8_t d = 0; d < num_dims; d++) {
+        s->centroid[nearest][d] += (outputs[d] - s->centroid[nearest][d]) / (float)s->members[nearest];
+    }
+    s->distance_mean[nearest] += (nearest_distance_sq - s->distance_mean[nearest]) /
+                                 (float)(s->members[nearest] - 1U);
+    return true;
+}
+
+/**
+ * @brief Fit and persist a record from the frames collected so far
+ */
+bool tinyml_calibration_commit(uint8_t model_type) {
+    int8_t slot = find_slot(model_type);
+    if (!calibration_initialized || slot < 0 || !slots[slot].collecting ||
+        slots[slot].frames < TINYML_CALIBRATION_MIN_FRAMES) {
+        return false;
+    }
+
+    calibration_slot_t *s = &slots[slot];
+    tinyml_calibration_record_t record;
+
+    memset(&record, 0, sizeof(record));
+    record.magic = TINYML_CALIBRATION_MAGIC;
+    record.model_type = model_type;
+    record.num_dims = s->session_dims;
+    record.model_checksum = s->session_checksum;
+    record.frames = s->frames;
+
+    for (uint8_t d = 0; d < s->session_dims; d++) {
+        record.offset[d] = -s->output_stats[d].mean;
+        record.scale[d] = 1.0f / session_std_dev(s, d);
+    }
+
+    /* Clusters that never grew past their seed are outliers, not modes */
+    for (uint8_t k = 0; k < s->num_seeded; k++) {
+        if (s->members[k] < 2) {
+            continue;
+        }
+        uint8_t c = record.num_clusters++;
+        for (uint8_t d = 0; d < s->session_dims; d++) {
+            record.centroid[c][d] = (s->centroid[k][d] + record.offset[d]) * record.scale[d];
+        }
+        record.radius_sq[c] = (s->distance_mean[k] > CALIBRATION_RADIUS_FLOOR) ?
+                              s->distance_mean[k] : CALIBRATION_RADIUS_FLOOR;
+    }
+    if (record.num_clusters == 0) {
+        return false;
+    }
+
+    record.checksum = record_crc(&record);
+    s->record = record;
+    s->calibrated = true;
+    s->persisted = calibration_persist((uint8_t)slot);
+    return true;
+}
+
+/**
+ * @brief Score model outputs against the active record
+ */
+bool tinyml_calibration_score(uint8_t model_type, uint32_t model_checksum,
+                              const float *outputs, float *score) {
+    int8_t slot = find_slot(model_type);
+    if (slot < 0 || !outputs || !score || !slots[slot].calibrated ||
+        slots[slot].record.model_checksum != model_checksum) {
+        return false;
+    }
+
+    const tinyml_calibration_record_t *record = &slots[slot].record;
+    float corrected[DIMS];
+    float best_ratio = INFINITY;
+
+    for (uint8_t d = 0; d < record->num_dims; d++) {
+        corrected[d] = (outputs[d] + record->offset[d]) * record->scale[d];
+    }
+
+    for (uint8_t k = 0; k < record->num_clusters; k++) {
+        float distance_sq = 0.0f;
+        for (uint8_t d = 0; d < record->num_dims; d++) {
+            float diff = corrected[d] - record->centroid[k][d];
+            distance_sq += diff * diff;
+        }
+        float ratio = distance_sq / (float)record->num_dims / record->radius_sq[k];
+        if (ratio < best_ratio) {
+            best_ratio = ratio;
+        }
+    }
+
+    *score = 100.0f * (1.0f - expf(-best_ratio / TINYML_CALIBRATION_SCORE_SCALE));
+    return true;
+}
+
+/**
+ * @brief Install and persist a record built elsewhere
+ */
+bool tinyml_calibration_set_record(const tinyml_calibration_record_t *record) {
+    if (!calibration_initialized || !record || !record_valid(record)) {
+        return false;
+    }
+
+    int8_t slot = claim_slot(record->model_type);
+    if (slot < 0) {
+        return false;
+    }
+
+    calibration_slot_t *s = &slots[slot];
+    s->record = *record;
+    s->calibrated = true;
+    s->collecting = false;
+    s->persisted = calibration_persist((uint8_t)slot);
+    return true;
+}
+
+/**
+ * @brief Get the active record of a model
+ */
+bool tinyml_calibration_get_record(uint8_t model_type, tinyml_calibration_record_t *record) {
+    int8_t slot = find_slot(model_type);
+    if (slot < 0 || !record || !slots[slot].calibrated) {
+        return false;
+    }
+
+    *record = slots[slot].record;
+    return true;
+}
+
+/**
+ * @brief Discard a model's record and session
+ */
+bool tinyml_calibration_reset(uint8_t model_type) {
+    int8_t slot = find_slot(model_type);
+    if (!calibration_initialized) {
+        return false;
+    }
+    if (slot < 0) {
+        return true;
+    }
+
+    bool was_persisted = slots[slot].persisted;
+    memset(&slots[slot], 0, sizeof(calibration_slot_t));
+
+    /* Empty chunks invalidate the stored copy */
+    return was_persisted ? calibration_persist((uint8_t)slot) : true;
+}
+
+/**
+ * @brief Get the calibration status of a model
+ */
+bool tinyml_calibration_get_status(uint8_t model_type, tinyml_calibration_status_t *status) {
+    if (!status) {
+        return false;
+    }
+
+    memset(status, 0, sizeof(tinyml_calibration_status_t));
+    int8_t slot = find_slot(model_type);
+    if (slot < 0) {
+        return true;
+    }
+
+    const calibration_slot_t *s = &slots[slot];
+    status->calibrated = s->calibrated;
+    status->persisted = s->persisted;
+    status->frames_collected = s->collecting ? s->frames : 0;
+    status->frames_learned = s->calibrated ? s->record.frames : 0;
+    status->num_clusters = s->calibrated ? s->record.num_clusters : 0;
+    return true;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file tinyml_calibration.h
+ * @brief On-Device Calibration of TinyML Model Outputs
+ *
+ * This file defines the per-machine adaptation of a loaded model. Model
+ * blobs execute in place from flash, so their weights are never rewritten;
+ * instead each calibrated model gets two small learned stages applied to
+ * its float outputs (or embedding):
+ * - An output correction, the adapted final-layer bias and scale, that
+ *   standardizes every output to zero mean and unit variance on the
+ *   machine's normal operation
+ * - A one-class model: streaming k-means clusters of the corrected outputs
+ *   with the mean squared distance of each cluster's members
+ *
+ * A calibrated model scores an inference by its distance to the nearest
+ * cluster relative to that cluster's spread, mapped to 0-100, so the
+ * engine's anomaly thresholds mean the same on every machine.
+ *
+ * Calibration is incremental: normal-operation frames collected during
+ * commissioning are added in any number of batches and memory stays
+ * constant. Records are persisted through the configuration manager and
+ * are tied to the model blob's checksum, so a model update invalidates
+ * them.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_TINYML_CALIBRATION_H
+#define ESOCORE_TINYML_CALIBRATION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Calibration Configuration
+ * ============================================================================ */
+
+#define TINYML_CALIBRATION_MAX_MODELS       2       /* Models calibrated at the same time */
+#define TINYML_CALIBRATION_MAX_DIMS         8       /* Outputs per calibrated model */
+#define TINYML_CALIBRATION_CLUSTERS         4       /* One-class k-means clusters */
+#define TINYML_CALIBRATION_MIN_FRAMES       32      /* Fewest frames accepted as a calibration */
+#define TINYML_CALIBRATION_SCORE_SCALE      3.0f    /* Distance ratio scoring 63 of 100 */
+#define TINYML_CALIBRATION_MAGIC            0x31434C54  /* "TLC1" */
+#define TINYML_CALIBRATION_CONFIG_PARAM_BASE 104    /* Config parameter ID of slot 0, chunk 0 */
+#define TINYML_CALIBRATION_CONFIG_CHUNKS    4       /* Config values per record */
+
+/* ============================================================================
+ * Calibration Structures
+ * ============================================================================ */
+
+/* Calibration record, as persisted and as accepted by
+ * tinyml_update_model_parameters() */
+typedef struct {
+    uint32_t magic;                         /* TINYML_CALIBRATION_MAGIC */
+    uint8_t model_type;                     /* tinyml_model_type_t */
+    uint8_t num_dims;                       /* Calibrated outputs */
+    uint8_t num_clusters;                   /* Valid clusters */
+    uint8_t reserved;                       /* Must be zero */
+    uint32_t model_checksum;                /* Checksum of the calibrated model blob */
+    uint32_t frames;                        /* Normal-operation frames learned */
+    float offset[TINYML_CALIBRATION_MAX_DIMS];   /* Output bias correction */
+    float scale[TINYML_CALIBRATION_MAX_DIMS];    /* Output scale correction */
+    float centroid[TINYML_CALIBRATION_CLUSTERS][TINYML_CALIBRATION_MAX_DIMS]; /* Corrected space */
+    float radius_sq[TINYML_CALIBRATION_CLUSTERS]; /* Mean squared member distance per output */
+    uint32_t checksum;                      /* CRC-32 of the record before this field */
+} tinyml_calibration_record_t;
+
+/* Calibration status of one model */
+typedef struct {
+    bool calibrated;                        /* Record active for scoring */
+    bool persisted;                         /* Record stored in configuration */
+    uint32_t frames_collected;              /* Frames in the current session */
+    uint32_t frames_learned;                /* Frames in the active record */
+    uint8_t num_clusters;                   /* Clusters of the active record */
+} tinyml_calibration_status_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Initialize calibration and restore persisted records
+ *
+ * The configuration manager must be initialized for persistence; without it
+ * records are kept in RAM only.
+ *
+ * @return true if initialization successful, false otherwise
+ */
+bool tinyml_calibration_init(void);
+
+/**
+ * @brief Add one frame of normal-operation outputs
+ *
+ * Starts a session for the model if none is running. A session for a
+ * different blob or output count is restarted.
+ *
+ * @param model_type Model type
+ * @param model_checksum Checksum of the loaded model blob
+ * @param outputs Model outputs [num_dims]
+ * @param num_dims Output count (at most TINYML_CALIBRATION_MAX_DIMS)
+ * @return true if frame added, false otherwise
+ */
+bool tinyml_calibration_add_frame(uint8_t model_type, uint32_t model_checksum,
+                                  const float *outputs, uint8_t num_dims);
+
+/**
+ * @brief Fit and persist a record from the frames collected so far
+ *
+ * The session keeps running, so later frames refine the next commit. A
+ * record that could not be stored stays active in RAM; see the persisted
+ * status flag.
+ *
+ * @param model_type Model type
+ * @return true if a record was fitted, false otherwise
+ */
+bool tinyml_calibration_commit(uint8_t model_type);
+
+/**
+ * @brief Score model outputs against the active record
+ *
+ * @param model_type Model type
+ * @param model_checksum Checksum of the loaded model blob
+ * @param outputs Model outputs [num_dims of the record]
+ * @param score Pointer to store the anomaly score (0-100)
+ * @return true if a matching record scored the outputs, false otherwise
+ */
+bool tinyml_calibration_score(uint8_t model_type, uint32_t model_checksum,
+                              const float *outputs, float *score);
+
+/**
+ * @brief Install and persist a record built elsewhere
+ *
+ * @param record Pointer to record (magic and checksum are verified)
+ * @return true if record installed, false otherwise (persistence as for commit)
+ */
+bool tinyml_calibration_set_record(const tinyml_calibration_record_t *record);
+
+/**
+ * @brief Get the active record of a model
+ *
+ * @param model_type Model type
+ * @param record Pointer to record to fill
+ * @return true if the model has an active record, false otherwise
+ */
+bool tinyml_calibration_get_record(uint8_t model_type, tinyml_calibration_record_t *record);
+
+/**
+ * @brief Discard a model's record and session
+ *
+ * @param model_type Model type
+ * @return true if calibration discarded, false otherwise
+ */
+bool tinyml_calibration_reset(uint8_t model_type);
+
+/**
+ * @brief Get the calibration status of a model
+ *
+ * @param model_type Model type
+ * @param status Pointer to status to fill
+ * @return true if status retrieved, false otherwise
+ */
+bool tinyml_calibration_get_status(uint8_t model_type, tinyml_calibration_status_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_TINYML_CALIBRATION_H */
@@ -3,7 +3,7 @@
  * @brief TinyML Engine Implementation
  *
  * This file contains the implementation of the TinyML engine for the EsoCore Edge device,
- * providing on-device machine learning capabilities using TensorFlow Lite Micro.
+ * providing on-device machine learning capabilities on an int8 quantized kernel backend.
  *
  * @author EsoCore Development Team
  * @copyright Copyright © 2025 Newmatik. All rights reserved.
@@ -11,9 +11,20 @@
  */
 
 #include "tinyml_engine.h"
+#include "tinyml_model.h"
+#include "tinyml_trees.h"
+#include "tinyml_profiler.h"
+#include "tinyml_calibration.h"
+#include "dsp_features.h"
+#include "dsp_mel.h"
+#include "dsp_stats.h"
+#include "anomaly_baseline.h"
+#include "../event_system.h"
+#include "../power_management.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 
 /* ============================================================================
  * Private Data Structures
@@ -26,106 +37,439 @@ static tinyml_performance_stats_t performance_stats;
 /* Model storage */
 static struct {
     tinyml_model_info_t info;
-    uint8_t *model_data;
+    const uint8_t *model_data;              /* Blob executed in place (flash or caller RAM) */
     uint32_t model_size;
+    tinyml_model_t model;                   /* Neural network (arena_required 0 for ensembles) */
+    tinyml_tree_ensemble_t ensemble;        /* Tree ensemble */
+    bool is_ensemble;
     bool loaded;
 } models[TINYML_MAX_MODELS];
 
-/* Tensor arena for inference */
+/* Tensor arena shared by all models; each plan starts at offset 0 */
 static uint8_t *tensor_arena = NULL;
 
-/* Inference queue */
-static tinyml_inference_request_t inference_queue[TINYML_MAX_MODELS * 2];
-static uint8_t queue_head = 0;
-static uint8_t queue_tail = 0;
+/* Scheduled inference requests; entries reference caller-owned requests */
+static struct {
+    const tinyml_inference_request_t *request;
+    tinyml_inference_result_t *result;
+    uint32_t submit_time_ms;
+    uint32_t deadline_time_ms;              /* Absolute deadline */
+    uint8_t priority;
+    bool safety;
+    bool in_use;
+} inference_queue[TINYML_MAX_QUEUE_DEPTH];
 static uint8_t queue_count = 0;
+static uint8_t queue_processing = 0;
+static uint32_t queue_completed = 0;
+
+/* Priorities by model type, kept across model reloads */
+static uint8_t model_priority[TINYML_MAX_MODELS];
 
-/* TensorFlow Lite Micro context - would be hardware dependent */
-static void *tflm_interpreter = NULL;
-static void *tflm_error_reporter = NULL;
+/* Sequence numbers of buffers published to the feature store by the engine */
+static uint32_t adhoc_capture_seq = 0;
+
+/* Continuous monitoring, indexed by model type */
+static struct {
+    bool enabled;
+    bool source_set;
+    uint8_t source_sensor;                  /* Feature store sensor ID */
+    bool has_capture;                       /* last_capture_seq valid */
+    uint32_t last_capture_seq;              /* Capture analyzed by the last run */
+    uint32_t base_interval_ms;              /* Configured interval */
+    uint32_t activity_interval_ms;          /* Interval adapted to recent scores */
+    uint32_t effective_interval_ms;         /* Activity interval adapted to the power budget */
+    uint32_t next_run_ms;
+    float last_score;
+    bool above_threshold;
+} monitors[TINYML_MAX_MODELS];
+
+/* Cascades, indexed by gated model type */
+static struct {
+    tinyml_cascade_config_t config;
+    dsp_ewma_t baseline[ANOMALY_FEATURE_COUNT];  /* Statistical gate baselines */
+    uint32_t blocks_seen;                   /* Captures seen by the statistical gate */
+    float gate_time_ms;                     /* Total time in the gate */
+    float model_time_ms;                    /* Total time in the model behind the gate */
+} cascades[TINYML_MAX_MODELS];
+
+/* Per-layer profiles of the models being profiled */
+static struct {
+    bool in_use;
+    tinyml_model_type_t model_type;
+    tinyml_model_profile_t profile;
+} profiles[TINYML_PROFILER_MAX_MODELS];
+
+/* Inference time since the statistics were cleared, for CPU utilization */
+static float inference_busy_ms = 0.0f;
+static uint32_t stats_start_ms = 0;
+
+/* Anomaly thresholds by model type and the application's anomaly callback */
+static float anomaly_thresholds[TINYML_MAX_MODELS];
+static void (*anomaly_callback)(const anomaly_detection_result_t *result) = NULL;
+
+/* Acoustic classifier front-end; its stream continues across calls with the same configuration */
+static dsp_mel_t acoustic_frontend;
+static bool acoustic_frontend_valid = false;
+static uint8_t acoustic_num_bands = DSP_MEL_MAX_BANDS;   /* Mel bands behind MFCCs */
+static uint8_t acoustic_num_mfcc = 0;                    /* 0 = log-mel features */
+static int8_t acoustic_features[DSP_MEL_MAX_FRAMES * DSP_MEL_MAX_BANDS];
 
 /* ============================================================================
- * TensorFlow Lite Micro Abstraction Layer
+ * Inference Backend
  * ============================================================================ */
 
+#if TINYML_KERNELS_USE_SIMD
+#define TINYML_CYCLES_PER_MAC       TINYML_TARGET_CYCLES_PER_MAC_SIMD
+#else
+#define TINYML_CYCLES_PER_MAC       TINYML_TARGET_CYCLES_PER_MAC_REFERENCE
+#endif
+#define TINYML_CYCLES_PER_TREE_NODE TINYML_TARGET_CYCLES_PER_TREE_NODE
+
+#define BACKEND_TICKS_PER_MS        (TINYML_PROFILER_CYCLES_PER_US * 1000UL)
+
+/**
+ * @brief Read the backend timebase (profiler cycles)
+ *
+ * @return Free-running tick count (wraps)
+ */
+static uint32_t backend_get_ticks(void) {
+    return tinyml_profiler_get_cycles();
+}
+
+/**
+ * @brief Millisecond engine time
+ *
+ * Read from the millisecond tick rather than extended from the cycle
+ * counter, which wraps every ~25 s at 168 MHz and would lose whole wraps
+ * while the caller sleeps on a long monitoring hint.
+ *
+ * @return Free-running milliseconds (wraps after ~49.7 days)
+ */
+static uint32_t engine_get_time_ms(void) {
+    return tinyml_profiler_get_time_ms();
+}
+
+/**
+ * @brief Find the shared arena high-water of the loaded models
+ *
+ * Model blobs execute in place, so the arena is the engine's only RAM cost.
+ *
+ * @return Largest planned arena of the loaded models in bytes
+ */
+static uint32_t get_arena_high_water(void) {
+    uint32_t arena_high_water = 0;
+
+    for (uint8_t i = 0; i < TINYML_MAX_MODELS; i++) {
+        if (models[i].loaded && models[i].model.arena_required > arena_high_water) {
+            arena_high_water = models[i].model.arena_required;
+        }
+    }
+
+    return arena_high_water;
+}
+
+/**
+ * @brief Find the profile of a model type
+ *
+ * @param model_type Model type
+ * @return Pointer to profile, or NULL if the model is not being profiled
+ */
+static tinyml_model_profile_t *find_profile(tinyml_model_type_t model_type) {
+    for (uint8_t i = 0; i < TINYML_PROFILER_MAX_MODELS; i++) {
+        if (profiles[i].in_use && profiles[i].model_type == model_type) {
+            return &profiles[i].profile;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Initialize the inference backend
+ *
+ * @return true if backend initialized successfully, false otherwise
+ */
+static bool backend_init(void) {
+    tinyml_profiler_init();
+
+    /* Kernels read int32 biases and the planner aligns tensors to 4 bytes */
+    return tensor_arena != NULL && ((uintptr_t)tensor_arena % sizeof(uint32_t)) == 0;
+}
+
 /**
- * @brief Initialize TensorFlow Lite Micro
+ * @brief Parse a tree ensemble blob and fill its model information
  *
- * @return true if TFLM initialized successfully, false otherwise
+ * Ensembles take float features and produce float outputs without using
+ * the arena. Rejects ensembles whose worst-case evaluation exceeds
+ * TINYML_INFERENCE_BUDGET_PERCENT of the timeout.
+ *
+ * @param model_data Pointer to model data
+ * @param model_size Model data size
+ * @param model_index Index of model in models array
+ * @return true if ensemble loaded successfully, false otherwise
  */
-static bool tflm_init(void) {
-    /* TODO: Initialize TensorFlow Lite Micro */
-    /* This would typically involve:
-     * - Creating error reporter
-     * - Setting up interpreter
-     * - Allocating tensor arena
-     * - Configuring micro ops resolver
-     */
+static bool backend_load_ensemble(const uint8_t *model_data, uint32_t model_size, uint8_t model_index) {
+    tinyml_tree_ensemble_t *ensemble = &models[model_index].ensemble;
+    tinyml_model_info_t *info = &models[model_index].info;
+
+    if (!tinyml_tree_parse(model_data, model_size, ensemble) ||
+        ensemble->header->num_features * sizeof(float) > TINYML_MAX_INPUT_SIZE) {
+        return false;
+    }
+
+    uint32_t timeout_ms = engine_config.inference_timeout_ms ?
+                          engine_config.inference_timeout_ms : TINYML_INFERENCE_TIMEOUT_MS;
+    uint64_t estimated_cycles = (uint64_t)ensemble->header->num_trees * (ensemble->max_depth + 1U) *
+                                TINYML_CYCLES_PER_TREE_NODE;
+    uint64_t budget_cycles = (uint64_t)timeout_ms * (TINYML_CPU_CLOCK_HZ / 1000UL) *
+                             TINYML_INFERENCE_BUDGET_PERCENT / 100U;
+    if (estimated_cycles > budget_cycles) {
+        return false;
+    }
+
+    info->input_tensor_size = ensemble->header->num_features;
+    info->output_tensor_size = ensemble->header->num_outputs;
+    info->input_tensor_type = TINYML_DATA_TYPE_FLOAT32;
+    info->output_tensor_type = TINYML_DATA_TYPE_FLOAT32;
+    info->input_shape[0] = 1;
+    info->input_shape[1] = ensemble->header->num_features;
+    info->output_shape[0] = 1;
+    info->output_shape[1] = ensemble->header->num_outputs;
+    info->quantization_scale = 1.0f;
+    info->quantization_zero_point = 0;
+
     return true;
 }
 
 /**
- * @brief Load model into TFLM interpreter
+ * @brief Parse and plan a model blob and fill its model information
+ *
+ * Rejects models whose tensors do not fit the arena or whose estimated
+ * execution time exceeds TINYML_INFERENCE_BUDGET_PERCENT of the timeout.
  *
  * @param model_data Pointer to model data
  * @param model_size Model data size
  * @param model_index Index of model in models array
  * @return true if model loaded successfully, false otherwise
  */
-static bool tflm_load_model(const uint8_t *model_data, uint32_t model_size, uint8_t model_index) {
-    /* TODO: Load model into TFLM interpreter */
-    /* This would typically involve:
-     * - Creating model from flatbuffer
-     * - Setting up interpreter with model
-     * - Allocating tensors
-     * - Preparing for inference
-     */
+static bool backend_load_model(const uint8_t *model_data, uint32_t model_size, uint8_t model_index) {
+    tinyml_model_t *model = &models[model_index].model;
+    tinyml_model_info_t *info = &models[model_index].info;
+
+    memset(model, 0, sizeof(tinyml_model_t));
+    models[model_index].is_ensemble = tinyml_tree_is_ensemble(model_data, model_size);
+    if (models[model_index].is_ensemble) {
+        return backend_load_ensemble(model_data, model_size, model_index);
+    }
+
+    if (!tinyml_model_parse(model_data, model_size, model) || !tinyml_model_plan(model)) {
+        return false;
+    }
+
+    if (model->arena_required > engine_config.tensor_arena_size ||
+        model->header->output_size > TINYML_MAX_OUTPUT_SIZE) {
+        return false;
+    }
+
+    /* Models run one at a time, so the arena costs the largest plan, not the sum */
+    if (engine_config.memory_limit_kb > 0) {
+        uint32_t arena_high_water = get_arena_high_water();
+        if (model->arena_required > arena_high_water) {
+            arena_high_water = model->arena_required;
+        }
+        if (arena_high_water > engine_config.memory_limit_kb * 1024U) {
+            return false;
+        }
+    }
+
+    uint32_t timeout_ms = engine_config.inference_timeout_ms ?
+                          engine_config.inference_timeout_ms : TINYML_INFERENCE_TIMEOUT_MS;
+    uint64_t estimated_cycles = (uint64_t)model->total_macs * TINYML_CYCLES_PER_MAC;
+    uint64_t budget_cycles = (uint64_t)timeout_ms * (TINYML_CPU_CLOCK_HZ / 1000UL) *
+                             TINYML_INFERENCE_BUDGET_PERCENT / 100U;
+    if (estimated_cycles > budget_cycles) {
+        return false;
+    }
+
+    const tinyml_model_header_t *header = model->header;
+    info->input_tensor_size = model->tensor_size[0];
+    info->output_tensor_size = header->output_size;
+    info->input_tensor_type = TINYML_DATA_TYPE_INT8;
+    info->output_tensor_type = TINYML_DATA_TYPE_INT8;
+    info->input_shape[0] = 1;
+    info->input_shape[1] = header->input_length;
+    info->input_shape[2] = header->input_channels;
+    info->output_shape[0] = 1;
+    info->output_shape[1] = header->output_size;
+    info->quantization_scale = header->input_scale;
+    info->quantization_zero_point = header->input_zero_point;
+
+    return true;
+}
+
+/**
+ * @brief Evaluate a loaded tree ensemble
+ *
+ * @param model_index Index of model
+ * @param request Pointer to inference request (float features)
+ * @param result Pointer to inference result (float output buffer and capacity)
+ * @param inference_time_ms Pointer to store inference time
+ * @return true if evaluation successful, false otherwise
+ */
+static bool backend_perform_ensemble(uint8_t model_index, const tinyml_inference_request_t *request,
+                                     tinyml_inference_result_t *result, float *inference_time_ms) {
+    const tinyml_tree_ensemble_t *ensemble = &models[model_index].ensemble;
+    float *outputs = (float *)result->output_data;
+    uint8_t output_count = ensemble->header->num_outputs;
+
+    uint32_t start = backend_get_ticks();
+
+    if (!tinyml_tree_predict(ensemble, (const float *)request->input_data, outputs)) {
+        return false;
+    }
+
+    /* Confidence is the largest output read as a probability */
+    float confidence = 0.0f;
+    for (uint8_t i = 0; i < output_count; i++) {
+        if (outputs[i] > confidence) {
+            confidence = outputs[i];
+        }
+    }
+    result->confidence_score = ((confidence > 1.0f) ? 1.0f : confidence) * 100.0f;
+    result->output_size = output_count * sizeof(float);
+    result->output_data_type = TINYML_DATA_TYPE_FLOAT32;
+
+    uint32_t elapsed = backend_get_ticks() - start;
+    tinyml_profiler_record(find_profile(models[model_index].info.model_type), elapsed, NULL);
+
+    *inference_time_ms = (float)elapsed / (float)BACKEND_TICKS_PER_MS;
     return true;
 }
 
 /**
  * @brief Perform inference with loaded model
  *
- * @param input_data Input data for inference
- * @param input_size Input data size
- * @param output_data Buffer for output data
- * @param output_size Output buffer size
+ * Float inputs are quantized with the model's quantization_scale and
+ * quantization_zero_point straight into the input tensor; int8 inputs are
+ * copied as-is. Outputs are dequantized to float unless int8 was requested.
+ * Models being profiled are timed per layer.
+ *
+ * @param model_index Index of model
+ * @param request Pointer to inference request
+ * @param result Pointer to inference result (output buffer and capacity)
  * @param inference_time_ms Pointer to store inference time
  * @return true if inference successful, false otherwise
  */
-static bool tflm_perform_inference(const void *input_data, uint32_t input_size,
-                                  void *output_data, uint32_t output_size,
-                                  uint32_t *inference_time_ms) {
-    /* TODO: Perform inference using TFLM */
-    /* This would typically involve:
-     * - Copying input data to input tensor
-     * - Invoking interpreter
-     * - Copying output tensor to output buffer
-     * - Measuring execution time
-     */
+static bool backend_perform_inference(uint8_t model_index, const tinyml_inference_request_t *request,
+                                      tinyml_inference_result_t *result, float *inference_time_ms) {
+    if (models[model_index].is_ensemble) {
+        return backend_perform_ensemble(model_index, request, result, inference_time_ms);
+    }
+
+    const tinyml_model_t *model = &models[model_index].model;
+    const tinyml_model_info_t *info = &models[model_index].info;
+    uint32_t input_count = model->tensor_size[0];
+    uint32_t output_count = model->header->output_size;
+    int8_t *input_tensor = (int8_t *)&tensor_arena[model->tensor_offset[0]];
+    int8_t *output_tensor = (int8_t *)&tensor_arena[model->tensor_offset[model->num_tensors - 1]];
+    tinyml_model_profile_t *profile = find_profile(models[model_index].info.model_type);
+    uint32_t layer_cycles[TINYML_MODEL_MAX_LAYERS];
+
+    uint32_t start = backend_get_ticks();
+
+    if (request->input_size == input_count * sizeof(float) &&
+        request->input_data_type != TINYML_DATA_TYPE_INT8) {
+        tinyml_quantize_float((const float *)request->input_data, input_tensor, input_count,
+                              info->quantization_scale, info->quantization_zero_point);
+    } else {
+        memcpy(input_tensor, request->input_data, input_count);
+    }
+
+    if (!tinyml_model_invoke(model, tensor_arena, engine_config.tensor_arena_size,
+                             input_tensor, output_tensor, profile ? layer_cycles : NULL)) {
+        return false;
+    }
+
+    /* Confidence is the largest output read as a probability */
+    float confidence = 0.0f;
+    for (uint32_t i = 0; i < output_count; i++) {
+        float value = ((float)output_tensor[i] - (float)model->header->output_zero_point) *
+                      model->header->output_scale;
+        if (value > confidence) {
+            confidence = value;
+        }
+    }
+    result->confidence_score = ((confidence > 1.0f) ? 1.0f : confidence) * 100.0f;
+
+    if (result->output_data_type == TINYML_DATA_TYPE_INT8) {
+        memcpy(result->output_data, output_tensor, output_count);
+        result->output_size = output_count;
+    } else {
+        tinyml_dequantize_int8(output_tensor, (float *)result->output_data, output_count,
+                               model->header->output_scale, model->header->output_zero_point);
+        result->output_size = output_count * sizeof(float);
+        result->output_data_type = TINYML_DATA_TYPE_FLOAT32;
+    }
+
+    uint32_t elapsed = backend_get_ticks() - start;
+    if (profile) {
+        tinyml_profiler_record(profile, elapsed, layer_cycles);
+    }
+
+    *inference_time_ms = (float)elapsed / (float)BACKEND_TICKS_PER_MS;
     return true;
 }
 
 /**
- * @brief Get input tensor size for model
+ * @brief Check an input buffer against the model input tensor
+ *
+ * @param model_index Index of model
+ * @param request Pointer to inference request
+ * @return true if the input is int8 or float of the right length
+ */
+static bool backend_validate_input(uint8_t model_index, const tinyml_inference_request_t *request) {
+    if (models[model_index].is_ensemble) {
+        return request->input_data_type != TINYML_DATA_TYPE_INT8 &&
+               request->input_size == models[model_index].ensemble.header->num_features * sizeof(float);
+    }
+
+    uint32_t input_count = models[model_index].model.tensor_size[0];
+
+    if (request->input_data_type == TINYML_DATA_TYPE_INT8) {
+        return request->input_size == input_count;
+    }
+    if (request->input_data_type == TINYML_DATA_TYPE_FLOAT32) {
+        return request->input_size == input_count * sizeof(float);
+    }
+    return request->input_size == input_count || request->input_size == input_count * sizeof(float);
+}
+
+/**
+ * @brief Get output buffer size required for a result
  *
  * @param model_index Index of model
- * @return Input tensor size in bytes, or 0 on error
+ * @param output_data_type Requested output data type
+ * @return Output size in bytes
  */
-static uint32_t tflm_get_input_size(uint8_t model_index) {
-    /* TODO: Get input tensor size from model */
-    return 1024; /* Placeholder */
+static uint32_t backend_get_output_size(uint8_t model_index, uint32_t output_data_type) {
+    if (models[model_index].is_ensemble) {
+        return models[model_index].ensemble.header->num_outputs * sizeof(float);
+    }
+
+    uint32_t output_count = models[model_index].model.header->output_size;
+    return (output_data_type == TINYML_DATA_TYPE_INT8) ? output_count : output_count * sizeof(float);
 }
 
 /**
- * @brief Get output tensor size for model
+ * @brief Get the checksum of a loaded model blob
  *
  * @param model_index Index of model
- * @return Output tensor size in bytes, or 0 on error
+ * @return Blob checksum from the model header
  */
-static uint32_t tflm_get_output_size(uint8_t model_index) {
-    /* TODO: Get output tensor size from model */
-    return 256; /* Placeholder */
+static uint32_t backend_get_model_checksum(uint8_t model_index) {
+    if (models[model_index].is_ensemble) {
+        return models[model_index].ensemble.header->checksum;
+    }
+    return models[model_index].model.header->checksum;
 }
 
 /* ============================================================================
@@ -180,6 +524,7 @@ static bool initialize_model_info(tinyml_model_type_t model_type, const uint8_t
     info->model_type = model_type;
     info->model_size_bytes = model_size;
     info->is_active = true;
+    info->priority = model_priority[model_type];
 
     /* Set model name based on type */
     switch (model_type) {
@@ -217,11 +562,11 @@ static bool initialize_model_info(tinyml_model_type_t model_type, const uint8_t
             break;
     }
 
-    /* Set placeholder tensor information */
+    /* Tensor defaults until the backend reads the model header */
     info->input_tensor_size = TINYML_MAX_INPUT_SIZE;
     info->output_tensor_size = TINYML_MAX_OUTPUT_SIZE;
-    info->input_tensor_type = 1; /* Float32 */
-    info->output_tensor_type = 1; /* Float32 */
+    info->input_tensor_type = TINYML_DATA_TYPE_FLOAT32;
+    info->output_tensor_type = TINYML_DATA_TYPE_FLOAT32;
     info->quantization_scale = 1.0f;
     info->quantization_zero_point = 0;
     info->creation_timestamp = 0; /* TODO: Current timestamp */
@@ -231,96 +576,307 @@ static bool initialize_model_info(tinyml_model_type_t model_type, const uint8_t
 }
 
 /* ============================================================================
- * Inference Queue Management
+ * Inference Scheduler
  * ============================================================================ */
 
 /**
- * @brief Add inference request to queue
+ * @brief Check whether a model is a safety-relevant anomaly detector
  *
- * @param request Pointer to inference request
- * @return true if request queued successfully, false otherwise
+ * @param model_type Model type
+ * @return true if the model must never wait behind other models
+ */
+static bool is_safety_model(tinyml_model_type_t model_type) {
+    return model_type == TINYML_MODEL_VIBRATION_ANOMALY ||
+           model_type == TINYML_MODEL_BEARING_FAULT ||
+           model_type == TINYML_MODEL_PUMP_CAVITATION;
+}
+
+/**
+ * @brief Default scheduling priority of a model type
+ *
+ * @param model_type Model type
+ * @return Priority (higher first)
  */
-static bool queue_inference_request(const tinyml_inference_request_t *request) {
-    if (queue_count >= sizeof(inference_queue) / sizeof(inference_queue[0])) {
-        return false; /* Queue full */
+static uint8_t default_model_priority(tinyml_model_type_t model_type) {
+    if (is_safety_model(model_type)) {
+        return TINYML_PRIORITY_SAFETY;
     }
+    if (model_type == TINYML_MODEL_ACOUSTIC_CLASSIFIER) {
+        return TINYML_PRIORITY_BULK;
+    }
+    return TINYML_PRIORITY_DEFAULT;
+}
 
-    memcpy(&inference_queue[queue_tail], request, sizeof(tinyml_inference_request_t));
-    queue_tail = (queue_tail + 1) % (sizeof(inference_queue) / sizeof(inference_queue[0]));
-    queue_count++;
+/**
+ * @brief Check whether queue entry a should run before entry b
+ *
+ * Safety class first, then priority, then earliest deadline, then age.
+ *
+ * @param a Index of first entry
+ * @param b Index of second entry
+ * @return true if a is more urgent than b
+ */
+static bool queue_entry_before(uint8_t a, uint8_t b) {
+    if (inference_queue[a].safety != inference_queue[b].safety) {
+        return inference_queue[a].safety;
+    }
+    if (inference_queue[a].priority != inference_queue[b].priority) {
+        return inference_queue[a].priority > inference_queue[b].priority;
+    }
 
-    return true;
+    int32_t deadline_diff = (int32_t)(inference_queue[a].deadline_time_ms -
+                                      inference_queue[b].deadline_time_ms);
+    if (deadline_diff != 0) {
+        return deadline_diff < 0;
+    }
+    return (int32_t)(inference_queue[a].submit_time_ms - inference_queue[b].submit_time_ms) < 0;
 }
 
 /**
- * @brief Get next inference request from queue
+ * @brief Find the most urgent queue entry, optionally restricted to one batch
  *
- * @param request Pointer to request structure to fill
- * @return true if request retrieved successfully, false otherwise
+ * @param batch_only true to consider only entries compatible with the batch
+ * @param model_type Batch model type
+ * @param input_data_type Batch input data type
+ * @return Index of entry, or -1 if none
  */
-static bool dequeue_inference_request(tinyml_inference_request_t *request) {
-    if (queue_count == 0) {
-        return false; /* Queue empty */
+static int8_t find_next_queue_entry(bool batch_only, tinyml_model_type_t model_type,
+                                    uint32_t input_data_type) {
+    int8_t best = -1;
+
+    for (uint8_t i = 0; i < TINYML_MAX_QUEUE_DEPTH; i++) {
+        if (!inference_queue[i].in_use) {
+            continue;
+        }
+        if (batch_only && (inference_queue[i].request->model_type != model_type ||
+                           inference_queue[i].request->input_data_type != input_data_type)) {
+            continue;
+        }
+        if (best < 0 || queue_entry_before(i, (uint8_t)best)) {
+            best = (int8_t)i;
+        }
     }
 
-    memcpy(request, &inference_queue[queue_head], sizeof(tinyml_inference_request_t));
-    queue_head = (queue_head + 1) % (sizeof(inference_queue) / sizeof(inference_queue[0]));
-    queue_count--;
+    return best;
+}
 
-    return true;
+/**
+ * @brief Run or drop one queue entry and release it
+ *
+ * @param index Queue entry index
+ */
+static void dispatch_queue_entry(uint8_t index) {
+    const tinyml_inference_request_t *request = inference_queue[index].request;
+    tinyml_inference_result_t *result = inference_queue[index].result;
+    uint32_t now = engine_get_time_ms();
+    uint32_t queue_delay = now - inference_queue[index].submit_time_ms;
+    bool stale = (int32_t)(now - inference_queue[index].deadline_time_ms) > 0;
+    int8_t slot = find_model_by_type(request->model_type);
+
+    queue_processing = 1;
+
+    if (stale && !inference_queue[index].safety) {
+        /* Late bulk results are worthless; free the CPU for fresh work */
+        result->success = false;
+        strcpy(result->error_message, "Deadline expired");
+        if (slot >= 0) {
+            models[slot].info.dropped_requests++;
+            models[slot].info.deadline_misses++;
+        }
+    } else {
+        /* Anomaly detectors still run late: a stale answer beats none */
+        tinyml_perform_inference(request, result);
+        if (slot >= 0 &&
+            (int32_t)(engine_get_time_ms() - inference_queue[index].deadline_time_ms) > 0) {
+            models[slot].info.deadline_misses++;
+        }
+    }
+
+    if (slot >= 0) {
+        tinyml_model_info_t *info = &models[slot].info;
+        /* Direct calls count as usage but have no queue delay */
+        info->queue_dispatches++;
+        info->average_queue_delay_ms +=
+            ((float)queue_delay - info->average_queue_delay_ms) / (float)info->queue_dispatches;
+        if (queue_delay > info->max_queue_delay_ms) {
+            info->max_queue_delay_ms = queue_delay;
+        }
+    }
+
+    result->timestamp = engine_get_time_ms();
+    inference_queue[index].in_use = false;
+    queue_count--;
+    queue_completed++;
+    queue_processing = 0;
 }
 
 /* ============================================================================
  * Anomaly Detection Algorithms
  * ============================================================================ */
 
+/* Feature-based detection thresholds */
+#define VIBRATION_BASELINE_CHANNEL    0       /* Anomaly baseline channel of the vibration sensor */
+#define ANOMALY_PROBABILITY_WARNING   0.99f   /* Baseline tail probability for a warning */
+#define ANOMALY_PROBABILITY_CRITICAL  0.999f  /* Baseline tail probability for a critical anomaly */
+#define BEARING_KURTOSIS_ONSET        4.0f    /* Impulsiveness above Gaussian (3) */
+#define BEARING_KURTOSIS_SPAN         6.0f    /* Kurtosis rise to full score */
+#define BEARING_PROMINENCE_ONSET      6.0f    /* Envelope peak / mean envelope level */
+#define BEARING_PROMINENCE_SPAN       12.0f   /* Prominence rise to full score */
+#define GEAR_SIDEBAND_FAULT_RATIO     0.1f    /* Sideband / mesh amplitude for a fault */
+
 /**
- * @brief Detect vibration anomalies using statistical methods
+ * @brief Resolve a data buffer to a feature store capture
  *
- * @param vibration_data Vibration data array
+ * A buffer already published by a sensor driver reuses that capture and the
+ * features computed for it; any other buffer is published as a fresh ad hoc
+ * capture, since its contents may have changed since an earlier call.
+ *
+ * @param data Data array
  * @param data_length Length of data array
+ * @param sampling_rate_hz Sampling rate in Hz (0 if unknown)
+ * @param sensor_id Pointer to store capture sensor ID
+ * @param capture_seq Pointer to store capture sequence
+ * @return true if capture available, false otherwise
+ */
+static bool acquire_capture_features(const float *data, uint32_t data_length, uint32_t sampling_rate_hz,
+                                     uint8_t *sensor_id, uint32_t *capture_seq) {
+    uint16_t length = (data_length > UINT16_MAX) ? UINT16_MAX : (uint16_t)data_length;
+
+    if (dsp_feature_find(data, length, sensor_id, capture_seq)) {
+        return true;
+    }
+
+    *sensor_id = DSP_FEATURE_SENSOR_ADHOC;
+    *capture_seq = ++adhoc_capture_seq;
+    return dsp_feature_publish(*sensor_id, *capture_seq, data, length, (float)sampling_rate_hz);
+}
+
+/**
+ * @brief Detect vibration anomalies against the learned baseline
+ *
+ * Scores the capture's feature vector by Mahalanobis distance to the
+ * commissioned baseline, or by z-score against the adaptive baselines until
+ * one is learned, and feeds the vector to the learner.
+ *
+ * @param sensor_id Capture sensor ID
+ * @param capture_seq Capture sequence
  * @param result Pointer to anomaly result structure
  * @return true if detection successful, false otherwise
  */
-static bool detect_vibration_anomaly_statistical(const float *vibration_data, uint32_t data_length,
+static bool detect_vibration_anomaly_statistical(uint8_t sensor_id, uint32_t capture_seq,
                                                 anomaly_detection_result_t *result) {
-    if (!vibration_data || !result || data_length == 0) {
+    const dsp_feature_stats_t *stats = dsp_feature_get_stats(sensor_id, capture_seq);
+    float features[ANOMALY_FEATURE_COUNT];
+    anomaly_baseline_score_t score;
+
+    if (!anomaly_baseline_extract_features(stats, features) ||
+        !anomaly_baseline_update(VIBRATION_BASELINE_CHANNEL, features, &score)) {
         return false;
     }
 
-    /* Calculate basic statistics */
-    float mean = 0.0f;
-    float variance = 0.0f;
+    bool ready = (score.state == ANOMALY_BASELINE_READY);
+    const char *feature = anomaly_baseline_feature_name(score.dominant_feature);
 
-    for (uint32_t i = 0; i < data_length; i++) {
-        mean += vibration_data[i];
+    result->anomaly_type = ANOMALY_TYPE_POINT;
+    result->anomaly_score = score.probability * 100.0f;
+    result->confidence_level = ready ? 90.0f : 60.0f;
+    result->detection_timestamp = engine_get_time_ms();
+
+    if (score.probability >= ANOMALY_PROBABILITY_WARNING) {
+        if (ready) {
+            snprintf(result->anomaly_description, sizeof(result->anomaly_description),
+                     "Vibration deviates from baseline (D2 %.1f, %s z %.1f)",
+                     (double)score.distance_sq, feature, (double)score.max_z_score);
+        } else {
+            snprintf(result->anomaly_description, sizeof(result->anomaly_description),
+                     "Vibration %s deviates from recent level (z %.1f)",
+                     feature, (double)score.max_z_score);
+        }
+        strcpy(result->recommended_action, "Inspect equipment for potential issues");
+    } else {
+        strcpy(result->anomaly_description, ready ? "Vibration within baseline" :
+                                                    "Vibration within recent level");
+        strcpy(result->recommended_action, "No action required");
     }
-    mean /= data_length;
 
-    for (uint32_t i = 0; i < data_length; i++) {
-        float diff = vibration_data[i] - mean;
-        variance += diff * diff;
+    if (score.probability >= ANOMALY_PROBABILITY_CRITICAL) {
+        result->severity_level = 3;
+    } else if (score.probability >= ANOMALY_PROBABILITY_WARNING) {
+        result->severity_level = 2;
+    } else {
+        result->severity_level = 1;
     }
-    variance /= data_length;
-
-    float std_dev = sqrtf(variance);
-
-    /* Simple anomaly detection based on standard deviation */
-    result->anomaly_type = ANOMALY_TYPE_POINT;
-    result->anomaly_score = (std_dev > 2.0f) ? 85.0f : 15.0f; /* Placeholder threshold */
-    result->confidence_level = 75.0f;
-    result->detection_timestamp = 0; /* TODO: Current timestamp */
-    strcpy(result->anomaly_description, "Vibration anomaly detected");
-    strcpy(result->recommended_action, "Inspect equipment for potential issues");
-    result->severity_level = (std_dev > 3.0f) ? 3 : 1;
     strcpy(result->affected_component, "Vibration Sensor");
 
     return true;
 }
 
+/**
+ * @brief Find the strongest spectrum bin above DC and its prominence
+ *
+ * @param spectrum Amplitude spectrum
+ * @param num_bins Number of bins
+ * @param peak_bin Pointer to store peak bin index
+ * @return Peak amplitude divided by mean bin amplitude (0 if spectrum is flat zero)
+ */
+static float find_spectral_peak(const float *spectrum, uint16_t num_bins, uint16_t *peak_bin) {
+    float peak = 0.0f;
+    float sum = 0.0f;
+
+    *peak_bin = 0;
+    for (uint16_t k = 1; k < num_bins; k++) {
+        sum += spectrum[k];
+        if (spectrum[k] > peak) {
+            peak = spectrum[k];
+            *peak_bin = k;
+        }
+    }
+
+    if (num_bins < 2 || sum <= 0.0f) {
+        return 0.0f;
+    }
+    return peak * (float)(num_bins - 1) / sum;
+}
+
+/**
+ * @brief Check whether two front-end configurations are the same
+ *
+ * @param a First configuration
+ * @param b Second configuration
+ * @return true if every field matches
+ */
+static bool mel_config_equal(const dsp_mel_config_t *a, const dsp_mel_config_t *b) {
+    return a->sample_rate_hz == b->sample_rate_hz && a->num_bands == b->num_bands &&
+           a->num_mfcc == b->num_mfcc && a->num_frames == b->num_frames &&
+           a->min_freq_hz == b->min_freq_hz && a->max_freq_hz == b->max_freq_hz &&
+           a->output_scale == b->output_scale && a->output_zero_point == b->output_zero_point;
+}
+
+/**
+ * @brief Configure the acoustic front-end
+ *
+ * Tables are rebuilt only when the configuration changes, so consecutive
+ * calls with the same configuration continue one audio stream.
+ *
+ * @param config Front-end configuration
+ * @return true if the front-end is ready, false if the configuration is invalid
+ */
+static bool acoustic_frontend_configure(const dsp_mel_config_t *config) {
+    if (acoustic_frontend_valid && mel_config_equal(&acoustic_frontend.config, config)) {
+        return true;
+    }
+
+    acoustic_frontend_valid = dsp_mel_init(&acoustic_frontend, config);
+    return acoustic_frontend_valid;
+}
+
 /**
  * @brief Classify acoustic patterns using basic frequency analysis
  *
+ * Without a model the output is the clip's mean log-mel spectrum and the
+ * confidence is the share of the clip's energy in its strongest band, i.e.
+ * how tonal the sound is.
+ *
  * @param audio_data Audio data array
  * @param data_length Length of data array
  * @param sampling_rate Audio sampling rate
@@ -333,24 +889,64 @@ static bool classify_acoustic_pattern_basic(const int16_t *audio_data, uint32_t
         return false;
     }
 
-    /* Calculate RMS level */
-    float rms = 0.0f;
-    for (uint32_t i = 0; i < data_length; i++) {
-        rms += (float)audio_data[i] * audio_data[i];
+    uint32_t start_ms = engine_get_time_ms();
+    dsp_mel_config_t config;
+    dsp_mel_default_config(&config, sampling_rate);
+    config.num_frames = 1;
+    if (!acoustic_frontend_configure(&config)) {
+        return false;
+    }
+    dsp_mel_reset(&acoustic_frontend);
+
+    /* Mean band energy over every frame of the clip, fed one hop at a time */
+    float mean_energy[DSP_MEL_MAX_BANDS];
+    uint32_t frames = 0;
+    memset(mean_energy, 0, sizeof(mean_energy));
+    for (uint32_t offset = 0; offset < data_length; offset += acoustic_frontend.hop_length) {
+        uint32_t block = data_length - offset;
+        if (block > acoustic_frontend.hop_length) {
+            block = acoustic_frontend.hop_length;
+        }
+        if (dsp_mel_process(&acoustic_frontend, &audio_data[offset], block) > 0) {
+            const float *frame = dsp_mel_get_frame(&acoustic_frontend);
+            for (uint8_t b = 0; b < config.num_bands; b++) {
+                mean_energy[b] += expf(frame[b]);
+            }
+            frames++;
+        }
+    }
+    if (frames == 0) {
+        return false;
+    }
+
+    float total = 0.0f;
+    float peak = 0.0f;
+    for (uint8_t b = 0; b < config.num_bands; b++) {
+        mean_energy[b] /= (float)frames;
+        total += mean_energy[b];
+        if (mean_energy[b] > peak) {
+            peak = mean_energy[b];
+        }
     }
-    rms = sqrtf(rms / data_length);
 
-    /* Simple classification based on RMS level */
     result->model_type = TINYML_MODEL_ACOUSTIC_CLASSIFIER;
-    result->confidence_score = 70.0f;
-    result->inference_time_ms = 10; /* Placeholder */
-    result->success = true;
-
-    /* Placeholder classification result */
-    static float placeholder_output[10] = {0.1f, 0.8f, 0.05f, 0.03f, 0.02f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    result->confidence_score = (total > 0.0f) ? 100.0f * peak / total : 0.0f;
+    result->anomaly_score = result->confidence_score;
     if (result->output_data) {
-        memcpy(result->output_data, placeholder_output, sizeof(placeholder_output));
+        uint32_t count = result->output_size / sizeof(float);
+        if (count > config.num_bands) {
+            count = config.num_bands;
+        }
+        for (uint32_t b = 0; b < count; b++) {
+            ((float *)result->output_data)[b] = logf(mean_energy[b] + DSP_MEL_LOG_FLOOR);
+        }
+        result->output_size = count * sizeof(float);
+        result->output_data_type = TINYML_DATA_TYPE_FLOAT32;
     }
+    result->timestamp = engine_get_time_ms();
+    result->inference_time_ms = result->timestamp - start_ms;
+    result->success = true;
+    result->error_message[0] = '\0';
 
     return true;
 }
@@ -377,8 +973,8 @@ bool tinyml_engine_init(const tinyml_engine_config_t *config) {
         }
     }
 
-    /* Initialize TensorFlow Lite Micro */
-    if (!tflm_init()) {
+    /* Initialize inference backend */
+    if (!backend_init()) {
         free(tensor_arena);
         tensor_arena = NULL;
         return false;
@@ -387,11 +983,35 @@ bool tinyml_engine_init(const tinyml_engine_config_t *config) {
     /* Initialize model storage */
     memset(models, 0, sizeof(models));
 
+    /* Restore learned anomaly baselines and model calibrations */
+    anomaly_baseline_init();
+    tinyml_calibration_init();
+
+    /* Initialize scheduler */
+    memset(inference_queue, 0, sizeof(inference_queue));
+    queue_count = 0;
+    queue_processing = 0;
+    queue_completed = 0;
+    for (uint8_t i = 0; i < TINYML_MAX_MODELS; i++) {
+        model_priority[i] = default_model_priority((tinyml_model_type_t)i);
+        anomaly_thresholds[i] = TINYML_DEFAULT_ANOMALY_THRESHOLD;
+    }
+    /* Vibration scores are baseline tail probabilities */
+    anomaly_thresholds[TINYML_MODEL_VIBRATION_ANOMALY] = ANOMALY_PROBABILITY_WARNING * 100.0f;
+
+    /* Initialize continuous monitoring and cascades */
+    memset(monitors, 0, sizeof(monitors));
+    memset(cascades, 0, sizeof(cascades));
+    anomaly_callback = NULL;
+
     /* Initialize status */
-    engine_status.status = TINYML_STATUS_READY;
+    engine_status = TINYML_STATUS_READY;
 
-    /* Initialize performance statistics */
+    /* Initialize performance statistics and profiling */
     memset(&performance_stats, 0, sizeof(tinyml_performance_stats_t));
+    memset(profiles, 0, sizeof(profiles));
+    inference_busy_ms = 0.0f;
+    stats_start_ms = engine_get_time_ms();
 
     return true;
 }
@@ -414,7 +1034,7 @@ bool tinyml_engine_deinit(void) {
     }
 
     /* Reset status */
-    engine_status.status = TINYML_STATUS_UNINITIALIZED;
+    engine_status = TINYML_STATUS_UNINITIALIZED;
 
     return true;
 }
@@ -424,40 +1044,37 @@ bool tinyml_engine_deinit(void) {
  */
 bool tinyml_load_model(tinyml_model_type_t model_type, const uint8_t *model_data,
                       uint32_t model_size, tinyml_model_info_t *model_info) {
-    if (!model_data || model_size == 0) {
+    if (!model_data || model_size == 0 || model_size > TINYML_MAX_MODEL_SIZE) {
         return false;
     }
 
     /* Find free model slot */
-    int8_t slot = find_free_model_slot();
-    if (slot < 0) {
+    int8_t found = find_free_model_slot();
+    if (found < 0) {
         return false; /* No free slots */
     }
-
-    /* Allocate memory for model data */
-    models[slot].model_data = (uint8_t *)malloc(model_size);
-    if (!models[slot].model_data) {
-        return false;
-    }
-
-    /* Copy model data */
-    memcpy(models[slot].model_data, model_data, model_size);
-    models[slot].model_size = model_size;
+    uint8_t slot = (uint8_t)found;
 
     /* Initialize model info */
     if (!initialize_model_info(model_type, model_data, model_size, &models[slot].info)) {
-        free(models[slot].model_data);
         return false;
     }
 
-    /* Load model into TFLM */
-    if (!tflm_load_model(model_data, model_size, slot)) {
-        free(models[slot].model_data);
+    /* Parse and plan the blob where it lies; weights are never copied */
+    if (!backend_load_model(model_data, model_size, slot)) {
         return false;
     }
 
+    models[slot].model_data = model_data;
+    models[slot].model_size = model_size;
     models[slot].loaded = true;
 
+    /* A reloaded model starts a fresh profile */
+    tinyml_model_profile_t *profile = find_profile(model_type);
+    if (profile) {
+        tinyml_profiler_reset(profile, models[slot].is_ensemble ? NULL : &models[slot].model);
+    }
+
     /* Copy model info to output if requested */
     if (model_info) {
         memcpy(model_info, &models[slot].info, sizeof(tinyml_model_info_t));
@@ -475,11 +1092,9 @@ bool tinyml_unload_model(tinyml_model_type_t model_type) {
         return false;
     }
 
-    /* Free model data */
-    if (models[slot].model_data) {
-        free(models[slot].model_data);
-        models[slot].model_data = NULL;
-    }
+    /* The blob belongs to the caller or to flash; only forget it */
+    models[slot].model_data = NULL;
+    models[slot].model_size = 0;
 
     /* Reset model info */
     memset(&models[slot].info, 0, sizeof(tinyml_model_info_t));
@@ -496,12 +1111,17 @@ bool tinyml_get_model_info(tinyml_model_type_t model_type, tinyml_model_info_t *
         return false;
     }
 
-    int8_t slot = find_model_by_type(model_type);
-    if (slot < 0) {
+    int8_t found = find_model_by_type(model_type);
+    if (found < 0) {
         return false;
     }
+    uint8_t slot = (uint8_t)found;
 
     memcpy(model_info, &models[slot].info, sizeof(tinyml_model_info_t));
+
+    tinyml_calibration_record_t record;
+    model_info->is_calibrated = tinyml_calibration_get_record((uint8_t)model_type, &record) &&
+                                record.model_checksum == backend_get_model_checksum(slot);
     return true;
 }
 
@@ -515,30 +1135,30 @@ bool tinyml_perform_inference(const tinyml_inference_request_t *request,
     }
 
     /* Check if engine is ready */
-    if (engine_status.status != TINYML_STATUS_READY) {
+    if (engine_status != TINYML_STATUS_READY) {
         result->success = false;
         strcpy(result->error_message, "Engine not ready");
         return false;
     }
 
     /* Find model */
-    int8_t slot = find_model_by_type(request->model_type);
-    if (slot < 0) {
+    int8_t found = find_model_by_type(request->model_type);
+    if (found < 0) {
         result->success = false;
         strcpy(result->error_message, "Model not loaded");
         return false;
     }
+    uint8_t slot = (uint8_t)found;
 
     /* Validate input data size */
-    uint32_t expected_input_size = tflm_get_input_size(slot);
-    if (request->input_size != expected_input_size) {
+    if (!request->input_data || !backend_validate_input(slot, request)) {
         result->success = false;
         strcpy(result->error_message, "Invalid input size");
         return false;
     }
 
-    /* Allocate output buffer if needed */
-    uint32_t output_size = tflm_get_output_size(slot);
+    /* Validate output buffer */
+    uint32_t output_size = backend_get_output_size(slot, result->output_data_type);
     if (!result->output_data || result->output_size < output_size) {
         result->success = false;
         strcpy(result->error_message, "Invalid output buffer");
@@ -546,31 +1166,64 @@ bool tinyml_perform_inference(const tinyml_inference_request_t *request,
     }
 
     /* Perform inference */
-    uint32_t inference_time;
-    if (!tflm_perform_inference(request->input_data, request->input_size,
-                               result->output_data, output_size, &inference_time)) {
+    float inference_time;
+    engine_status = TINYML_STATUS_BUSY;
+    bool inference_ok = backend_perform_inference(slot, request, result, &inference_time);
+    engine_status = TINYML_STATUS_READY;
+    if (inference_ok) {
+        inference_busy_ms += inference_time;
+    }
+
+    if (!inference_ok) {
         result->success = false;
         strcpy(result->error_message, "Inference failed");
+        performance_stats.total_inferences++;
+        performance_stats.failed_inferences++;
+        return false;
+    }
+
+    uint32_t timeout_ms = engine_config.inference_timeout_ms ?
+                          engine_config.inference_timeout_ms : TINYML_INFERENCE_TIMEOUT_MS;
+    if (inference_time > (float)timeout_ms) {
+        result->success = false;
+        strcpy(result->error_message, "Inference timeout");
+        performance_stats.total_inferences++;
         performance_stats.failed_inferences++;
         return false;
     }
 
     /* Fill result structure */
     result->model_type = request->model_type;
-    result->output_size = output_size;
-    result->inference_time_ms = inference_time;
+    result->inference_time_ms = (uint32_t)(inference_time + 0.5f);
     result->success = true;
     result->error_message[0] = '\0';
 
-    /* Set confidence score based on output (placeholder) */
-    result->confidence_score = 85.0f; /* TODO: Calculate from model output */
+    /* Calibrated models score against this machine's normal operation */
+    result->anomaly_score = result->confidence_score;
+    if (result->output_data_type == TINYML_DATA_TYPE_FLOAT32) {
+        tinyml_calibration_score((uint8_t)request->model_type, backend_get_model_checksum(slot),
+                                 (const float *)result->output_data, &result->anomaly_score);
+    }
 
     /* Update performance statistics */
+    if (performance_stats.successful_inferences == 0 ||
+        inference_time < performance_stats.min_inference_time_ms) {
+        performance_stats.min_inference_time_ms = inference_time;
+    }
+    if (inference_time > performance_stats.max_inference_time_ms) {
+        performance_stats.max_inference_time_ms = inference_time;
+    }
+    uint32_t live_kb = (models[slot].model.arena_required + 1023U) / 1024U;
+    performance_stats.memory_usage_kb = live_kb;
+    if (live_kb > performance_stats.peak_memory_usage_kb) {
+        performance_stats.peak_memory_usage_kb = live_kb;
+    }
+
     performance_stats.total_inferences++;
     performance_stats.successful_inferences++;
     performance_stats.average_inference_time_ms =
-        (performance_stats.average_inference_time_ms * (performance_stats.total_inferences - 1) +
-         inference_time) / performance_stats.total_inferences;
+        (performance_stats.average_inference_time_ms * (performance_stats.successful_inferences - 1) +
+         inference_time) / performance_stats.successful_inferences;
 
     /* Update model usage statistics */
     models[slot].info.usage_count++;
@@ -605,11 +1258,12 @@ bool tinyml_detect_vibration_anomaly(const float *vibration_data, uint32_t data_
         float output_buffer[10]; /* Placeholder output buffer */
         inference_result.output_data = output_buffer;
         inference_result.output_size = sizeof(output_buffer);
+        inference_result.output_data_type = TINYML_DATA_TYPE_FLOAT32;
 
         if (tinyml_perform_inference(&request, &inference_result) && inference_result.success) {
             /* Parse ML model output for anomaly detection */
             result->anomaly_type = ANOMALY_TYPE_POINT;
-            result->anomaly_score = inference_result.confidence_score;
+            result->anomaly_score = inference_result.anomaly_score;
             result->confidence_level = inference_result.confidence_score;
             result->detection_timestamp = 0; /* TODO: Current timestamp */
             strcpy(result->anomaly_description, "Vibration anomaly detected by ML model");
@@ -620,12 +1274,171 @@ bool tinyml_detect_vibration_anomaly(const float *vibration_data, uint32_t data_
         }
     }
 
-    /* Fall back to statistical method */
-    return detect_vibration_anomaly_statistical(vibration_data, data_length, result);
+    /* Fall back to statistical method on the shared capture features */
+    uint8_t sensor_id;
+    uint32_t capture_seq;
+    if (!acquire_capture_features(vibration_data, data_length, sampling_rate_hz, &sensor_id, &capture_seq)) {
+        return false;
+    }
+    return detect_vibration_anomaly_statistical(sensor_id, capture_seq, result);
 }
 
 /**
- * @brief Classify acoustic patterns
+ * @brief Detect bearing faults
+ */
+bool tinyml_detect_bearing_fault(const float *vibration_data, uint32_t data_length,
+                                const char *bearing_type, anomaly_detection_result_t *result) {
+    if (!vibration_data || !result || data_length == 0) {
+        return false;
+    }
+
+    uint8_t sensor_id;
+    uint32_t capture_seq;
+    if (!acquire_capture_features(vibration_data, data_length, 0, &sensor_id, &capture_seq)) {
+        return false;
+    }
+
+    const dsp_feature_stats_t *stats = dsp_feature_get_stats(sensor_id, capture_seq);
+    uint16_t num_bins;
+    float bin_width_hz;
+    const float *envelope = dsp_feature_get_envelope_spectrum(sensor_id, capture_seq,
+                                                              &num_bins, &bin_width_hz);
+    if (!stats || !envelope) {
+        return false;
+    }
+
+    const char *component = bearing_type ? bearing_type : "Bearing";
+
+    /* A bearing model classifies the envelope spectrum, the same feature the heuristic uses */
+    if (find_model_by_type(TINYML_MODEL_BEARING_FAULT) >= 0) {
+        tinyml_inference_request_t request = {
+            .model_type = TINYML_MODEL_BEARING_FAULT,
+            .input_data = envelope,
+            .input_size = (uint32_t)num_bins * sizeof(float),
+            .timestamp = engine_get_time_ms()
+        };
+
+        tinyml_inference_result_t inference_result;
+        float output_buffer[10];
+        inference_result.output_data = output_buffer;
+        inference_result.output_size = sizeof(output_buffer);
+        inference_result.output_data_type = TINYML_DATA_TYPE_FLOAT32;
+
+        if (tinyml_perform_inference(&request, &inference_result) && inference_result.success) {
+            result->anomaly_type = ANOMALY_TYPE_COLLECTIVE;
+            result->anomaly_score = inference_result.anomaly_score;
+            result->confidence_level = inference_result.confidence_score;
+            result->detection_timestamp = engine_get_time_ms();
+            strcpy(result->anomaly_description, "Bearing fault detected by ML model");
+            strcpy(result->recommended_action, "Plan bearing inspection and lubrication check");
+            result->severity_level = (result->anomaly_score > 90.0f) ? 3 : 2;
+            strncpy(result->affected_component, component, sizeof(result->affected_component) - 1);
+            result->affected_component[sizeof(result->affected_component) - 1] = '\0';
+            return true;
+        }
+    }
+
+    /* Defects cause impulsive vibration (high kurtosis) repeating at the defect rate (envelope peak) */
+    uint16_t peak_bin;
+    float prominence = find_spectral_peak(envelope, num_bins, &peak_bin);
+
+    float kurtosis_score = fminf(fmaxf((stats->kurtosis - BEARING_KURTOSIS_ONSET) /
+                                       BEARING_KURTOSIS_SPAN, 0.0f), 1.0f);
+    float prominence_score = fminf(fmaxf((prominence - BEARING_PROMINENCE_ONSET) /
+                                         BEARING_PROMINENCE_SPAN, 0.0f), 1.0f);
+    bool impulsive = stats->kurtosis > BEARING_KURTOSIS_ONSET;
+    bool periodic = prominence > BEARING_PROMINENCE_ONSET;
+
+    result->anomaly_type = ANOMALY_TYPE_COLLECTIVE;
+    result->anomaly_score = 50.0f * (kurtosis_score + prominence_score);
+    result->confidence_level = (impulsive == periodic) ? 85.0f : 60.0f;
+    result->detection_timestamp = engine_get_time_ms();
+    result->severity_level = (impulsive && periodic) ? 3 : ((impulsive || periodic) ? 2 : 1);
+
+    if (impulsive || periodic) {
+        if (bin_width_hz > 0.0f) {
+            snprintf(result->anomaly_description, sizeof(result->anomaly_description),
+                     "Bearing defect signature at %.1f Hz (kurtosis %.1f)",
+                     (double)((float)peak_bin * bin_width_hz), (double)stats->kurtosis);
+        } else {
+            snprintf(result->anomaly_description, sizeof(result->anomaly_description),
+                     "Bearing defect signature at envelope bin %u (kurtosis %.1f)",
+                     (unsigned)peak_bin, (double)stats->kurtosis);
+        }
+        strcpy(result->recommended_action, "Plan bearing inspection and lubrication check");
+    } else {
+        strcpy(result->anomaly_description, "No bearing defect signature");
+        strcpy(result->recommended_action, "No action required");
+    }
+    strncpy(result->affected_component, component, sizeof(result->affected_component) - 1);
+    result->affected_component[sizeof(result->affected_component) - 1] = '\0';
+
+    return true;
+}
+
+/**
+ * @brief Analyze gear mesh patterns
+ */
+bool tinyml_analyze_gear_mesh(const float *vibration_data, uint32_t data_length,
+                             float gear_ratio, tinyml_inference_result_t *result) {
+    if (!vibration_data || !result || data_length == 0 || gear_ratio <= 1.0f) {
+        return false;
+    }
+
+    uint8_t sensor_id;
+    uint32_t capture_seq;
+    if (!acquire_capture_features(vibration_data, data_length, 0, &sensor_id, &capture_seq)) {
+        return false;
+    }
+
+    uint16_t num_bins;
+    float bin_width_hz;
+    const float *spectrum = dsp_feature_get_spectrum(sensor_id, capture_seq, &num_bins, &bin_width_hz);
+    if (!spectrum) {
+        return false;
+    }
+
+    /* Take the dominant tone as the mesh frequency; the gear ratio places the
+     * shaft-rate sidebands that wear and tooth damage modulate onto it */
+    uint16_t mesh_bin;
+    find_spectral_peak(spectrum, num_bins, &mesh_bin);
+    float carrier_amplitude = spectrum[mesh_bin];
+    float spacing_bins = (float)mesh_bin / gear_ratio;
+
+    uint16_t lower_bin = (uint16_t)((float)mesh_bin - spacing_bins + 0.5f);
+    uint16_t upper_bin = (uint16_t)((float)mesh_bin + spacing_bins + 0.5f);
+    float sideband_amplitude = 0.0f;
+    if (spacing_bins >= 1.0f) {
+        sideband_amplitude = spectrum[lower_bin];
+        if (upper_bin < num_bins) {
+            sideband_amplitude = 0.5f * (sideband_amplitude + spectrum[upper_bin]);
+        }
+    }
+
+    float modulation_index = (carrier_amplitude > 0.0f) ? sideband_amplitude / carrier_amplitude : 0.0f;
+
+    /* Output: mesh frequency (Hz, or bin if rate unknown), mesh amplitude, modulation index */
+    float *output = (float *)result->output_data;
+    if (output && result->output_size >= 3 * sizeof(float)) {
+        output[0] = (bin_width_hz > 0.0f) ? (float)mesh_bin * bin_width_hz : (float)mesh_bin;
+        output[1] = carrier_amplitude;
+        output[2] = modulation_index;
+        result->output_size = 3 * sizeof(float);
+        result->output_data_type = TINYML_DATA_TYPE_FLOAT32;
+    }
+
+    result->model_type = TINYML_MODEL_GEAR_ANALYSIS;
+    result->confidence_score = fminf(modulation_index / GEAR_SIDEBAND_FAULT_RATIO, 1.0f) * 100.0f;
+    result->inference_time_ms = 0;
+    result->timestamp = engine_get_time_ms();
+    result->success = true;
+    result->error_message[0] = '\0';
+
+    return true;
+}
+
+/**
+ * @brief Classify acoustic patterns
  */
 bool tinyml_classify_acoustic_pattern(const int16_t *audio_data, uint32_t data_length,
                                      uint32_t sampling_rate_hz, tinyml_inference_result_t *result) {
@@ -633,16 +1446,47 @@ bool tinyml_classify_acoustic_pattern(const int16_t *audio_data, uint32_t data_l
         return false;
     }
 
-    /* Try ML model first */
+    /* Models classify the log-mel/MFCC map laid out as their [1, frames, coefficients] input */
     int8_t slot = find_model_by_type(TINYML_MODEL_ACOUSTIC_CLASSIFIER);
     if (slot >= 0) {
-        /* Use ML model for acoustic classification */
-        tinyml_inference_request_t request = {
-            .model_type = TINYML_MODEL_ACOUSTIC_CLASSIFIER,
-            .input_data = audio_data,
-            .input_size = data_length * sizeof(int16_t),
-            .timestamp = 0 /* TODO: Current timestamp */
-        };
+        const tinyml_model_info_t *info = &models[slot].info;
+        uint32_t num_frames = info->input_shape[1];
+        uint32_t num_coeffs = info->input_shape[2];
+        if (models[slot].is_ensemble || num_frames == 0 || num_frames > DSP_MEL_MAX_FRAMES ||
+            num_coeffs != (acoustic_num_mfcc ? acoustic_num_mfcc : num_coeffs) ||
+            num_coeffs == 0 || num_coeffs > DSP_MEL_MAX_BANDS) {
+            result->success = false;
+            strcpy(result->error_message, "Model input is not a feature map");
+            return false;
+        }
+
+        dsp_mel_config_t config;
+        dsp_mel_default_config(&config, sampling_rate_hz);
+        config.num_bands = acoustic_num_mfcc ? acoustic_num_bands : (uint8_t)num_coeffs;
+        config.num_mfcc = acoustic_num_mfcc;
+        config.num_frames = (uint8_t)num_frames;
+        config.output_scale = info->quantization_scale;
+        config.output_zero_point = info->quantization_zero_point;
+        if (!acoustic_frontend_configure(&config)) {
+            result->success = false;
+            strcpy(result->error_message, "Invalid feature configuration");
+            return false;
+        }
+
+        dsp_mel_process(&acoustic_frontend, audio_data, data_length);
+        if (!dsp_mel_get_feature_map(&acoustic_frontend, acoustic_features, sizeof(acoustic_features))) {
+            result->success = false;
+            strcpy(result->error_message, "Feature map incomplete");
+            return false;
+        }
+
+        tinyml_inference_request_t request;
+        memset(&request, 0, sizeof(request));
+        request.model_type = TINYML_MODEL_ACOUSTIC_CLASSIFIER;
+        request.input_data = acoustic_features;
+        request.input_size = num_frames * num_coeffs;
+        request.input_data_type = TINYML_DATA_TYPE_INT8;
+        request.timestamp = engine_get_time_ms();
 
         return tinyml_perform_inference(&request, result);
     }
@@ -651,6 +1495,19 @@ bool tinyml_classify_acoustic_pattern(const int16_t *audio_data, uint32_t data_l
     return classify_acoustic_pattern_basic(audio_data, data_length, sampling_rate_hz, result);
 }
 
+/**
+ * @brief Select log-mel or MFCC features for the acoustic classifier
+ */
+bool tinyml_set_acoustic_features(uint8_t num_bands, uint8_t num_mfcc) {
+    if (num_mfcc > DSP_MEL_MAX_MFCC || (num_mfcc && (num_bands < num_mfcc || num_bands > DSP_MEL_MAX_BANDS))) {
+        return false;
+    }
+
+    acoustic_num_bands = num_mfcc ? num_bands : DSP_MEL_MAX_BANDS;
+    acoustic_num_mfcc = num_mfcc;
+    return true;
+}
+
 /**
  * @brief Analyze motor current
  */
@@ -700,6 +1557,11 @@ bool tinyml_get_performance_stats(tinyml_performance_stats_t *stats) {
         return false;
     }
 
+    /* Share of wall time spent in inference since the statistics were cleared */
+    uint32_t elapsed_ms = engine_get_time_ms() - stats_start_ms;
+    performance_stats.cpu_utilization_percent = (elapsed_ms > 0) ?
+        fminf(inference_busy_ms * 100.0f / (float)elapsed_ms, 100.0f) : 0.0f;
+
     memcpy(stats, &performance_stats, sizeof(tinyml_performance_stats_t));
     return true;
 }
@@ -709,29 +1571,877 @@ bool tinyml_get_performance_stats(tinyml_performance_stats_t *stats) {
  */
 bool tinyml_clear_performance_stats(void) {
     memset(&performance_stats, 0, sizeof(tinyml_performance_stats_t));
+    inference_busy_ms = 0.0f;
+    stats_start_ms = engine_get_time_ms();
+    for (uint8_t i = 0; i < TINYML_PROFILER_MAX_MODELS; i++) {
+        if (profiles[i].in_use) {
+            int8_t slot = find_model_by_type(profiles[i].model_type);
+            tinyml_profiler_reset(&profiles[i].profile,
+                                  (slot >= 0 && !models[slot].is_ensemble) ? &models[slot].model : NULL);
+        }
+    }
+    for (uint8_t i = 0; i < TINYML_MAX_MODELS; i++) {
+        cascades[i].gate_time_ms = 0.0f;
+        cascades[i].model_time_ms = 0.0f;
+    }
+    return true;
+}
+
+/**
+ * @brief Get TinyML engine memory usage
+ */
+bool tinyml_get_memory_usage(uint32_t *used_memory_kb, uint32_t *available_memory_kb) {
+    if (!used_memory_kb || !available_memory_kb) {
+        return false;
+    }
+
+    uint32_t arena_high_water = get_arena_high_water();
+
+    *used_memory_kb = (arena_high_water + 1023U) / 1024U;
+    *available_memory_kb = (engine_config.tensor_arena_size - arena_high_water) / 1024U;
+    return true;
+}
+
+/**
+ * @brief Queue an inference request with the scheduler
+ */
+bool tinyml_submit_inference(const tinyml_inference_request_t *request,
+                             tinyml_inference_result_t *result) {
+    if (!request || !result || request->model_type >= TINYML_MAX_MODELS) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < TINYML_MAX_QUEUE_DEPTH; i++) {
+        if (inference_queue[i].in_use) {
+            continue;
+        }
+
+        uint32_t now = engine_get_time_ms();
+        inference_queue[i].request = request;
+        inference_queue[i].result = result;
+        inference_queue[i].submit_time_ms = now;
+        inference_queue[i].deadline_time_ms = now +
+            (request->deadline_ms ? request->deadline_ms : TINYML_DEFAULT_DEADLINE_MS);
+        inference_queue[i].priority = request->priority ? request->priority :
+                                      model_priority[request->model_type];
+        inference_queue[i].safety = is_safety_model(request->model_type);
+        inference_queue[i].in_use = true;
+        queue_count++;
+
+        result->success = false;
+        result->error_message[0] = '\0';
+        return true;
+    }
+
+    return false; /* Queue full */
+}
+
+/**
+ * @brief Dispatch the most urgent queued request and its batch
+ */
+uint32_t tinyml_process_queue(void) {
+    int8_t head = find_next_queue_entry(false, TINYML_MODEL_VIBRATION_ANOMALY, 0);
+    if (head < 0) {
+        return 0;
+    }
+
+    /* The head's entry is released when it runs, so keep its batch key */
+    tinyml_model_type_t batch_model = inference_queue[head].request->model_type;
+    uint32_t batch_input_type = inference_queue[head].request->input_data_type;
+    bool batch_safety = inference_queue[head].safety;
+    uint32_t completed = 0;
+
+    dispatch_queue_entry((uint8_t)head);
+    completed++;
+
+    /* Compatible requests run back to back so the weights stay hot in the
+     * flash accelerator cache, unless an anomaly detector is now waiting */
+    while (completed < TINYML_MAX_BATCH_SIZE) {
+        int8_t urgent = find_next_queue_entry(false, TINYML_MODEL_VIBRATION_ANOMALY, 0);
+        if (urgent < 0 || (inference_queue[urgent].safety && !batch_safety)) {
+            break;
+        }
+
+        int8_t next = find_next_queue_entry(true, batch_model, batch_input_type);
+        if (next < 0) {
+            break;
+        }
+
+        dispatch_queue_entry((uint8_t)next);
+        completed++;
+    }
+
+    return completed;
+}
+
+/**
+ * @brief Set inference priority for model
+ */
+bool tinyml_set_model_priority(tinyml_model_type_t model_type, uint8_t priority) {
+    if (model_type >= TINYML_MAX_MODELS) {
+        return false;
+    }
+
+    model_priority[model_type] = priority;
+
+    int8_t slot = find_model_by_type(model_type);
+    if (slot >= 0) {
+        models[slot].info.priority = priority;
+    }
+    return true;
+}
+
+/**
+ * @brief Perform batch inference on multiple data samples
+ */
+bool tinyml_batch_inference(const tinyml_inference_request_t *requests, uint32_t num_requests,
+                            tinyml_inference_result_t *results) {
+    if (!requests || !results || num_requests == 0) {
+        return false;
+    }
+
+    uint32_t submitted = 0;
+    bool all_ok = true;
+
+    while (submitted < num_requests || queue_count > 0) {
+        /* Top the queue up, then let the scheduler pick the order */
+        while (submitted < num_requests && tinyml_submit_inference(&requests[submitted],
+                                                                   &results[submitted])) {
+            submitted++;
+        }
+
+        bool pending = false;
+        for (uint8_t i = 0; i < TINYML_MAX_QUEUE_DEPTH; i++) {
+            if (inference_queue[i].in_use && inference_queue[i].request >= requests &&
+                inference_queue[i].request < &requests[num_requests]) {
+                pending = true;
+                break;
+            }
+        }
+        if (!pending && submitted == num_requests) {
+            break;
+        }
+
+        if (tinyml_process_queue() == 0) {
+            return false; /* Queue full of foreign entries that cannot run */
+        }
+    }
+
+    for (uint32_t i = 0; i < num_requests; i++) {
+        all_ok = all_ok && results[i].success;
+    }
+    return all_ok;
+}
+
+/**
+ * @brief Get inference queue status
+ */
+bool tinyml_get_queue_status(uint32_t *queued_requests, uint32_t *processing_requests,
+                             uint32_t *completed_requests) {
+    if (!queued_requests || !processing_requests || !completed_requests) {
+        return false;
+    }
+
+    *queued_requests = queue_count;
+    *processing_requests = queue_processing;
+    *completed_requests = queue_completed;
+    return true;
+}
+
+/* ============================================================================
+ * Inference Cascades
+ * ============================================================================ */
+
+/**
+ * @brief Run a model stage on a capture
+ *
+ * @param model_type Model type
+ * @param samples Capture samples
+ * @param num_samples Number of samples
+ * @param sample_rate_hz Capture sample rate in Hz
+ * @param result Pointer to anomaly result structure
+ * @return true if the model produced a score, false otherwise
+ */
+static bool run_capture_model(tinyml_model_type_t model_type, const float *samples,
+                              uint16_t num_samples, uint32_t sample_rate_hz,
+                              anomaly_detection_result_t *result) {
+    switch (model_type) {
+        case TINYML_MODEL_VIBRATION_ANOMALY:
+            return tinyml_detect_vibration_anomaly(samples, num_samples, sample_rate_hz, result);
+        case TINYML_MODEL_BEARING_FAULT:
+            return tinyml_detect_bearing_fault(samples, num_samples, NULL, result);
+        default:
+            break;
+    }
+
+    /* Other models score the capture through their (calibrated) anomaly score */
+    int8_t slot = find_model_by_type(model_type);
+    if (slot < 0) {
+        return false;
+    }
+
+    tinyml_inference_request_t request;
+    memset(&request, 0, sizeof(request));
+    request.model_type = model_type;
+    request.input_data = samples;
+    request.input_size = (uint32_t)num_samples * sizeof(float);
+    request.timestamp = engine_get_time_ms();
+
+    tinyml_inference_result_t inference_result;
+    float output_buffer[10];
+    inference_result.output_data = output_buffer;
+    inference_result.output_size = sizeof(output_buffer);
+    inference_result.output_data_type = TINYML_DATA_TYPE_FLOAT32;
+
+    if (!tinyml_perform_inference(&request, &inference_result) || !inference_result.success) {
+        return false;
+    }
+
+    result->anomaly_type = ANOMALY_TYPE_POINT;
+    result->anomaly_score = inference_result.anomaly_score;
+    result->confidence_level = inference_result.confidence_score;
+    result->detection_timestamp = engine_get_time_ms();
+    snprintf(result->anomaly_description, sizeof(result->anomaly_description),
+             "%s score %.1f", models[slot].info.model_name, (double)inference_result.anomaly_score);
+    strcpy(result->recommended_action, "Review model output");
+    result->severity_level = (result->anomaly_score > 90.0f) ? 3 : 2;
+    strncpy(result->affected_component, models[slot].info.model_name,
+            sizeof(result->affected_component) - 1);
+    result->affected_component[sizeof(result->affected_component) - 1] = '\0';
+    return true;
+}
+
+/**
+ * @brief Convert backend ticks to milliseconds
+ */
+static float ticks_to_ms(uint32_t ticks) {
+    return (float)ticks / (float)BACKEND_TICKS_PER_MS;
+}
+
+/**
+ * @brief Score a capture with a cascade's statistical gate
+ *
+ * @param model_type Gated model type
+ * @param samples Capture samples
+ * @param num_samples Number of samples
+ * @param sample_rate_hz Capture sample rate in Hz
+ * @param score Pointer to store gate score (0-100)
+ * @return true if the capture was scored, false otherwise
+ */
+static bool cascade_statistical_gate(tinyml_model_type_t model_type, const float *samples,
+                                     uint16_t num_samples, uint32_t sample_rate_hz, float *score) {
+    uint8_t sensor_id;
+    uint32_t capture_seq;
+    float features[ANOMALY_FEATURE_COUNT];
+
+    /* The features are cached, so a model passed the capture reuses them */
+    if (!acquire_capture_features(samples, num_samples, sample_rate_hz, &sensor_id, &capture_seq) ||
+        !anomaly_baseline_extract_features(dsp_feature_get_stats(sensor_id, capture_seq), features)) {
+        return false;
+    }
+
+    float max_z = 0.0f;
+    for (uint8_t i = 0; i < ANOMALY_FEATURE_COUNT; i++) {
+        float z = fabsf(dsp_ewma_z_score(&cascades[model_type].baseline[i], features[i]));
+        if (z > max_z) {
+            max_z = z;
+        }
+        dsp_ewma_update(&cascades[model_type].baseline[i], features[i]);
+    }
+
+    /* Pass everything until the baselines have seen enough captures */
+    if (cascades[model_type].blocks_seen < ANOMALY_BASELINE_MIN_BLOCKS) {
+        cascades[model_type].blocks_seen++;
+        *score = 100.0f;
+        return true;
+    }
+
+    *score = erff(max_z * 0.70710678f) * 100.0f;
+    return true;
+}
+
+/**
+ * @brief Score a capture with a cascade's gate model
+ *
+ * @param gate_model Gate model type
+ * @param samples Capture samples
+ * @param num_samples Number of samples
+ * @param score Pointer to store gate score (0-100)
+ * @return true if the capture was scored, false otherwise
+ */
+static bool cascade_model_gate(tinyml_model_type_t gate_model, const float *samples,
+                               uint16_t num_samples, float *score) {
+    tinyml_inference_request_t request;
+    memset(&request, 0, sizeof(request));
+    request.model_type = gate_model;
+    request.input_data = samples;
+    request.input_size = (uint32_t)num_samples * sizeof(float);
+    request.input_data_type = TINYML_DATA_TYPE_FLOAT32;
+    request.timestamp = engine_get_time_ms();
+
+    tinyml_inference_result_t inference_result;
+    float output_buffer[TINYML_MAX_OUTPUT_SIZE];
+    memset(&inference_result, 0, sizeof(inference_result));
+    inference_result.output_data = output_buffer;
+    inference_result.output_size = sizeof(output_buffer);
+
+    if (!tinyml_perform_inference(&request, &inference_result) || !inference_result.success ||
+        inference_result.output_size < sizeof(float)) {
+        return false;
+    }
+
+    float abnormal = output_buffer[inference_result.output_size / sizeof(float) - 1];
+    *score = fminf(fmaxf(abnormal, 0.0f), 1.0f) * 100.0f;
+    return true;
+}
+
+/**
+ * @brief Refresh the published statistics of a cascade
+ *
+ * @param model_type Gated model type
+ */
+static void cascade_update_stats(tinyml_model_type_t model_type) {
+    tinyml_cascade_stats_t *stats = &performance_stats.cascade_stats[model_type];
+
+    stats->gate_hit_rate_percent = (stats->gate_runs > 0) ?
+        100.0f * (float)stats->gate_passes / (float)stats->gate_runs : 0.0f;
+    stats->gate_average_time_ms = (stats->gate_runs > 0) ?
+        cascades[model_type].gate_time_ms / (float)stats->gate_runs : 0.0f;
+    stats->model_hit_rate_percent = (stats->model_runs > 0) ?
+        100.0f * (float)stats->model_detections / (float)stats->model_runs : 0.0f;
+    stats->model_average_time_ms = (stats->model_runs > 0) ?
+        cascades[model_type].model_time_ms / (float)stats->model_runs : 0.0f;
+
+    /* Compare with running the model on every screened capture */
+    float ungated_ms = stats->model_average_time_ms * (float)stats->gate_runs;
+    float gated_ms = cascades[model_type].gate_time_ms + cascades[model_type].model_time_ms;
+    stats->cpu_saved_percent = (ungated_ms > 0.0f) ? 100.0f * (1.0f - gated_ms / ungated_ms) : 0.0f;
+
+    float total_ungated_ms = 0.0f;
+    float total_gated_ms = 0.0f;
+    for (uint8_t i = 0; i < TINYML_MAX_MODELS; i++) {
+        const tinyml_cascade_stats_t *other = &performance_stats.cascade_stats[i];
+        if (other->model_runs == 0) {
+            continue;
+        }
+        total_ungated_ms += other->model_average_time_ms * (float)other->gate_runs;
+        total_gated_ms += cascades[i].gate_time_ms + cascades[i].model_time_ms;
+    }
+    performance_stats.cascade_cpu_saved_percent = (total_ungated_ms > 0.0f) ?
+        100.0f * (1.0f - total_gated_ms / total_ungated_ms) : 0.0f;
+}
+
+/**
+ * @brief Gate a model behind a cheap first stage
+ */
+bool tinyml_configure_cascade(tinyml_model_type_t model_type, const tinyml_cascade_config_t *config) {
+    if (model_type >= TINYML_MAX_MODELS || !config || config->gate_type > TINYML_GATE_MODEL ||
+        config->threshold < 0.0f || config->threshold > 100.0f) {
+        return false;
+    }
+
+    /* A gate model must be another, ungated model */
+    if (config->gate_type == TINYML_GATE_MODEL &&
+        (config->gate_model >= TINYML_MAX_MODELS || config->gate_model == model_type ||
+         cascades[config->gate_model].config.gate_type != TINYML_GATE_NONE)) {
+        return false;
+    }
+
+    memset(&cascades[model_type], 0, sizeof(cascades[model_type]));
+    cascades[model_type].config = *config;
+    for (uint8_t i = 0; i < ANOMALY_FEATURE_COUNT; i++) {
+        dsp_ewma_init(&cascades[model_type].baseline[i], ANOMALY_BASELINE_EWMA_ALPHA);
+    }
+    memset(&performance_stats.cascade_stats[model_type], 0, sizeof(tinyml_cascade_stats_t));
+    cascade_update_stats(model_type);
+    return true;
+}
+
+/**
+ * @brief Analyze a capture through a model's cascade
+ */
+bool tinyml_run_cascade(tinyml_model_type_t model_type, const float *samples, uint16_t num_samples,
+                        uint32_t sample_rate_hz, anomaly_detection_result_t *result) {
+    if (model_type >= TINYML_MAX_MODELS || !samples || num_samples == 0 || !result) {
+        return false;
+    }
+
+    const tinyml_cascade_config_t *config = &cascades[model_type].config;
+    if (config->gate_type == TINYML_GATE_NONE) {
+        return run_capture_model(model_type, samples, num_samples, sample_rate_hz, result);
+    }
+
+    tinyml_cascade_stats_t *stats = &performance_stats.cascade_stats[model_type];
+    float gate_score = 0.0f;
+    bool gated;
+
+    /* Stage 1: the gate; a failed gate passes the capture rather than hiding it */
+    uint32_t start = backend_get_ticks();
+    if (config->gate_type == TINYML_GATE_STATISTICAL) {
+        gated = cascade_statistical_gate(model_type, samples, num_samples, sample_rate_hz, &gate_score);
+    } else {
+        gated = cascade_model_gate(config->gate_model, samples, num_samples, &gate_score);
+    }
+    cascades[model_type].gate_time_ms += ticks_to_ms(backend_get_ticks() - start);
+    stats->gate_runs++;
+
+    if (gated && gate_score < config->threshold) {
+        memset(result, 0, sizeof(anomaly_detection_result_t));
+        result->anomaly_type = ANOMALY_TYPE_POINT;
+        result->confidence_level = 100.0f - gate_score;
+        result->detection_timestamp = engine_get_time_ms();
+        snprintf(result->anomaly_description, sizeof(result->anomaly_description),
+                 "Screened by cascade gate (score %.1f)", (double)gate_score);
+        strcpy(result->recommended_action, "Continue normal operation");
+        result->severity_level = 1;
+        cascade_update_stats(model_type);
+        return true;
+    }
+
+    /* Stage 2: the model */
+    stats->gate_passes++;
+    start = backend_get_ticks();
+    bool analyzed = run_capture_model(model_type, samples, num_samples, sample_rate_hz, result);
+    cascades[model_type].model_time_ms += ticks_to_ms(backend_get_ticks() - start);
+    stats->model_runs++;
+    if (analyzed && result->anomaly_score >= anomaly_thresholds[model_type]) {
+        stats->model_detections++;
+    }
+
+    cascade_update_stats(model_type);
+    return analyzed;
+}
+
+/* ============================================================================
+ * Continuous Monitoring
+ * ============================================================================ */
+
+#define MONITOR_HEALTHY_FRACTION      0.5f    /* Scores below this share of threshold slow the cadence */
+#define MONITOR_CLEAR_FRACTION        0.8f    /* Scores below this share of threshold clear an alarm */
+
+/**
+ * @brief Interval multiplier for the current power budget
+ *
+ * @return 1 with ample power, 2 below a quarter of the budget free, 4 below a tenth
+ */
+static uint32_t monitor_power_factor(void) {
+    uint32_t available_mw;
+    uint32_t allocated_mw;
+
+    if (!esocore_power_get_budget(&available_mw, &allocated_mw, NULL)) {
+        return 1;
+    }
+
+    uint32_t total_mw = available_mw + allocated_mw;
+    if (total_mw == 0 || available_mw * 4 >= total_mw) {
+        return 1;
+    }
+    return (available_mw * 10 < total_mw) ? 4 : 2;
+}
+
+/**
+ * @brief Raise callbacks and events on threshold crossings and adapt the interval
+ *
+ * @param model_type Model type
+ * @param result Anomaly result of the run
+ */
+static void monitor_handle_result(tinyml_model_type_t model_type, const anomaly_detection_result_t *result) {
+    float threshold = anomaly_thresholds[model_type];
+    float score = result->anomaly_score;
+    uint32_t base = monitors[model_type].base_interval_ms;
+    uint32_t interval = monitors[model_type].activity_interval_ms;
+
+    monitors[model_type].last_score = score;
+
+    if (score >= threshold) {
+        if (!monitors[model_type].above_threshold) {
+            monitors[model_type].above_threshold = true;
+            if (anomaly_callback) {
+                anomaly_callback(result);
+            }
+            esocore_event_log_message(ESOCORE_EVENT_DIAG_MAINTENANCE,
+                                      (result->severity_level >= 3) ? ESOCORE_EVENT_SEVERITY_CRITICAL :
+                                                                      ESOCORE_EVENT_SEVERITY_WARNING,
+                                      result->anomaly_description, NULL, 0);
+        }
+
+        /* Look closer while something is wrong */
+        interval = base / TINYML_MONITOR_FAST_DIVISOR;
+        if (interval < TINYML_MONITOR_MIN_INTERVAL_MS) {
+            interval = TINYML_MONITOR_MIN_INTERVAL_MS;
+        }
+    } else {
+        if (monitors[model_type].above_threshold && score < threshold * MONITOR_CLEAR_FRACTION) {
+            monitors[model_type].above_threshold = false;
+            esocore_event_log_message(ESOCORE_EVENT_DIAG_HEALTH_CHECK, ESOCORE_EVENT_SEVERITY_INFO,
+                                      "Anomaly cleared", NULL, 0);
+        }
+
+        if (score < threshold * MONITOR_HEALTHY_FRACTION) {
+            /* Back off gradually while healthy */
+            interval += interval / 2;
+            if (interval > base * TINYML_MONITOR_SLOW_FACTOR) {
+                interval = base * TINYML_MONITOR_SLOW_FACTOR;
+            }
+        } else if (interval < base || !monitors[model_type].above_threshold) {
+            interval = base;
+        }
+    }
+
+    monitors[model_type].activity_interval_ms = interval;
+}
+
+/**
+ * @brief Set anomaly detection threshold
+ */
+bool tinyml_set_anomaly_threshold(tinyml_model_type_t model_type, float threshold) {
+    if (model_type >= TINYML_MAX_MODELS || threshold < 0.0f || threshold > 100.0f) {
+        return false;
+    }
+
+    anomaly_thresholds[model_type] = threshold;
+    return true;
+}
+
+/**
+ * @brief Get anomaly detection threshold
+ */
+bool tinyml_get_anomaly_threshold(tinyml_model_type_t model_type, float *threshold) {
+    if (model_type >= TINYML_MAX_MODELS || !threshold) {
+        return false;
+    }
+
+    *threshold = anomaly_thresholds[model_type];
+    return true;
+}
+
+/**
+ * @brief Enable/disable continuous monitoring mode
+ */
+bool tinyml_enable_continuous_monitoring(tinyml_model_type_t model_type, bool enable,
+                                        uint32_t interval_ms) {
+    if (model_type >= TINYML_MAX_MODELS || engine_status == TINYML_STATUS_UNINITIALIZED) {
+        return false;
+    }
+
+    if (!enable) {
+        monitors[model_type].enabled = false;
+        return true;
+    }
+
+    if (interval_ms < TINYML_MONITOR_MIN_INTERVAL_MS || interval_ms > TINYML_MONITOR_MAX_INTERVAL_MS) {
+        return false;
+    }
+
+    monitors[model_type].enabled = true;
+    monitors[model_type].has_capture = false;
+    monitors[model_type].base_interval_ms = interval_ms;
+    monitors[model_type].activity_interval_ms = interval_ms;
+    monitors[model_type].effective_interval_ms = interval_ms;
+    monitors[model_type].next_run_ms = engine_get_time_ms();
+    monitors[model_type].last_score = 0.0f;
+    monitors[model_type].above_threshold = false;
+    return true;
+}
+
+/**
+ * @brief Select the sensor whose captures a monitored model analyzes
+ */
+bool tinyml_set_monitoring_source(tinyml_model_type_t model_type, uint8_t sensor_id) {
+    if (model_type >= TINYML_MAX_MODELS) {
+        return false;
+    }
+
+    monitors[model_type].source_set = true;
+    monitors[model_type].source_sensor = sensor_id;
+    monitors[model_type].has_capture = false;
+    return true;
+}
+
+/**
+ * @brief Run the continuous monitors that are due
+ */
+uint32_t tinyml_run_monitoring(void) {
+    uint32_t next_due_ms = UINT32_MAX;
+
+    if (engine_status == TINYML_STATUS_UNINITIALIZED) {
+        return next_due_ms;
+    }
+
+    uint32_t power_factor = monitor_power_factor();
+
+    for (uint8_t type = 0; type < TINYML_MAX_MODELS; type++) {
+        if (!monitors[type].enabled) {
+            continue;
+        }
+
+        uint32_t now = engine_get_time_ms();
+        if ((int32_t)(now - monitors[type].next_run_ms) >= 0) {
+            uint32_t capture_seq;
+            const float *samples;
+            uint16_t num_samples;
+            float sample_rate_hz;
+
+            /* Only new captures cost an inference */
+            if (monitors[type].source_set &&
+                dsp_feature_get_latest(monitors[type].source_sensor, &capture_seq) &&
+                (!monitors[type].has_capture || capture_seq != monitors[type].last_capture_seq) &&
+                dsp_feature_get_capture(monitors[type].source_sensor, capture_seq, &samples,
+                                        &num_samples, &sample_rate_hz)) {
+                anomaly_detection_result_t result;
+                memset(&result, 0, sizeof(result));
+
+                monitors[type].has_capture = true;
+                monitors[type].last_capture_seq = capture_seq;
+                if (tinyml_run_cascade((tinyml_model_type_t)type, samples, num_samples,
+                                       (uint32_t)sample_rate_hz, &result)) {
+                    monitor_handle_result((tinyml_model_type_t)type, &result);
+                }
+            }
+
+            /* Power savings never delay a model that is looking at an anomaly */
+            uint32_t interval = monitors[type].activity_interval_ms;
+            if (!monitors[type].above_threshold) {
+                interval *= power_factor;
+            }
+            monitors[type].effective_interval_ms = interval;
+            monitors[type].next_run_ms = now + interval;
+        }
+
+        uint32_t until_due = monitors[type].next_run_ms - now;
+        if ((int32_t)until_due < 0) {
+            until_due = 0;
+        }
+        if (until_due < next_due_ms) {
+            next_due_ms = until_due;
+        }
+    }
+
+    return next_due_ms;
+}
+
+/**
+ * @brief Get continuous monitoring status
+ */
+bool tinyml_get_monitoring_status(tinyml_model_type_t model_type, uint32_t *interval_ms,
+                                  float *last_score) {
+    if (model_type >= TINYML_MAX_MODELS || !monitors[model_type].enabled) {
+        return false;
+    }
+
+    if (interval_ms) {
+        *interval_ms = monitors[model_type].effective_interval_ms;
+    }
+    if (last_score) {
+        *last_score = monitors[model_type].last_score;
+    }
+    return true;
+}
+
+/**
+ * @brief Register anomaly detection callback
+ */
+bool tinyml_register_anomaly_callback(void (*callback)(const anomaly_detection_result_t *result)) {
+    if (!callback) {
+        return false;
+    }
+
+    anomaly_callback = callback;
+    return true;
+}
+
+/**
+ * @brief Unregister anomaly detection callback
+ */
+bool tinyml_unregister_anomaly_callback(void) {
+    anomaly_callback = NULL;
+    return true;
+}
+
+/* ============================================================================
+ * Profiling
+ * ============================================================================ */
+
+/**
+ * @brief Enable/disable per-layer profiling of a model
+ */
+bool tinyml_enable_profiling(tinyml_model_type_t model_type, bool enable) {
+    uint8_t i;
+
+    for (i = 0; i < TINYML_PROFILER_MAX_MODELS; i++) {
+        if (profiles[i].in_use && profiles[i].model_type == model_type) {
+            break;
+        }
+    }
+
+    if (!enable) {
+        if (i < TINYML_PROFILER_MAX_MODELS) {
+            profiles[i].in_use = false;
+        }
+        return true;
+    }
+
+    int8_t slot = find_model_by_type(model_type);
+    if (slot < 0) {
+        return false;
+    }
+
+    if (i == TINYML_PROFILER_MAX_MODELS) {
+        for (i = 0; i < TINYML_PROFILER_MAX_MODELS; i++) {
+            if (!profiles[i].in_use) {
+                break;
+            }
+        }
+        if (i == TINYML_PROFILER_MAX_MODELS) {
+            return false; /* All profiles in use */
+        }
+    }
+
+    profiles[i].in_use = true;
+    profiles[i].model_type = model_type;
+    return tinyml_profiler_reset(&profiles[i].profile,
+                                 models[slot].is_ensemble ? NULL : &models[slot].model);
+}
+
+/**
+ * @brief Export model performance metrics
+ */
+bool tinyml_export_metrics(tinyml_model_type_t model_type, char *metrics_buffer, uint16_t buffer_size) {
+    if (!metrics_buffer || buffer_size == 0) {
+        return false;
+    }
+
+    int8_t slot = find_model_by_type(model_type);
+    if (slot < 0) {
+        return false;
+    }
+
+    tinyml_performance_stats_t stats;
+    tinyml_get_performance_stats(&stats);
+
+    int length = snprintf(metrics_buffer, buffer_size,
+                          "{\"model\":%u,\"runs\":%lu,\"avg_ms\":%.2f,\"cpu\":%.1f,\"profile\":",
+                          (unsigned)model_type, (unsigned long)models[slot].info.usage_count,
+                          (double)models[slot].info.average_inference_time_ms,
+                          (double)stats.cpu_utilization_percent);
+    if (length < 0 || length >= buffer_size) {
+        return false;
+    }
+
+    const tinyml_model_profile_t *profile = find_profile(model_type);
+    if (profile) {
+        uint32_t timeout_ms = engine_config.inference_timeout_ms ?
+                              engine_config.inference_timeout_ms : TINYML_INFERENCE_TIMEOUT_MS;
+        if (!tinyml_profiler_export_json(profile, timeout_ms * BACKEND_TICKS_PER_MS,
+                                         &metrics_buffer[length], (uint16_t)(buffer_size - length))) {
+            return false;
+        }
+    } else if (length + 4 < buffer_size) {
+        strcpy(&metrics_buffer[length], "null");
+    } else {
+        return false;
+    }
+
+    length += (int)strlen(&metrics_buffer[length]);
+    if (length + 1 >= buffer_size) {
+        return false;
+    }
+    strcpy(&metrics_buffer[length], "}");
+    return true;
+}
+
+/**
+ * @brief Update model parameters
+ */
+bool tinyml_update_model_parameters(tinyml_model_type_t model_type,
+                                   const uint8_t *parameters, uint32_t param_size) {
+    if (param_size == 0) {
+        return tinyml_calibration_reset((uint8_t)model_type);
+    }
+
+    int8_t found = find_model_by_type(model_type);
+    if (found < 0 || !parameters || param_size != sizeof(tinyml_calibration_record_t)) {
+        return false;
+    }
+    uint8_t slot = (uint8_t)found;
+
+    /* Records are only valid for the exact blob they were learned on */
+    tinyml_calibration_record_t record;
+    memcpy(&record, parameters, sizeof(record));
+    uint32_t output_count = backend_get_output_size(slot, TINYML_DATA_TYPE_FLOAT32) / sizeof(float);
+    if (record.model_type != (uint8_t)model_type || record.num_dims != output_count ||
+        record.model_checksum != backend_get_model_checksum(slot)) {
+        return false;
+    }
+
+    return tinyml_calibration_set_record(&record);
+}
+
+/**
+ * @brief Calibrate model with reference data
+ */
+bool tinyml_calibrate_model(tinyml_model_type_t model_type,
+                           const float *reference_data, uint32_t data_length) {
+    int8_t found = find_model_by_type(model_type);
+    if (found < 0 || !reference_data) {
+        return false;
+    }
+    uint8_t slot = (uint8_t)found;
+
+    uint32_t input_count = models[slot].is_ensemble ? models[slot].ensemble.header->num_features :
+                                                      models[slot].model.tensor_size[0];
+    uint32_t output_count = backend_get_output_size(slot, TINYML_DATA_TYPE_FLOAT32) / sizeof(float);
+    if (data_length == 0 || data_length % input_count != 0 || output_count > TINYML_CALIBRATION_MAX_DIMS) {
+        return false;
+    }
+
+    uint32_t checksum = backend_get_model_checksum(slot);
+    float outputs[TINYML_CALIBRATION_MAX_DIMS];
+
+    for (uint32_t offset = 0; offset < data_length; offset += input_count) {
+        tinyml_inference_request_t request;
+        memset(&request, 0, sizeof(request));
+        request.model_type = model_type;
+        request.input_data = &reference_data[offset];
+        request.input_size = input_count * sizeof(float);
+        request.input_data_type = TINYML_DATA_TYPE_FLOAT32;
+        request.timestamp = engine_get_time_ms();
+
+        tinyml_inference_result_t inference_result;
+        inference_result.output_data = outputs;
+        inference_result.output_size = sizeof(outputs);
+        inference_result.output_data_type = TINYML_DATA_TYPE_FLOAT32;
+
+        if (!tinyml_perform_inference(&request, &inference_result) || !inference_result.success ||
+            !tinyml_calibration_add_frame((uint8_t)model_type, checksum, outputs, (uint8_t)output_count)) {
+            return false;
+        }
+    }
+
+    /* Too few frames yet: wait for further batches before fitting */
+    tinyml_calibration_status_t status;
+    tinyml_calibration_get_status((uint8_t)model_type, &status);
+    if (status.frames_collected < TINYML_CALIBRATION_MIN_FRAMES) {
+        return true;
+    }
+
+    if (!tinyml_calibration_commit((uint8_t)model_type)) {
+        return false;
+    }
+
+    char message[64];
+    snprintf(message, sizeof(message), "%s calibrated on %lu frames",
+             models[slot].info.model_name, (unsigned long)status.frames_collected);
+    esocore_event_log_message(ESOCORE_EVENT_DIAG_HEALTH_CHECK, ESOCORE_EVENT_SEVERITY_INFO, message, NULL, 0);
     return true;
 }
 
 /* Placeholder implementations for remaining functions */
-bool tinyml_detect_bearing_fault(const float *vibration_data, uint32_t data_length, const char *bearing_type, anomaly_detection_result_t *result) { return false; }
-bool tinyml_analyze_gear_mesh(const float *vibration_data, uint32_t data_length, float gear_ratio, tinyml_inference_result_t *result) { return false; }
 bool tinyml_detect_pump_cavitation(const float *vibration_data, const float *pressure_data, uint32_t data_length, anomaly_detection_result_t *result) { return false; }
-bool tinyml_update_model_parameters(tinyml_model_type_t model_type, const uint8_t *parameters, uint32_t param_size) { return false; }
-bool tinyml_calibrate_model(tinyml_model_type_t model_type, const float *reference_data, uint32_t data_length) { return false; }
 bool tinyml_get_model_health(tinyml_model_type_t model_type, float *health_score, uint32_t *issues) { return false; }
 bool tinyml_enable_model(tinyml_model_type_t model_type, bool enable) { return false; }
-bool tinyml_set_model_priority(tinyml_model_type_t model_type, uint8_t priority) { return false; }
 bool tinyml_get_supported_models(tinyml_model_type_t *supported_models, uint32_t max_models, uint32_t *num_models) { return false; }
-bool tinyml_batch_inference(const tinyml_inference_request_t *requests, uint32_t num_requests, tinyml_inference_result_t *results) { return false; }
-bool tinyml_get_queue_status(uint32_t *queued_requests, uint32_t *processing_requests, uint32_t *completed_requests) { return false; }
-bool tinyml_set_anomaly_threshold(tinyml_model_type_t model_type, float threshold) { return false; }
-bool tinyml_get_anomaly_threshold(tinyml_model_type_t model_type, float *threshold) { return false; }
-bool tinyml_enable_continuous_monitoring(tinyml_model_type_t model_type, bool enable, uint32_t interval_ms) { return false; }
-bool tinyml_register_anomaly_callback(void (*callback)(const anomaly_detection_result_t *result)) { return false; }
-bool tinyml_unregister_anomaly_callback(void) { return false; }
-bool tinyml_get_memory_usage(uint32_t *used_memory_kb, uint32_t *available_memory_kb) { return false; }
 bool tinyml_self_test(void) { return false; }
 bool tinyml_reset_engine(void) { return false; }
 bool tinyml_get_version(char *version_string, uint16_t buffer_size) { return false; }
 bool tinyml_set_debug_level(uint8_t level) { return false; }
-bool tinyml_export_metrics(tinyml_model_type_t model_type, char *metrics_buffer, uint16_t buffer_size) { return false; }
@@ -3,19 +3,20 @@
  * @brief TinyML Engine for EsoCore Edge Device
  *
  * This file implements the TinyML engine for the EsoCore Edge device, providing
- * on-device machine learning capabilities using TensorFlow Lite Micro.
+ * on-device machine learning capabilities using int8 quantized models.
  * The engine supports real-time anomaly detection, pattern recognition,
  * and predictive maintenance for industrial applications.
  *
  * Features:
- * - TensorFlow Lite Micro integration
+ * - Int8 quantized kernels with Cortex-M4 SIMD fast paths
+ * - Tree ensemble (boosted trees, random forest) evaluation on features
  * - Real-time inference with <100ms latency
  * - Multiple model support (vibration, acoustic, current analysis)
  * - Model management and updates (OTA model deployment)
  * - Anomaly detection algorithms
  * - Pattern recognition and classification
  * - Predictive maintenance algorithms
- * - Model performance monitoring
+ * - Model performance monitoring with per-layer cycle profiles
  * - Memory-efficient inference (<32KB RAM usage)
  *
  * @author EsoCore Development Team
@@ -39,10 +40,23 @@ extern "C" {
 
 #define TINYML_MAX_MODELS             8     /* Maximum number of models */
 #define TINYML_MAX_MODEL_SIZE         (64 * 1024) /* Maximum model size (64KB) */
-#define TINYML_TENSOR_ARENA_SIZE      (32 * 1024) /* Tensor arena size (32KB) */
+#define TINYML_TENSOR_ARENA_SIZE      (32 * 1024) /* Shared tensor arena size (32KB) */
 #define TINYML_MAX_INPUT_SIZE         1024  /* Maximum input data size */
 #define TINYML_MAX_OUTPUT_SIZE        256   /* Maximum output data size */
 #define TINYML_INFERENCE_TIMEOUT_MS   100   /* Inference timeout (100ms) */
+#define TINYML_INFERENCE_BUDGET_PERCENT 50  /* Share of the timeout a model may use */
+#define TINYML_MAX_QUEUE_DEPTH        (TINYML_MAX_MODELS * 2) /* Pending scheduled requests */
+#define TINYML_MAX_BATCH_SIZE         4     /* Same-model requests run back to back */
+#define TINYML_DEFAULT_DEADLINE_MS    1000  /* Relative deadline when a request sets none */
+#define TINYML_PRIORITY_SAFETY        200   /* Default priority of anomaly detectors */
+#define TINYML_PRIORITY_DEFAULT       100   /* Default priority of analysis models */
+#define TINYML_PRIORITY_BULK          20    /* Default priority of acoustic classification */
+#define TINYML_DEFAULT_ANOMALY_THRESHOLD 80.0f /* Score raising anomaly callbacks and events */
+#define TINYML_MONITOR_MIN_INTERVAL_MS 50   /* Fastest continuous monitoring cadence */
+#define TINYML_MONITOR_MAX_INTERVAL_MS 3600000UL /* Slowest base cadence (1 h) */
+#define TINYML_MONITOR_FAST_DIVISOR   4     /* Interval divisor while above threshold */
+#define TINYML_MONITOR_SLOW_FACTOR    4     /* Interval multiplier reached while healthy */
+#define TINYML_CASCADE_DEFAULT_THRESHOLD 95.0f /* Gate score passing a capture to the model */
 
 typedef enum {
     TINYML_MODEL_VIBRATION_ANOMALY  = 0,    /* Vibration anomaly detection */
@@ -63,6 +77,18 @@ typedef enum {
     TINYML_STATUS_UPDATING          = 4,    /* Model update in progress */
 } tinyml_engine_status_t;
 
+typedef enum {
+    TINYML_DATA_TYPE_UNSPECIFIED    = 0,    /* Inferred from buffer size */
+    TINYML_DATA_TYPE_FLOAT32        = 1,    /* 32-bit float */
+    TINYML_DATA_TYPE_INT8           = 9,    /* Quantized int8 */
+} tinyml_data_type_t;
+
+typedef enum {
+    TINYML_GATE_NONE                = 0,    /* Model runs on every capture */
+    TINYML_GATE_STATISTICAL         = 1,    /* Capture statistics against adaptive baselines */
+    TINYML_GATE_MODEL               = 2,    /* Small gate model; last output is P(abnormal) */
+} tinyml_gate_type_t;
+
 /* TinyML Engine Configuration */
 typedef struct {
     uint32_t tensor_arena_size;             /* Tensor arena size in bytes */
@@ -98,18 +124,34 @@ typedef struct {
     uint32_t usage_count;                  /* Number of inferences performed */
     float average_inference_time_ms;       /* Average inference time */
     float model_accuracy;                  /* Model accuracy (0-100) */
+    uint8_t priority;                      /* Scheduling priority (higher first) */
+    float average_queue_delay_ms;          /* Mean submit-to-dispatch delay */
+    uint32_t queue_dispatches;             /* Queue entries behind the mean delay */
+    uint32_t max_queue_delay_ms;           /* Worst submit-to-dispatch delay */
+    uint32_t deadline_misses;              /* Requests completed or dropped past deadline */
+    uint32_t dropped_requests;             /* Stale requests dropped without running */
+    bool is_calibrated;                    /* Scored against this machine's calibration */
 } tinyml_model_info_t;
 
+/* Cascade gating a model */
+typedef struct {
+    tinyml_gate_type_t gate_type;          /* Gate kind */
+    tinyml_model_type_t gate_model;        /* Gate model (TINYML_GATE_MODEL) */
+    float threshold;                       /* Gate score (0-100) passing a capture on */
+} tinyml_cascade_config_t;
+
 /* ============================================================================
  * Inference Data Structures
  * ============================================================================ */
 
 typedef struct {
     tinyml_model_type_t model_type;         /* Model to use for inference */
-    void *input_data;                      /* Input data buffer */
+    const void *input_data;                /* Input data buffer */
     uint32_t input_size;                   /* Input data size */
     uint32_t input_data_type;              /* Input data type */
     uint32_t timestamp;                    /* Inference timestamp */
+    uint32_t deadline_ms;                  /* Relative deadline (0 = TINYML_DEFAULT_DEADLINE_MS) */
+    uint8_t priority;                      /* Request priority (0 = model priority) */
     char context[64];                      /* Inference context information */
 } tinyml_inference_request_t;
 
@@ -119,6 +161,7 @@ typedef struct {
     uint32_t output_size;                  /* Output data size */
     uint32_t output_data_type;             /* Output data type */
     float confidence_score;                /* Confidence score (0-100) */
+    float anomaly_score;                   /* Calibrated anomaly score, else confidence (0-100) */
     uint32_t inference_time_ms;            /* Inference execution time */
     uint32_t timestamp;                    /* Inference completion timestamp */
     bool success;                          /* Inference success flag */
@@ -150,6 +193,19 @@ typedef struct {
  * Performance Monitoring
  * ============================================================================ */
 
+/* Cascade statistics of one gated model */
+typedef struct {
+    uint32_t gate_runs;                    /* Captures screened by the gate */
+    uint32_t gate_passes;                  /* Captures passed on to the model */
+    float gate_hit_rate_percent;           /* Share of screened captures passed on */
+    float gate_average_time_ms;            /* Mean gate time */
+    uint32_t model_runs;                   /* Model runs behind the gate */
+    uint32_t model_detections;             /* Model runs at or above the anomaly threshold */
+    float model_hit_rate_percent;          /* Share of model runs detecting an anomaly */
+    float model_average_time_ms;           /* Mean model time */
+    float cpu_saved_percent;               /* Time saved versus running the model on every capture */
+} tinyml_cascade_stats_t;
+
 typedef struct {
     uint32_t total_inferences;             /* Total inferences performed */
     uint32_t successful_inferences;        /* Successful inferences */
@@ -157,12 +213,14 @@ typedef struct {
     float average_inference_time_ms;       /* Average inference time */
     float min_inference_time_ms;           /* Minimum inference time */
     float max_inference_time_ms;           /* Maximum inference time */
-    uint32_t memory_usage_kb;              /* Current memory usage */
-    uint32_t peak_memory_usage_kb;         /* Peak memory usage */
+    uint32_t memory_usage_kb;              /* Arena in use by the last inference */
+    uint32_t peak_memory_usage_kb;         /* Peak arena usage of any inference */
     float model_accuracy;                  /* Model accuracy */
     uint32_t false_positives;              /* False positive detections */
     uint32_t false_negatives;              /* False negative detections */
     float cpu_utilization_percent;         /* CPU utilization during inference */
+    tinyml_cascade_stats_t cascade_stats[TINYML_MAX_MODELS]; /* Cascade statistics by gated model type */
+    float cascade_cpu_saved_percent;       /* Time saved by all cascades */
 } tinyml_performance_stats_t;
 
 /* ============================================================================
@@ -187,8 +245,17 @@ bool tinyml_engine_deinit(void);
 /**
  * @brief Load model into TinyML engine
  *
+ * The blob is executed in place: weights are read where they lie and only
+ * activations use the tensor arena. model_data must therefore stay valid
+ * and unchanged until the model is unloaded; internal or memory-mapped
+ * flash is the intended home (see tinyml_model_store.h).
+ *
+ * Besides int8 neural network blobs (tinyml_model.h), tree ensemble blobs
+ * (tinyml_trees.h) are accepted, typically as TINYML_MODEL_CUSTOM. They
+ * take float features, always produce float outputs and use no arena.
+ *
  * @param model_type Model type to load
- * @param model_data Pointer to model data
+ * @param model_data Pointer to model data (4-byte aligned)
  * @param model_size Model data size
  * @param model_info Pointer to model information structure
  * @return true if model loaded successfully, false otherwise
@@ -223,6 +290,30 @@ bool tinyml_get_model_info(tinyml_model_type_t model_type, tinyml_model_info_t *
 bool tinyml_perform_inference(const tinyml_inference_request_t *request,
                              tinyml_inference_result_t *result);
 
+/**
+ * @brief Queue an inference request with the scheduler
+ *
+ * Requests are referenced, not copied: request, its input buffer and result
+ * must stay valid until the result completes. Anomaly detectors are always
+ * dispatched before other models; within a class requests run by priority,
+ * then earliest deadline first.
+ *
+ * @param request Pointer to inference request
+ * @param result Pointer to result structure (output buffer set by caller)
+ * @return true if request queued successfully, false if queue full
+ */
+bool tinyml_submit_inference(const tinyml_inference_request_t *request,
+                             tinyml_inference_result_t *result);
+
+/**
+ * @brief Dispatch the most urgent queued request and its batch
+ *
+ * Stale requests are dropped, except anomaly detectors which still run late.
+ *
+ * @return Number of requests completed or dropped
+ */
+uint32_t tinyml_process_queue(void);
+
 /**
  * @brief Perform vibration anomaly detection
  *
@@ -238,15 +329,33 @@ bool tinyml_detect_vibration_anomaly(const float *vibration_data, uint32_t data_
 /**
  * @brief Perform acoustic pattern classification
  *
+ * With an acoustic classifier loaded, the audio is streamed through a
+ * log-mel (or MFCC, see tinyml_set_acoustic_features()) front-end whose
+ * int8 feature map matches the model's [1, frames, coefficients] input and
+ * quantization. Consecutive calls continue the same stream, so audio may be
+ * passed in blocks as it arrives; the model runs once a full map of
+ * frames is available. Without a model, the output is the mean log-mel
+ * spectrum of the clip.
+ *
  * @param audio_data Pointer to audio data
  * @param data_length Number of audio samples
- * @param sampling_rate_hz Audio sampling rate
+ * @param sampling_rate_hz Audio sampling rate (8-48 kHz)
  * @param result Pointer to classification result
- * @return true if classification successful, false otherwise
+ * @return true if classification successful, false otherwise (also while the feature map is incomplete)
  */
 bool tinyml_classify_acoustic_pattern(const int16_t *audio_data, uint32_t data_length,
                                      uint32_t sampling_rate_hz, tinyml_inference_result_t *result);
 
+/**
+ * @brief Select log-mel or MFCC features for the acoustic classifier
+ *
+ * @param num_bands Mel bands behind the MFCCs (ignored for log-mel features,
+ *                  whose band count is the model's coefficient dimension)
+ * @param num_mfcc Cepstral coefficients, 0 for log-mel features (default)
+ * @return true if the feature selection is valid, false otherwise
+ */
+bool tinyml_set_acoustic_features(uint8_t num_bands, uint8_t num_mfcc);
+
 /**
  * @brief Perform motor current analysis
  *
@@ -321,6 +430,10 @@ bool tinyml_clear_performance_stats(void);
 /**
  * @brief Update model parameters
  *
+ * Installs a tinyml_calibration_record_t, e.g. one exported from a sister
+ * machine, after checking it against the loaded model's type, outputs and
+ * blob checksum. A param_size of 0 discards the model's calibration.
+ *
  * @param model_type Model type to update
  * @param parameters Pointer to parameter data
  * @param param_size Parameter data size
@@ -332,9 +445,15 @@ bool tinyml_update_model_parameters(tinyml_model_type_t model_type,
 /**
  * @brief Calibrate model with reference data
  *
+ * Runs the model on whole input frames recorded during normal operation
+ * and adds its float outputs to the model's calibration session (see
+ * tinyml_calibration.h). Calibration may be fed in several calls; once
+ * TINYML_CALIBRATION_MIN_FRAMES frames are collected every call refits and
+ * persists the record, and inferences report a calibrated anomaly_score.
+ *
  * @param model_type Model type to calibrate
- * @param reference_data Pointer to reference data
- * @param data_length Reference data length
+ * @param reference_data Pointer to reference data (consecutive input frames)
+ * @param data_length Reference data length in floats (multiple of the input size)
  * @return true if calibration successful, false otherwise
  */
 bool tinyml_calibrate_model(tinyml_model_type_t model_type,
@@ -382,10 +501,13 @@ bool tinyml_get_supported_models(tinyml_model_type_t *supported_models,
 /**
  * @brief Perform batch inference on multiple data samples
  *
+ * Queues every request and runs the scheduler until all of them completed;
+ * requests already queued may be dispatched in between by urgency.
+ *
  * @param requests Array of inference requests
  * @param num_requests Number of requests
  * @param results Array to store inference results
- * @return true if batch inference successful, false otherwise
+ * @return true if every request succeeded, false otherwise
  */
 bool tinyml_batch_inference(const tinyml_inference_request_t *requests, uint32_t num_requests,
                            tinyml_inference_result_t *results);
@@ -422,14 +544,95 @@ bool tinyml_get_anomaly_threshold(tinyml_model_type_t model_type, float *thresho
 /**
  * @brief Enable/disable continuous monitoring mode
  *
+ * An enabled model runs from tinyml_run_monitoring() on the newest capture
+ * its source sensor published to the feature store. The interval adapts:
+ * it drops to interval_ms / TINYML_MONITOR_FAST_DIVISOR while the anomaly
+ * score is above threshold, stretches towards interval_ms *
+ * TINYML_MONITOR_SLOW_FACTOR while healthy, and is stretched further when
+ * the power budget runs low.
+ *
+ * Monitor and deadline times are compared as wrapping differences of the
+ * engine's millisecond tick, so every interval must stay below 2^31 ms;
+ * interval_ms is limited to TINYML_MONITOR_MAX_INTERVAL_MS, which keeps
+ * even the stretched interval (up to 16 times the base) within about
+ * 16 hours.
+ *
  * @param model_type Model type
  * @param enable true to enable continuous monitoring, false to disable
  * @param interval_ms Monitoring interval in milliseconds
+ *                    (TINYML_MONITOR_MIN_INTERVAL_MS to TINYML_MONITOR_MAX_INTERVAL_MS)
  * @return true if configuration successful, false otherwise
  */
 bool tinyml_enable_continuous_monitoring(tinyml_model_type_t model_type, bool enable,
                                         uint32_t interval_ms);
 
+/**
+ * @brief Select the sensor whose captures a monitored model analyzes
+ *
+ * @param model_type Model type
+ * @param sensor_id Sensor ID under which captures are published to the feature store
+ * @return true if source set successfully, false otherwise
+ */
+bool tinyml_set_monitoring_source(tinyml_model_type_t model_type, uint8_t sensor_id);
+
+/**
+ * @brief Run the continuous monitors that are due
+ *
+ * A monitor whose source has not published a new capture since its last
+ * run is skipped without inference. Call from the main loop; the return
+ * value tells how long the caller may sleep. Engine time is the
+ * millisecond tick, which keeps counting through the sleep, so no
+ * schedule falls behind however long the hint is.
+ *
+ * @return Milliseconds until the next monitor is due (UINT32_MAX if none enabled)
+ */
+uint32_t tinyml_run_monitoring(void);
+
+/**
+ * @brief Get continuous monitoring status
+ *
+ * @param model_type Model type
+ * @param interval_ms Pointer to store current effective interval
+ * @param last_score Pointer to store last anomaly score (0-100)
+ * @return true if model is monitored, false otherwise
+ */
+bool tinyml_get_monitoring_status(tinyml_model_type_t model_type, uint32_t *interval_ms,
+                                  float *last_score);
+
+/**
+ * @brief Gate a model behind a cheap first stage
+ *
+ * A gated model runs only on captures whose gate score reaches the
+ * threshold; other captures are reported healthy without running it. The
+ * statistical gate scores a capture by its largest feature z-score against
+ * adaptive baselines, as a probability, and passes every capture while the
+ * baselines warm up. A model gate scores by its last output element read as
+ * the probability of an abnormal capture. Continuous monitoring applies
+ * the cascade automatically.
+ *
+ * @param model_type Model to gate
+ * @param config Cascade configuration (gate_type TINYML_GATE_NONE removes the gate)
+ * @return true if cascade configured successfully, false otherwise
+ */
+bool tinyml_configure_cascade(tinyml_model_type_t model_type, const tinyml_cascade_config_t *config);
+
+/**
+ * @brief Analyze a capture through a model's cascade
+ *
+ * Runs vibration anomaly detection, bearing fault detection or the loaded
+ * model of the given type, behind its gate if one is configured. A capture
+ * the gate screens out yields a healthy result (score 0, severity 1).
+ *
+ * @param model_type Model type
+ * @param samples Capture samples
+ * @param num_samples Number of samples
+ * @param sample_rate_hz Capture sample rate in Hz
+ * @param result Pointer to anomaly result structure
+ * @return true if the capture was analyzed, false otherwise
+ */
+bool tinyml_run_cascade(tinyml_model_type_t model_type, const float *samples, uint16_t num_samples,
+                        uint32_t sample_rate_hz, anomaly_detection_result_t *result);
+
 /**
  * @brief Register anomaly detection callback
  *
@@ -448,6 +651,11 @@ bool tinyml_unregister_anomaly_callback(void);
 /**
  * @brief Get TinyML engine memory usage
  *
+ * Used memory is the model data held in RAM plus the shared arena high-water,
+ * i.e. the largest planned arena among the loaded models. Available memory is
+ * the arena space no loaded model needs. Live and peak arena usage of actual
+ * inferences are reported in tinyml_performance_stats_t.
+ *
  * @param used_memory_kb Pointer to store used memory in KB
  * @param available_memory_kb Pointer to store available memory in KB
  * @return true if memory information retrieved successfully, false otherwise
@@ -485,9 +693,27 @@ bool tinyml_get_version(char *version_string, uint16_t buffer_size);
  */
 bool tinyml_set_debug_level(uint8_t level);
 
+/**
+ * @brief Enable/disable per-layer profiling of a model
+ *
+ * Up to TINYML_PROFILER_MAX_MODELS models can be profiled at once. Enabling
+ * starts a fresh profile; so does reloading the model or clearing the
+ * performance statistics.
+ *
+ * @param model_type Model type (must be loaded to enable)
+ * @param enable Enable profiling
+ * @return true if profiling state changed successfully, false otherwise
+ */
+bool tinyml_enable_profiling(tinyml_model_type_t model_type, bool enable);
+
 /**
  * @brief Export model performance metrics
  *
+ * Writes compact JSON with the model's run count, mean latency and engine
+ * CPU utilization. For a model being profiled, "profile" holds the cycle
+ * statistics of the whole inference and of each layer (see
+ * tinyml_profiler_export_json()); otherwise it is null.
+ *
  * @param model_type Model type
  * @param metrics_buffer Buffer to store metrics in JSON format
  * @param buffer_size Size of buffer
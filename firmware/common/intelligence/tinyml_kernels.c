@@ -0,0 +1,444 @@
+/**
+ * @file tinyml_kernels.c
+ * @brief Int8 Quantized Neural Network Kernels Implementation
+ *
+ * This file contains the int8 kernels used by the TinyML engine. The inner
+ * dot products have a Cortex-M4 SIMD path that widens four int8 pairs into
+ * int16 lanes with SXTB16/SXTAB16 and accumulates them with two SMLAD
+ * instructions; all other targets use the reference C loops.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "tinyml_kernels.h"
+#include <string.h>
+#include <math.h>
+
+#if TINYML_KERNELS_USE_SIMD
+#include <arm_acle.h>
+#endif
+
+/* ============================================================================
+ * Fixed-Point Arithmetic
+ * ============================================================================ */
+
+/**
+ * @brief High half of 2*a*b with rounding and saturation (gemmlowp semantics)
+ */
+static int32_t saturating_rounding_doubling_high_mul(int32_t a, int32_t b) {
+    if (a == INT32_MIN && b == INT32_MIN) {
+        return INT32_MAX;
+    }
+
+    int64_t product = (int64_t)a * (int64_t)b;
+    int64_t nudge = (product >= 0) ? (1LL << 30) : (1 - (1LL << 30));
+    return (int32_t)((product + nudge) / (1LL << 31));
+}
+
+/**
+ * @brief Arithmetic right shift with round-half-away-from-zero
+ */
+static int32_t rounding_divide_by_pot(int32_t value, int32_t exponent) {
+    if (exponent <= 0) {
+        return value;
+    }
+
+    int32_t mask = (int32_t)((1U << exponent) - 1U);
+    int32_t remainder = value & mask;
+    int32_t threshold = (mask >> 1) + ((value < 0) ? 1 : 0);
+    return (value >> exponent) + ((remainder > threshold) ? 1 : 0);
+}
+
+/**
+ * @brief Clamp an offset accumulator into the activation range
+ */
+static int8_t clamp_activation(int32_t value, int8_t activation_min, int8_t activation_max) {
+    if (value < activation_min) {
+        return activation_min;
+    }
+    if (value > activation_max) {
+        return activation_max;
+    }
+    return (int8_t)value;
+}
+
+/* ============================================================================
+ * Dot Products
+ * ============================================================================ */
+
+#if TINYML_KERNELS_USE_SIMD
+/**
+ * @brief Offset int8 dot product using dual 16-bit MACs
+ */
+static int32_t dot_product_offset(const int8_t *input, const int8_t *weights, uint32_t length,
+                                  int32_t input_offset, int32_t accumulator) {
+    uint32_t offset_pair = ((uint32_t)(uint16_t)input_offset << 16) | (uint16_t)input_offset;
+    uint32_t i = 0;
+
+    for (; i + 4 <= length; i += 4) {
+        uint32_t in_word;
+        uint32_t w_word;
+        memcpy(&in_word, &input[i], sizeof(in_word));
+        memcpy(&w_word, &weights[i], sizeof(w_word));
+
+        /* Bytes 0/2 and 1/3 widened into int16 lanes, input offset added */
+        int16x2_t in_even = __sxtab16(offset_pair, in_word);
+        int16x2_t in_odd = __sxtab16(offset_pair, __ror(in_word, 8));
+        int16x2_t w_even = __sxtb16(w_word);
+        int16x2_t w_odd = __sxtb16(__ror(w_word, 8));
+
+        accumulator = __smlad(in_even, w_even, accumulator);
+        accumulator = __smlad(in_odd, w_odd, accumulator);
+    }
+
+    for (; i < length; i++) {
+        accumulator += ((int32_t)input[i] + input_offset) * (int32_t)weights[i];
+    }
+
+    return accumulator;
+}
+#else
+/**
+ * @brief Offset int8 dot product (reference)
+ */
+static int32_t dot_product_offset(const int8_t *input, const int8_t *weights, uint32_t length,
+                                  int32_t input_offset, int32_t accumulator) {
+    for (uint32_t i = 0; i < length; i++) {
+        accumulator += ((int32_t)input[i] + input_offset) * (int32_t)weights[i];
+    }
+    return accumulator;
+}
+#endif
+
+/* ============================================================================
+ * Quantization Helpers
+ * ============================================================================ */
+
+/**
+ * @brief Convert a real-valued rescale factor into a Q31 multiplier and shift
+ */
+bool tinyml_quantize_multiplier(double real_multiplier, tinyml_quant_multiplier_t *result) {
+    if (!result || real_multiplier < 0.0) {
+        return false;
+    }
+
+    if (real_multiplier == 0.0) {
+        result->multiplier = 0;
+        result->shift = 0;
+        return true;
+    }
+
+    int exponent;
+    double fraction = frexp(real_multiplier, &exponent);
+    int64_t fixed = (int64_t)round(fraction * (double)(1LL << 31));
+
+    if (fixed == (1LL << 31)) {
+        fixed /= 2;
+        exponent++;
+    }
+
+    /* Multipliers this small round to zero anyway */
+    if (exponent < -31) {
+        fixed = 0;
+        exponent = 0;
+    }
+
+    result->multiplier = (int32_t)fixed;
+    result->shift = exponent;
+    return true;
+}
+
+/**
+ * @brief Requantize an int32 accumulator with a fixed-point multiplier
+ */
+int32_t tinyml_requantize(int32_t value, const tinyml_quant_multiplier_t *multiplier) {
+    int32_t left_shift = (multiplier->shift > 0) ? multiplier->shift : 0;
+    int32_t right_shift = (multiplier->shift > 0) ? 0 : -multiplier->shift;
+
+    return rounding_divide_by_pot(
+        saturating_rounding_doubling_high_mul((int32_t)((uint32_t)value << left_shift),
+                                              multiplier->multiplier),
+        right_shift);
+}
+
+/**
+ * @brief Quantize float values to int8
+ */
+void tinyml_quantize_float(const float *input, int8_t *output, uint32_t length,
+                           float scale, int32_t zero_point) {
+    float inverse_scale = (scale > 0.0f) ? 1.0f / scale : 0.0f;
+
+    for (uint32_t i = 0; i < length; i++) {
+        int32_t value = (int32_t)lrintf(input[i] * inverse_scale) + zero_point;
+        output[i] = clamp_activation(value, INT8_MIN, INT8_MAX);
+    }
+}
+
+/**
+ * @brief Dequantize int8 values to float
+ */
+void tinyml_dequantize_int8(const int8_t *input, float *output, uint32_t length,
+                            float scale, int32_t zero_point) {
+    for (uint32_t i = 0; i < length; i++) {
+        output[i] = (float)((int32_t)input[i] - zero_point) * scale;
+    }
+}
+
+/* ============================================================================
+ * Kernel Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Fully connected layer
+ */
+bool tinyml_kernel_dense(const int8_t *input, uint16_t input_size,
+                         const int8_t *weights, const int32_t *bias, uint16_t output_size,
+                         const tinyml_quant_params_t *params, int8_t *output) {
+    if (!input || !weights || !params || !output || input_size == 0 || output_size == 0) {
+        return false;
+    }
+
+    for (uint16_t o = 0; o < output_size; o++) {
+        int32_t acc = bias ? bias[o] : 0;
+        acc = dot_product_offset(input, &weights[(uint32_t)o * input_size], input_size,
+                                 params->input_offset, acc);
+        acc = tinyml_requantize(acc, &params->output_multiplier) + params->output_offset;
+        output[o] = clamp_activation(acc, params->activation_min, params->activation_max);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 1-D convolution
+ */
+bool tinyml_kernel_conv1d(const int8_t *input, uint16_t input_length, uint16_t input_channels,
+                          const int8_t *weights, const int32_t *bias, uint16_t output_channels,
+                          uint8_t kernel_size, uint8_t stride, uint8_t pad,
+                          const tinyml_quant_params_t *params, int8_t *output) {
+    if (!input || !weights || !params || !output || input_channels == 0 ||
+        output_channels == 0 || kernel_size == 0 || stride == 0 ||
+        (uint32_t)input_length + 2U * pad < kernel_size) {
+        return false;
+    }
+
+    uint32_t output_length = ((uint32_t)input_length + 2U * pad - kernel_size) / stride + 1U;
+    uint32_t filter_size = (uint32_t)kernel_size * input_channels;
+
+    for (uint32_t x = 0; x < output_length; x++) {
+        int32_t start = (int32_t)(x * stride) - (int32_t)pad;
+
+        /* Padding contributes nothing, so only the in-range taps are summed;
+         * being channels-last, those taps are one contiguous run */
+        uint32_t tap_first = (start < 0) ? (uint32_t)(-start) : 0U;
+        uint32_t tap_last = kernel_size;
+        if (start + (int32_t)kernel_size > (int32_t)input_length) {
+            tap_last = (uint32_t)((int32_t)input_length - start);
+        }
+
+        const int8_t *window = &input[(uint32_t)(start + (int32_t)tap_first) * input_channels];
+        uint32_t run = (tap_last - tap_first) * input_channels;
+
+        for (uint16_t o = 0; o < output_channels; o++) {
+            const int8_t *filter = &weights[(uint32_t)o * filter_size + tap_first * input_channels];
+            int32_t acc = bias ? bias[o] : 0;
+
+            acc = dot_product_offset(window, filter, run, params->input_offset, acc);
+            acc = tinyml_requantize(acc, &params->output_multiplier) + params->output_offset;
+            output[x * output_channels + o] = clamp_activation(acc, params->activation_min,
+                                                               params->activation_max);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 1-D depthwise convolution
+ */
+bool tinyml_kernel_depthwise_conv1d(const int8_t *input, uint16_t input_length, uint16_t channels,
+                                    const int8_t *weights, const int32_t *bias,
+                                    uint8_t kernel_size, uint8_t stride, uint8_t pad,
+                                    const tinyml_quant_params_t *params, int8_t *output) {
+    if (!input || !weights || !params || !output || channels == 0 ||
+        kernel_size == 0 || stride == 0 || (uint32_t)input_length + 2U * pad < kernel_size) {
+        return false;
+    }
+
+    uint32_t output_length = ((uint32_t)input_length + 2U * pad - kernel_size) / stride + 1U;
+
+    for (uint32_t x = 0; x < output_length; x++) {
+        int32_t start = (int32_t)(x * stride) - (int32_t)pad;
+
+        for (uint16_t c = 0; c < channels; c++) {
+            int32_t acc = bias ? bias[c] : 0;
+
+            /* Channel-strided taps do not pack into SIMD lanes; kernels are short */
+            for (uint8_t k = 0; k < kernel_size; k++) {
+                int32_t position = start + k;
+                if (position >= 0 && position < (int32_t)input_length) {
+                    acc += ((int32_t)input[(uint32_t)position * channels + c] + params->input_offset) *
+                           (int32_t)weights[(uint32_t)k * channels + c];
+                }
+            }
+
+            acc = tinyml_requantize(acc, &params->output_multiplier) + params->output_offset;
+            output[x * channels + c] = clamp_activation(acc, params->activation_min,
+                                                        params->activation_max);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 1-D max pooling
+ */
+bool tinyml_kernel_max_pool1d(const int8_t *input, uint16_t input_length, uint16_t channels,
+                              uint8_t pool_size, uint8_t stride,
+                              int8_t activation_min, int8_t activation_max, int8_t *output) {
+    if (!input || !output || channels == 0 || pool_size == 0 || stride == 0 ||
+        input_length < pool_size) {
+        return false;
+    }
+
+    uint32_t output_length = ((uint32_t)input_length - pool_size) / stride + 1U;
+
+    for (uint32_t x = 0; x < output_length; x++) {
+        const int8_t *window = &input[x * stride * channels];
+        int8_t *out = &output[x * channels];
+
+        memcpy(out, window, channels);
+        for (uint8_t k = 1; k < pool_size; k++) {
+            const int8_t *row = &window[(uint32_t)k * channels];
+            for (uint16_t c = 0; c < channels; c++) {
+                if (row[c] > out[c]) {
+                    out[c] = row[c];
+                }
+            }
+        }
+
+        for (uint16_t c = 0; c < channels; c++) {
+            out[c] = clamp_activation(out[c], activation_min, activation_max);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 1-D average pooling
+ */
+bool tinyml_kernel_avg_pool1d(const int8_t *input, uint16_t input_length, uint16_t channels,
+                              uint16_t pool_size, uint8_t stride,
+                              int8_t activation_min, int8_t activation_max, int8_t *output) {
+    if (!input || !output || channels == 0 || pool_size == 0 || stride == 0 ||
+        input_length < pool_size) {
+        return false;
+    }
+
+    uint32_t output_length = ((uint32_t)input_length - pool_size) / stride + 1U;
+    int32_t half = pool_size / 2;
+
+    for (uint32_t x = 0; x < output_length; x++) {
+        const int8_t *window = &input[x * stride * channels];
+
+        for (uint16_t c = 0; c < channels; c++) {
+            int32_t sum = 0;
+            for (uint16_t k = 0; k < pool_size; k++) {
+                sum += window[(uint32_t)k * channels + c];
+            }
+
+            /* Round half away from zero, matching the reference interpreter */
+            sum = (sum >= 0) ? (sum + half) / pool_size : (sum - half) / pool_size;
+            output[x * channels + c] = clamp_activation(sum, activation_min, activation_max);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief ReLU on a quantized tensor
+ */
+void tinyml_kernel_relu(const int8_t *input, int8_t *output, uint32_t length, int8_t zero_point) {
+    for (uint32_t i = 0; i < length; i++) {
+        output[i] = (input[i] < zero_point) ? zero_point : input[i];
+    }
+}
+
+/**
+ * @brief Softmax producing int8 probabilities
+ */
+bool tinyml_kernel_softmax(const int8_t *input, uint16_t length, float input_scale, int8_t *output) {
+    if (!input || !output || length == 0 || input_scale <= 0.0f) {
+        return false;
+    }
+
+    /* Subtracting the maximum keeps every exponent <= 0 so expf cannot overflow */
+    int8_t max_value = input[0];
+    for (uint16_t i = 1; i < length; i++) {
+        if (input[i] > max_value) {
+            max_value = input[i];
+        }
+    }
+
+    float sum = 0.0f;
+    for (uint16_t i = 0; i < length; i++) {
+        sum += expf(-(float)(max_value - input[i]) * input_scale);
+    }
+
+    float inverse_sum = 1.0f / sum;
+    for (uint16_t i = 0; i < length; i++) {
+        float probability = expf(-(float)(max_value - input[i]) * input_scale) * inverse_sum;
+        int32_t q = (int32_t)lrintf(probability * 256.0f) + TINYML_SOFTMAX_OUTPUT_ZERO_POINT;
+        output[i] = clamp_activation(q, INT8_MIN, INT8_MAX);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Element-wise quantized addition
+ */
+bool tinyml_kernel_add(const int8_t *input1, const int8_t *input2, uint32_t length,
+                       const tinyml_elementwise_params_t *params, int8_t *output) {
+    if (!input1 || !input2 || !params || !output) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < length; i++) {
+        /* Bring both operands to a common high-precision scale before summing */
+        int32_t a = ((int32_t)input1[i] + params->input1_offset) * (1 << params->left_shift);
+        int32_t b = ((int32_t)input2[i] + params->input2_offset) * (1 << params->left_shift);
+        int32_t sum = tinyml_requantize(a, &params->input1_multiplier) +
+                      tinyml_requantize(b, &params->input2_multiplier);
+
+        sum = tinyml_requantize(sum, &params->output_multiplier) + params->output_offset;
+        output[i] = clamp_activation(sum, params->activation_min, params->activation_max);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Element-wise quantized multiplication
+ */
+bool tinyml_kernel_mul(const int8_t *input1, const int8_t *input2, uint32_t length,
+                       const tinyml_elementwise_params_t *params, int8_t *output) {
+    if (!input1 || !input2 || !params || !output) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < length; i++) {
+        int32_t product = ((int32_t)input1[i] + params->input1_offset) *
+                          ((int32_t)input2[i] + params->input2_offset);
+
+        product = tinyml_requantize(product, &params->output_multiplier) + params->output_offset;
+        output[i] = clamp_activation(product, params->activation_min, params->activation_max);
+    }
+
+    return true;
+}
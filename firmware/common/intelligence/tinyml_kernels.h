@@ -0,0 +1,281 @@
+/**
+ * @file tinyml_kernels.h
+ * @brief Int8 Quantized Neural Network Kernels for the TinyML Engine
+ *
+ * This file defines the int8 kernels used by the TinyML engine to run 1-D
+ * sensor CNNs and small fully connected networks. Quantization follows the
+ * TensorFlow Lite scheme: activations are asymmetric int8 with a per-tensor
+ * scale and zero point, weights are symmetric int8, biases are int32 in the
+ * accumulator scale, and accumulators are requantized with a Q31 fixed-point
+ * multiplier and shift.
+ *
+ * Features:
+ * - Dense, conv1d and depthwise conv1d with fused activation clamping
+ * - Max and average pooling
+ * - ReLU and softmax
+ * - Quantized element-wise add and multiply
+ * - Cortex-M4 SIMD (SMLAD) fast paths with a portable reference C path
+ *
+ * Tensor layout is channels-last: a 1-D tensor of length L with C channels is
+ * stored as [L][C]. Conv1d weights are [out_channels][kernel][in_channels],
+ * depthwise weights are [kernel][channels] and dense weights are
+ * [outputs][inputs].
+ *
+ * Defining TINYML_KERNELS_REFERENCE forces the reference path on every target.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_TINYML_KERNELS_H
+#define ESOCORE_TINYML_KERNELS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Kernel Configuration
+ * ============================================================================ */
+
+#if defined(__ARM_FEATURE_SIMD32) && !defined(TINYML_KERNELS_REFERENCE)
+#define TINYML_KERNELS_USE_SIMD       1     /* SMLAD/SXTB16 dot products */
+#else
+#define TINYML_KERNELS_USE_SIMD       0     /* Portable reference C */
+#endif
+
+#define TINYML_SOFTMAX_OUTPUT_ZERO_POINT  (-128)  /* Softmax output scale is 1/256 */
+
+/* ============================================================================
+ * Quantization Structures
+ * ============================================================================ */
+
+typedef struct {
+    int32_t multiplier;                     /* Q31 fixed-point multiplier */
+    int32_t shift;                          /* Exponent (positive = left shift) */
+} tinyml_quant_multiplier_t;
+
+/* Parameters for dense, convolution and pooling kernels */
+typedef struct {
+    int32_t input_offset;                   /* Negated input zero point */
+    int32_t output_offset;                  /* Output zero point */
+    tinyml_quant_multiplier_t output_multiplier; /* input_scale * weight_scale / output_scale */
+    int8_t activation_min;                  /* Fused activation lower clamp */
+    int8_t activation_max;                  /* Fused activation upper clamp */
+} tinyml_quant_params_t;
+
+/* Parameters for element-wise add and multiply */
+typedef struct {
+    int32_t input1_offset;                  /* Negated zero point of the first input */
+    int32_t input2_offset;                  /* Negated zero point of the second input */
+    int32_t output_offset;                  /* Output zero point */
+    int32_t left_shift;                     /* Headroom shift applied before rescaling (add only) */
+    tinyml_quant_multiplier_t input1_multiplier; /* Rescale of input 1 (add only) */
+    tinyml_quant_multiplier_t input2_multiplier; /* Rescale of input 2 (add only) */
+    tinyml_quant_multiplier_t output_multiplier; /* Final rescale to the output scale */
+    int8_t activation_min;                  /* Fused activation lower clamp */
+    int8_t activation_max;                  /* Fused activation upper clamp */
+} tinyml_elementwise_params_t;
+
+/* ============================================================================
+ * Quantization Helpers
+ * ============================================================================ */
+
+/**
+ * @brief Convert a real-valued rescale factor into a Q31 multiplier and shift
+ *
+ * @param real_multiplier Positive real multiplier
+ * @param result Pointer to multiplier structure to fill
+ * @return true if conversion successful, false otherwise
+ */
+bool tinyml_quantize_multiplier(double real_multiplier, tinyml_quant_multiplier_t *result);
+
+/**
+ * @brief Requantize an int32 accumulator with a fixed-point multiplier
+ *
+ * @param value Accumulator value
+ * @param multiplier Pointer to fixed-point multiplier
+ * @return Rescaled value (not offset or clamped)
+ */
+int32_t tinyml_requantize(int32_t value, const tinyml_quant_multiplier_t *multiplier);
+
+/**
+ * @brief Quantize float values to int8
+ *
+ * @param input Float input values
+ * @param output Int8 output values
+ * @param length Number of values
+ * @param scale Quantization scale
+ * @param zero_point Quantization zero point
+ */
+void tinyml_quantize_float(const float *input, int8_t *output, uint32_t length,
+                           float scale, int32_t zero_point);
+
+/**
+ * @brief Dequantize int8 values to float
+ *
+ * @param input Int8 input values
+ * @param output Float output values
+ * @param length Number of values
+ * @param scale Quantization scale
+ * @param zero_point Quantization zero point
+ */
+void tinyml_dequantize_int8(const int8_t *input, float *output, uint32_t length,
+                            float scale, int32_t zero_point);
+
+/* ============================================================================
+ * Kernel Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Fully connected layer
+ *
+ * @param input Input vector [input_size]
+ * @param input_size Number of inputs
+ * @param weights Weights [output_size][input_size]
+ * @param bias Bias per output (may be NULL)
+ * @param output_size Number of outputs
+ * @param params Quantization parameters
+ * @param output Output vector [output_size]
+ * @return true if kernel executed successfully, false otherwise
+ */
+bool tinyml_kernel_dense(const int8_t *input, uint16_t input_size,
+                         const int8_t *weights, const int32_t *bias, uint16_t output_size,
+                         const tinyml_quant_params_t *params, int8_t *output);
+
+/**
+ * @brief 1-D convolution
+ *
+ * Output length is (input_length + 2 * pad - kernel_size) / stride + 1.
+ *
+ * @param input Input tensor [input_length][input_channels]
+ * @param input_length Input length
+ * @param input_channels Input channels
+ * @param weights Weights [output_channels][kernel_size][input_channels]
+ * @param bias Bias per output channel (may be NULL)
+ * @param output_channels Output channels
+ * @param kernel_size Kernel size
+ * @param stride Stride
+ * @param pad Zero padding on each side
+ * @param params Quantization parameters
+ * @param output Output tensor [output_length][output_channels]
+ * @return true if kernel executed successfully, false otherwise
+ */
+bool tinyml_kernel_conv1d(const int8_t *input, uint16_t input_length, uint16_t input_channels,
+                          const int8_t *weights, const int32_t *bias, uint16_t output_channels,
+                          uint8_t kernel_size, uint8_t stride, uint8_t pad,
+                          const tinyml_quant_params_t *params, int8_t *output);
+
+/**
+ * @brief 1-D depthwise convolution (depth multiplier 1)
+ *
+ * @param input Input tensor [input_length][channels]
+ * @param input_length Input length
+ * @param channels Channels
+ * @param weights Weights [kernel_size][channels]
+ * @param bias Bias per channel (may be NULL)
+ * @param kernel_size Kernel size
+ * @param stride Stride
+ * @param pad Zero padding on each side
+ * @param params Quantization parameters
+ * @param output Output tensor [output_length][channels]
+ * @return true if kernel executed successfully, false otherwise
+ */
+bool tinyml_kernel_depthwise_conv1d(const int8_t *input, uint16_t input_length, uint16_t channels,
+                                    const int8_t *weights, const int32_t *bias,
+                                    uint8_t kernel_size, uint8_t stride, uint8_t pad,
+                                    const tinyml_quant_params_t *params, int8_t *output);
+
+/**
+ * @brief 1-D max pooling (input and output share quantization)
+ *
+ * @param input Input tensor [input_length][channels]
+ * @param input_length Input length
+ * @param channels Channels
+ * @param pool_size Pooling window
+ * @param stride Stride
+ * @param activation_min Lower clamp
+ * @param activation_max Upper clamp
+ * @param output Output tensor [output_length][channels]
+ * @return true if kernel executed successfully, false otherwise
+ */
+bool tinyml_kernel_max_pool1d(const int8_t *input, uint16_t input_length, uint16_t channels,
+                              uint8_t pool_size, uint8_t stride,
+                              int8_t activation_min, int8_t activation_max, int8_t *output);
+
+/**
+ * @brief 1-D average pooling (input and output share quantization)
+ *
+ * A pool_size equal to input_length implements global average pooling.
+ *
+ * @param input Input tensor [input_length][channels]
+ * @param input_length Input length
+ * @param channels Channels
+ * @param pool_size Pooling window
+ * @param stride Stride
+ * @param activation_min Lower clamp
+ * @param activation_max Upper clamp
+ * @param output Output tensor [output_length][channels]
+ * @return true if kernel executed successfully, false otherwise
+ */
+bool tinyml_kernel_avg_pool1d(const int8_t *input, uint16_t input_length, uint16_t channels,
+                              uint16_t pool_size, uint8_t stride,
+                              int8_t activation_min, int8_t activation_max, int8_t *output);
+
+/**
+ * @brief ReLU on a quantized tensor (in place allowed)
+ *
+ * @param input Input values
+ * @param output Output values
+ * @param length Number of values
+ * @param zero_point Zero point of the tensor
+ */
+void tinyml_kernel_relu(const int8_t *input, int8_t *output, uint32_t length, int8_t zero_point);
+
+/**
+ * @brief Softmax producing int8 probabilities with scale 1/256 and zero point -128
+ *
+ * @param input Input logits
+ * @param length Number of logits
+ * @param input_scale Scale of the input logits
+ * @param output Output probabilities
+ * @return true if kernel executed successfully, false otherwise
+ */
+bool tinyml_kernel_softmax(const int8_t *input, uint16_t length, float input_scale, int8_t *output);
+
+/**
+ * @brief Element-wise quantized addition
+ *
+ * @param input1 First input
+ * @param input2 Second input
+ * @param length Number of values
+ * @param params Element-wise quantization parameters
+ * @param output Output values
+ * @return true if kernel executed successfully, false otherwise
+ */
+bool tinyml_kernel_add(const int8_t *input1, const int8_t *input2, uint32_t length,
+                       const tinyml_elementwise_params_t *params, int8_t *output);
+
+/**
+ * @brief Element-wise quantized multiplication
+ *
+ * @param input1 First input
+ * @param input2 Second input
+ * @param length Number of values
+ * @param params Element-wise quantization parameters (output_multiplier is
+ *               input1_scale * input2_scale / output_scale)
+ * @param output Output values
+ * @return true if kernel executed successfully, false otherwise
+ */
+bool tinyml_kernel_mul(const int8_t *input1, const int8_t *input2, uint32_t length,
+                       const tinyml_elementwise_params_t *params, int8_t *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_TINYML_KERNELS_H */
@@ -0,0 +1,428 @@
+/**
+ * @file tinyml_model.c
+ * @brief Quantized Model Interpreter Implementation
+ *
+ * This file contains the parser, tensor planner and interpreter for the
+ * TinyML model blob format. All validation happens at parse time so that
+ * invoke is a straight walk over the layer descriptors.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "tinyml_model.h"
+#include "tinyml_profiler.h"
+#include <string.h>
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Round a byte count up to the arena tensor alignment
+ */
+static uint32_t align_tensor_size(uint32_t size) {
+    return (size + (TINYML_MODEL_TENSOR_ALIGN - 1U)) & ~(uint32_t)(TINYML_MODEL_TENSOR_ALIGN - 1U);
+}
+
+/**
+ * @brief Check that a blob region is in bounds and suitably aligned
+ */
+static bool blob_region_valid(uint32_t blob_size, uint32_t offset, uint32_t length, uint32_t align) {
+    if (offset == 0 || (offset % align) != 0) {
+        return false;
+    }
+    return offset <= blob_size && length <= blob_size - offset;
+}
+
+/* CRC-32 remainders of one nibble; 64 bytes instead of a 1 KB byte table */
+static const uint32_t crc32_nibble_table[16] = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL,
+};
+
+/**
+ * @brief Validate one layer and compute its output size and MAC count
+ */
+static bool validate_layer(const tinyml_model_t *model, uint8_t index, uint32_t blob_size,
+                           uint32_t *output_size, uint32_t *macs) {
+    const tinyml_layer_desc_t *layer = &model->layers[index];
+    uint32_t input_elements = (uint32_t)layer->input_length * layer->input_channels;
+    uint32_t output_elements = (uint32_t)layer->output_length * layer->output_channels;
+    uint32_t weight_bytes = 0;
+    uint32_t bias_count = 0;
+
+    /* Layers may only read tensors produced before them */
+    if (layer->input_tensor > index || model->tensor_size[layer->input_tensor] != input_elements ||
+        input_elements == 0 || output_elements == 0 || layer->activation_min > layer->activation_max) {
+        return false;
+    }
+
+    /* Only the element-wise ops read a second tensor; the planner indexes by it */
+    bool elementwise = (layer->op == TINYML_OP_ADD || layer->op == TINYML_OP_MUL);
+    if (!elementwise && layer->aux_tensor != TINYML_MODEL_TENSOR_NONE) {
+        return false;
+    }
+
+    switch ((tinyml_op_t)layer->op) {
+        case TINYML_OP_DENSE:
+            if (input_elements > UINT16_MAX || layer->output_length != 1) {
+                return false;
+            }
+            weight_bytes = input_elements * layer->output_channels;
+            bias_count = layer->output_channels;
+            *macs = weight_bytes;
+            break;
+
+        case TINYML_OP_CONV1D:
+        case TINYML_OP_DEPTHWISE_CONV1D:
+            if (layer->kernel_size == 0 || layer->stride == 0 ||
+                (uint32_t)layer->input_length + 2U * layer->pad < layer->kernel_size ||
+                layer->output_length !=
+                    ((uint32_t)layer->input_length + 2U * layer->pad - layer->kernel_size) / layer->stride + 1U) {
+                return false;
+            }
+            if (layer->op == TINYML_OP_CONV1D) {
+                weight_bytes = (uint32_t)layer->output_channels * layer->kernel_size * layer->input_channels;
+            } else {
+                if (layer->output_channels != layer->input_channels) {
+                    return false;
+                }
+                weight_bytes = (uint32_t)layer->kernel_size * layer->input_channels;
+            }
+            bias_count = layer->output_channels;
+            *macs = (uint32_t)layer->output_length * weight_bytes;
+            break;
+
+        case TINYML_OP_MAX_POOL1D:
+        case TINYML_OP_AVG_POOL1D:
+            if (layer->kernel_size == 0 || layer->stride == 0 ||
+                layer->input_length < layer->kernel_size ||
+                layer->output_channels != layer->input_channels ||
+                layer->output_length != (uint32_t)(layer->input_length - layer->kernel_size) / layer->stride + 1U) {
+                return false;
+            }
+            *macs = output_elements * layer->kernel_size;
+            break;
+
+        case TINYML_OP_SOFTMAX:
+            if (!(layer->input_scale > 0.0f) || input_elements > UINT16_MAX) {
+                return false;
+            }
+            /* fall through */
+        case TINYML_OP_RELU:
+            if (output_elements != input_elements) {
+                return false;
+            }
+            *macs = output_elements;
+            break;
+
+        case TINYML_OP_ADD:
+        case TINYML_OP_MUL:
+            if (layer->aux_tensor > index || model->tensor_size[layer->aux_tensor] != input_elements ||
+                output_elements != input_elements ||
+                layer->left_shift < 0 || layer->left_shift > 20) {
+                return false;
+            }
+            *macs = output_elements;
+            break;
+
+        default:
+            return false;
+    }
+
+    if (weight_bytes > 0 && !blob_region_valid(blob_size, layer->weights_offset, weight_bytes, 1)) {
+        return false;
+    }
+    if (layer->bias_offset != 0 &&
+        !blob_region_valid(blob_size, layer->bias_offset, bias_count * sizeof(int32_t), sizeof(int32_t))) {
+        return false;
+    }
+
+    *output_size = output_elements;
+    return true;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Compute a CRC-32 (IEEE 802.3)
+ */
+uint32_t tinyml_model_crc32(uint32_t crc, const uint8_t *data, uint32_t length) {
+    if (!data) {
+        return crc;
+    }
+
+    crc = ~crc;
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ crc32_nibble_table[crc & 0x0FU];
+        crc = (crc >> 4) ^ crc32_nibble_table[crc & 0x0FU];
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Parse and validate a model blob
+ */
+bool tinyml_model_parse(const uint8_t *data, uint32_t size, tinyml_model_t *model) {
+    if (!data || !model || ((uintptr_t)data % sizeof(uint32_t)) != 0 ||
+        size < sizeof(tinyml_model_header_t)) {
+        return false;
+    }
+
+    const tinyml_model_header_t *header = (const tinyml_model_header_t *)data;
+    if (header->magic != TINYML_MODEL_MAGIC ||
+        header->format_version != TINYML_MODEL_FORMAT_VERSION ||
+        header->num_layers == 0 || header->num_layers > TINYML_MODEL_MAX_LAYERS ||
+        header->total_size != size || header->output_size == 0 ||
+        !(header->input_scale > 0.0f) || !(header->output_scale > 0.0f) ||
+        sizeof(tinyml_model_header_t) + header->num_layers * sizeof(tinyml_layer_desc_t) > size) {
+        return false;
+    }
+
+    /* Reject blobs that were corrupted or only partially written */
+    if (tinyml_model_crc32(0, data + sizeof(tinyml_model_header_t),
+                           size - (uint32_t)sizeof(tinyml_model_header_t)) != header->checksum) {
+        return false;
+    }
+
+    memset(model, 0, sizeof(tinyml_model_t));
+    model->blob = data;
+    model->header = header;
+    model->layers = (const tinyml_layer_desc_t *)(data + sizeof(tinyml_model_header_t));
+    model->num_tensors = (uint8_t)(header->num_layers + 1);
+    model->tensor_size[0] = (uint32_t)header->input_length * header->input_channels;
+
+    if (model->tensor_size[0] == 0) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < header->num_layers; i++) {
+        uint32_t macs = 0;
+        if (!validate_layer(model, i, size, &model->tensor_size[i + 1], &macs)) {
+            return false;
+        }
+        model->layer_macs[i] = macs;
+        model->total_macs += macs;
+    }
+
+    return model->tensor_size[header->num_layers] == header->output_size;
+}
+
+/**
+ * @brief Assign arena offsets to every tensor of a parsed model
+ */
+bool tinyml_model_plan(tinyml_model_t *model) {
+    if (!model || !model->header) {
+        return false;
+    }
+
+    uint8_t num_layers = (uint8_t)model->header->num_layers;
+    uint8_t num_tensors = model->num_tensors;
+    if (num_layers == 0 || num_tensors != num_layers + 1 || num_tensors > TINYML_MODEL_MAX_TENSORS) {
+        return false;
+    }
+    uint32_t aligned_size[TINYML_MODEL_MAX_TENSORS];
+    uint8_t order[TINYML_MODEL_MAX_TENSORS];
+    bool placed[TINYML_MODEL_MAX_TENSORS];
+
+    /* Lifetimes in layer steps; the input is written just before layer 0 and
+     * the output is read just after the last layer */
+    for (uint8_t t = 0; t < num_tensors; t++) {
+        model->tensor_first_use[t] = (t == 0) ? 0 : (uint8_t)(t - 1);
+        model->tensor_last_use[t] = model->tensor_first_use[t];
+        aligned_size[t] = align_tensor_size(model->tensor_size[t]);
+        placed[t] = false;
+    }
+    for (uint8_t i = 0; i < num_layers; i++) {
+        const tinyml_layer_desc_t *layer = &model->layers[i];
+        model->tensor_last_use[layer->input_tensor] = i;
+        if (layer->aux_tensor != TINYML_MODEL_TENSOR_NONE) {
+            model->tensor_last_use[layer->aux_tensor] = i;
+        }
+    }
+    model->tensor_last_use[num_tensors - 1] = (uint8_t)(num_layers - 1);
+
+    /* Largest first; insertion sort is fine for a handful of tensors */
+    for (uint8_t t = 0; t < num_tensors; t++) {
+        uint8_t j = t;
+        while (j > 0 && aligned_size[order[j - 1]] < aligned_size[t]) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = t;
+    }
+
+    model->arena_required = 0;
+    for (uint8_t n = 0; n < num_tensors; n++) {
+        uint8_t t = order[n];
+        uint32_t offset = 0;
+        bool moved = true;
+
+        /* Slide past every placed, lifetime-overlapping tensor we collide with
+         * until a gap large enough is found */
+        while (moved) {
+            moved = false;
+            for (uint8_t u = 0; u < num_tensors; u++) {
+                if (!placed[u] ||
+                    model->tensor_last_use[u] < model->tensor_first_use[t] ||
+                    model->tensor_first_use[u] > model->tensor_last_use[t]) {
+                    continue;
+                }
+                uint32_t u_end = model->tensor_offset[u] + aligned_size[u];
+                if (offset < u_end && model->tensor_offset[u] < offset + aligned_size[t]) {
+                    offset = u_end;
+                    moved = true;
+                }
+            }
+        }
+
+        model->tensor_offset[t] = offset;
+        placed[t] = true;
+        if (offset + aligned_size[t] > model->arena_required) {
+            model->arena_required = offset + aligned_size[t];
+        }
+    }
+
+    model->peak_live_bytes = 0;
+    for (uint8_t i = 0; i < num_layers; i++) {
+        uint32_t live = 0;
+        model->layer_arena_extent[i] = 0;
+        for (uint8_t t = 0; t < num_tensors; t++) {
+            if (model->tensor_first_use[t] <= i && model->tensor_last_use[t] >= i) {
+                live += aligned_size[t];
+                if (model->tensor_offset[t] + aligned_size[t] > model->layer_arena_extent[i]) {
+                    model->layer_arena_extent[i] = model->tensor_offset[t] + aligned_size[t];
+                }
+            }
+        }
+        if (live > model->peak_live_bytes) {
+            model->peak_live_bytes = live;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Run a planned model
+ */
+bool tinyml_model_invoke(const tinyml_model_t *model, uint8_t *arena, uint32_t arena_size,
+                         const int8_t *input, int8_t *output, uint32_t *layer_cycles) {
+    if (!model || !model->header || !arena || !input || !output ||
+        arena_size < model->arena_required) {
+        return false;
+    }
+
+    int8_t *tensors[TINYML_MODEL_MAX_TENSORS];
+    for (uint8_t t = 0; t < model->num_tensors; t++) {
+        tensors[t] = (int8_t *)&arena[model->tensor_offset[t]];
+    }
+
+    /* Callers may quantize straight into the input tensor */
+    if (input != tensors[0]) {
+        memcpy(tensors[0], input, model->tensor_size[0]);
+    }
+
+    for (uint8_t i = 0; i < model->header->num_layers; i++) {
+        const tinyml_layer_desc_t *layer = &model->layers[i];
+        const int8_t *in = tensors[layer->input_tensor];
+        int8_t *out = tensors[i + 1];
+        const int8_t *weights = layer->weights_offset ?
+            (const int8_t *)&model->blob[layer->weights_offset] : NULL;
+        const int32_t *bias = layer->bias_offset ?
+            (const int32_t *)(const void *)&model->blob[layer->bias_offset] : NULL;
+        tinyml_quant_params_t params = {
+            .input_offset = layer->input_offset,
+            .output_offset = layer->output_offset,
+            .output_multiplier = layer->output_multiplier,
+            .activation_min = layer->activation_min,
+            .activation_max = layer->activation_max
+        };
+        bool ok = false;
+        uint32_t start = layer_cycles ? tinyml_profiler_get_cycles() : 0;
+
+        switch ((tinyml_op_t)layer->op) {
+            case TINYML_OP_DENSE:
+                ok = tinyml_kernel_dense(in, (uint16_t)model->tensor_size[layer->input_tensor],
+                                         weights, bias, layer->output_channels, &params, out);
+                break;
+
+            case TINYML_OP_CONV1D:
+                ok = tinyml_kernel_conv1d(in, layer->input_length, layer->input_channels,
+                                          weights, bias, layer->output_channels,
+                                          layer->kernel_size, layer->stride, layer->pad,
+                                          &params, out);
+                break;
+
+            case TINYML_OP_DEPTHWISE_CONV1D:
+                ok = tinyml_kernel_depthwise_conv1d(in, layer->input_length, layer->input_channels,
+                                                    weights, bias, layer->kernel_size,
+                                                    layer->stride, layer->pad, &params, out);
+                break;
+
+            case TINYML_OP_MAX_POOL1D:
+                ok = tinyml_kernel_max_pool1d(in, layer->input_length, layer->input_channels,
+                                              layer->kernel_size, layer->stride,
+                                              layer->activation_min, layer->activation_max, out);
+                break;
+
+            case TINYML_OP_AVG_POOL1D:
+                ok = tinyml_kernel_avg_pool1d(in, layer->input_length, layer->input_channels,
+                                              layer->kernel_size, layer->stride,
+                                              layer->activation_min, layer->activation_max, out);
+                break;
+
+            case TINYML_OP_RELU:
+                tinyml_kernel_relu(in, out, model->tensor_size[i + 1], (int8_t)layer->output_offset);
+                ok = true;
+                break;
+
+            case TINYML_OP_SOFTMAX:
+                ok = tinyml_kernel_softmax(in, (uint16_t)model->tensor_size[i + 1],
+                                           layer->input_scale, out);
+                break;
+
+            case TINYML_OP_ADD:
+            case TINYML_OP_MUL: {
+                tinyml_elementwise_params_t elementwise = {
+                    .input1_offset = layer->input_offset,
+                    .input2_offset = layer->input2_offset,
+                    .output_offset = layer->output_offset,
+                    .left_shift = layer->left_shift,
+                    .input1_multiplier = layer->input1_multiplier,
+                    .input2_multiplier = layer->input2_multiplier,
+                    .output_multiplier = layer->output_multiplier,
+                    .activation_min = layer->activation_min,
+                    .activation_max = layer->activation_max
+                };
+                if (layer->op == TINYML_OP_ADD) {
+                    ok = tinyml_kernel_add(in, tensors[layer->aux_tensor], model->tensor_size[i + 1],
+                                           &elementwise, out);
+                } else {
+                    ok = tinyml_kernel_mul(in, tensors[layer->aux_tensor], model->tensor_size[i + 1],
+                                           &elementwise, out);
+                }
+                break;
+            }
+        }
+
+        if (!ok) {
+            return false;
+        }
+        if (layer_cycles) {
+            layer_cycles[i] = tinyml_profiler_get_cycles() - start;
+        }
+    }
+
+    if (output != tensors[model->header->num_layers]) {
+        memcpy(output, tensors[model->header->num_layers], model->header->output_size);
+    }
+    return true;
+}
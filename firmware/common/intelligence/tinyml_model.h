@@ -0,0 +1,193 @@
+/**
+ * @file tinyml_model.h
+ * @brief Quantized Model Format and Interpreter for the TinyML Engine
+ *
+ * This file defines the compact model blob executed by the TinyML engine and
+ * the interpreter that runs it on the int8 kernels. A blob is a header, an
+ * array of layer descriptors and the weight/bias data they reference. The
+ * blob is used in place, so it must be 4-byte aligned and little-endian; it
+ * may live in memory-mapped flash, since nothing ever writes to it. The
+ * header carries a CRC-32 of everything after it so that a blob left in
+ * flash by an interrupted update is never executed.
+ *
+ * Tensors are numbered so that tensor 0 is the model input and tensor i + 1
+ * is the output of layer i. A layer may read any earlier tensor, which allows
+ * residual connections through ADD and MUL.
+ *
+ * Tensors are placed in the arena by a greedy planner: each tensor is live
+ * from the layer that produces it to the last layer that reads it, tensors
+ * are placed largest first at the lowest offset that does not collide with
+ * an already placed tensor of overlapping lifetime. Every model's plan starts
+ * at offset 0, so models that never run concurrently share one arena.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_TINYML_MODEL_H
+#define ESOCORE_TINYML_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tinyml_kernels.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Model Format Configuration
+ * ============================================================================ */
+
+#define TINYML_MODEL_MAGIC            0x4C4D5345  /* "ESML" */
+#define TINYML_MODEL_FORMAT_VERSION   2
+#define TINYML_MODEL_MAX_LAYERS       16
+#define TINYML_MODEL_MAX_TENSORS      (TINYML_MODEL_MAX_LAYERS + 1)
+#define TINYML_MODEL_TENSOR_NONE      0xFF        /* No auxiliary tensor */
+#define TINYML_MODEL_TENSOR_ALIGN     4           /* Arena tensor alignment */
+
+typedef enum {
+    TINYML_OP_DENSE                 = 0,    /* Fully connected */
+    TINYML_OP_CONV1D                = 1,    /* 1-D convolution */
+    TINYML_OP_DEPTHWISE_CONV1D      = 2,    /* 1-D depthwise convolution */
+    TINYML_OP_MAX_POOL1D            = 3,    /* 1-D max pooling */
+    TINYML_OP_AVG_POOL1D            = 4,    /* 1-D average pooling */
+    TINYML_OP_RELU                  = 5,    /* ReLU */
+    TINYML_OP_SOFTMAX               = 6,    /* Softmax */
+    TINYML_OP_ADD                   = 7,    /* Element-wise add */
+    TINYML_OP_MUL                   = 8,    /* Element-wise multiply */
+} tinyml_op_t;
+
+/* ============================================================================
+ * Model Blob Structures
+ * ============================================================================ */
+
+/* Blob header */
+typedef struct {
+    uint32_t magic;                         /* TINYML_MODEL_MAGIC */
+    uint16_t format_version;                /* TINYML_MODEL_FORMAT_VERSION */
+    uint16_t num_layers;                    /* Number of layer descriptors */
+    uint32_t total_size;                    /* Blob size in bytes */
+    uint16_t input_length;                  /* Input length (time steps) */
+    uint16_t input_channels;                /* Input channels */
+    uint16_t output_size;                   /* Output element count */
+    uint16_t reserved;                      /* Must be zero */
+    float input_scale;                      /* Input quantization scale */
+    int32_t input_zero_point;               /* Input quantization zero point */
+    float output_scale;                     /* Output quantization scale */
+    int32_t output_zero_point;              /* Output quantization zero point */
+    uint32_t checksum;                      /* CRC-32 of the blob after the header */
+} tinyml_model_header_t;
+
+/* Layer descriptor */
+typedef struct {
+    uint8_t op;                             /* tinyml_op_t */
+    uint8_t input_tensor;                   /* Input tensor index */
+    uint8_t aux_tensor;                     /* Second input (ADD/MUL) or TINYML_MODEL_TENSOR_NONE */
+    uint8_t kernel_size;                    /* Kernel or pool size */
+    uint8_t stride;                         /* Stride */
+    uint8_t pad;                            /* Zero padding on each side */
+    int8_t activation_min;                  /* Fused activation lower clamp */
+    int8_t activation_max;                  /* Fused activation upper clamp */
+    uint16_t input_length;                  /* Input length */
+    uint16_t input_channels;                /* Input channels */
+    uint16_t output_length;                 /* Output length */
+    uint16_t output_channels;               /* Output channels */
+    int32_t input_offset;                   /* Negated input zero point */
+    int32_t input2_offset;                  /* Negated zero point of aux tensor */
+    int32_t output_offset;                  /* Output zero point */
+    int32_t left_shift;                     /* ADD headroom shift */
+    tinyml_quant_multiplier_t output_multiplier; /* Output rescale */
+    tinyml_quant_multiplier_t input1_multiplier; /* ADD input 1 rescale */
+    tinyml_quant_multiplier_t input2_multiplier; /* ADD input 2 rescale */
+    float input_scale;                      /* Input scale (SOFTMAX) */
+    uint32_t weights_offset;                /* Weights offset in blob (0 = none) */
+    uint32_t bias_offset;                   /* Bias offset in blob (0 = none) */
+} tinyml_layer_desc_t;
+
+/* ============================================================================
+ * Interpreter Structures
+ * ============================================================================ */
+
+/* Parsed model; references the blob, never copies it */
+typedef struct {
+    const uint8_t *blob;                    /* Model blob */
+    const tinyml_model_header_t *header;    /* Blob header */
+    const tinyml_layer_desc_t *layers;      /* Layer descriptors */
+    uint8_t num_tensors;                    /* Input plus one per layer */
+    uint32_t tensor_size[TINYML_MODEL_MAX_TENSORS];   /* Tensor sizes in bytes */
+    uint32_t tensor_offset[TINYML_MODEL_MAX_TENSORS]; /* Tensor offsets in the arena */
+    uint8_t tensor_first_use[TINYML_MODEL_MAX_TENSORS]; /* Layer producing the tensor */
+    uint8_t tensor_last_use[TINYML_MODEL_MAX_TENSORS];  /* Last layer reading the tensor */
+    uint32_t arena_required;                /* Arena bytes needed to invoke (planned peak) */
+    uint32_t peak_live_bytes;               /* Largest sum of simultaneously live tensors */
+    uint32_t total_macs;                    /* Multiply-accumulates per inference */
+    uint32_t layer_macs[TINYML_MODEL_MAX_LAYERS];        /* Multiply-accumulates per layer */
+    uint32_t layer_arena_extent[TINYML_MODEL_MAX_LAYERS]; /* Arena bytes in use while each layer runs */
+} tinyml_model_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Compute a CRC-32 (IEEE 802.3)
+ *
+ * Pass 0 as crc to start; pass the previous result to continue over
+ * further data.
+ *
+ * @param crc Running CRC
+ * @param data Data to add
+ * @param length Data length in bytes
+ * @return Updated CRC
+ */
+uint32_t tinyml_model_crc32(uint32_t crc, const uint8_t *data, uint32_t length);
+
+/**
+ * @brief Parse and validate a model blob
+ *
+ * Checks the header and its checksum, every layer's shapes against its
+ * input tensors and the bounds of all weight and bias references.
+ *
+ * @param data Pointer to model blob (4-byte aligned)
+ * @param size Blob size in bytes
+ * @param model Pointer to model structure to fill
+ * @return true if blob is valid, false otherwise
+ */
+bool tinyml_model_parse(const uint8_t *data, uint32_t size, tinyml_model_t *model);
+
+/**
+ * @brief Assign arena offsets to every tensor of a parsed model
+ *
+ * Computes tensor lifetimes and packs the tensors greedily by size and
+ * lifetime. arena_required is the planned peak; peak_live_bytes is the lower
+ * bound any plan could reach and shows how much fragmentation costs.
+ *
+ * @param model Pointer to parsed model
+ * @return true if planning successful, false otherwise
+ */
+bool tinyml_model_plan(tinyml_model_t *model);
+
+/**
+ * @brief Run a planned model
+ *
+ * With layer_cycles set, each layer is timed with the profiler timebase
+ * (tinyml_profiler.h); the two counter reads per layer are the only cost.
+ *
+ * @param model Pointer to planned model
+ * @param arena Tensor arena (4-byte aligned)
+ * @param arena_size Arena size in bytes
+ * @param input Quantized input [input_length][input_channels] (may be the arena's input tensor)
+ * @param output Quantized output [output_size] (may be the arena's output tensor)
+ * @param layer_cycles Cycles per layer [num_layers], or NULL to skip timing
+ * @return true if inference successful, false otherwise
+ */
+bool tinyml_model_invoke(const tinyml_model_t *model, uint8_t *arena, uint32_t arena_size,
+                         const int8_t *input, int8_t *output, uint32_t *layer_cycles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_TINYML_MODEL_H */
@@ -0,0 +1,580 @@
+/**
+ * @file tinyml_model_store.c
+ * @brief Flash Model Store Implementation
+ *
+ * This file contains the A/B slot store that keeps TinyML model packages in
+ * flash for execute-in-place loading, and the streaming over-the-air update
+ * with atomic activation and rollback.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "tinyml_model_store.h"
+#include "tinyml_model.h"
+#include "../event_system.h"
+#include <string.h>
+
+/* ============================================================================
+ * Flash Backend
+ * ============================================================================ */
+
+/* Slots live in the edge MCU's flash, or in RAM for host builds (-DTINYML_STORE_HOST).
+ * Other targets, such as the sensor MCUs, have no slots and the store stays uninitialized. */
+#if defined(STM32F407xx)
+#define STORE_BACKEND_FLASH
+#elif defined(TINYML_STORE_HOST)
+#define STORE_BACKEND_RAM
+#endif
+
+#if defined(STORE_BACKEND_FLASH)
+/* STM32F407 sectors 10 and 11 (128 KB each) hold the two slots */
+#ifndef TINYML_STORE_SLOT0_ADDRESS
+#define TINYML_STORE_SLOT0_ADDRESS  0x080C0000UL
+#define TINYML_STORE_SLOT0_SECTOR   10U
+#define TINYML_STORE_SLOT1_ADDRESS  0x080E0000UL
+#define TINYML_STORE_SLOT1_SECTOR   11U
+#endif
+
+#define FLASH_ACR_REG               (*(volatile uint32_t *)0x40023C00UL)
+#define FLASH_KEYR_REG              (*(volatile uint32_t *)0x40023C04UL)
+#define FLASH_SR_REG                (*(volatile uint32_t *)0x40023C0CUL)
+#define FLASH_CR_REG                (*(volatile uint32_t *)0x40023C10UL)
+
+#define FLASH_KEY1                  0x45670123UL
+#define FLASH_KEY2                  0xCDEF89ABUL
+#define FLASH_CR_PG                 (1UL << 0)
+#define FLASH_CR_SER                (1UL << 1)
+#define FLASH_CR_SNB_MASK           (0xFUL << 3)
+#define FLASH_CR_PSIZE_MASK         (3UL << 8)
+#define FLASH_CR_PSIZE_X32          (2UL << 8)
+#define FLASH_CR_STRT               (1UL << 16)
+#define FLASH_CR_LOCK               (1UL << 31)
+#define FLASH_SR_BSY                (1UL << 16)
+#define FLASH_SR_ERRORS             0xF2UL      /* OPERR, WRPERR, PGAERR, PGPERR, PGSERR */
+#define FLASH_ACR_DCEN              (1UL << 10)
+#define FLASH_ACR_DCRST             (1UL << 12)
+
+static const uint32_t slot_address[TINYML_STORE_NUM_SLOTS] = {
+    TINYML_STORE_SLOT0_ADDRESS, TINYML_STORE_SLOT1_ADDRESS
+};
+static const uint32_t slot_sector[TINYML_STORE_NUM_SLOTS] = {
+    TINYML_STORE_SLOT0_SECTOR, TINYML_STORE_SLOT1_SECTOR
+};
+#elif defined(STORE_BACKEND_RAM)
+/* Host builds keep the slots in RAM with NOR flash semantics */
+static uint32_t flash_emulation[TINYML_STORE_NUM_SLOTS][TINYML_STORE_SLOT_SIZE / sizeof(uint32_t)];
+#endif
+
+/**
+ * @brief Get the memory-mapped base of a slot
+ *
+ * @param slot Slot index
+ * @return Slot base address
+ */
+static const uint8_t *flash_slot_base(uint8_t slot) {
+#if defined(STORE_BACKEND_FLASH)
+    return (const uint8_t *)(uintptr_t)slot_address[slot];
+#elif defined(STORE_BACKEND_RAM)
+    return (const uint8_t *)flash_emulation[slot];
+#else
+    (void)slot;
+    return NULL;
+#endif
+}
+
+#if defined(STORE_BACKEND_FLASH)
+/**
+ * @brief Wait for the flash controller and collect its error flags
+ *
+ * @return true if the last operation succeeded, false otherwise
+ */
+static bool flash_wait(void) {
+    while (FLASH_SR_REG & FLASH_SR_BSY) {
+    }
+
+    uint32_t errors = FLASH_SR_REG & FLASH_SR_ERRORS;
+    FLASH_SR_REG = errors;                  /* Write-one-to-clear */
+    return errors == 0;
+}
+
+/**
+ * @brief Relock the flash controller and drop stale data cache lines
+ */
+static void flash_lock(void) {
+    FLASH_CR_REG |= FLASH_CR_LOCK;
+
+    FLASH_ACR_REG &= ~FLASH_ACR_DCEN;
+    FLASH_ACR_REG |= FLASH_ACR_DCRST;
+    FLASH_ACR_REG &= ~FLASH_ACR_DCRST;
+    FLASH_ACR_REG |= FLASH_ACR_DCEN;
+}
+
+/**
+ * @brief Unlock the flash controller
+ *
+ * @return true if unlocked, false otherwise
+ */
+static bool flash_unlock(void) {
+    if (FLASH_CR_REG & FLASH_CR_LOCK) {
+        FLASH_KEYR_REG = FLASH_KEY1;
+        FLASH_KEYR_REG = FLASH_KEY2;
+    }
+    return (FLASH_CR_REG & FLASH_CR_LOCK) == 0 && flash_wait();
+}
+#endif
+
+/**
+ * @brief Erase a slot
+ *
+ * @param slot Slot index
+ * @return true if erase successful, false otherwise
+ */
+static bool flash_erase_slot(uint8_t slot) {
+#if defined(STORE_BACKEND_FLASH)
+    if (!flash_unlock()) {
+        return false;
+    }
+
+    FLASH_CR_REG = (FLASH_CR_REG & ~(FLASH_CR_SNB_MASK | FLASH_CR_PSIZE_MASK)) |
+                   FLASH_CR_PSIZE_X32 | FLASH_CR_SER | (slot_sector[slot] << 3);
+    FLASH_CR_REG |= FLASH_CR_STRT;
+    bool success = flash_wait();
+    FLASH_CR_REG &= ~(FLASH_CR_SER | FLASH_CR_SNB_MASK);
+
+    flash_lock();
+    return success;
+#elif defined(STORE_BACKEND_RAM)
+    memset(flash_emulation[slot], 0xFF, sizeof(flash_emulation[slot]));
+    return true;
+#else
+    (void)slot;
+    return false;
+#endif
+}
+
+/**
+ * @brief Program words into a slot
+ *
+ * Programming can only clear bits, which the commit word relies on.
+ *
+ * @param slot Slot index
+ * @param offset Byte offset in the slot (4-byte aligned)
+ * @param words Words to program
+ * @param num_words Number of words
+ * @return true if the words read back correctly, false otherwise
+ */
+static bool flash_program(uint8_t slot, uint32_t offset, const uint32_t *words, uint32_t num_words) {
+    if ((offset % sizeof(uint32_t)) != 0 || offset > TINYML_STORE_SLOT_SIZE ||
+        num_words > (TINYML_STORE_SLOT_SIZE - offset) / sizeof(uint32_t)) {
+        return false;
+    }
+
+    const uint8_t *base = flash_slot_base(slot);
+    if (!base) {
+        return false;
+    }
+
+    volatile uint32_t *target = (volatile uint32_t *)(base + offset);
+    bool success = true;
+
+#if defined(STORE_BACKEND_FLASH)
+    if (!flash_unlock()) {
+        return false;
+    }
+
+    FLASH_CR_REG = (FLASH_CR_REG & ~FLASH_CR_PSIZE_MASK) | FLASH_CR_PSIZE_X32 | FLASH_CR_PG;
+    for (uint32_t i = 0; i < num_words && success; i++) {
+        target[i] = words[i];
+        success = flash_wait();
+    }
+    FLASH_CR_REG &= ~FLASH_CR_PG;
+
+    flash_lock();
+#else
+    for (uint32_t i = 0; i < num_words; i++) {
+        target[i] &= words[i];
+    }
+#endif
+
+    for (uint32_t i = 0; i < num_words && success; i++) {
+        success = (target[i] == words[i]);
+    }
+    return success;
+}
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+static bool store_initialized = false;
+static uint8_t active_slot = TINYML_STORE_NO_SLOT;
+static uint32_t active_generation = 0;
+
+/* Update in progress */
+static struct {
+    bool in_progress;
+    uint8_t slot;
+    uint32_t package_size;
+    uint32_t bytes_written;                 /* Bytes received, including the pending tail */
+    uint8_t tail[sizeof(uint32_t)];         /* Bytes of a partially received word */
+    uint8_t tail_length;
+} update;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Get a slot's record
+ */
+static const tinyml_store_slot_record_t *slot_record(uint8_t slot) {
+    return (const tinyml_store_slot_record_t *)flash_slot_base(slot);
+}
+
+/**
+ * @brief Get a slot's package
+ */
+static const uint8_t *slot_package(uint8_t slot) {
+    const uint8_t *base = flash_slot_base(slot);
+    return base ? base + sizeof(tinyml_store_slot_record_t) : NULL;
+}
+
+/**
+ * @brief Check a package directory and every blob it references
+ *
+ * @param package Package data
+ * @param package_size Package size in bytes
+ * @return true if the package is valid, false otherwise
+ */
+static bool validate_package(const uint8_t *package, uint32_t package_size) {
+    if (!package || package_size < sizeof(tinyml_store_package_header_t)) {
+        return false;
+    }
+
+    const tinyml_store_package_header_t *header = (const tinyml_store_package_header_t *)package;
+    if (header->magic != TINYML_STORE_PACKAGE_MAGIC ||
+        header->format_version != TINYML_STORE_PACKAGE_VERSION ||
+        header->num_models == 0 || header->num_models > TINYML_MAX_MODELS) {
+        return false;
+    }
+
+    uint32_t directory_size = (uint32_t)sizeof(tinyml_store_package_header_t) +
+                              header->num_models * (uint32_t)sizeof(tinyml_store_package_entry_t);
+    if (directory_size > package_size) {
+        return false;
+    }
+
+    const tinyml_store_package_entry_t *entries =
+        (const tinyml_store_package_entry_t *)(package + sizeof(tinyml_store_package_header_t));
+    bool type_seen[TINYML_MAX_MODELS] = { false };
+
+    for (uint16_t i = 0; i < header->num_models; i++) {
+        const tinyml_store_package_entry_t *entry = &entries[i];
+        tinyml_model_t model;
+
+        if (entry->model_type >= TINYML_MAX_MODELS || type_seen[entry->model_type] ||
+            entry->reserved != 0 || (entry->offset % sizeof(uint32_t)) != 0 ||
+            entry->offset < directory_size || entry->offset > package_size ||
+            entry->size == 0 || entry->size > TINYML_MAX_MODEL_SIZE ||
+            entry->size > package_size - entry->offset) {
+            return false;
+        }
+        type_seen[entry->model_type] = true;
+
+        /* Checks the blob's own checksum as well as its structure */
+        if (!tinyml_model_parse(package + entry->offset, entry->size, &model)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check whether a slot holds a committed, intact package
+ *
+ * @param slot Slot index
+ * @return true if the slot can be activated, false otherwise
+ */
+static bool slot_valid(uint8_t slot) {
+    const tinyml_store_slot_record_t *record = slot_record(slot);
+
+    if (!record || record->magic != TINYML_STORE_SLOT_MAGIC ||
+        record->state != TINYML_STORE_STATE_COMMITTED ||
+        record->package_size > TINYML_STORE_SLOT_SIZE - sizeof(tinyml_store_slot_record_t)) {
+        return false;
+    }
+
+    return tinyml_model_crc32(0, slot_package(slot), record->package_size) == record->package_crc;
+}
+
+/**
+ * @brief Get the directory of a slot's package
+ */
+static const tinyml_store_package_entry_t *slot_entries(uint8_t slot, uint16_t *num_models) {
+    const tinyml_store_package_header_t *header = (const tinyml_store_package_header_t *)slot_package(slot);
+
+    *num_models = header->num_models;
+    return (const tinyml_store_package_entry_t *)(slot_package(slot) + sizeof(tinyml_store_package_header_t));
+}
+
+/**
+ * @brief Unload the models of a slot's package from the engine
+ *
+ * @param slot Slot index
+ */
+static void unload_slot_models(uint8_t slot) {
+    uint16_t num_models;
+    const tinyml_store_package_entry_t *entries = slot_entries(slot, &num_models);
+
+    for (uint16_t i = 0; i < num_models; i++) {
+        tinyml_unload_model((tinyml_model_type_t)entries[i].model_type);
+    }
+}
+
+/**
+ * @brief Load the models of a slot's package in place
+ *
+ * On failure the models loaded so far are unloaded again.
+ *
+ * @param slot Slot index
+ * @return true if all models loaded, false otherwise
+ */
+static bool load_slot_models(uint8_t slot) {
+    uint16_t num_models;
+    const tinyml_store_package_entry_t *entries = slot_entries(slot, &num_models);
+    const uint8_t *package = slot_package(slot);
+
+    for (uint16_t i = 0; i < num_models; i++) {
+        tinyml_model_type_t model_type = (tinyml_model_type_t)entries[i].model_type;
+
+        tinyml_unload_model(model_type);
+        if (!tinyml_load_model(model_type, package + entries[i].offset, entries[i].size, NULL)) {
+            for (uint16_t j = 0; j <= i; j++) {
+                tinyml_unload_model((tinyml_model_type_t)entries[j].model_type);
+            }
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Program buffered package bytes, padding a final partial word
+ *
+ * @param pad Program a partial tail word padded with erased bytes
+ * @return true if programming successful, false otherwise
+ */
+static bool flush_tail(bool pad) {
+    if (update.tail_length == 0 || (!pad && update.tail_length < sizeof(uint32_t))) {
+        return true;
+    }
+
+    uint32_t word = TINYML_STORE_STATE_ERASED;
+    memcpy(&word, update.tail, update.tail_length);
+
+    uint32_t offset = (uint32_t)sizeof(tinyml_store_slot_record_t) + update.bytes_written - update.tail_length;
+    update.tail_length = 0;
+    return flash_program(update.slot, offset, &word, 1);
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Initialize the model store
+ */
+bool tinyml_model_store_init(void) {
+#if !defined(STORE_BACKEND_FLASH) && !defined(STORE_BACKEND_RAM)
+    return false;
+#endif
+
+    active_slot = TINYML_STORE_NO_SLOT;
+    active_generation = 0;
+    memset(&update, 0, sizeof(update));
+
+    for (uint8_t slot = 0; slot < TINYML_STORE_NUM_SLOTS; slot++) {
+        if (!slot_valid(slot)) {
+            continue;
+        }
+        uint32_t generation = slot_record(slot)->generation;
+        if (active_slot == TINYML_STORE_NO_SLOT || generation > active_generation) {
+            active_slot = slot;
+            active_generation = generation;
+        }
+    }
+
+    store_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Load every model of the active package into the engine
+ */
+bool tinyml_model_store_load_models(void) {
+    if (!store_initialized || active_slot == TINYML_STORE_NO_SLOT) {
+        return false;
+    }
+
+    return load_slot_models(active_slot);
+}
+
+/**
+ * @brief Start writing a new package to the inactive slot
+ */
+bool tinyml_model_store_begin_update(uint32_t package_size) {
+    if (!store_initialized || package_size < sizeof(tinyml_store_package_header_t) ||
+        package_size > TINYML_STORE_SLOT_SIZE - sizeof(tinyml_store_slot_record_t)) {
+        return false;
+    }
+
+    /* Only the active slot's models can be loaded, so the other slot is free */
+    uint8_t slot = (active_slot == 0) ? 1 : 0;
+    memset(&update, 0, sizeof(update));
+    if (!flash_erase_slot(slot)) {
+        return false;
+    }
+
+    update.in_progress = true;
+    update.slot = slot;
+    update.package_size = package_size;
+    return true;
+}
+
+/**
+ * @brief Write the next chunk of the package
+ */
+bool tinyml_model_store_write(uint32_t offset, const uint8_t *data, uint32_t length) {
+    if (!update.in_progress || !data || offset != update.bytes_written ||
+        length > update.package_size - update.bytes_written) {
+        return false;
+    }
+
+    while (length > 0) {
+        /* Complete a pending partial word first */
+        if (update.tail_length > 0 || length < sizeof(uint32_t)) {
+            update.tail[update.tail_length++] = *data++;
+            update.bytes_written++;
+            length--;
+            if (!flush_tail(false)) {
+                update.in_progress = false;
+                return false;
+            }
+            continue;
+        }
+
+        /* Program whole words straight from the chunk */
+        uint32_t words[16];
+        uint32_t num_words = length / sizeof(uint32_t);
+        if (num_words > sizeof(words) / sizeof(words[0])) {
+            num_words = sizeof(words) / sizeof(words[0]);
+        }
+        memcpy(words, data, num_words * sizeof(uint32_t));
+
+        uint32_t flash_offset = sizeof(tinyml_store_slot_record_t) + update.bytes_written;
+        if (!flash_program(update.slot, flash_offset, words, num_words)) {
+            update.in_progress = false;
+            return false;
+        }
+
+        data += num_words * sizeof(uint32_t);
+        update.bytes_written += num_words * (uint32_t)sizeof(uint32_t);
+        length -= num_words * (uint32_t)sizeof(uint32_t);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Verify, commit and activate the written package
+ */
+bool tinyml_model_store_commit_update(void) {
+    if (!update.in_progress || update.bytes_written != update.package_size) {
+        return false;
+    }
+
+    uint8_t slot = update.slot;
+    update.in_progress = false;
+
+    if (!flush_tail(true) || !validate_package(slot_package(slot), update.package_size)) {
+        esocore_event_log_message(ESOCORE_EVENT_NETWORK_OTA, ESOCORE_EVENT_SEVERITY_WARNING,
+                                  "Model package rejected", NULL, 0);
+        return false;
+    }
+
+    /* Record first, commit word last: a reset in between leaves the slot uncommitted */
+    tinyml_store_slot_record_t record;
+    memset(&record, 0xFF, sizeof(record));
+    record.magic = TINYML_STORE_SLOT_MAGIC;
+    record.generation = active_generation + 1;
+    record.package_size = update.package_size;
+    record.package_crc = tinyml_model_crc32(0, slot_package(slot), update.package_size);
+
+    uint32_t commit = TINYML_STORE_STATE_COMMITTED;
+    if (!flash_program(slot, 0, (const uint32_t *)&record,
+                       (sizeof(record) - sizeof(record.state)) / sizeof(uint32_t)) ||
+        !flash_program(slot, sizeof(record) - sizeof(record.state), &commit, 1)) {
+        return false;
+    }
+
+    /* Swap: the previous package's models go, the new ones execute from flash */
+    uint8_t previous_slot = active_slot;
+    if (previous_slot != TINYML_STORE_NO_SLOT) {
+        unload_slot_models(previous_slot);
+    }
+
+    if (!load_slot_models(slot)) {
+        uint32_t revoke = TINYML_STORE_STATE_REVOKED;
+        flash_program(slot, sizeof(record) - sizeof(record.state), &revoke, 1);
+
+        if (previous_slot != TINYML_STORE_NO_SLOT) {
+            load_slot_models(previous_slot);
+        }
+        esocore_event_log_message(ESOCORE_EVENT_NETWORK_OTA, ESOCORE_EVENT_SEVERITY_WARNING,
+                                  "Model package failed to load, rolled back", NULL, 0);
+        return false;
+    }
+
+    active_slot = slot;
+    active_generation = record.generation;
+    esocore_event_log_message(ESOCORE_EVENT_NETWORK_OTA, ESOCORE_EVENT_SEVERITY_INFO,
+                              "Model package activated", NULL, 0);
+    return true;
+}
+
+/**
+ * @brief Abandon an update in progress
+ */
+bool tinyml_model_store_abort_update(void) {
+    if (!update.in_progress) {
+        return false;
+    }
+
+    /* The slot was never committed, so it stays inactive as written */
+    memset(&update, 0, sizeof(update));
+    return true;
+}
+
+/**
+ * @brief Get model store status
+ */
+bool tinyml_model_store_get_status(tinyml_store_status_t *status) {
+    if (!status || !store_initialized) {
+        return false;
+    }
+
+    memset(status, 0, sizeof(tinyml_store_status_t));
+    status->active_slot = active_slot;
+    status->active_generation = active_generation;
+    if (active_slot != TINYML_STORE_NO_SLOT) {
+        slot_entries(active_slot, &status->active_models);
+    }
+    status->update_in_progress = update.in_progress;
+    status->update_bytes_written = update.bytes_written;
+    status->update_package_size = update.package_size;
+    return true;
+}
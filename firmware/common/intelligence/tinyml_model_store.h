@@ -0,0 +1,167 @@
+/**
+ * @file tinyml_model_store.h
+ * @brief Flash Model Store with Atomic Over-the-Air Updates
+ *
+ * This file defines the flash store that keeps the TinyML model blobs so the
+ * engine can execute them in place. The store has two slots (A/B). Each slot
+ * holds one model package: a small directory followed by the model blobs,
+ * each 4-byte aligned within the package.
+ *
+ * An update streams a new package into the inactive slot, verifies it and
+ * only then writes the slot's commit word. The slot with the highest
+ * committed generation is active, so a reset at any point leaves either the
+ * old or the new package active, never a partial one. If the engine rejects
+ * the new models, the new slot is revoked and the old package is reloaded.
+ *
+ * Slot layout:
+ *   [tinyml_store_slot_record_t][package header][entries][blobs ...]
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_TINYML_MODEL_STORE_H
+#define ESOCORE_TINYML_MODEL_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tinyml_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Model Store Configuration
+ * ============================================================================ */
+
+#define TINYML_STORE_NUM_SLOTS            2
+#define TINYML_STORE_SLOT_SIZE            (128 * 1024)  /* One STM32F407 128 KB sector per slot */
+#define TINYML_STORE_SLOT_MAGIC           0x534D5345    /* "ESMS" */
+#define TINYML_STORE_PACKAGE_MAGIC        0x504D5345    /* "ESMP" */
+#define TINYML_STORE_PACKAGE_VERSION      1
+#define TINYML_STORE_NO_SLOT              0xFF
+
+/* Slot commit word values; programming only clears bits, so each state can
+ * follow the previous one without an erase */
+#define TINYML_STORE_STATE_ERASED         0xFFFFFFFFUL
+#define TINYML_STORE_STATE_COMMITTED      0x5AA5C33CUL
+#define TINYML_STORE_STATE_REVOKED        0x00000000UL
+
+/* ============================================================================
+ * Model Store Structures
+ * ============================================================================ */
+
+/* Slot record written by the device at the start of each slot */
+typedef struct {
+    uint32_t magic;                         /* TINYML_STORE_SLOT_MAGIC */
+    uint32_t generation;                    /* Highest committed generation is active */
+    uint32_t package_size;                  /* Package bytes following the record */
+    uint32_t package_crc;                   /* CRC-32 of the package */
+    uint32_t reserved[3];                   /* Erased */
+    uint32_t state;                         /* Commit word, written last */
+} tinyml_store_slot_record_t;
+
+/* Package header, as delivered over the air */
+typedef struct {
+    uint32_t magic;                         /* TINYML_STORE_PACKAGE_MAGIC */
+    uint16_t format_version;                /* TINYML_STORE_PACKAGE_VERSION */
+    uint16_t num_models;                    /* Directory entries that follow */
+} tinyml_store_package_header_t;
+
+/* Package directory entry */
+typedef struct {
+    uint16_t model_type;                    /* tinyml_model_type_t */
+    uint16_t reserved;                      /* Must be zero */
+    uint32_t offset;                        /* Blob offset in the package (4-byte aligned) */
+    uint32_t size;                          /* Blob size in bytes */
+} tinyml_store_package_entry_t;
+
+/* Store status */
+typedef struct {
+    uint8_t active_slot;                    /* Active slot or TINYML_STORE_NO_SLOT */
+    uint32_t active_generation;             /* Generation of the active package */
+    uint16_t active_models;                 /* Models in the active package */
+    bool update_in_progress;                /* Package being written */
+    uint32_t update_bytes_written;          /* Bytes received for the update */
+    uint32_t update_package_size;           /* Expected update size */
+} tinyml_store_status_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Initialize the model store
+ *
+ * Scans both slots and selects the committed package with the highest
+ * generation whose checksum matches.
+ *
+ * @return true if initialization successful, false otherwise
+ */
+bool tinyml_model_store_init(void);
+
+/**
+ * @brief Load every model of the active package into the engine
+ *
+ * Models are loaded in place from flash. Models of the same type that are
+ * already loaded are replaced.
+ *
+ * @return true if all models loaded, false otherwise
+ */
+bool tinyml_model_store_load_models(void);
+
+/**
+ * @brief Start writing a new package to the inactive slot
+ *
+ * Erases the inactive slot, which stalls flash reads for the erase time.
+ *
+ * @param package_size Package size in bytes
+ * @return true if update started, false otherwise
+ */
+bool tinyml_model_store_begin_update(uint32_t package_size);
+
+/**
+ * @brief Write the next chunk of the package
+ *
+ * Chunks must arrive in order but may have any length.
+ *
+ * @param offset Offset of the chunk in the package
+ * @param data Chunk data
+ * @param length Chunk length in bytes
+ * @return true if chunk written, false otherwise
+ */
+bool tinyml_model_store_write(uint32_t offset, const uint8_t *data, uint32_t length);
+
+/**
+ * @brief Verify, commit and activate the written package
+ *
+ * The package is validated, committed and its models swapped into the
+ * engine. If any model fails to load, the new slot is revoked and the
+ * previous package is reloaded.
+ *
+ * @return true if the new package is active, false otherwise
+ */
+bool tinyml_model_store_commit_update(void);
+
+/**
+ * @brief Abandon an update in progress
+ *
+ * @return true if update abandoned, false otherwise
+ */
+bool tinyml_model_store_abort_update(void);
+
+/**
+ * @brief Get model store status
+ *
+ * @param status Pointer to status structure to fill
+ * @return true if status retrieved successfully, false otherwise
+ */
+bool tinyml_model_store_get_status(tinyml_store_status_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_TINYML_MODEL_STORE_H */
@@ -0,0 +1,237 @@
+/**
+ * @file tinyml_profiler.c
+ * @brief Per-Layer Inference Profiling Implementation
+ *
+ * This file contains the cycle timebase, the latency accumulators and the
+ * JSON export of model profiles.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#if defined(TINYML_HOST_BUILD)
+#define _POSIX_C_SOURCE 199309L                 /* clock_gettime() */
+#endif
+
+#include "tinyml_profiler.h"
+#include <string.h>
+#include <stdio.h>
+
+#if defined(TINYML_HOST_BUILD)
+#include <time.h>
+#else
+/* HAL millisecond tick, driven by SysTick */
+uint32_t HAL_GetTick(void);
+#if defined(__ARM_ARCH_7EM__)
+/* Cortex-M4 DWT cycle counter */
+#define DEMCR_REG                   (*(volatile uint32_t *)0xE000EDFCUL)
+#define DWT_CTRL_REG                (*(volatile uint32_t *)0xE0001000UL)
+#define DWT_CYCCNT_REG              (*(volatile uint32_t *)0xE0001004UL)
+#else
+/* Cores without DWT (Cortex-M0+): SysTick counts down through each HAL millisecond */
+#define SYST_RVR_REG                (*(volatile uint32_t *)0xE000E014UL)
+#define SYST_CVR_REG                (*(volatile uint32_t *)0xE000E018UL)
+#endif
+#endif
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Reset cycle statistics
+ *
+ * @param stats Pointer to statistics
+ */
+static void cycle_stats_reset(tinyml_cycle_stats_t *stats) {
+    memset(stats, 0, sizeof(tinyml_cycle_stats_t));
+    dsp_quantile_init(&stats->p99, TINYML_PROFILER_QUANTILE);
+}
+
+/**
+ * @brief Add one timed run to cycle statistics
+ *
+ * @param stats Pointer to statistics
+ * @param cycles Cycles of the run
+ */
+static void cycle_stats_update(tinyml_cycle_stats_t *stats, uint32_t cycles) {
+    if (stats->runs == 0 || cycles < stats->min_cycles) {
+        stats->min_cycles = cycles;
+    }
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+    stats->runs++;
+    stats->total_cycles += cycles;
+    dsp_quantile_update(&stats->p99, (float)cycles);
+}
+
+/**
+ * @brief Get the mean of cycle statistics
+ *
+ * @param stats Pointer to statistics
+ * @return Mean cycles (0 if no runs)
+ */
+static uint32_t cycle_stats_mean(const tinyml_cycle_stats_t *stats) {
+    return stats->runs ? (uint32_t)(stats->total_cycles / stats->runs) : 0;
+}
+
+/**
+ * @brief Append formatted JSON to a buffer
+ *
+ * @param buffer Buffer
+ * @param buffer_size Buffer size
+ * @param length Pointer to current length, advanced on success
+ * @param json Text to append
+ * @return true if the text fit, false otherwise
+ */
+static bool json_append(char *buffer, uint16_t buffer_size, uint16_t *length, const char *json) {
+    size_t json_length = strlen(json);
+    if (*length + json_length >= buffer_size) {
+        return false;
+    }
+    memcpy(&buffer[*length], json, json_length + 1);
+    *length = (uint16_t)(*length + json_length);
+    return true;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Start the cycle timebase
+ */
+void tinyml_profiler_init(void) {
+#if !defined(TINYML_HOST_BUILD) && defined(__ARM_ARCH_7EM__)
+    DEMCR_REG |= (1UL << 24);               /* TRCENA */
+    DWT_CTRL_REG |= 1UL;                    /* CYCCNTENA */
+#endif
+}
+
+/**
+ * @brief Read the cycle timebase
+ */
+uint32_t tinyml_profiler_get_cycles(void) {
+#if defined(TINYML_HOST_BUILD)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec);
+#elif defined(__ARM_ARCH_7EM__)
+    return DWT_CYCCNT_REG;
+#else
+    /* Re-read if the millisecond tick advanced between the two reads */
+    uint32_t tick_ms, count;
+    do {
+        tick_ms = HAL_GetTick();
+        count = SYST_CVR_REG;
+    } while (tick_ms != HAL_GetTick());
+
+    uint32_t reload = SYST_RVR_REG + 1U;
+    return tick_ms * reload + (reload - 1U - count);
+#endif
+}
+
+/**
+ * @brief Read the millisecond clock
+ */
+uint32_t tinyml_profiler_get_time_ms(void) {
+#if defined(TINYML_HOST_BUILD)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000ULL + (uint64_t)now.tv_nsec / 1000000ULL);
+#else
+    return HAL_GetTick();
+#endif
+}
+
+/**
+ * @brief Reset a profile for a model
+ */
+bool tinyml_profiler_reset(tinyml_model_profile_t *profile, const tinyml_model_t *model) {
+    if (!profile) {
+        return false;
+    }
+
+    memset(profile, 0, sizeof(tinyml_model_profile_t));
+    cycle_stats_reset(&profile->cycles);
+
+    if (model && model->header) {
+        profile->num_layers = (uint8_t)model->header->num_layers;
+        profile->total_macs = model->total_macs;
+        profile->arena_required = model->arena_required;
+        for (uint8_t i = 0; i < profile->num_layers; i++) {
+            profile->layers[i].op = model->layers[i].op;
+            profile->layers[i].macs = model->layer_macs[i];
+            profile->layers[i].arena_extent = model->layer_arena_extent[i];
+            cycle_stats_reset(&profile->layers[i].cycles);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Add one inference to a profile
+ */
+bool tinyml_profiler_record(tinyml_model_profile_t *profile, uint32_t total_cycles,
+                            const uint32_t *layer_cycles) {
+    if (!profile) {
+        return false;
+    }
+
+    cycle_stats_update(&profile->cycles, total_cycles);
+    if (layer_cycles) {
+        for (uint8_t i = 0; i < profile->num_layers; i++) {
+            cycle_stats_update(&profile->layers[i].cycles, layer_cycles[i]);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Write a profile as compact JSON
+ */
+bool tinyml_profiler_export_json(const tinyml_model_profile_t *profile, uint32_t budget_cycles,
+                                 char *buffer, uint16_t buffer_size) {
+    if (!profile || !buffer || buffer_size == 0) {
+        return false;
+    }
+
+    char json[224];
+    uint16_t length = 0;
+    uint32_t total_mean = cycle_stats_mean(&profile->cycles);
+    buffer[0] = '\0';
+
+    snprintf(json, sizeof(json),
+             "{\"cycles_per_us\":%lu,\"budget\":%lu,\"macs\":%lu,\"arena\":%lu,\"runs\":%lu,"
+             "\"min\":%lu,\"mean\":%lu,\"p99\":%lu,\"max\":%lu,\"layers\":[",
+             (unsigned long)TINYML_PROFILER_CYCLES_PER_US, (unsigned long)budget_cycles,
+             (unsigned long)profile->total_macs, (unsigned long)profile->arena_required,
+             (unsigned long)profile->cycles.runs, (unsigned long)profile->cycles.min_cycles,
+             (unsigned long)total_mean, (unsigned long)dsp_quantile_value(&profile->cycles.p99),
+             (unsigned long)profile->cycles.max_cycles);
+    if (!json_append(buffer, buffer_size, &length, json)) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < profile->num_layers; i++) {
+        const tinyml_layer_profile_t *layer = &profile->layers[i];
+        uint32_t mean = cycle_stats_mean(&layer->cycles);
+        uint32_t share = total_mean ? (uint32_t)((uint64_t)mean * 100U / total_mean) : 0;
+
+        snprintf(json, sizeof(json),
+                 "%s{\"op\":%u,\"macs\":%lu,\"arena\":%lu,\"min\":%lu,\"mean\":%lu,"
+                 "\"p99\":%lu,\"max\":%lu,\"share\":%lu}",
+                 i ? "," : "", (unsigned)layer->op, (unsigned long)layer->macs,
+                 (unsigned long)layer->arena_extent, (unsigned long)layer->cycles.min_cycles,
+                 (unsigned long)mean, (unsigned long)dsp_quantile_value(&layer->cycles.p99),
+                 (unsigned long)layer->cycles.max_cycles, (unsigned long)share);
+        if (!json_append(buffer, buffer_size, &length, json)) {
+            return false;
+        }
+    }
+
+    return json_append(buffer, buffer_size, &length, "]}");
+}
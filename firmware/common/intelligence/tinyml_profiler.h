@@ -0,0 +1,161 @@
+/**
+ * @file tinyml_profiler.h
+ * @brief Per-Layer Inference Profiling for the TinyML Engine
+ *
+ * This file defines the cycle timebase and the per-model, per-layer latency
+ * profiles used to find which layer of a model breaks the inference budget.
+ * Each profile records min, mean, p99 and max cycles for the whole inference
+ * and for every layer, next to each layer's MACs and the arena bytes in use
+ * while it runs.
+ *
+ * On target, cycles are core clock cycles from the Cortex-M4 DWT cycle
+ * counter. On the host, a cycle is one nanosecond of the monotonic clock.
+ * TINYML_PROFILER_CYCLES_PER_US converts either to time.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_TINYML_PROFILER_H
+#define ESOCORE_TINYML_PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tinyml_model.h"
+#include "dsp_stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Profiler Configuration
+ * ============================================================================ */
+
+#ifndef TINYML_CPU_CLOCK_HZ
+#if defined(STM32G031xx)
+#define TINYML_CPU_CLOCK_HZ             64000000UL  /* STM32G031 core clock */
+#else
+#define TINYML_CPU_CLOCK_HZ             168000000UL /* STM32F407 core clock */
+#endif
+#endif
+
+/* Timebase: DWT cycles on the Cortex-M4, SysTick cycles extended by the HAL
+   millisecond tick on cores without DWT, nanoseconds in host builds
+   (-DTINYML_HOST_BUILD) */
+#if defined(TINYML_HOST_BUILD)
+#define TINYML_PROFILER_CYCLES_PER_US   1000UL      /* Host: nanoseconds */
+#else
+#define TINYML_PROFILER_CYCLES_PER_US   (TINYML_CPU_CLOCK_HZ / 1000000UL)
+#endif
+
+/* Target cost model, for budgets checked before a model has run on the device */
+#define TINYML_TARGET_CYCLES_PER_MAC_SIMD       2   /* SMLAD path incl. requantization overhead */
+#define TINYML_TARGET_CYCLES_PER_MAC_REFERENCE  6   /* Reference C path */
+#define TINYML_TARGET_CYCLES_PER_TREE_NODE      8   /* Load, compare, branch per tree level */
+
+#define TINYML_PROFILER_MAX_MODELS      2           /* Models profiled at the same time */
+#define TINYML_PROFILER_QUANTILE        0.99f       /* Tail latency reported as p99 */
+
+/* ============================================================================
+ * Profile Structures
+ * ============================================================================ */
+
+/* Cycle statistics of one timed section */
+typedef struct {
+    uint32_t runs;                          /* Timed runs */
+    uint32_t min_cycles;                    /* Fastest run */
+    uint32_t max_cycles;                    /* Slowest run */
+    uint64_t total_cycles;                  /* Sum of all runs */
+    dsp_quantile_t p99;                     /* Streaming p99 estimate */
+} tinyml_cycle_stats_t;
+
+/* Profile of one layer */
+typedef struct {
+    uint8_t op;                             /* tinyml_op_t */
+    uint32_t macs;                          /* Multiply-accumulates per run */
+    uint32_t arena_extent;                  /* Arena bytes in use while the layer runs */
+    tinyml_cycle_stats_t cycles;            /* Layer cycles */
+} tinyml_layer_profile_t;
+
+/* Profile of one model */
+typedef struct {
+    uint8_t num_layers;                     /* Profiled layers (0 for tree ensembles) */
+    uint32_t total_macs;                    /* Multiply-accumulates per inference */
+    uint32_t arena_required;                /* Arena high-water of the model */
+    tinyml_cycle_stats_t cycles;            /* Whole inference incl. (de)quantization */
+    tinyml_layer_profile_t layers[TINYML_MODEL_MAX_LAYERS];
+} tinyml_model_profile_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Start the cycle timebase
+ *
+ * Enables the DWT cycle counter on the Cortex-M4; elsewhere the HAL's
+ * SysTick or the host clock already runs.
+ */
+void tinyml_profiler_init(void);
+
+/**
+ * @brief Read the cycle timebase
+ *
+ * @return Free-running cycle count (wraps; differences stay valid)
+ */
+uint32_t tinyml_profiler_get_cycles(void);
+
+/**
+ * @brief Read the millisecond clock
+ *
+ * The HAL tick on target, the monotonic clock on the host. Unlike the
+ * cycle count it needs no polling to stay correct and wraps only after
+ * 2^32 ms (about 49.7 days).
+ *
+ * @return Free-running millisecond count (wraps; differences stay valid)
+ */
+uint32_t tinyml_profiler_get_time_ms(void);
+
+/**
+ * @brief Reset a profile for a model
+ *
+ * @param profile Pointer to profile
+ * @param model Pointer to planned model, or NULL to time whole inferences only
+ * @return true if profile reset, false otherwise
+ */
+bool tinyml_profiler_reset(tinyml_model_profile_t *profile, const tinyml_model_t *model);
+
+/**
+ * @brief Add one inference to a profile
+ *
+ * @param profile Pointer to profile
+ * @param total_cycles Cycles of the whole inference
+ * @param layer_cycles Cycles per layer [num_layers], or NULL
+ * @return true if inference recorded, false otherwise
+ */
+bool tinyml_profiler_record(tinyml_model_profile_t *profile, uint32_t total_cycles,
+                            const uint32_t *layer_cycles);
+
+/**
+ * @brief Write a profile as compact JSON
+ *
+ * Writes one object with the timebase, budget, totals and a "layers" array
+ * of {op, macs, arena, min, mean, p99, max, share}; share is the layer's
+ * percentage of the mean inference.
+ *
+ * @param profile Pointer to profile
+ * @param budget_cycles Inference budget in cycles (0 = none)
+ * @param buffer Buffer to write
+ * @param buffer_size Buffer size in bytes
+ * @return true if the JSON fit the buffer, false otherwise
+ */
+bool tinyml_profiler_export_json(const tinyml_model_profile_t *profile, uint32_t budget_cycles,
+                                 char *buffer, uint16_t buffer_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_TINYML_PROFILER_H */
@@ -0,0 +1,213 @@
+/**
+ * @file tinyml_trees.c
+ * @brief Tree Ensemble Evaluator Implementation
+ *
+ * This file contains the parser and evaluator for tree ensemble blobs. All
+ * validation happens at parse time so that evaluation is a tight loop of
+ * one compare and one branch per node.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "tinyml_trees.h"
+#include "tinyml_model.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Validate one tree and measure its depth
+ *
+ * Walks the tree from its root with an explicit stack. Children always lie
+ * after their parent, so the walk terminates, and the visits of all trees
+ * together may not exceed the node count, which bounds the walk. Nodes
+ * shared between branches or trees are not detected as such; they are
+ * accepted while the total stays within that bound.
+ *
+ * @param ensemble Pointer to ensemble being parsed
+ * @param root Root node index
+ * @param visits Pointer to running visit count of all trees
+ * @param depth Pointer to store tree depth
+ * @return true if tree is valid, false otherwise
+ */
+static bool validate_tree(const tinyml_tree_ensemble_t *ensemble, uint32_t root,
+                          uint32_t *visits, uint16_t *depth) {
+    const tinyml_tree_header_t *header = ensemble->header;
+    uint32_t stack_node[TINYML_TREE_MAX_DEPTH + 1];
+    uint16_t stack_depth[TINYML_TREE_MAX_DEPTH + 1];
+    uint8_t top = 0;
+
+    stack_node[0] = root;
+    stack_depth[0] = 0;
+    top = 1;
+    *depth = 0;
+
+    while (top > 0) {
+        top--;
+        uint32_t index = stack_node[top];
+        uint16_t level = stack_depth[top];
+
+        if (index >= header->num_nodes || ++(*visits) > header->num_nodes) {
+            return false;
+        }
+
+        const tinyml_tree_node_t *node = &ensemble->nodes[index];
+        if (node->feature == TINYML_TREE_LEAF) {
+            if (node->right >= header->num_outputs || !isfinite(node->value)) {
+                return false;
+            }
+            if (level > *depth) {
+                *depth = level;
+            }
+            continue;
+        }
+
+        /* The left child follows, so the right one must lie beyond it */
+        if (node->feature >= header->num_features || node->right < 2 || isnan(node->value) ||
+            level >= TINYML_TREE_MAX_DEPTH || top + 2 > TINYML_TREE_MAX_DEPTH + 1) {
+            return false;
+        }
+
+        stack_node[top] = index + node->right;
+        stack_depth[top] = (uint16_t)(level + 1);
+        top++;
+        stack_node[top] = index + 1;
+        stack_depth[top] = (uint16_t)(level + 1);
+        top++;
+    }
+
+    return true;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Check whether a blob holds a tree ensemble
+ */
+bool tinyml_tree_is_ensemble(const uint8_t *data, uint32_t size) {
+    return data && size >= sizeof(uint32_t) && ((uintptr_t)data % sizeof(uint32_t)) == 0 &&
+           *(const uint32_t *)data == TINYML_TREE_MAGIC;
+}
+
+/**
+ * @brief Parse and validate a tree ensemble blob
+ */
+bool tinyml_tree_parse(const uint8_t *data, uint32_t size, tinyml_tree_ensemble_t *ensemble) {
+    if (!ensemble || !tinyml_tree_is_ensemble(data, size) || size < sizeof(tinyml_tree_header_t)) {
+        return false;
+    }
+
+    const tinyml_tree_header_t *header = (const tinyml_tree_header_t *)data;
+    if (header->format_version != TINYML_TREE_FORMAT_VERSION || header->total_size != size ||
+        header->num_trees == 0 || header->num_nodes == 0 ||
+        header->num_features == 0 || header->num_features > TINYML_TREE_MAX_FEATURES ||
+        header->num_outputs == 0 || header->num_outputs > TINYML_TREE_MAX_OUTPUTS ||
+        header->aggregate > TINYML_TREE_AGGREGATE_MEAN || header->transform > TINYML_TREE_TRANSFORM_SOFTMAX ||
+        header->reserved[0] != 0 || header->reserved[1] != 0 || header->reserved[2] != 0) {
+        return false;
+    }
+
+    /* 64-bit arithmetic so that a hostile node count cannot wrap the layout */
+    uint64_t layout_size = (uint64_t)sizeof(tinyml_tree_header_t) +
+                           (uint64_t)header->num_outputs * sizeof(float) +
+                           (uint64_t)header->num_trees * sizeof(uint32_t) +
+                           (uint64_t)header->num_nodes * sizeof(tinyml_tree_node_t);
+    if (layout_size != size) {
+        return false;
+    }
+
+    if (tinyml_model_crc32(0, data + sizeof(tinyml_tree_header_t),
+                           size - (uint32_t)sizeof(tinyml_tree_header_t)) != header->checksum) {
+        return false;
+    }
+
+    const uint8_t *cursor = data + sizeof(tinyml_tree_header_t);
+    memset(ensemble, 0, sizeof(tinyml_tree_ensemble_t));
+    ensemble->header = header;
+    ensemble->base_score = (const float *)cursor;
+    cursor += header->num_outputs * sizeof(float);
+    ensemble->tree_root = (const uint32_t *)cursor;
+    cursor += header->num_trees * sizeof(uint32_t);
+    ensemble->nodes = (const tinyml_tree_node_t *)cursor;
+
+    uint32_t visits = 0;
+    for (uint16_t t = 0; t < header->num_trees; t++) {
+        uint16_t depth;
+        if (!validate_tree(ensemble, ensemble->tree_root[t], &visits, &depth)) {
+            return false;
+        }
+        if (depth > ensemble->max_depth) {
+            ensemble->max_depth = depth;
+        }
+    }
+
+    for (uint8_t o = 0; o < header->num_outputs; o++) {
+        if (!isfinite(ensemble->base_score[o])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Evaluate a tree ensemble
+ */
+bool tinyml_tree_predict(const tinyml_tree_ensemble_t *ensemble, const float *features, float *outputs) {
+    if (!ensemble || !ensemble->header || !features || !outputs) {
+        return false;
+    }
+
+    const tinyml_tree_header_t *header = ensemble->header;
+    const tinyml_tree_node_t *nodes = ensemble->nodes;
+    float sums[TINYML_TREE_MAX_OUTPUTS];
+
+    memset(sums, 0, header->num_outputs * sizeof(float));
+
+    for (uint16_t t = 0; t < header->num_trees; t++) {
+        const tinyml_tree_node_t *node = &nodes[ensemble->tree_root[t]];
+
+        /* NaN compares false and goes right */
+        while (node->feature != TINYML_TREE_LEAF) {
+            node += (features[node->feature] <= node->value) ? 1 : node->right;
+        }
+        sums[node->right] += node->value;
+    }
+
+    float scale = (header->aggregate == TINYML_TREE_AGGREGATE_MEAN) ?
+                  1.0f / (float)header->num_trees : 1.0f;
+    for (uint8_t o = 0; o < header->num_outputs; o++) {
+        outputs[o] = ensemble->base_score[o] + sums[o] * scale;
+    }
+
+    if (header->transform == TINYML_TREE_TRANSFORM_SIGMOID) {
+        for (uint8_t o = 0; o < header->num_outputs; o++) {
+            outputs[o] = 1.0f / (1.0f + expf(-outputs[o]));
+        }
+    } else if (header->transform == TINYML_TREE_TRANSFORM_SOFTMAX) {
+        float max_score = outputs[0];
+        for (uint8_t o = 1; o < header->num_outputs; o++) {
+            if (outputs[o] > max_score) {
+                max_score = outputs[o];
+            }
+        }
+
+        float total = 0.0f;
+        for (uint8_t o = 0; o < header->num_outputs; o++) {
+            outputs[o] = expf(outputs[o] - max_score);
+            total += outputs[o];
+        }
+        for (uint8_t o = 0; o < header->num_outputs; o++) {
+            outputs[o] /= total;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file tinyml_trees.h
+ * @brief Tree Ensemble Models for the TinyML Engine
+ *
+ * This file defines the blob format and evaluator for decision tree
+ * ensembles (gradient-boosted trees and random forests) on engineered
+ * features. Like neural model blobs, tree blobs are used in place and may
+ * live in flash; evaluation needs no tensor arena.
+ *
+ * Blob layout (4-byte aligned, little-endian):
+ *   [tinyml_tree_header_t][float base_score[num_outputs]]
+ *   [uint32_t tree_root[num_trees]][tinyml_tree_node_t nodes[num_nodes]]
+ *
+ * Nodes are stored in pre-order, so a split's left child is the next node
+ * and only the distance to the right child is stored. A split sends a
+ * sample left when feature <= threshold; NaN features go right. Each leaf
+ * adds its value to one output.
+ *
+ * tools/tree_codegen.py builds blobs and can also emit the same ensemble
+ * as straight-line C for a fixed model.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_TINYML_TREES_H
+#define ESOCORE_TINYML_TREES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Tree Format Configuration
+ * ============================================================================ */
+
+#define TINYML_TREE_MAGIC             0x45545345  /* "ESTE" */
+#define TINYML_TREE_FORMAT_VERSION    1
+#define TINYML_TREE_LEAF              0xFFFF      /* Node feature of a leaf */
+#define TINYML_TREE_MAX_FEATURES      256
+#define TINYML_TREE_MAX_OUTPUTS       16
+#define TINYML_TREE_MAX_DEPTH         32          /* Longest root-to-leaf path */
+
+typedef enum {
+    TINYML_TREE_AGGREGATE_SUM       = 0,    /* Boosting: base score plus leaf sum */
+    TINYML_TREE_AGGREGATE_MEAN      = 1,    /* Forest: base score plus leaf sum / trees */
+} tinyml_tree_aggregate_t;
+
+typedef enum {
+    TINYML_TREE_TRANSFORM_NONE      = 0,    /* Raw scores (regression) */
+    TINYML_TREE_TRANSFORM_SIGMOID   = 1,    /* Per-output logistic */
+    TINYML_TREE_TRANSFORM_SOFTMAX   = 2,    /* Softmax across outputs */
+} tinyml_tree_transform_t;
+
+/* ============================================================================
+ * Tree Blob Structures
+ * ============================================================================ */
+
+/* Blob header */
+typedef struct {
+    uint32_t magic;                         /* TINYML_TREE_MAGIC */
+    uint16_t format_version;                /* TINYML_TREE_FORMAT_VERSION */
+    uint16_t num_trees;                     /* Trees in the ensemble */
+    uint32_t total_size;                    /* Blob size in bytes */
+    uint32_t num_nodes;                     /* Nodes of all trees */
+    uint16_t num_features;                  /* Input feature count */
+    uint8_t num_outputs;                    /* Output count */
+    uint8_t aggregate;                      /* tinyml_tree_aggregate_t */
+    uint8_t transform;                      /* tinyml_tree_transform_t */
+    uint8_t reserved[3];                    /* Must be zero */
+    uint32_t checksum;                      /* CRC-32 of the blob after the header */
+} tinyml_tree_header_t;
+
+/* Node, 8 bytes */
+typedef struct {
+    uint16_t feature;                       /* Split feature or TINYML_TREE_LEAF */
+    uint16_t right;                         /* Split: nodes to the right child; leaf: output index */
+    float value;                            /* Split threshold or leaf value */
+} tinyml_tree_node_t;
+
+/* Parsed ensemble; references the blob, never copies it */
+typedef struct {
+    const tinyml_tree_header_t *header;     /* Blob header */
+    const float *base_score;                /* Base score per output */
+    const uint32_t *tree_root;              /* Root node of each tree */
+    const tinyml_tree_node_t *nodes;        /* Node array */
+    uint16_t max_depth;                     /* Longest root-to-leaf path */
+} tinyml_tree_ensemble_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Check whether a blob holds a tree ensemble
+ *
+ * @param data Pointer to blob
+ * @param size Blob size in bytes
+ * @return true if the blob starts with the tree magic, false otherwise
+ */
+bool tinyml_tree_is_ensemble(const uint8_t *data, uint32_t size);
+
+/**
+ * @brief Parse and validate a tree ensemble blob
+ *
+ * Checks the header and its checksum, every split's feature and children
+ * and every leaf's output, and that each tree is a proper tree no deeper
+ * than TINYML_TREE_MAX_DEPTH.
+ *
+ * @param data Pointer to blob (4-byte aligned)
+ * @param size Blob size in bytes
+ * @param ensemble Pointer to ensemble structure to fill
+ * @return true if blob is valid, false otherwise
+ */
+bool tinyml_tree_parse(const uint8_t *data, uint32_t size, tinyml_tree_ensemble_t *ensemble);
+
+/**
+ * @brief Evaluate a tree ensemble
+ *
+ * @param ensemble Pointer to parsed ensemble
+ * @param features Input features [num_features]
+ * @param outputs Outputs [num_outputs]
+ * @return true if evaluation successful, false otherwise
+ */
+bool tinyml_tree_predict(const tinyml_tree_ensemble_t *ensemble, const float *features, float *outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_TINYML_TREES_H */
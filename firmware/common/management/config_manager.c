@@ -52,6 +52,8 @@ static bool remote_sync_enabled = false;
 static esocore_config_value_t change_history[100]; /* Last 100 changes */
 static uint8_t change_history_index = 0;
 
+static int16_t find_parameter_by_id(uint16_t parameter_id);
+
 /* ============================================================================
  * Configuration Storage (Placeholder Implementation)
  * ============================================================================ */
@@ -76,11 +78,12 @@ static bool config_save_to_storage(void) {
  * @brief Validate configuration data
  */
 static bool config_validate_parameter_value(uint16_t parameter_id, const esocore_config_value_t *value) {
-    if (parameter_id >= ESOCORE_MAX_CONFIG_PARAMETERS || !parameter_registered[parameter_id]) {
+    int16_t slot = find_parameter_by_id(parameter_id);
+    if (slot < 0) {
         return false;
     }
 
-    const esocore_config_parameter_t *param = &parameter_registry[parameter_id];
+    const esocore_config_parameter_t *param = &parameter_registry[slot];
 
     /* Check data type */
     if (value->data_type != param->data_type) {
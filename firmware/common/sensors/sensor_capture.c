@@ -0,0 +1,499 @@
+/**
+ * @file sensor_capture.c
+ * @brief Pre-Trigger Ring Buffer and Burst Capture Implementation
+ *
+ * This file contains the ring buffer, the trigger detectors, the rate
+ * limiter and the chunked burst upload.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "sensor_capture.h"
+#include "protocol.h"
+#include "safety_io.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+#define MS_PER_HOUR                   3600000U
+#define RMS_SETTLE_TAU                4U    /* Long-term time constants before RMS jumps count */
+#define CHUNK_SAMPLES                 ((ESOCORE_MAX_PAYLOAD_SIZE - sizeof(esocore_burst_chunk_header_t)) / \
+                                       sizeof(int16_t))
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Append frames to the ring, one contiguous copy per channel and wrap
+ */
+static void ring_write(sensor_capture_t *capture, const int16_t *const *channels, uint32_t offset,
+                       uint32_t count) {
+    while (count > 0) {
+        uint32_t run = capture->capacity - capture->write_pos;
+        if (run > count) {
+            run = count;
+        }
+        for (uint8_t ch = 0; ch < capture->config.num_channels; ch++) {
+            memcpy(&capture->buffer[ch * capture->capacity + capture->write_pos], &channels[ch][offset],
+                   run * sizeof(int16_t));
+        }
+
+        capture->write_pos += run;
+        if (capture->write_pos == capture->capacity) {
+            capture->write_pos = 0;
+        }
+        capture->filled = (capture->filled + run > capture->capacity) ? capture->capacity :
+                          capture->filled + run;
+        offset += run;
+        count -= run;
+    }
+}
+
+/**
+ * @brief Threshold or slope level in counts per sample
+ */
+static int32_t trigger_level_counts(const sensor_capture_config_t *config) {
+    float level = 0.0f;
+    if (config->trigger_type == SENSOR_TRIGGER_THRESHOLD || config->trigger_type == SENSOR_TRIGGER_SLOPE) {
+        float counts_per_unit = 1.0f / fabsf(config->scale[config->trigger_channel]);
+        level = config->trigger_level * counts_per_unit;
+        if (config->trigger_type == SENSOR_TRIGGER_SLOPE) {
+            level /= (float)config->sample_rate_hz;
+        }
+        level = ceilf(level);
+    }
+    return (level > 65536.0f) ? 65536 : (level < 1.0f ? 1 : (int32_t)level);
+}
+
+/**
+ * @brief Check the minimum interval and the hourly budget
+ */
+static bool rate_allows(const sensor_capture_t *capture, uint32_t now_ms) {
+    const sensor_capture_config_t *config = &capture->config;
+
+    if (capture->has_triggered && now_ms - capture->last_trigger_ms < config->min_interval_ms) {
+        return false;
+    }
+    if (config->max_captures_per_hour > 0 && capture->budget_used >= config->max_captures_per_hour &&
+        now_ms - capture->budget_window_ms < MS_PER_HOUR) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Evaluate the trigger condition at one sample
+ *
+ * @return true if a capture starts at this sample
+ */
+static bool trigger_edge(sensor_capture_t *capture, bool condition, uint32_t index, uint32_t timestamp_ms) {
+    /* Only the transition into the condition fires, and only with the pre-trigger samples in the ring */
+    bool edge = condition && !capture->condition_active;
+    capture->condition_active = condition;
+    if (!edge || capture->filled + index < capture->config.pre_trigger_samples) {
+        return false;
+    }
+
+    uint32_t now_ms = timestamp_ms + (uint32_t)(((uint64_t)index * 1000U) / capture->config.sample_rate_hz);
+    if (!rate_allows(capture, now_ms)) {
+        capture->suppressed++;
+        return false;
+    }
+
+    capture->has_triggered = true;
+    capture->last_trigger_ms = now_ms;
+    capture->trigger_timestamp_ms = now_ms;
+    if (capture->budget_used == 0 || now_ms - capture->budget_window_ms >= MS_PER_HOUR) {
+        capture->budget_window_ms = now_ms;
+        capture->budget_used = 0;
+    }
+    capture->budget_used++;
+    return true;
+}
+
+/**
+ * @brief Scan a block of the trigger channel
+ *
+ * @return Index of the triggering sample, count if none
+ */
+static uint32_t trigger_scan(sensor_capture_t *capture, const int16_t *x, uint32_t count,
+                             uint32_t timestamp_ms) {
+    const sensor_capture_config_t *config = &capture->config;
+    const int32_t level = capture->level_counts;
+
+    switch (config->trigger_type) {
+        case SENSOR_TRIGGER_THRESHOLD:
+            for (uint32_t n = 0; n < count; n++) {
+                int32_t v = x[n];
+                if (trigger_edge(capture, (v < 0 ? -v : v) >= level, n, timestamp_ms)) {
+                    return n;
+                }
+            }
+            break;
+
+        case SENSOR_TRIGGER_SLOPE:
+            for (uint32_t n = 0; n < count; n++) {
+                int32_t d = (int32_t)x[n] - (int32_t)capture->previous;
+                capture->previous = x[n];
+                if (trigger_edge(capture, (d < 0 ? -d : d) >= level, n, timestamp_ms)) {
+                    return n;
+                }
+            }
+            break;
+
+        case SENSOR_TRIGGER_RMS_JUMP: {
+            /* Exponential mean squares about a slow mean, compared as squares */
+            const float short_alpha = 1.0f / (float)config->rms_window;
+            const float long_alpha = short_alpha / (float)SENSOR_CAPTURE_RMS_LONG_RATIO;
+            const float ratio_square = config->trigger_level * config->trigger_level;
+            for (uint32_t n = 0; n < count; n++) {
+                float v = (float)x[n];
+                capture->mean += (v - capture->mean) * long_alpha;
+                float d = v - capture->mean;
+                capture->short_square += (d * d - capture->short_square) * short_alpha;
+                capture->long_square += (d * d - capture->long_square) * long_alpha;
+                if (capture->seen_samples < capture->settle_samples) {
+                    capture->seen_samples++;
+                    continue;
+                }
+                if (trigger_edge(capture, capture->short_square > ratio_square * capture->long_square,
+                                 n, timestamp_ms)) {
+                    return n;
+                }
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Freeze the ring position of the capture that starts at the current frame
+ */
+static void start_capture(sensor_capture_t *capture) {
+    uint32_t pre = capture->config.pre_trigger_samples;
+    capture->start_pos = (capture->write_pos + capture->capacity - pre) % capture->capacity;
+    capture->post_remaining = capture->config.post_trigger_samples;
+    capture->state = SENSOR_CAPTURE_TRIGGERED;
+}
+
+/**
+ * @brief Fill one burst chunk
+ *
+ * @return Payload length
+ */
+static uint16_t build_chunk(const sensor_capture_t *capture, uint16_t chunk_index, uint16_t chunk_count,
+                            uint8_t *payload) {
+    const sensor_capture_config_t *config = &capture->config;
+    esocore_burst_chunk_header_t header = {
+        .burst_id = capture->burst_id,
+        .chunk_index = chunk_index,
+        .chunk_count = chunk_count
+    };
+    uint16_t length = sizeof(header);
+    memcpy(payload, &header, sizeof(header));
+
+    if (chunk_index == 0) {
+        esocore_burst_descriptor_t descriptor = {
+            .trigger_timestamp = capture->trigger_timestamp_ms,
+            .sample_rate_hz = config->sample_rate_hz,
+            .pre_trigger_samples = config->pre_trigger_samples,
+            .post_trigger_samples = config->post_trigger_samples,
+            .num_channels = config->num_channels,
+            .trigger_type = (uint8_t)config->trigger_type,
+            .trigger_channel = config->trigger_channel,
+            .sample_format = 0
+        };
+        memcpy(&payload[length], &descriptor, sizeof(descriptor));
+        length += sizeof(descriptor);
+        memcpy(&payload[length], config->scale, config->num_channels * sizeof(float));
+        return (uint16_t)(length + config->num_channels * sizeof(float));
+    }
+
+    /* Samples run channel by channel; a chunk may span a channel boundary */
+    uint32_t frames = (uint32_t)config->pre_trigger_samples + config->post_trigger_samples;
+    uint32_t total = frames * config->num_channels;
+    uint32_t first = (uint32_t)(chunk_index - 1) * CHUNK_SAMPLES;
+    uint32_t count = total - first;
+    if (count > CHUNK_SAMPLES) {
+        count = CHUNK_SAMPLES;
+    }
+
+    int16_t samples[CHUNK_SAMPLES];
+    uint32_t done = 0;
+    while (done < count) {
+        uint32_t index = first + done;
+        uint8_t channel = (uint8_t)(index / frames);
+        uint32_t offset = index % frames;
+        uint32_t run = frames - offset;
+        if (run > count - done) {
+            run = count - done;
+        }
+        sensor_capture_read(capture, channel, offset, &samples[done], run);
+        done += run;
+    }
+    memcpy(&payload[length], samples, count * sizeof(int16_t));
+    return (uint16_t)(length + count * sizeof(int16_t));
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Initialize a capture over caller-provided ring storage
+ */
+bool sensor_capture_init(sensor_capture_t *capture, const sensor_capture_config_t *config,
+                         int16_t *buffer, uint32_t capacity) {
+    if (!capture || !config || !buffer || config->num_channels == 0 ||
+        config->num_channels > SENSOR_CAPTURE_MAX_CHANNELS || config->sample_rate_hz == 0 ||
+        config->post_trigger_samples == 0 ||
+        (uint32_t)config->pre_trigger_samples + config->post_trigger_samples > capacity ||
+        !(config->trigger_level > 0.0f)) {
+        return false;
+    }
+
+    /* Analog triggers need their channel's scale to convert the level to counts */
+    if (config->trigger_type == SENSOR_TRIGGER_DIGITAL_INPUT) {
+        if (config->trigger_channel >= SAFETY_INPUT_CHANNELS) {
+            return false;
+        }
+    } else {
+        if (config->trigger_channel >= config->num_channels || config->scale[config->trigger_channel] == 0.0f) {
+            return false;
+        }
+    }
+    if (config->trigger_type == SENSOR_TRIGGER_RMS_JUMP && config->rms_window == 0) {
+        return false;
+    }
+
+    memset(capture, 0, sizeof(sensor_capture_t));
+    capture->config = *config;
+    capture->buffer = buffer;
+    capture->capacity = capacity;
+    capture->state = SENSOR_CAPTURE_IDLE;
+
+    switch (config->trigger_type) {
+        case SENSOR_TRIGGER_THRESHOLD:
+        case SENSOR_TRIGGER_SLOPE:
+        case SENSOR_TRIGGER_DIGITAL_INPUT:
+            break;
+        case SENSOR_TRIGGER_RMS_JUMP:
+            capture->settle_samples = RMS_SETTLE_TAU * SENSOR_CAPTURE_RMS_LONG_RATIO * config->rms_window;
+            break;
+        default:
+            return false;
+    }
+    capture->level_counts = trigger_level_counts(config);
+
+    return true;
+}
+
+/**
+ * @brief Arm the trigger, discarding the ring contents and any frozen capture
+ */
+bool sensor_capture_arm(sensor_capture_t *capture) {
+    if (!capture || !capture->buffer) {
+        return false;
+    }
+
+    capture->write_pos = 0;
+    capture->filled = 0;
+    capture->condition_active = false;
+    capture->previous = 0;
+    capture->mean = 0.0f;
+    capture->short_square = 0.0f;
+    capture->long_square = 0.0f;
+    capture->seen_samples = 0;
+    capture->next_chunk = 0;
+
+    /* An input already active when arming is not an event */
+    if (capture->config.trigger_type == SENSOR_TRIGGER_DIGITAL_INPUT) {
+        safety_input_status_t input;
+        capture->condition_active = safety_io_get_input_status(capture->config.trigger_channel, &input) &&
+                                    input.active;
+    }
+
+    capture->state = SENSOR_CAPTURE_ARMED;
+    return true;
+}
+
+/**
+ * @brief Follow a change of the sample rate
+ */
+bool sensor_capture_set_rate(sensor_capture_t *capture, uint32_t sample_rate_hz) {
+    if (!capture || !capture->buffer || sample_rate_hz == 0) {
+        return false;
+    }
+    if (sample_rate_hz == capture->config.sample_rate_hz) {
+        return true;
+    }
+    if (capture->state == SENSOR_CAPTURE_TRIGGERED || capture->state == SENSOR_CAPTURE_FROZEN) {
+        return false;
+    }
+
+    capture->config.sample_rate_hz = sample_rate_hz;
+    capture->level_counts = trigger_level_counts(&capture->config);
+
+    /* The ring holds samples at the old rate: start it over */
+    if (capture->state == SENSOR_CAPTURE_ARMED) {
+        return sensor_capture_arm(capture);
+    }
+    return true;
+}
+
+/**
+ * @brief Stop filling the ring and evaluating the trigger
+ */
+void sensor_capture_disarm(sensor_capture_t *capture) {
+    if (!capture || capture->state == SENSOR_CAPTURE_FROZEN) {
+        return;
+    }
+
+    capture->state = SENSOR_CAPTURE_IDLE;
+}
+
+/**
+ * @brief Feed a block of frames
+ */
+bool sensor_capture_process(sensor_capture_t *capture, const int16_t *const *channels,
+                            uint32_t num_frames, uint32_t timestamp_ms) {
+    if (!capture || !channels) {
+        return false;
+    }
+    for (uint8_t ch = 0; ch < capture->config.num_channels; ch++) {
+        if (!channels[ch]) {
+            return false;
+        }
+    }
+
+    uint32_t offset = 0;
+    while (offset < num_frames) {
+        uint32_t count = num_frames - offset;
+
+        if (capture->state == SENSOR_CAPTURE_ARMED) {
+            uint32_t block_ms = timestamp_ms +
+                                (uint32_t)(((uint64_t)offset * 1000U) / capture->config.sample_rate_hz);
+            uint32_t hit = count;
+
+            if (capture->config.trigger_type == SENSOR_TRIGGER_DIGITAL_INPUT) {
+                /* Polled once per block: the capture starts at the block's first frame */
+                safety_input_status_t input;
+                bool active = safety_io_get_input_status(capture->config.trigger_channel, &input) &&
+                              input.active;
+                if (trigger_edge(capture, active, 0, block_ms)) {
+                    hit = 0;
+                }
+            } else {
+                hit = trigger_scan(capture, &channels[capture->config.trigger_channel][offset], count, block_ms);
+            }
+
+            ring_write(capture, channels, offset, hit);
+            offset += hit;
+            if (hit < count) {
+                start_capture(capture);
+            }
+        } else if (capture->state == SENSOR_CAPTURE_TRIGGERED) {
+            if (count > capture->post_remaining) {
+                count = capture->post_remaining;
+            }
+            ring_write(capture, channels, offset, count);
+            offset += count;
+            capture->post_remaining -= (uint16_t)count;
+            if (capture->post_remaining == 0) {
+                capture->state = SENSOR_CAPTURE_FROZEN;
+                capture->captures++;
+                capture->burst_id++;
+                capture->next_chunk = 0;
+            }
+        } else {
+            break;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Copy samples of the frozen capture
+ */
+bool sensor_capture_read(const sensor_capture_t *capture, uint8_t channel, uint32_t offset,
+                         int16_t *output, uint32_t count) {
+    if (!capture || !output || capture->state != SENSOR_CAPTURE_FROZEN ||
+        channel >= capture->config.num_channels) {
+        return false;
+    }
+
+    uint32_t frames = (uint32_t)capture->config.pre_trigger_samples + capture->config.post_trigger_samples;
+    if (offset > frames || count > frames - offset) {
+        return false;
+    }
+
+    const int16_t *ring = &capture->buffer[channel * capture->capacity];
+    uint32_t pos = (capture->start_pos + offset) % capture->capacity;
+    uint32_t run = capture->capacity - pos;
+    if (run > count) {
+        run = count;
+    }
+    memcpy(output, &ring[pos], run * sizeof(int16_t));
+    memcpy(&output[run], ring, (count - run) * sizeof(int16_t));
+
+    return true;
+}
+
+/**
+ * @brief Upload the frozen capture through the protocol burst transfer
+ */
+bool sensor_capture_upload(sensor_capture_t *capture, uint8_t dest_address, uint16_t max_chunks,
+                           bool *complete) {
+    if (complete) {
+        *complete = false;
+    }
+    if (!capture || capture->state != SENSOR_CAPTURE_FROZEN) {
+        return false;
+    }
+
+    uint32_t total = ((uint32_t)capture->config.pre_trigger_samples + capture->config.post_trigger_samples) *
+                     capture->config.num_channels;
+    uint16_t chunk_count = (uint16_t)(1U + (total + CHUNK_SAMPLES - 1U) / CHUNK_SAMPLES);
+    uint8_t payload[ESOCORE_MAX_PAYLOAD_SIZE];
+
+    for (uint16_t sent = 0; capture->next_chunk < chunk_count && (max_chunks == 0 || sent < max_chunks); sent++) {
+        uint16_t length = build_chunk(capture, capture->next_chunk, chunk_count, payload);
+        if (!esocore_send_message(dest_address, MSG_TYPE_DATA_BURST, payload, length)) {
+            return false;
+        }
+        capture->next_chunk++;
+    }
+
+    if (capture->next_chunk < chunk_count) {
+        return true;
+    }
+
+    capture->uploads++;
+    capture->state = SENSOR_CAPTURE_IDLE;
+    if (capture->config.auto_rearm) {
+        sensor_capture_arm(capture);
+    }
+    if (complete) {
+        *complete = true;
+    }
+    return true;
+}
+
+/**
+ * @brief Get the capture state
+ */
+sensor_capture_state_t sensor_capture_get_state(const sensor_capture_t *capture) {
+    return capture ? capture->state : SENSOR_CAPTURE_IDLE;
+}
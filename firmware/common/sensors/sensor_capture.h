@@ -0,0 +1,225 @@
+/**
+ * @file sensor_capture.h
+ * @brief Pre-Trigger Ring Buffer and Event-Triggered Burst Capture
+ *
+ * This file defines an oscilloscope-style capture mode for any sensor:
+ * - A continuous ring buffer of raw int16 samples, one contiguous region
+ *   per channel, fed block by block from the acquisition path
+ * - A cheap trigger on one channel (absolute threshold, slope, jump of the
+ *   short-term RMS over the long-term RMS) or on a safety_io digital input
+ * - On trigger, the ring keeps the pre-trigger samples and fills with the
+ *   post-trigger samples, then freezes until the capture is uploaded
+ * - Upload through the protocol burst transfer (MSG_TYPE_DATA_BURST), a
+ *   few chunks per call so the main loop is never blocked for long
+ * - Rate limiting by a minimum interval and a budget per hour, and re-arm
+ *   either automatic after upload or explicit
+ *
+ * Triggers fire on the transition into the trigger condition, so one
+ * event yields one capture however long it lasts, and only once the ring
+ * holds the pre-trigger samples. Levels are given in physical units and
+ * converted to raw counts once, when the capture is configured; digital
+ * inputs are polled once per processed block.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_SENSOR_CAPTURE_H
+#define ESOCORE_SENSOR_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Capture Configuration
+ * ============================================================================ */
+
+#define SENSOR_CAPTURE_MAX_CHANNELS   4
+#define SENSOR_CAPTURE_RMS_LONG_RATIO 16    /* Long-term / short-term RMS time constant */
+
+/* ============================================================================
+ * Capture Data Types
+ * ============================================================================ */
+
+/* Trigger condition */
+typedef enum {
+    SENSOR_TRIGGER_THRESHOLD = 0,           /* |x| reaches level */
+    SENSOR_TRIGGER_SLOPE = 1,               /* |dx/dt| reaches level (units per second) */
+    SENSOR_TRIGGER_RMS_JUMP = 2,            /* Short-term RMS reaches level times the long-term RMS */
+    SENSOR_TRIGGER_DIGITAL_INPUT = 3,       /* safety_io input becomes active */
+} sensor_trigger_type_t;
+
+/* Capture state */
+typedef enum {
+    SENSOR_CAPTURE_IDLE = 0,                /* Not armed */
+    SENSOR_CAPTURE_ARMED = 1,               /* Filling the ring and evaluating the trigger */
+    SENSOR_CAPTURE_TRIGGERED = 2,           /* Collecting post-trigger samples */
+    SENSOR_CAPTURE_FROZEN = 3,              /* Complete, waiting for upload */
+} sensor_capture_state_t;
+
+/* Capture configuration */
+typedef struct {
+    uint8_t num_channels;                   /* Channels per frame (1 to SENSOR_CAPTURE_MAX_CHANNELS) */
+    uint32_t sample_rate_hz;                /* Sample rate of every channel */
+    float scale[SENSOR_CAPTURE_MAX_CHANNELS]; /* Physical units per raw count */
+    uint16_t pre_trigger_samples;           /* Samples kept before the trigger */
+    uint16_t post_trigger_samples;          /* Samples collected from the trigger on */
+    sensor_trigger_type_t trigger_type;
+    uint8_t trigger_channel;                /* Channel evaluated, or safety_io input channel */
+    float trigger_level;                    /* Threshold, slope or RMS ratio */
+    uint16_t rms_window;                    /* Short-term RMS time constant in samples */
+    uint32_t min_interval_ms;               /* Minimum time between captures */
+    uint16_t max_captures_per_hour;         /* Capture budget per hour (0 = unlimited) */
+    bool auto_rearm;                        /* Re-arm when the upload completes */
+} sensor_capture_config_t;
+
+/* Capture instance (caller-owned, one per capture channel group) */
+typedef struct {
+    sensor_capture_config_t config;
+    int16_t *buffer;                        /* Ring storage, capacity samples per channel */
+    uint32_t capacity;                      /* Ring length per channel */
+    uint32_t write_pos;                     /* Next ring position */
+    uint32_t filled;                        /* Valid samples in the ring (saturating) */
+    sensor_capture_state_t state;
+
+    /* Trigger detector */
+    int32_t level_counts;                   /* Threshold or slope per sample in counts */
+    bool condition_active;                  /* Condition held at the last sample */
+    int16_t previous;                       /* Last sample of the trigger channel */
+    float mean;                             /* Long-term mean (RMS jump) */
+    float short_square;                     /* Short-term mean square (RMS jump) */
+    float long_square;                      /* Long-term mean square (RMS jump) */
+    uint32_t settle_samples;                /* Samples before the RMS jump detector is valid */
+    uint32_t seen_samples;                  /* Samples since arming (saturating) */
+
+    /* Frozen capture */
+    uint32_t start_pos;                     /* Ring position of the first captured sample */
+    uint16_t post_remaining;                /* Post-trigger samples still to collect */
+    uint32_t trigger_timestamp_ms;
+
+    /* Rate limiting */
+    bool has_triggered;                     /* last_trigger_ms is valid */
+    uint32_t last_trigger_ms;
+    uint32_t budget_window_ms;              /* Start of the current hour */
+    uint16_t budget_used;                   /* Captures in the current hour */
+
+    /* Upload */
+    uint16_t burst_id;
+    uint16_t next_chunk;
+
+    /* Statistics */
+    uint32_t captures;                      /* Captures frozen */
+    uint32_t suppressed;                    /* Triggers dropped by rate limiting */
+    uint32_t uploads;                       /* Captures uploaded */
+} sensor_capture_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Initialize a capture over caller-provided ring storage
+ *
+ * The ring must hold at least pre_trigger_samples + post_trigger_samples
+ * per channel. The capture starts idle.
+ *
+ * @param capture Pointer to capture
+ * @param config Pointer to configuration
+ * @param buffer Ring storage of capacity * num_channels samples
+ * @param capacity Ring length per channel
+ * @return true if initialization successful, false otherwise
+ */
+bool sensor_capture_init(sensor_capture_t *capture, const sensor_capture_config_t *config,
+                         int16_t *buffer, uint32_t capacity);
+
+/**
+ * @brief Arm the trigger, discarding the ring contents and any frozen capture
+ *
+ * @param capture Pointer to capture
+ * @return true if armed, false otherwise
+ */
+bool sensor_capture_arm(sensor_capture_t *capture);
+
+/**
+ * @brief Follow a change of the sample rate
+ *
+ * Rescales the slope level and, if armed, re-arms so the ring and the
+ * trigger detector only see samples at the new rate. Refused while a
+ * capture is being collected or waits for upload, since its samples and
+ * descriptor belong to the old rate.
+ *
+ * @param capture Pointer to capture
+ * @param sample_rate_hz New sample rate of every channel
+ * @return true if the capture runs at the new rate, false otherwise
+ */
+bool sensor_capture_set_rate(sensor_capture_t *capture, uint32_t sample_rate_hz);
+
+/**
+ * @brief Stop filling the ring and evaluating the trigger
+ *
+ * A frozen capture stays available until it is uploaded or re-armed.
+ *
+ * @param capture Pointer to capture
+ */
+void sensor_capture_disarm(sensor_capture_t *capture);
+
+/**
+ * @brief Feed a block of frames
+ *
+ * Ignored unless the capture is armed or triggered.
+ *
+ * @param capture Pointer to capture
+ * @param channels Per-channel sample arrays [num_channels]
+ * @param num_frames Samples per channel
+ * @param timestamp_ms Time of the first frame in ms
+ * @return true if the block was accepted, false otherwise
+ */
+bool sensor_capture_process(sensor_capture_t *capture, const int16_t *const *channels,
+                            uint32_t num_frames, uint32_t timestamp_ms);
+
+/**
+ * @brief Copy samples of the frozen capture
+ *
+ * @param capture Pointer to capture
+ * @param channel Channel index
+ * @param offset First sample, 0 = oldest pre-trigger sample
+ * @param output Output array
+ * @param count Number of samples
+ * @return true if the range lies within the frozen capture, false otherwise
+ */
+bool sensor_capture_read(const sensor_capture_t *capture, uint8_t channel, uint32_t offset,
+                         int16_t *output, uint32_t count);
+
+/**
+ * @brief Upload the frozen capture through the protocol burst transfer
+ *
+ * Sends at most max_chunks chunks per call and resumes where it stopped;
+ * a failed send is retried on the next call.
+ *
+ * @param capture Pointer to capture
+ * @param dest_address Destination device address
+ * @param max_chunks Chunks to send in this call (0 = all)
+ * @param complete Pointer to store whether the upload has finished (may be NULL)
+ * @return true if the chunks were sent, false otherwise
+ */
+bool sensor_capture_upload(sensor_capture_t *capture, uint8_t dest_address, uint16_t max_chunks,
+                           bool *complete);
+
+/**
+ * @brief Get the capture state
+ *
+ * @param capture Pointer to capture
+ * @return Current state
+ */
+sensor_capture_state_t sensor_capture_get_state(const sensor_capture_t *capture);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_SENSOR_CAPTURE_H */
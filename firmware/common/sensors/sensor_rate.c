@@ -0,0 +1,224 @@
+/**
+ * @file sensor_rate.c
+ * @brief Adaptive Sampling Rate Controller Implementation
+ *
+ * This file contains the activity metrics, the per-channel hysteresis,
+ * the window schedule and the step-down logic.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "sensor_rate.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Check whether a time lies inside a window
+ */
+static bool window_contains(const sensor_rate_window_t *window, uint32_t now_ms) {
+    /* Differences in the wrapping millisecond clock */
+    if ((int32_t)(now_ms - window->start_ms) < 0) {
+        return false;
+    }
+
+    uint32_t elapsed = now_ms - window->start_ms;
+    if (window->period_ms > 0) {
+        elapsed %= window->period_ms;
+    }
+    return elapsed < window->duration_ms;
+}
+
+/**
+ * @brief Check the schedule and the caller request
+ */
+static bool full_rate_scheduled(sensor_rate_controller_t *controller, uint32_t now_ms) {
+    if (controller->request_pending) {
+        if ((int32_t)(controller->request_until_ms - now_ms) > 0) {
+            return true;
+        }
+        controller->request_pending = false;
+    }
+
+    for (uint8_t i = 0; i < controller->config.num_windows; i++) {
+        if (window_contains(&controller->config.windows[i], now_ms)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Initialize a controller at full rate
+ */
+bool sensor_rate_init(sensor_rate_controller_t *controller, const sensor_rate_config_t *config,
+                      uint32_t now_ms) {
+    if (!controller || !config || config->min_rate_hz == 0 || config->max_rate_hz < config->min_rate_hz ||
+        config->step_divisor < 2 || config->num_channels == 0 ||
+        config->num_channels > SENSOR_RATE_MAX_CHANNELS || config->num_windows > SENSOR_RATE_MAX_WINDOWS) {
+        return false;
+    }
+    for (uint8_t ch = 0; ch < config->num_channels; ch++) {
+        if (config->channels[ch].idle_level > config->channels[ch].active_level) {
+            return false;
+        }
+    }
+
+    memset(controller, 0, sizeof(sensor_rate_controller_t));
+    controller->config = *config;
+    controller->rate_hz = config->max_rate_hz;
+    controller->mode = SENSOR_RATE_MODE_SETTLING;
+    controller->last_busy_ms = now_ms;
+    controller->last_step_ms = now_ms;
+
+    return true;
+}
+
+/**
+ * @brief Compute and record the activity of one channel from a sample block
+ */
+bool sensor_rate_process(sensor_rate_controller_t *controller, uint8_t channel,
+                         const float *samples, uint32_t num_samples) {
+    if (!controller || !samples || num_samples == 0 || channel >= controller->config.num_channels) {
+        return false;
+    }
+
+    float activity = 0.0f;
+    if (controller->config.channels[channel].metric == SENSOR_ACTIVITY_CHANGE_RATE) {
+        /* Continue from the last sample of the previous block */
+        float previous = controller->has_previous[channel] ? controller->previous[channel] : samples[0];
+        float sum = 0.0f;
+        for (uint32_t n = 0; n < num_samples; n++) {
+            sum += fabsf(samples[n] - previous);
+            previous = samples[n];
+        }
+        controller->previous[channel] = previous;
+        controller->has_previous[channel] = true;
+        activity = sum / (float)num_samples * (float)controller->rate_hz;
+    } else {
+        float sum = 0.0f, square = 0.0f;
+        for (uint32_t n = 0; n < num_samples; n++) {
+            sum += samples[n];
+            square += samples[n] * samples[n];
+        }
+        float mean = sum / (float)num_samples;
+        activity = fmaxf(square / (float)num_samples - mean * mean, 0.0f);
+    }
+
+    return sensor_rate_update(controller, channel, activity);
+}
+
+/**
+ * @brief Record a caller-computed activity of one channel
+ */
+bool sensor_rate_update(sensor_rate_controller_t *controller, uint8_t channel, float activity) {
+    if (!controller || channel >= controller->config.num_channels) {
+        return false;
+    }
+
+    const sensor_rate_channel_config_t *config = &controller->config.channels[channel];
+    controller->activity[channel] = activity;
+    if (!controller->channel_active[channel] && activity >= config->active_level) {
+        controller->channel_active[channel] = true;
+    } else if (controller->channel_active[channel] && activity < config->idle_level) {
+        controller->channel_active[channel] = false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Decide the rate after the activities of a block are recorded
+ */
+uint32_t sensor_rate_evaluate(sensor_rate_controller_t *controller, uint32_t now_ms, bool *rate_changed) {
+    if (rate_changed) {
+        *rate_changed = false;
+    }
+    if (!controller) {
+        return 0;
+    }
+
+    const sensor_rate_config_t *config = &controller->config;
+    uint32_t previous_rate = controller->rate_hz;
+
+    bool active = false;
+    for (uint8_t ch = 0; ch < config->num_channels; ch++) {
+        active = active || controller->channel_active[ch];
+    }
+
+    if (active || full_rate_scheduled(controller, now_ms)) {
+        /* Straight to full rate: the transient that woke us must not be undersampled */
+        controller->mode = active ? SENSOR_RATE_MODE_ACTIVE : SENSOR_RATE_MODE_SCHEDULED;
+        controller->rate_hz = config->max_rate_hz;
+        controller->last_busy_ms = now_ms;
+        controller->last_step_ms = now_ms;
+    } else if (controller->rate_hz > config->min_rate_hz) {
+        /* Down one step at a time, the first after the hold time */
+        bool first_step = (controller->rate_hz == config->max_rate_hz);
+        uint32_t wait_ms = first_step ? config->idle_hold_ms : config->step_interval_ms;
+        uint32_t since_ms = first_step ? now_ms - controller->last_busy_ms : now_ms - controller->last_step_ms;
+        controller->mode = SENSOR_RATE_MODE_SETTLING;
+        if (since_ms >= wait_ms) {
+            uint32_t rate = controller->rate_hz / config->step_divisor;
+            controller->rate_hz = (rate > config->min_rate_hz) ? rate : config->min_rate_hz;
+            controller->last_step_ms = now_ms;
+        }
+    }
+    if (controller->rate_hz == config->min_rate_hz && !active && controller->mode == SENSOR_RATE_MODE_SETTLING) {
+        controller->mode = SENSOR_RATE_MODE_IDLE;
+    }
+
+    if (controller->rate_hz != previous_rate) {
+        controller->rate_changes++;
+        /* Samples at another rate are not continuous with the last block */
+        memset(controller->has_previous, 0, sizeof(controller->has_previous));
+        if (rate_changed) {
+            *rate_changed = true;
+        }
+    }
+
+    return controller->rate_hz;
+}
+
+/**
+ * @brief Hold full rate for a while, for example on a start command
+ */
+bool sensor_rate_request_full(sensor_rate_controller_t *controller, uint32_t duration_ms, uint32_t now_ms) {
+    if (!controller) {
+        return false;
+    }
+
+    uint32_t until_ms = now_ms + duration_ms;
+    if (!controller->request_pending || (int32_t)(until_ms - controller->request_until_ms) > 0) {
+        controller->request_until_ms = until_ms;
+    }
+    controller->request_pending = true;
+    return true;
+}
+
+/**
+ * @brief Report the rate the sensor actually runs at
+ */
+void sensor_rate_sync(sensor_rate_controller_t *controller, uint32_t rate_hz) {
+    if (!controller || rate_hz == 0) {
+        return;
+    }
+
+    controller->rate_hz = rate_hz;
+}
+
+/**
+ * @brief Get the controller mode
+ */
+sensor_rate_mode_t sensor_rate_get_mode(const sensor_rate_controller_t *controller) {
+    return controller ? controller->mode : SENSOR_RATE_MODE_IDLE;
+}
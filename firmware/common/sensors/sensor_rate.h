@@ -0,0 +1,184 @@
+/**
+ * @file sensor_rate.h
+ * @brief Adaptive Sampling Rate Controller
+ *
+ * This file defines a controller that lowers a sensor's sample rate while
+ * the machine is stopped or steady and restores it when something happens:
+ * - Per-channel activity, either the energy about the mean of each block
+ *   (band energy above DC) or the mean rate of change in units per
+ *   second, or any metric the caller computes (for example a band power
+ *   from the feature store)
+ * - Per-channel hysteresis: a channel becomes active at active_level and
+ *   quiet again below idle_level
+ * - Full rate at once on any active channel, inside a scheduled window
+ *   (one-off or periodic, placed ahead of known start-ups) or while a
+ *   caller request lasts
+ * - After idle_hold_ms without activity the rate is divided by
+ *   step_divisor, then again every step_interval_ms, down to min_rate_hz
+ *
+ * Starting at full rate and ramping up in one step means a start-up
+ * transient is sampled at full rate from the first block that shows it.
+ * The controller only decides; the caller applies the rate and reports
+ * back with sensor_rate_sync() if the sensor could not take it.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef ESOCORE_SENSOR_RATE_H
+#define ESOCORE_SENSOR_RATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Rate Controller Configuration
+ * ============================================================================ */
+
+#define SENSOR_RATE_MAX_CHANNELS      8
+#define SENSOR_RATE_MAX_WINDOWS       4
+
+/* ============================================================================
+ * Rate Controller Data Types
+ * ============================================================================ */
+
+/* Activity metric computed from sample blocks */
+typedef enum {
+    SENSOR_ACTIVITY_ENERGY = 0,             /* Mean square about the block mean (units²) */
+    SENSOR_ACTIVITY_CHANGE_RATE = 1,        /* Mean |dx/dt| (units per second) */
+} sensor_activity_metric_t;
+
+/* Controller mode */
+typedef enum {
+    SENSOR_RATE_MODE_ACTIVE = 0,            /* Full rate, a channel is active */
+    SENSOR_RATE_MODE_SCHEDULED = 1,         /* Full rate, scheduled window or request */
+    SENSOR_RATE_MODE_SETTLING = 2,          /* Quiet, stepping down */
+    SENSOR_RATE_MODE_IDLE = 3,              /* Quiet, at the minimum rate */
+} sensor_rate_mode_t;
+
+/* Per-channel activity configuration */
+typedef struct {
+    sensor_activity_metric_t metric;
+    float active_level;                     /* Activity at which the channel becomes active */
+    float idle_level;                       /* Activity below which it is quiet again (<= active_level) */
+} sensor_rate_channel_config_t;
+
+/* Full-rate window, in the caller's millisecond clock */
+typedef struct {
+    uint32_t start_ms;                      /* First window start */
+    uint32_t duration_ms;                   /* Window length */
+    uint32_t period_ms;                     /* Repeat period (0 = once) */
+} sensor_rate_window_t;
+
+/* Controller configuration */
+typedef struct {
+    uint32_t min_rate_hz;                   /* Idle rate */
+    uint32_t max_rate_hz;                   /* Full rate */
+    uint8_t step_divisor;                   /* Rate divisor per step down (>= 2) */
+    uint32_t idle_hold_ms;                  /* Quiet time before the first step down */
+    uint32_t step_interval_ms;              /* Quiet time between further steps */
+    uint8_t num_channels;
+    sensor_rate_channel_config_t channels[SENSOR_RATE_MAX_CHANNELS];
+    uint8_t num_windows;
+    sensor_rate_window_t windows[SENSOR_RATE_MAX_WINDOWS];
+} sensor_rate_config_t;
+
+/* Controller state (caller-owned, one per sensor) */
+typedef struct {
+    sensor_rate_config_t config;
+    uint32_t rate_hz;                       /* Current rate */
+    sensor_rate_mode_t mode;
+    float activity[SENSOR_RATE_MAX_CHANNELS];   /* Latest activity per channel */
+    bool channel_active[SENSOR_RATE_MAX_CHANNELS];
+    float previous[SENSOR_RATE_MAX_CHANNELS];   /* Last sample per channel (change rate) */
+    bool has_previous[SENSOR_RATE_MAX_CHANNELS];
+    uint32_t last_busy_ms;                  /* Last evaluation at full rate */
+    uint32_t last_step_ms;                  /* Last step down */
+    uint32_t request_until_ms;              /* End of the caller request */
+    bool request_pending;
+    uint32_t rate_changes;                  /* Number of rate changes */
+} sensor_rate_controller_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Initialize a controller at full rate
+ *
+ * @param controller Pointer to controller
+ * @param config Pointer to configuration
+ * @param now_ms Current time in ms
+ * @return true if initialization successful, false otherwise
+ */
+bool sensor_rate_init(sensor_rate_controller_t *controller, const sensor_rate_config_t *config,
+                      uint32_t now_ms);
+
+/**
+ * @brief Compute and record the activity of one channel from a sample block
+ *
+ * @param controller Pointer to controller
+ * @param channel Channel index
+ * @param samples Samples at the current rate
+ * @param num_samples Number of samples
+ * @return true if the activity was recorded, false otherwise
+ */
+bool sensor_rate_process(sensor_rate_controller_t *controller, uint8_t channel,
+                         const float *samples, uint32_t num_samples);
+
+/**
+ * @brief Record a caller-computed activity of one channel
+ *
+ * @param controller Pointer to controller
+ * @param channel Channel index
+ * @param activity Activity in the units of the channel's levels
+ * @return true if the activity was recorded, false otherwise
+ */
+bool sensor_rate_update(sensor_rate_controller_t *controller, uint8_t channel, float activity);
+
+/**
+ * @brief Decide the rate after the activities of a block are recorded
+ *
+ * @param controller Pointer to controller
+ * @param now_ms Current time in ms
+ * @param rate_changed Pointer to store whether the rate changed (may be NULL)
+ * @return Rate to run at in Hz
+ */
+uint32_t sensor_rate_evaluate(sensor_rate_controller_t *controller, uint32_t now_ms, bool *rate_changed);
+
+/**
+ * @brief Hold full rate for a while, for example on a start command
+ *
+ * @param controller Pointer to controller
+ * @param duration_ms Time to hold full rate
+ * @param now_ms Current time in ms
+ * @return true if the request was recorded, false otherwise
+ */
+bool sensor_rate_request_full(sensor_rate_controller_t *controller, uint32_t duration_ms, uint32_t now_ms);
+
+/**
+ * @brief Report the rate the sensor actually runs at
+ *
+ * @param controller Pointer to controller
+ * @param rate_hz Applied rate in Hz
+ */
+void sensor_rate_sync(sensor_rate_controller_t *controller, uint32_t rate_hz);
+
+/**
+ * @brief Get the controller mode
+ *
+ * @param controller Pointer to controller
+ * @return Current mode
+ */
+sensor_rate_mode_t sensor_rate_get_mode(const sensor_rate_controller_t *controller);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESOCORE_SENSOR_RATE_H */
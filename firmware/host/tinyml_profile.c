@@ -0,0 +1,295 @@
+/**
+ * @file tinyml_profile.c
+ * @brief Host Model Profiler CLI
+ *
+ * Runs a TinyML model blob on recorded inputs with the firmware interpreter
+ * and prints its per-layer profile, so a model that would break the
+ * inference budget is caught before deployment. Host times come from the
+ * monotonic clock and only rank the layers: a PC runs many times faster
+ * than the target. The budget verdict and the exit code use target cycles
+ * at TINYML_CPU_CLOCK_HZ, estimated as for the engine's load-time check
+ * (MACs times --cycles-per-mac, or tree nodes visited), or, with
+ * --cpu-scale, the measured host p99 times the target/host slowdown.
+ * On-device cycle counts are read with tinyml_export_metrics().
+ *
+ * Usage:
+ *   tinyml_profile <model.bin> <inputs> [--int8] [--repeat N] [--budget-ms MS]
+ *                  [--cycles-per-mac N] [--cpu-scale S] [--json]
+ *
+ * Inputs are consecutive raw little-endian frames of the model input size:
+ * float32 by default, int8 with --int8.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#define _POSIX_C_SOURCE 199309L                 /* clock_gettime() */
+
+#include "tinyml_model.h"
+#include "tinyml_trees.h"
+#include "tinyml_kernels.h"
+#include "tinyml_profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define PROFILE_DEFAULT_BUDGET_MS     100
+#define PROFILE_JSON_SIZE             4096
+#define PROFILE_TARGET_CYCLES_PER_MS  ((double)TINYML_CPU_CLOCK_HZ / 1000.0)
+
+static const char *op_names[] = {
+    "DENSE", "CONV1D", "DEPTHWISE_CONV1D", "MAX_POOL1D", "AVG_POOL1D",
+    "RELU", "SOFTMAX", "ADD", "MUL"
+};
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Read a whole file into a 4-byte aligned buffer
+ *
+ * @param path File path
+ * @param size Pointer to store file size
+ * @return Buffer (caller frees) or NULL on error
+ */
+static uint8_t *read_file(const char *path, uint32_t *size) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t *data = (length > 0) ? (uint8_t *)malloc((size_t)length) : NULL;
+    if (data && fread(data, 1, (size_t)length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+
+    *size = (uint32_t)length;
+    return data;
+}
+
+/**
+ * @brief Convert cycles to microseconds
+ *
+ * @param cycles Cycle count
+ * @return Microseconds
+ */
+static double cycles_to_us(double cycles) {
+    return cycles / (double)TINYML_PROFILER_CYCLES_PER_US;
+}
+
+/**
+ * @brief Read the host monotonic clock
+ *
+ * @return Nanoseconds, without the 32-bit wrap of the profiler timebase
+ */
+static uint64_t host_time_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Print a profile as a table
+ *
+ * @param profile Pointer to profile
+ * @param target_cycles Target cycles per inference
+ * @param target_basis How target_cycles was obtained
+ * @param budget_cycles Inference budget in target cycles
+ */
+static void print_profile(const tinyml_model_profile_t *profile, double target_cycles,
+                          const char *target_basis, double budget_cycles) {
+    const tinyml_cycle_stats_t *total = &profile->cycles;
+    double total_mean = total->runs ? (double)total->total_cycles / total->runs : 0.0;
+
+    printf("Model: %u layers, %lu MACs, arena %lu bytes, %lu runs\n\n",
+           (unsigned)profile->num_layers, (unsigned long)profile->total_macs,
+           (unsigned long)profile->arena_required, (unsigned long)total->runs);
+    printf("Host   %-17s %10s %8s %10s %10s %10s %10s %6s\n",
+           "Op", "MACs", "Arena", "Min us", "Mean us", "P99 us", "Max us", "Share");
+
+    for (uint8_t i = 0; i < profile->num_layers; i++) {
+        const tinyml_layer_profile_t *layer = &profile->layers[i];
+        double mean = layer->cycles.runs ? (double)layer->cycles.total_cycles / layer->cycles.runs : 0.0;
+        printf("%5u  %-17s %10lu %8lu %10.2f %10.2f %10.2f %10.2f %5.1f%%\n",
+               (unsigned)i, (layer->op < sizeof(op_names) / sizeof(op_names[0])) ? op_names[layer->op] : "?",
+               (unsigned long)layer->macs, (unsigned long)layer->arena_extent,
+               cycles_to_us(layer->cycles.min_cycles), cycles_to_us(mean),
+               cycles_to_us(dsp_quantile_value(&layer->cycles.p99)), cycles_to_us(layer->cycles.max_cycles),
+               total_mean > 0.0 ? mean * 100.0 / total_mean : 0.0);
+    }
+
+    float p99 = dsp_quantile_value(&total->p99);
+    printf("Total  %-17s %10lu %8lu %10.2f %10.2f %10.2f %10.2f\n\n", "",
+           (unsigned long)profile->total_macs, (unsigned long)profile->arena_required,
+           cycles_to_us(total->min_cycles), cycles_to_us(total_mean),
+           cycles_to_us(p99), cycles_to_us(total->max_cycles));
+    printf("Target %.0f cycles = %.2f ms at %lu MHz (%s)\n", target_cycles,
+           target_cycles / PROFILE_TARGET_CYCLES_PER_MS, (unsigned long)(TINYML_CPU_CLOCK_HZ / 1000000UL),
+           target_basis);
+    printf("Budget %.2f ms: %s\n", budget_cycles / PROFILE_TARGET_CYCLES_PER_MS,
+           (target_cycles <= budget_cycles) ? "OK" : "OVER");
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+int main(int argc, char **argv) {
+    const char *model_path = NULL;
+    const char *inputs_path = NULL;
+    bool int8_inputs = false;
+    bool json = false;
+    uint32_t repeat = 1;
+    uint32_t budget_ms = PROFILE_DEFAULT_BUDGET_MS;
+    uint32_t cycles_per_mac = TINYML_TARGET_CYCLES_PER_MAC_SIMD;
+    double cpu_scale = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--int8") == 0) {
+            int8_inputs = true;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--budget-ms") == 0 && i + 1 < argc) {
+            budget_ms = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--cycles-per-mac") == 0 && i + 1 < argc) {
+            cycles_per_mac = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--cpu-scale") == 0 && i + 1 < argc) {
+            cpu_scale = strtod(argv[++i], NULL);
+        } else if (!model_path) {
+            model_path = argv[i];
+        } else if (!inputs_path) {
+            inputs_path = argv[i];
+        }
+    }
+
+    if (!model_path || !inputs_path || repeat == 0 || cycles_per_mac == 0 || cpu_scale < 0.0) {
+        fprintf(stderr, "Usage: %s <model.bin> <inputs> [--int8] [--repeat N] [--budget-ms MS]\n"
+                        "       [--cycles-per-mac N] [--cpu-scale S] [--json]\n", argv[0]);
+        return 2;
+    }
+
+    uint32_t model_size = 0;
+    uint32_t inputs_size = 0;
+    uint8_t *blob = read_file(model_path, &model_size);
+    uint8_t *inputs = read_file(inputs_path, &inputs_size);
+    if (!blob || !inputs) {
+        fprintf(stderr, "Cannot read %s\n", blob ? inputs_path : model_path);
+        return 1;
+    }
+
+    tinyml_model_t model;
+    tinyml_tree_ensemble_t ensemble;
+    tinyml_model_profile_t profile;
+    bool is_ensemble = tinyml_tree_is_ensemble(blob, model_size);
+    uint32_t input_count;
+
+    if (is_ensemble) {
+        if (!tinyml_tree_parse(blob, model_size, &ensemble) || int8_inputs) {
+            fprintf(stderr, "Invalid tree ensemble (float inputs only)\n");
+            return 1;
+        }
+        input_count = ensemble.header->num_features;
+        tinyml_profiler_reset(&profile, NULL);
+    } else {
+        if (!tinyml_model_parse(blob, model_size, &model) || !tinyml_model_plan(&model)) {
+            fprintf(stderr, "Invalid model blob\n");
+            return 1;
+        }
+        input_count = model.tensor_size[0];
+        tinyml_profiler_reset(&profile, &model);
+    }
+
+    uint32_t frame_size = input_count * (uint32_t)(int8_inputs ? sizeof(int8_t) : sizeof(float));
+    uint32_t num_frames = inputs_size / frame_size;
+    if (num_frames == 0 || inputs_size % frame_size != 0) {
+        fprintf(stderr, "Input file is not a whole number of %lu-byte frames\n", (unsigned long)frame_size);
+        return 1;
+    }
+
+    uint8_t *arena = is_ensemble ? NULL : (uint8_t *)malloc(model.arena_required);
+    int8_t *quantized = (int8_t *)malloc(input_count);
+    float outputs[TINYML_TREE_MAX_OUTPUTS];
+    int8_t *output = is_ensemble ? NULL : (int8_t *)malloc(model.header->output_size);
+    uint32_t layer_cycles[TINYML_MODEL_MAX_LAYERS];
+
+    tinyml_profiler_init();
+
+    for (uint32_t r = 0; r < repeat; r++) {
+        for (uint32_t f = 0; f < num_frames; f++) {
+            const uint8_t *frame = &inputs[f * frame_size];
+            bool ok;
+            uint64_t start = host_time_ns();
+
+            if (is_ensemble) {
+                ok = tinyml_tree_predict(&ensemble, (const float *)frame, outputs);
+            } else {
+                if (int8_inputs) {
+                    memcpy(quantized, frame, input_count);
+                } else {
+                    tinyml_quantize_float((const float *)frame, quantized, input_count,
+                                          model.header->input_scale, model.header->input_zero_point);
+                }
+                ok = tinyml_model_invoke(&model, arena, model.arena_required, quantized, output, layer_cycles);
+            }
+
+            uint64_t elapsed = host_time_ns() - start;
+            if (!ok) {
+                fprintf(stderr, "Inference failed on frame %lu\n", (unsigned long)f);
+                return 1;
+            }
+            tinyml_profiler_record(&profile, (elapsed < UINT32_MAX) ? (uint32_t)elapsed : UINT32_MAX,
+                                   is_ensemble ? NULL : layer_cycles);
+        }
+    }
+
+    /* Host nanoseconds say nothing about the target; the verdict is in target cycles */
+    double budget_cycles = (double)budget_ms * PROFILE_TARGET_CYCLES_PER_MS;
+    double target_cycles;
+    const char *target_basis;
+    if (cpu_scale > 0.0) {
+        double host_p99_ns = (double)dsp_quantile_value(&profile.cycles.p99) * 1000.0 /
+                             (double)TINYML_PROFILER_CYCLES_PER_US;
+        target_cycles = host_p99_ns * cpu_scale * PROFILE_TARGET_CYCLES_PER_MS / 1.0e6;
+        target_basis = "host p99 x cpu-scale";
+    } else if (is_ensemble) {
+        target_cycles = (double)ensemble.header->num_trees * (ensemble.max_depth + 1.0) *
+                        TINYML_TARGET_CYCLES_PER_TREE_NODE;
+        target_basis = "tree nodes x cycles/node";
+    } else {
+        target_cycles = (double)model.total_macs * cycles_per_mac;
+        target_basis = "MACs x cycles/MAC";
+    }
+
+    if (json) {
+        static char buffer[PROFILE_JSON_SIZE];
+        if (!tinyml_profiler_export_json(&profile, 0, buffer, sizeof(buffer))) {
+            fprintf(stderr, "Profile does not fit the JSON buffer\n");
+            return 1;
+        }
+        printf("{\"host\":%s,\"target_clock_hz\":%lu,\"target_cycles\":%.0f,\"budget_cycles\":%.0f,"
+               "\"over_budget\":%s}\n", buffer, (unsigned long)TINYML_CPU_CLOCK_HZ, target_cycles, budget_cycles,
+               (target_cycles <= budget_cycles) ? "false" : "true");
+    } else {
+        print_profile(&profile, target_cycles, target_basis, budget_cycles);
+    }
+
+    free(output);
+    free(quantized);
+    free(arena);
+    free(inputs);
+    free(blob);
+
+    /* Non-zero when the model would miss its budget on the target, for use in CI */
+    return (target_cycles <= budget_cycles) ? 0 : 3;
+}
@@ -438,6 +438,7 @@ static void system_runtime_loop(void) {
         send_heartbeat();
         send_telemetry();
         read_sensor_data();
+        tinyml_run_monitoring();
         update_display();
         check_ota_updates();
 
@@ -13,6 +13,9 @@
 
 #include "acoustic_sensor.h"
 #include "../../common/sensors/sensor_interface.h"
+#include "../../common/dsp/dsp_sound_level.h"
+#include "../../common/dsp/dsp_octave.h"
+#include "../../common/dsp/dsp_heterodyne.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -35,24 +38,42 @@ static bool buffer_full = false;
 static float fft_input_buffer[ACOUSTIC_SENSOR_FFT_SIZE];
 static float fft_output_buffer[ACOUSTIC_SENSOR_FFT_SIZE];
 
+/* Streaming feature front-end for the acoustic classifier */
+static dsp_mel_t feature_frontend;
+static bool features_enabled = false;
+
 /* Window functions */
 static float hanning_window[ACOUSTIC_SENSOR_FFT_SIZE];
 static float hamming_window[ACOUSTIC_SENSOR_FFT_SIZE];
 static float blackman_window[ACOUSTIC_SENSOR_FFT_SIZE];
 
-/* A-weighting filter coefficients */
-static const float a_weighting_coeffs[5] = {
-    1.0f,    /* DC gain */
-    -4.019f, /* Pole 1 */
-    6.189f,  /* Pole 2 */
-    -3.789f, /* Pole 3 */
-    0.618f   /* Pole 4 */
-};
+/* Continuous A/C-weighted sound level meters fed by the microphone stream */
+static dsp_sound_level_t level_meter_a;
+static dsp_sound_level_t level_meter_c;
+static bool level_meters_valid = false;
+
+/* Octave band analysis: bin plan for the FFT path, optional filterbank */
+static const float BAND_MIN_HZ = 25.0f;     /* First third-octave band */
+static const float BAND_MAX_HZ = 12500.0f;  /* Last third-octave band */
+static dsp_octave_plan_t band_plan;
+static dsp_octave_filterbank_t band_filterbank;
+static bool band_filterbank_enabled = false;
+static bool band_filterbank_valid = false;
 
 /* Ultrasound detection */
 static const uint32_t ULTRASOUND_LOW_FREQ = 20000;  /* 20kHz */
 static const uint32_t ULTRASOUND_HIGH_FREQ = 80000; /* 80kHz */
 static const float ULTRASOUND_THRESHOLD_DB = 40.0f;
+static const float ULTRASOUND_IMPULSIVE_CREST = 4.0f; /* Envelope crest of arcing/PD */
+
+/* Heterodyne receiver for the ultrasound channel, fed in small chunks */
+#define ULTRASOUND_CHUNK_SAMPLES 256
+static dsp_heterodyne_t ultrasound_receiver;
+static bool ultrasound_receiver_valid = false;
+static int16_t ultrasound_chunk[ULTRASOUND_CHUNK_SAMPLES];
+static int16_t ultrasound_audio[ACOUSTIC_ULTRASOUND_AUDIO_SAMPLES];
+static uint32_t ultrasound_audio_count = 0;
+static uint32_t ultrasound_sample_index = 0;
 
 /* Calibration data */
 static struct {
@@ -162,11 +183,12 @@ static bool ma40s4r_read_samples(int16_t *buffer, uint32_t num_samples) {
     /* Placeholder: Generate test ultrasound data */
     for (uint32_t i = 0; i < num_samples; i++) {
         /* Simulate ultrasound signal at 40kHz */
-        float time = (float)(buffer_index + i) / 48000.0f;
+        float time = (float)(ultrasound_sample_index + i) / (float)ACOUSTIC_ULTRASOUND_SAMPLE_RATE_HZ;
         float signal = 800.0f * sinf(2.0f * M_PI * 40000.0f * time); /* 40kHz tone */
         signal += (float)(rand() % 50) - 25.0f;                     /* Low noise */
         buffer[i] = (int16_t)signal;
     }
+    ultrasound_sample_index += num_samples;
 
     return true;
 }
@@ -184,6 +206,7 @@ static bool ma40s4r_configure(float sensitivity_mv_pa) {
      */
 
     calibration_data.ultrasound_sensitivity_mv_pa = sensitivity_mv_pa;
+    ultrasound_receiver_valid = false;
     return true;
 }
 
@@ -298,34 +321,23 @@ static void calculate_fft_parameters(const float *fft_data, acoustic_fft_data_t
 
 /**
  * @brief Apply A-weighting filter to audio data
+ *
+ * IEC 61672 A-weighting biquad cascade over time-domain samples, starting
+ * from rest. Input and output may alias.
  */
 static bool apply_a_weighting(const float *input, float *output, uint32_t length,
                              uint32_t sampling_rate) {
-    /* TODO: Implement complete A-weighting filter */
-    /* This is a simplified placeholder that approximates A-weighting */
+    dsp_biquad_coeffs_t coeffs[DSP_SOUND_LEVEL_MAX_STAGES];
+    dsp_biquad_cascade_t filter;
+    uint8_t num_stages = 0;
 
-    /* A-weighting frequency response approximation */
-    for (uint32_t i = 0; i < length; i++) {
-        /* Simplified A-weighting: boost low frequencies, cut high frequencies */
-        float freq_response = 1.0f;
-
-        /* Approximate A-weighting curve */
-        if (i < length / 2) {
-            float freq = (float)i * (float)sampling_rate / (float)length;
-            if (freq > 20.0f && freq < 20000.0f) {
-                /* Simplified A-weighting approximation */
-                if (freq < 1000.0f) {
-                    freq_response = 1.0f + (1000.0f - freq) / 5000.0f;
-                } else {
-                    freq_response = 1.0f - (freq - 1000.0f) / 19000.0f;
-                    freq_response = fmaxf(freq_response, 0.1f);
-                }
-            }
-        }
-
-        output[i] = input[i] * freq_response;
+    if (!input || !output ||
+        !dsp_weighting_design(DSP_WEIGHTING_A, sampling_rate, coeffs, &num_stages) ||
+        !dsp_biquad_cascade_init(&filter, coeffs, num_stages)) {
+        return false;
     }
 
+    dsp_biquad_cascade_process(&filter, input, output, length);
     return true;
 }
 
@@ -380,6 +392,84 @@ static float calculate_peak_spl(const int16_t *audio_data, uint32_t length,
     }
 }
 
+/**
+ * @brief Sound pressure per PCM count, as used by calculate_rms_spl()
+ */
+static float pressure_per_count(float sensitivity_mv_pa) {
+    return (3.3f / 32768.0f) * 1000.0f / sensitivity_mv_pa;
+}
+
+/**
+ * @brief Update the continuous sound level meters with a block of samples
+ *
+ * Meters restart, with a new LAeq interval, whenever the sample rate or
+ * sensitivity changes or a measurement starts.
+ */
+static bool update_level_meters(const int16_t *audio_data, uint32_t length) {
+    if (!level_meters_valid) {
+        float scale = pressure_per_count(sensor_config.sensitivity_mv_pa);
+        uint32_t rate = sensor_config.base_config.sample_rate_hz;
+        level_meters_valid = dsp_sound_level_init(&level_meter_a, DSP_WEIGHTING_A, rate, scale) &&
+                             dsp_sound_level_init(&level_meter_c, DSP_WEIGHTING_C, rate, scale);
+        if (!level_meters_valid) {
+            return false;
+        }
+    }
+
+    dsp_sound_level_process(&level_meter_a, audio_data, length);
+    dsp_sound_level_process(&level_meter_c, audio_data, length);
+    return true;
+}
+
+/**
+ * @brief Update the third-octave filterbank with a block of samples
+ *
+ * Restarts on the same events as the level meters.
+ */
+static bool update_band_filterbank(const int16_t *audio_data, uint32_t length) {
+    if (!band_filterbank_valid) {
+        band_filterbank_valid = dsp_octave_filterbank_init(&band_filterbank, DSP_OCTAVE_THIRD,
+                                                           BAND_MIN_HZ, BAND_MAX_HZ,
+                                                           sensor_config.base_config.sample_rate_hz,
+                                                           pressure_per_count(sensor_config.sensitivity_mv_pa));
+        if (!band_filterbank_valid) {
+            return false;
+        }
+    }
+
+    dsp_octave_filterbank_process(&band_filterbank, audio_data, length);
+    return true;
+}
+
+/**
+ * @brief Store third-octave band powers and fold them into octave levels
+ *
+ * @param band_power Powers of the third-octave bands from 25 Hz
+ * @param num_bands Valid entries; bands above the analysis range read 0 dB
+ * @param reference Power that reads 0 dB
+ * @param bands Output band levels
+ */
+static void store_band_levels(const float *band_power, uint8_t num_bands, float reference,
+                              acoustic_frequency_bands_t *bands) {
+    float *octave[ACOUSTIC_SENSOR_OCTAVE_BANDS] = {
+        &bands->band_31_5_hz, &bands->band_63_hz, &bands->band_125_hz,
+        &bands->band_250_hz, &bands->band_500_hz, &bands->band_1000_hz,
+        &bands->band_2000_hz, &bands->band_4000_hz, &bands->band_8000_hz
+    };
+
+    for (uint8_t b = 0; b < ACOUSTIC_SENSOR_THIRD_OCTAVE_BANDS; b++) {
+        float power = (b < num_bands) ? band_power[b] : 0.0f;
+        bands->third_octave_db[b] = (power > 0.0f) ? 10.0f * log10f(power / reference) : 0.0f;
+    }
+
+    /* Octave o spans third-octave bands 3o to 3o + 2 (25, 31.5 and 40 Hz for 31.5 Hz) */
+    for (uint8_t o = 0; o < ACOUSTIC_SENSOR_OCTAVE_BANDS; o++) {
+        uint8_t b = (uint8_t)(3 * o);
+        float power = (b + 2 < num_bands) ? band_power[b] + band_power[b + 1] + band_power[b + 2] : 0.0f;
+        *octave[o] = (power > 0.0f) ? 10.0f * log10f(power / reference) : 0.0f;
+    }
+}
+
 /**
  * @brief Calculate crest factor
  */
@@ -451,6 +541,63 @@ static void detect_ultrasound(const acoustic_fft_data_t *fft_data,
         ultrasound_data->ultrasound_bandwidth_hz = 0;
         ultrasound_data->ultrasound_type = 0;
     }
+    ultrasound_data->envelope_crest_factor = 0.0f;
+}
+
+/**
+ * @brief Measure the ultrasound channel through the heterodyne receiver
+ *
+ * Covers the time span of one microphone capture. Transducer samples are
+ * streamed through in small chunks and only the decimated audio is kept.
+ * A steady envelope indicates a leak, an impulsive one arcing or PD.
+ */
+static bool measure_ultrasound(acoustic_ultrasound_data_t *ultrasound_data) {
+    uint32_t audio_rate = sensor_config.base_config.sample_rate_hz;
+    if (audio_rate == 0) {
+        return false;
+    }
+
+    if (!ultrasound_receiver_valid) {
+        ultrasound_receiver_valid = dsp_heterodyne_init(&ultrasound_receiver, ACOUSTIC_ULTRASOUND_SAMPLE_RATE_HZ,
+                                                        (float)ACOUSTIC_ULTRASOUND_CENTER_HZ,
+                                                        (float)ACOUSTIC_ULTRASOUND_BANDWIDTH_HZ,
+                                                        pressure_per_count(calibration_data.ultrasound_sensitivity_mv_pa));
+        if (!ultrasound_receiver_valid) {
+            return false;
+        }
+    }
+
+    uint32_t total = (uint32_t)((uint64_t)ACOUSTIC_SENSOR_MAX_SAMPLES * ACOUSTIC_ULTRASOUND_SAMPLE_RATE_HZ / audio_rate);
+    dsp_heterodyne_reset(&ultrasound_receiver);
+    ultrasound_audio_count = 0;
+
+    for (uint32_t offset = 0; offset < total; offset += ULTRASOUND_CHUNK_SAMPLES) {
+        uint32_t count = (total - offset < ULTRASOUND_CHUNK_SAMPLES) ? total - offset : ULTRASOUND_CHUNK_SAMPLES;
+        if (!ma40s4r_read_samples(ultrasound_chunk, count)) {
+            return false;
+        }
+        uint32_t room = ACOUSTIC_ULTRASOUND_AUDIO_SAMPLES - ultrasound_audio_count;
+        uint32_t produced = dsp_heterodyne_process(&ultrasound_receiver, ultrasound_chunk, count,
+                                                   &ultrasound_audio[ultrasound_audio_count], room);
+        ultrasound_audio_count += (produced < room) ? produced : room;
+    }
+
+    dsp_heterodyne_levels_t levels;
+    dsp_heterodyne_get_levels(&ultrasound_receiver, &levels);
+
+    ultrasound_data->ultrasound_level_db = levels.level_db;
+    ultrasound_data->envelope_crest_factor = levels.envelope_crest_factor;
+    ultrasound_data->ultrasound_detected = (levels.level_db > ULTRASOUND_THRESHOLD_DB);
+    if (ultrasound_data->ultrasound_detected) {
+        ultrasound_data->ultrasound_frequency_hz = (uint16_t)levels.frequency_hz;
+        ultrasound_data->ultrasound_bandwidth_hz = (float)ACOUSTIC_ULTRASOUND_BANDWIDTH_HZ;
+        ultrasound_data->ultrasound_type = (levels.envelope_crest_factor > ULTRASOUND_IMPULSIVE_CREST) ? 2 : 0;
+    } else {
+        ultrasound_data->ultrasound_frequency_hz = 0;
+        ultrasound_data->ultrasound_bandwidth_hz = 0;
+        ultrasound_data->ultrasound_type = 0;
+    }
+    return true;
 }
 
 /* ============================================================================
@@ -513,6 +660,8 @@ bool acoustic_sensor_deinit(void) {
 
     /* TODO: Deinitialize hardware */
 
+    features_enabled = false;
+    band_filterbank_enabled = false;
     sensor_initialized = false;
     return true;
 }
@@ -526,6 +675,8 @@ bool acoustic_sensor_configure(const acoustic_sensor_config_t *config) {
     }
 
     sensor_config = *config;
+    level_meters_valid = false;
+    band_filterbank_valid = false;
     return ics43434_configure(sensor_config.sensitivity_mv_pa, sensor_config.base_config.sampling_rate_hz) &&
            ma40s4r_configure(sensor_config.sensitivity_mv_pa);
 }
@@ -547,6 +698,10 @@ bool acoustic_sensor_start_measurement(void) {
     sensor_status.base_status.is_initialized = true;
     sensor_status.samples_acquired = 0;
 
+    /* New LAeq interval */
+    level_meters_valid = false;
+    band_filterbank_valid = false;
+
     return true;
 }
 
@@ -577,6 +732,11 @@ bool acoustic_sensor_read_data(acoustic_sensor_data_t *data, uint32_t timeout_ms
         return false;
     }
 
+    /* Feature frames follow the audio stream */
+    if (features_enabled) {
+        dsp_mel_process(&feature_frontend, audio_buffer, ACOUSTIC_SENSOR_MAX_SAMPLES);
+    }
+
     /* Copy raw data */
     memcpy(data->raw_data.audio_samples, audio_buffer, sizeof(audio_buffer));
     data->raw_data.sample_count = ACOUSTIC_SENSOR_MAX_SAMPLES;
@@ -590,6 +750,21 @@ bool acoustic_sensor_read_data(acoustic_sensor_data_t *data, uint32_t timeout_ms
                                       sensor_config.base_config.sampling_rate_hz, &processed)) {
         return false;
     }
+
+    /* Continuous weighted levels over the whole measurement */
+    dsp_sound_levels_t levels_a;
+    dsp_sound_levels_t levels_c;
+    if (update_level_meters(audio_buffer, ACOUSTIC_SENSOR_MAX_SAMPLES) &&
+        dsp_sound_level_get(&level_meter_a, &levels_a) && dsp_sound_level_get(&level_meter_c, &levels_c)) {
+        processed.a_weighted_level_db = levels_a.fast_db;
+        processed.a_weighted_slow_level_db = levels_a.slow_db;
+        processed.a_weighted_max_level_db = levels_a.max_fast_db;
+        processed.equivalent_level_db = levels_a.leq_db;
+        processed.sound_exposure_db = levels_a.leq_db + 10.0f * log10f(levels_a.duration_s);
+        processed.measurement_duration_ms = (uint32_t)(levels_a.duration_s * 1000.0f);
+        processed.c_weighted_level_db = levels_c.fast_db;
+        processed.c_weighted_peak_db = levels_c.peak_db;
+    }
     data->processed_data = processed;
 
     /* Perform FFT analysis */
@@ -604,11 +779,23 @@ bool acoustic_sensor_read_data(acoustic_sensor_data_t *data, uint32_t timeout_ms
     if (!acoustic_sensor_analyze_frequency_bands(&fft_data, &bands)) {
         return false;
     }
+
+    /* Per-band Leq from the filterbank replaces the FFT band powers */
+    if (band_filterbank_enabled && update_band_filterbank(audio_buffer, ACOUSTIC_SENSOR_MAX_SAMPLES)) {
+        float mean_square[ACOUSTIC_SENSOR_THIRD_OCTAVE_BANDS];
+        uint8_t num_bands = dsp_octave_filterbank_get_mean_square(&band_filterbank, mean_square);
+        if (num_bands > 0) {
+            store_band_levels(mean_square, num_bands, DSP_SOUND_LEVEL_REF_PA * DSP_SOUND_LEVEL_REF_PA, &bands);
+            bands.filterbank_levels = true;
+        }
+    }
     data->frequency_bands = bands;
 
-    /* Detect ultrasound */
+    /* Detect ultrasound: heterodyne the transducer channel when enabled */
     acoustic_ultrasound_data_t ultrasound;
-    acoustic_sensor_detect_ultrasound(&fft_data, &ultrasound);
+    if (!sensor_config.enable_ultrasound_detection || !measure_ultrasound(&ultrasound)) {
+        acoustic_sensor_detect_ultrasound(&fft_data, &ultrasound);
+    }
     data->ultrasound_data = ultrasound;
 
     /* Calculate overall condition score */
@@ -748,33 +935,28 @@ bool acoustic_sensor_calculate_spl(const int16_t *audio_data, uint32_t data_leng
     processed_data->crest_factor = calculate_crest_factor(processed_data->rms_level_db,
                                                         processed_data->peak_level_db);
 
-    /* Apply A-weighting if enabled */
+    /* A-weighted level of this block, from the IEC 61672 filter cascade */
+    processed_data->a_weighted_level_db = processed_data->rms_level_db;
     if (sensor_config.enable_a_weighting) {
-        /* Convert to float for filtering */
-        float temp_buffer[ACOUSTIC_SENSOR_MAX_SAMPLES];
-        for (uint32_t i = 0; i < data_length && i < ACOUSTIC_SENSOR_MAX_SAMPLES; i++) {
-            temp_buffer[i] = (float)audio_data[i];
+        dsp_sound_level_t meter;
+        dsp_sound_levels_t levels;
+        if (dsp_sound_level_init(&meter, DSP_WEIGHTING_A, sampling_rate, pressure_per_count(sensitivity_mv_pa))) {
+            dsp_sound_level_process(&meter, audio_data, data_length);
+            dsp_sound_level_get(&meter, &levels);
+            processed_data->a_weighted_level_db = levels.leq_db;
         }
-
-        float a_weighted_buffer[ACOUSTIC_SENSOR_MAX_SAMPLES];
-        if (apply_a_weighting(temp_buffer, a_weighted_buffer, data_length, sampling_rate)) {
-            processed_data->a_weighted_level_db = calculate_rms_spl(
-                (int16_t *)a_weighted_buffer, data_length, sensitivity_mv_pa, sampling_rate);
-        } else {
-            processed_data->a_weighted_level_db = processed_data->rms_level_db;
-        }
-    } else {
-        processed_data->a_weighted_level_db = processed_data->rms_level_db;
     }
 
-    /* Calculate equivalent continuous level */
-    processed_data->equivalent_level_db = processed_data->rms_level_db;
-
-    /* Calculate sound exposure level */
-    processed_data->sound_exposure_db = processed_data->rms_level_db + 10.0f * log10f(
-        (float)processed_data->measurement_duration_ms / 1000.0f);
-
+    /* Block-only values; read_data() replaces them with the continuous meters */
     processed_data->measurement_duration_ms = (uint32_t)((float)data_length * 1000.0f / (float)sampling_rate);
+    processed_data->equivalent_level_db = processed_data->a_weighted_level_db;
+    processed_data->a_weighted_slow_level_db = processed_data->a_weighted_level_db;
+    processed_data->a_weighted_max_level_db = processed_data->a_weighted_level_db;
+    processed_data->c_weighted_level_db = processed_data->rms_level_db;
+    processed_data->c_weighted_peak_db = processed_data->peak_level_db;
+    processed_data->sound_exposure_db = processed_data->equivalent_level_db + 10.0f * log10f(
+        (float)data_length / (float)sampling_rate);
+
     processed_data->timestamp = 0; /* TODO: Get actual timestamp */
 
     return true;
@@ -783,9 +965,9 @@ bool acoustic_sensor_calculate_spl(const int16_t *audio_data, uint32_t data_leng
 /**
  * @brief Apply A-weighting filter
  */
-bool acoustic_sensor_apply_a_weighting(const float *frequency_data, float *a_weighted_data,
+bool acoustic_sensor_apply_a_weighting(const float *audio_data, float *a_weighted_data,
                                      uint32_t data_length, uint32_t sampling_rate) {
-    return apply_a_weighting(frequency_data, a_weighted_data, data_length, sampling_rate);
+    return apply_a_weighting(audio_data, a_weighted_data, data_length, sampling_rate);
 }
 
 /**
@@ -797,55 +979,18 @@ bool acoustic_sensor_analyze_frequency_bands(const acoustic_fft_data_t *fft_data
         return false;
     }
 
-    uint32_t sampling_rate = sensor_config.base_config.sampling_rate_hz;
-    float band_power[9] = {0};
-
-    /* Define frequency band edges (IEC 61672-1) */
-    const float band_edges[10] = {31.5f, 63.0f, 125.0f, 250.0f, 500.0f, 1000.0f, 2000.0f, 4000.0f, 8000.0f, 16000.0f};
-
-    /* Sum power in each frequency band */
-    for (uint16_t i = 1; i < ACOUSTIC_SENSOR_FFT_SIZE / 2; i++) {
-        float frequency = (float)i * (float)sampling_rate / (float)ACOUSTIC_SENSOR_FFT_SIZE;
-        float power = fft_data->frequency_bins[i] * fft_data->frequency_bins[i];
-
-        /* Find which band this frequency belongs to */
-        for (int band = 0; band < 9; band++) {
-            if (frequency >= band_edges[band] && frequency < band_edges[band + 1]) {
-                band_power[band] += power;
-                break;
-            }
-        }
+    /* Bin slices are rebuilt only when the sample rate changes */
+    uint32_t sampling_rate = sensor_config.base_config.sample_rate_hz;
+    if (band_plan.sample_rate_hz != sampling_rate &&
+        !dsp_octave_plan_init(&band_plan, DSP_OCTAVE_THIRD, BAND_MIN_HZ, BAND_MAX_HZ,
+                              sampling_rate, ACOUSTIC_SENSOR_FFT_SIZE)) {
+        return false;
     }
 
-    /* Convert to dB levels */
-    for (int band = 0; band < 9; band++) {
-        if (band_power[band] > 0) {
-            float db_level = 10.0f * log10f(band_power[band]);
-            switch (band) {
-                case 0: bands->band_31_5_hz = db_level; break;
-                case 1: bands->band_63_hz = db_level; break;
-                case 2: bands->band_125_hz = db_level; break;
-                case 3: bands->band_250_hz = db_level; break;
-                case 4: bands->band_500_hz = db_level; break;
-                case 5: bands->band_1000_hz = db_level; break;
-                case 6: bands->band_2000_hz = db_level; break;
-                case 7: bands->band_4000_hz = db_level; break;
-                case 8: bands->band_8000_hz = db_level; break;
-            }
-        } else {
-            switch (band) {
-                case 0: bands->band_31_5_hz = 0.0f; break;
-                case 1: bands->band_63_hz = 0.0f; break;
-                case 2: bands->band_125_hz = 0.0f; break;
-                case 3: bands->band_250_hz = 0.0f; break;
-                case 4: bands->band_500_hz = 0.0f; break;
-                case 5: bands->band_1000_hz = 0.0f; break;
-                case 6: bands->band_2000_hz = 0.0f; break;
-                case 7: bands->band_4000_hz = 0.0f; break;
-                case 8: bands->band_8000_hz = 0.0f; break;
-            }
-        }
-    }
+    float band_power[ACOUSTIC_SENSOR_THIRD_OCTAVE_BANDS];
+    uint8_t num_bands = dsp_octave_sum_magnitude(&band_plan, fft_data->frequency_bins, band_power);
+    store_band_levels(band_power, num_bands, 1.0f, bands);
+    bands->filterbank_levels = false;
 
     return true;
 }
@@ -1010,6 +1155,8 @@ bool acoustic_sensor_set_sensitivity(float sensitivity_mv_pa) {
     }
 
     sensor_config.sensitivity_mv_pa = sensitivity_mv_pa;
+    level_meters_valid = false;
+    band_filterbank_valid = false;
     return ics43434_configure(sensor_config.sensitivity_mv_pa, sensor_config.base_config.sampling_rate_hz);
 }
 
@@ -1036,10 +1183,78 @@ bool acoustic_sensor_clear_buffer(void) {
     buffer_index = 0;
     buffer_full = false;
     sensor_status.samples_acquired = 0;
+    if (features_enabled) {
+        dsp_mel_reset(&feature_frontend);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Enable the time-domain third-octave filterbank
+ */
+bool acoustic_sensor_enable_band_filterbank(bool enable) {
+    if (!sensor_initialized) {
+        return false;
+    }
+
+    band_filterbank_enabled = enable;
+    band_filterbank_valid = false;
+    return true;
+}
+
+/**
+ * @brief Get the heterodyned ultrasound audio of the last capture
+ */
+bool acoustic_sensor_get_ultrasound_audio(int16_t *audio, uint32_t buffer_size, uint32_t *sample_count) {
+    if (!sensor_initialized || !audio || !sample_count) {
+        return false;
+    }
+
+    uint32_t count = (ultrasound_audio_count < buffer_size) ? ultrasound_audio_count : buffer_size;
+    memcpy(audio, ultrasound_audio, count * sizeof(int16_t));
+    *sample_count = count;
+    return true;
+}
+
+/**
+ * @brief Enable the streaming log-mel/MFCC front-end
+ */
+bool acoustic_sensor_enable_features(const dsp_mel_config_t *config) {
+    if (!sensor_initialized) {
+        return false;
+    }
+
+    if (!config) {
+        features_enabled = false;
+        return true;
+    }
+
+    /* The front-end runs at the microphone rate */
+    if (config->sample_rate_hz != sensor_config.base_config.sample_rate_hz ||
+        !dsp_mel_init(&feature_frontend, config)) {
+        features_enabled = false;
+        return false;
+    }
 
+    features_enabled = true;
     return true;
 }
 
+/**
+ * @brief Get the latest feature map
+ */
+bool acoustic_sensor_get_feature_map(int8_t *features, uint32_t buffer_size, uint32_t *frames_computed) {
+    if (!sensor_initialized || !features_enabled || !features) {
+        return false;
+    }
+
+    if (frames_computed) {
+        *frames_computed = feature_frontend.frames_computed;
+    }
+    return dsp_mel_get_feature_map(&feature_frontend, features, buffer_size);
+}
+
 /**
  * @brief Get acoustic diagnostics
  */
@@ -16,6 +16,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "../../common/sensors/sensor_interface.h"
+#include "../../common/dsp/dsp_mel.h"
 
 /* ============================================================================
  * Acoustic Sensor Configuration
@@ -25,6 +26,14 @@
 #define ACOUSTIC_SENSOR_FFT_SIZE          1024
 #define ACOUSTIC_SENSOR_SAMPLE_RATE_MAX   48000
 #define ACOUSTIC_SENSOR_SAMPLE_RATE_MIN   8000
+#define ACOUSTIC_SENSOR_OCTAVE_BANDS      9     /* 31.5 Hz to 8 kHz */
+#define ACOUSTIC_SENSOR_THIRD_OCTAVE_BANDS 28   /* 25 Hz to 12.5 kHz */
+
+/* Ultrasound channel (MA40S4R), heterodyned to audio */
+#define ACOUSTIC_ULTRASOUND_SAMPLE_RATE_HZ 192000
+#define ACOUSTIC_ULTRASOUND_CENTER_HZ     40000
+#define ACOUSTIC_ULTRASOUND_BANDWIDTH_HZ  4000  /* 38-42 kHz */
+#define ACOUSTIC_ULTRASOUND_AUDIO_SAMPLES 512   /* Down-converted audio kept per capture */
 
 /* Acoustic thresholds (dB SPL) */
 #define ACOUSTIC_THRESHOLD_QUIET          30.0f
@@ -70,9 +79,13 @@ typedef struct {
     float rms_level_db;                      /**< RMS sound pressure level (dB SPL) */
     float peak_level_db;                     /**< Peak sound pressure level (dB SPL) */
     float crest_factor;                      /**< Crest factor */
-    float a_weighted_level_db;               /**< A-weighted sound level (dB(A)) */
-    float equivalent_level_db;               /**< Equivalent continuous level (dB) */
-    float sound_exposure_db;                 /**< Sound exposure level (dB) */
+    float a_weighted_level_db;               /**< A-weighted Fast sound level, LAF (dB(A)) */
+    float a_weighted_slow_level_db;          /**< A-weighted Slow sound level, LAS (dB(A)) */
+    float a_weighted_max_level_db;           /**< Maximum LAF since measurement start (dB(A)) */
+    float c_weighted_level_db;               /**< C-weighted Fast sound level, LCF (dB(C)) */
+    float c_weighted_peak_db;                /**< C-weighted peak level, LCpeak (dB(C)) */
+    float equivalent_level_db;               /**< LAeq since measurement start (dB(A)) */
+    float sound_exposure_db;                 /**< A-weighted sound exposure level, LAE (dB(A)) */
     uint32_t measurement_duration_ms;        /**< Measurement duration */
     uint32_t timestamp;                      /**< Processing timestamp */
 } acoustic_processed_data_t;
@@ -104,6 +117,8 @@ typedef struct {
     float band_2000_hz;                      /**< 2000 Hz band level (dB) */
     float band_4000_hz;                      /**< 4000 Hz band level (dB) */
     float band_8000_hz;                      /**< 8000 Hz band level (dB) */
+    float third_octave_db[ACOUSTIC_SENSOR_THIRD_OCTAVE_BANDS]; /**< 1/3-octave levels from 25 Hz (dB, 0 = not resolved) */
+    bool filterbank_levels;                  /**< Levels are per-band Leq in dB SPL from the filterbank */
 } acoustic_frequency_bands_t;
 
 /**
@@ -114,7 +129,8 @@ typedef struct {
     uint16_t ultrasound_frequency_hz;        /**< Detected ultrasound frequency */
     float ultrasound_level_db;               /**< Ultrasound level (dB) */
     float ultrasound_bandwidth_hz;           /**< Ultrasound bandwidth */
-    uint8_t ultrasound_type;                 /**< Type of ultrasound (0=Aerosol, 1=Leak, 2=PD) */
+    uint8_t ultrasound_type;                 /**< Type of ultrasound (0=Leak, 1=Bearing, 2=PD/arcing) */
+    float envelope_crest_factor;             /**< Envelope peak / RMS: steady leak vs impulsive arcing */
 } acoustic_ultrasound_data_t;
 
 /**
@@ -208,9 +224,9 @@ bool acoustic_sensor_calculate_spl(const int16_t *audio_data, uint32_t data_leng
                                   uint32_t sampling_rate, acoustic_processed_data_t *processed_data);
 
 /**
- * @brief Apply A-weighting filter
+ * @brief Apply IEC 61672 A-weighting to time-domain samples
  */
-bool acoustic_sensor_apply_a_weighting(const float *frequency_data, float *a_weighted_data,
+bool acoustic_sensor_apply_a_weighting(const float *audio_data, float *a_weighted_data,
                                      uint32_t data_length, uint32_t sampling_rate);
 
 /**
@@ -278,6 +294,38 @@ bool acoustic_sensor_get_rms_level(float *rms_level_db);
  */
 bool acoustic_sensor_clear_buffer(void);
 
+/**
+ * @brief Enable the streaming log-mel/MFCC front-end (NULL disables it)
+ *
+ * Every block read from the microphone is pushed through the front-end, so
+ * an int8 feature map for TINYML_MODEL_ACOUSTIC_CLASSIFIER builds up as
+ * audio arrives.
+ */
+bool acoustic_sensor_enable_features(const dsp_mel_config_t *config);
+
+/**
+ * @brief Get the latest feature map, oldest frame first
+ */
+bool acoustic_sensor_get_feature_map(int8_t *features, uint32_t buffer_size, uint32_t *frames_computed);
+
+/**
+ * @brief Enable the time-domain third-octave filterbank
+ *
+ * Band levels then come from per-band Leq in dB SPL since measurement start
+ * instead of the FFT band powers of each capture. The filterbank costs three
+ * biquad sections per band and sample (84 at 48 kHz), so it is off by
+ * default.
+ */
+bool acoustic_sensor_enable_band_filterbank(bool enable);
+
+/**
+ * @brief Get the heterodyned ultrasound audio of the last capture
+ *
+ * With ultrasound detection enabled, the 38-42 kHz band of the transducer
+ * is mixed down to 0-4 kHz at the receiver output rate (8 kHz).
+ */
+bool acoustic_sensor_get_ultrasound_audio(int16_t *audio, uint32_t buffer_size, uint32_t *sample_count);
+
 /**
  * @brief Get acoustic diagnostics
  */
@@ -12,6 +12,9 @@
 
 #include "current_sensor.h"
 #include "../../common/sensors/sensor_interface.h"
+#include "../../common/dsp/dsp_line_sync.h"
+#include "../../common/dsp/dsp_mcsa.h"
+#include "../../common/dsp/dsp_three_phase.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -30,6 +33,10 @@ static int16_t current_buffer[CURRENT_SENSOR_MAX_SAMPLES];
 static uint32_t buffer_index = 0;
 static bool buffer_full = false;
 
+/* Three-phase scan (DMA target, frames of A, B, C) and per-phase arrays */
+static int16_t scan_buffer[CURRENT_SENSOR_MAX_SAMPLES * CURRENT_SENSOR_PHASES];
+static float phase_buffers[CURRENT_SENSOR_PHASES][CURRENT_SENSOR_MAX_SAMPLES];
+
 /* FFT working buffers */
 static float fft_input_buffer[CURRENT_SENSOR_FFT_SIZE];
 static float fft_output_buffer[CURRENT_SENSOR_FFT_SIZE];
@@ -39,6 +46,16 @@ static float hanning_window[CURRENT_SENSOR_FFT_SIZE];
 static float hamming_window[CURRENT_SENSOR_FFT_SIZE];
 static float blackman_window[CURRENT_SENSOR_FFT_SIZE];
 
+/* Line-synchronous harmonic analysis (PLL state persists across reads) */
+static dsp_line_sync_t line_sync;
+static bool line_sync_valid = false;
+static dsp_line_sync_results_t line_sync_results;
+
+/* Motor current signature analysis (one zoom capture spans many reads) */
+static dsp_mcsa_t mcsa;
+static bool mcsa_valid = false;
+static float motor_speed_rpm = 0.0f;     /* Known shaft speed, 0 = estimate */
+
 /* Power analysis */
 static float voltage_reference = 220.0f; /* Default 220V RMS */
 static float power_factor = 1.0f;
@@ -128,6 +145,42 @@ static bool acs723_read_samples(int16_t *buffer, uint32_t num_samples) {
     return true;
 }
 
+/**
+ * @brief Read synchronous three-phase scans from the ACS723 channels
+ */
+static bool acs723_read_scan(int16_t *scan, uint32_t num_frames) {
+    /* TODO: Implement the ADC scan acquisition */
+    /* This would typically involve:
+     * - Configuring the ADC regular sequence for the phase A, B and C channels
+     * - Triggering one scan per sample from the sampling timer
+     * - Circular DMA of each scan into consecutive frames of the buffer
+     * - Waiting for the transfer-complete interrupt
+     */
+
+    /* Placeholder: Generate a slightly unbalanced three-phase motor current */
+    static float phase = 0.0f;
+    const float phase_increment = 2.0f * M_PI * 50.0f / 5000.0f; /* 50Hz at 5kHz sampling */
+    const float amplitude[CURRENT_SENSOR_PHASES] = {15.0f, 14.4f, 15.3f};
+    const float displacement[CURRENT_SENSOR_PHASES] = {0.0f, -2.0f * M_PI / 3.0f, 2.0f * M_PI / 3.0f};
+
+    for (uint32_t i = 0; i < num_frames; i++) {
+        for (uint8_t p = 0; p < CURRENT_SENSOR_PHASES; p++) {
+            float angle = phase + displacement[p];
+            float current = amplitude[p] * sinf(angle) + 1.5f * sinf(5.0f * angle);
+            current += (float)(rand() % 100) * 0.01f - 0.5f;
+            current += calibration_data.offset_mv * 0.001f;
+            scan[i * CURRENT_SENSOR_PHASES + p] = (int16_t)(current * 4096.0f / 60.0f); /* ±30A range */
+        }
+
+        phase += phase_increment;
+        if (phase > 2.0f * M_PI) {
+            phase -= 2.0f * M_PI;
+        }
+    }
+
+    return true;
+}
+
 /**
  * @brief Configure ACS723 sensor parameters
  */
@@ -324,6 +377,98 @@ static float calculate_form_factor(float rms_current, float average_current) {
  * Harmonic Analysis
  * ============================================================================ */
 
+/**
+ * @brief Run the samples through the line-synchronous PLL and the signature analyser
+ *
+ * Both are (re)initialised when the sample rate changes; the PLL running
+ * averages and the signature capture span successive reads. The signature
+ * analyser mixes at the frequency tracked by the PLL.
+ *
+ * @return true if the PLL is locked and has analysed at least one cycle
+ */
+static bool update_line_sync(const int16_t *current_samples, uint32_t sample_count, uint32_t sampling_rate) {
+    if (sensor_config.enable_motor_load_detection &&
+        (!mcsa_valid || mcsa.config.sample_rate_hz != sampling_rate)) {
+        dsp_mcsa_config_t config = {
+            .sample_rate_hz = sampling_rate,
+            .line_hz = CURRENT_SENSOR_LINE_FREQUENCY_HZ,
+            .poles = motor_specs.poles,
+            .speed_rpm = motor_speed_rpm,
+            .rated_speed_rpm = motor_specs.rated_speed_rpm
+        };
+        mcsa_valid = dsp_mcsa_init(&mcsa, &config);
+    }
+    if (mcsa_valid && line_sync_results.locked) {
+        dsp_mcsa_set_line_frequency(&mcsa, line_sync_results.frequency_hz);
+    }
+
+    if (!line_sync_valid || line_sync.config.sample_rate_hz != sampling_rate) {
+        dsp_line_sync_config_t config;
+        dsp_line_sync_default_config(&config, sampling_rate, CURRENT_SENSOR_LINE_FREQUENCY_HZ);
+        line_sync_valid = dsp_line_sync_init(&line_sync, &config);
+        memset(&line_sync_results, 0, sizeof(line_sync_results));
+        if (!line_sync_valid) {
+            return false;
+        }
+    }
+
+    /* Convert to amperes a buffer at a time */
+    for (uint32_t offset = 0; offset < sample_count; offset += CURRENT_SENSOR_FFT_SIZE) {
+        uint32_t count = sample_count - offset;
+        if (count > CURRENT_SENSOR_FFT_SIZE) {
+            count = CURRENT_SENSOR_FFT_SIZE;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            float voltage_mv = ((float)current_samples[offset + i] / 4096.0f) * 3300.0f;
+            fft_input_buffer[i] = (voltage_mv - calibration_data.offset_mv) / sensor_config.sensitivity_mv_a;
+        }
+        dsp_line_sync_process(&line_sync, fft_input_buffer, NULL, count);
+        if (mcsa_valid && sensor_config.enable_motor_load_detection) {
+            dsp_mcsa_process(&mcsa, fft_input_buffer, count);
+        }
+    }
+
+    if (!dsp_line_sync_get_results(&line_sync, &line_sync_results)) {
+        line_sync_results.locked = false;
+        return false;
+    }
+    return line_sync_results.locked;
+}
+
+/**
+ * @brief Fill the harmonic data from the line-synchronous results
+ */
+static void store_line_sync_harmonics(current_harmonic_data_t *harmonic_data) {
+    const dsp_line_sync_results_t *r = &line_sync_results;
+    float fundamental = r->harmonic_rms[0][1];
+
+    /* Index i holds harmonic order i + 1 */
+    for (uint8_t i = 0; i < 16; i++) {
+        uint8_t order = i + 1;
+        bool valid = (order <= r->max_harmonic);
+        harmonic_data->harmonic_magnitudes[i] = valid ? r->harmonic_rms[0][order] : 0.0f;
+        harmonic_data->harmonic_phases[i] = valid ? r->harmonic_phase_deg[0][order] : 0.0f;
+        harmonic_data->harmonic_percentages[i] = (fundamental > 0.0f) ?
+                                                (harmonic_data->harmonic_magnitudes[i] / fundamental) * 100.0f : 0.0f;
+    }
+
+    harmonic_data->thd_f = r->thd_f[0];
+    harmonic_data->thd_r = r->thd_r[0];
+
+    /* K-factor (IEEE C57.110) and significant harmonics over every tracked order */
+    float sum_squares = 0.0f, weighted_sum = 0.0f;
+    harmonic_data->significant_harmonics = 0;
+    for (uint8_t order = 1; order <= r->max_harmonic; order++) {
+        float ms = r->harmonic_rms[0][order] * r->harmonic_rms[0][order];
+        sum_squares += ms;
+        weighted_sum += ms * (float)order * (float)order;
+        if (r->harmonic_rms[0][order] > fundamental * 0.03f) { /* 3% threshold */
+            harmonic_data->significant_harmonics++;
+        }
+    }
+    harmonic_data->k_factor = (sum_squares > 0.0f) ? weighted_sum / sum_squares : 1.0f;
+}
+
 /**
  * @brief Calculate total harmonic distortion
  */
@@ -391,8 +536,13 @@ static void analyze_power_quality(float rms_current, float fundamental_current,
         power_data->displacement_power_factor = 1.0f;
     }
 
-    /* Estimate frequency (simplified) */
-    power_data->frequency_hz = 50.0f; /* Assume 50Hz */
+    /* With a locked PLL the fundamental is exact, so the assumed power factor is the displacement one */
+    if (line_sync_results.locked) {
+        power_data->displacement_power_factor = power_factor;
+        power_data->frequency_hz = line_sync_results.frequency_hz;
+    } else {
+        power_data->frequency_hz = CURRENT_SENSOR_LINE_FREQUENCY_HZ;
+    }
 
     /* Estimate voltage (simplified) */
     power_data->voltage_rms_v = voltage_reference;
@@ -411,11 +561,12 @@ static void analyze_power_quality(float rms_current, float fundamental_current,
 static void analyze_motor_load(float rms_current, float fundamental_current,
                              const current_processed_data_t *current_data,
                              current_motor_data_t *motor_data) {
+    memset(motor_data, 0, sizeof(current_motor_data_t));
+
     /* Check if motor is connected (current > threshold) */
     motor_data->motor_connected = (rms_current > CURRENT_THRESHOLD_LOW);
 
     if (!motor_data->motor_connected) {
-        memset(motor_data, 0, sizeof(current_motor_data_t));
         return;
     }
 
@@ -443,11 +594,36 @@ static void analyze_motor_load(float rms_current, float fundamental_current,
 
     /* Calculate slip (simplified) */
     if (motor_specs.rated_speed_rpm > 0) {
-        float synchronous_speed = (120.0f * motor_specs.frequency_hz) / motor_specs.poles;
+        float line_hz = line_sync_results.locked ? line_sync_results.frequency_hz : CURRENT_SENSOR_LINE_FREQUENCY_HZ;
+        float synchronous_speed = (120.0f * line_hz) / motor_specs.poles;
         motor_data->slip_percentage = ((synchronous_speed - motor_specs.rated_speed_rpm) /
                                      synchronous_speed) * 100.0f;
     }
 
+    /* Current signature: sideband slip and fault levels from the last zoom capture */
+    dsp_mcsa_results_t signature;
+    motor_data->signature_valid = mcsa_valid && dsp_mcsa_get_results(&mcsa, &signature);
+    if (motor_data->signature_valid) {
+        motor_data->slip_source = (uint8_t)signature.slip_source;
+        if (signature.slip_source != DSP_MCSA_SLIP_NONE) {
+            motor_data->slip_percentage = signature.slip * 100.0f;
+            motor_data->rotor_frequency_hz = signature.rotor_hz;
+        }
+        if (signature.rotor_resolved) {
+            motor_data->rotor_bar_sideband_db = signature.rotor_lower_db;
+            motor_data->rotor_bar_grade = (uint8_t)signature.rotor_grade;
+            motor_data->rotor_fault_detected = (signature.rotor_grade >= DSP_MCSA_ROTOR_CRACKED);
+        }
+        if (signature.eccentricity_resolved) {
+            motor_data->eccentricity_sideband_db = fmaxf(signature.eccentricity_lower_db,
+                                                         signature.eccentricity_upper_db);
+            motor_data->eccentricity_detected = signature.eccentricity_alert;
+        }
+        motor_data->load_oscillation_hz = signature.oscillation_hz;
+        motor_data->load_oscillation_db = signature.oscillation_db;
+        motor_data->load_oscillation_detected = signature.oscillation_alert;
+    }
+
     /* Detect overload */
     motor_data->overload_detected = (motor_data->motor_load_percentage > 110.0f);
 
@@ -530,6 +706,8 @@ bool current_sensor_configure(const current_sensor_config_t *config) {
     }
 
     sensor_config = *config;
+    line_sync_valid = false;
+    mcsa_valid = false;
     return acs723_configure(sensor_config.sensitivity_mv_a, sensor_config.nominal_current_a);
 }
 
@@ -544,6 +722,8 @@ bool current_sensor_start_acquisition(void) {
     /* Reset buffer */
     buffer_index = 0;
     buffer_full = false;
+    line_sync_valid = false;
+    mcsa_valid = false;
 
     /* Update status */
     sensor_status.base_status.current_mode = ESOCORE_MODE_ACTIVE;
@@ -606,6 +786,13 @@ bool current_sensor_read_data(current_sensor_data_t *data, uint32_t timeout_ms)
     }
     data->harmonic_data = harmonic_data;
 
+    /* Line-synchronous results replace the simplified fundamental and THD estimates */
+    if (line_sync_results.locked) {
+        processed.fundamental_current_a = harmonic_data.harmonic_magnitudes[0];
+        processed.total_harmonic_distortion = harmonic_data.thd_f;
+        data->processed_data = processed;
+    }
+
     /* Analyze power quality */
     current_power_data_t power_data;
     current_sensor_analyze_power(&processed, &harmonic_data, &power_data);
@@ -640,6 +827,77 @@ bool current_sensor_read_data(current_sensor_data_t *data, uint32_t timeout_ms)
     return true;
 }
 
+/**
+ * @brief Read a synchronous three-phase capture and analyse it
+ */
+bool current_sensor_read_three_phase(current_three_phase_data_t *data, uint32_t timeout_ms) {
+    if (!sensor_initialized || !data || sensor_config.sensitivity_mv_a <= 0.0f) {
+        return false;
+    }
+
+    if (!acs723_read_scan(scan_buffer, CURRENT_SENSOR_MAX_SAMPLES)) {
+        return false;
+    }
+
+    /* Split the scan frames into amperes per phase (same conversion as the single-phase path) */
+    float offset[CURRENT_SENSOR_PHASES], scale[CURRENT_SENSOR_PHASES];
+    float *channels[CURRENT_SENSOR_PHASES];
+    for (uint8_t p = 0; p < CURRENT_SENSOR_PHASES; p++) {
+        offset[p] = calibration_data.offset_mv * 4096.0f / 3300.0f;
+        scale[p] = 3300.0f / 4096.0f / sensor_config.sensitivity_mv_a;
+        channels[p] = phase_buffers[p];
+    }
+    if (!dsp_three_phase_deinterleave(scan_buffer, CURRENT_SENSOR_PHASES, CURRENT_SENSOR_MAX_SAMPLES,
+                                      offset, scale, channels)) {
+        return false;
+    }
+
+    float line_hz = line_sync_results.locked ? line_sync_results.frequency_hz : CURRENT_SENSOR_LINE_FREQUENCY_HZ;
+    const float *currents[CURRENT_SENSOR_PHASES] = {phase_buffers[0], phase_buffers[1], phase_buffers[2]};
+    dsp_three_phase_results_t results;
+    if (!dsp_three_phase_analyze(currents, NULL, CURRENT_SENSOR_MAX_SAMPLES,
+                                 sensor_config.base_config.sample_rate_hz, line_hz, &results)) {
+        return false;
+    }
+
+    memset(data, 0, sizeof(current_three_phase_data_t));
+    for (uint8_t p = 0; p < CURRENT_SENSOR_PHASES; p++) {
+        data->phase_rms_a[p] = results.current.rms[p];
+        data->phase_fundamental_a[p] = results.current.fundamental[p];
+        data->phase_angle_deg[p] = results.current.angle_deg[p];
+    }
+    data->effective_current_a = results.current.effective;
+    data->residual_current_a = results.current.residual;
+    data->imbalance_percentage = results.current.imbalance_percent;
+    data->positive_sequence_a = results.current.positive;
+    data->negative_sequence_a = results.current.negative;
+    data->zero_sequence_a = results.current.zero;
+    data->unbalance_factor = results.current.unbalance_percent;
+    data->phase_sequence_abc = results.abc_rotation;
+    data->frequency_hz = line_hz;
+    data->sample_count = results.samples;
+    data->timestamp = 0; /* TODO: Get actual timestamp */
+
+    /* Nominal voltage at the assumed displacement power factor */
+    float reactive_factor = sqrtf(fmaxf(1.0f - power_factor * power_factor, 0.0f));
+    for (uint8_t p = 0; p < CURRENT_SENSOR_PHASES; p++) {
+        data->active_power_w[p] = voltage_reference * data->phase_fundamental_a[p] * power_factor;
+        data->reactive_power_var[p] = voltage_reference * data->phase_fundamental_a[p] * reactive_factor;
+        data->apparent_power_va[p] = voltage_reference * data->phase_rms_a[p];
+        data->power_factor[p] = (data->apparent_power_va[p] > 0.0f) ?
+                                data->active_power_w[p] / data->apparent_power_va[p] : 1.0f;
+        data->total_active_power_w += data->active_power_w[p];
+        data->total_reactive_power_var += data->reactive_power_var[p];
+        data->total_apparent_power_va += data->apparent_power_va[p];
+    }
+    data->total_power_factor = (data->total_apparent_power_va > 0.0f) ?
+                               data->total_active_power_w / data->total_apparent_power_va : 1.0f;
+
+    sensor_status.samples_acquired += CURRENT_SENSOR_MAX_SAMPLES * CURRENT_SENSOR_PHASES;
+    sensor_status.current_rms_a = data->effective_current_a;
+    return true;
+}
+
 /**
  * @brief Get current sensor status
  */
@@ -701,6 +959,16 @@ bool current_sensor_analyze_harmonics(const int16_t *current_samples, uint32_t s
         return false;
     }
 
+    /* Per-cycle analysis on line-synchronous samples once the PLL has locked */
+    if (update_line_sync(current_samples, sample_count, sampling_rate)) {
+        store_line_sync_harmonics(harmonic_data);
+        sensor_status.harmonic_analyses++;
+        return true;
+    }
+
+    /* Fixed-rate FFT until then */
+    memset(harmonic_data, 0, sizeof(current_harmonic_data_t));
+
     /* Prepare FFT input buffer */
     memset(fft_input_buffer, 0, sizeof(fft_input_buffer));
 
@@ -740,7 +1008,35 @@ bool current_sensor_analyze_harmonics(const int16_t *current_samples, uint32_t s
 
     /* Calculate THD and other parameters */
     calculate_thd(harmonic_magnitudes, fundamental_magnitude, harmonic_data);
+    sensor_status.harmonic_analyses++;
+
+    return true;
+}
 
+/**
+ * @brief Get the line frequency tracked by the harmonic analysis PLL
+ */
+bool current_sensor_get_line_frequency(float *frequency_hz) {
+    if (!sensor_initialized || !frequency_hz) {
+        return false;
+    }
+
+    *frequency_hz = line_sync_results.locked ? line_sync_results.frequency_hz : CURRENT_SENSOR_LINE_FREQUENCY_HZ;
+    return line_sync_results.locked;
+}
+
+/**
+ * @brief Set the known shaft speed used by the current signature analysis
+ */
+bool current_sensor_set_motor_speed(float speed_rpm) {
+    if (!sensor_initialized || speed_rpm < 0.0f) {
+        return false;
+    }
+
+    motor_speed_rpm = speed_rpm;
+    if (mcsa_valid) {
+        dsp_mcsa_set_speed(&mcsa, speed_rpm);
+    }
     return true;
 }
 
@@ -938,6 +1234,8 @@ bool current_sensor_set_sensitivity(float sensitivity_mv_a) {
 
     sensor_config.sensitivity_mv_a = sensitivity_mv_a;
     calibration_data.scale_factor = sensitivity_mv_a;
+    line_sync_valid = false;
+    mcsa_valid = false;
     return acs723_configure(sensor_config.sensitivity_mv_a, sensor_config.nominal_current_a);
 }
 
@@ -25,6 +25,8 @@
 #define CURRENT_SENSOR_FFT_SIZE            512
 #define CURRENT_SENSOR_SAMPLE_RATE_MAX     10000
 #define CURRENT_SENSOR_SAMPLE_RATE_MIN     100
+#define CURRENT_SENSOR_LINE_FREQUENCY_HZ   50.0f   /* Nominal line frequency tracked by the PLL */
+#define CURRENT_SENSOR_PHASES              3       /* Phase channels in a three-phase scan (A, B, C) */
 
 /* Current thresholds (Amperes) */
 #define CURRENT_THRESHOLD_LOW              0.1f
@@ -116,8 +118,47 @@ typedef struct {
     float slip_percentage;                   /**< Motor slip percentage */
     bool overload_detected;                  /**< Motor overload detected */
     bool underload_detected;                 /**< Motor underload detected */
+    bool signature_valid;                    /**< Current signature analysis available */
+    uint8_t slip_source;                     /**< Slip source (0=None, 1=Configured speed, 2=Spectrum, 3=Rated speed) */
+    float rotor_frequency_hz;                /**< Shaft rotational frequency (Hz) */
+    float rotor_bar_sideband_db;             /**< (1-2s)f sideband relative to the fundamental (dB) */
+    uint8_t rotor_bar_grade;                 /**< Rotor grade (0=Excellent .. 5=Multiple broken bars) */
+    float eccentricity_sideband_db;          /**< Stronger f+/-fr sideband relative to the fundamental (dB) */
+    float load_oscillation_hz;               /**< Strongest load oscillation frequency (Hz) */
+    float load_oscillation_db;               /**< Load oscillation sideband relative to the fundamental (dB) */
+    bool rotor_fault_detected;               /**< Cracked or broken rotor bars */
+    bool eccentricity_detected;              /**< Air-gap eccentricity */
+    bool load_oscillation_detected;          /**< Oscillating load torque */
 } current_motor_data_t;
 
+/**
+ * @brief Three-phase analysis
+ */
+typedef struct {
+    float phase_rms_a[CURRENT_SENSOR_PHASES];        /**< RMS current per phase (A) */
+    float phase_fundamental_a[CURRENT_SENSOR_PHASES];/**< Fundamental current per phase (A) */
+    float phase_angle_deg[CURRENT_SENSOR_PHASES];    /**< Fundamental angle relative to phase A (degrees) */
+    float effective_current_a;               /**< Effective current over the phases (A) */
+    float residual_current_a;                /**< RMS of the phase sum (A) */
+    float imbalance_percentage;              /**< Largest deviation from the mean phase RMS (%) */
+    float positive_sequence_a;               /**< Positive sequence current (A) */
+    float negative_sequence_a;               /**< Negative sequence current (A) */
+    float zero_sequence_a;                   /**< Zero sequence current (A) */
+    float unbalance_factor;                  /**< Negative / positive sequence (%) */
+    bool phase_sequence_abc;                 /**< Phase order A-B-C */
+    float active_power_w[CURRENT_SENSOR_PHASES];     /**< Active power per phase (W) */
+    float reactive_power_var[CURRENT_SENSOR_PHASES]; /**< Reactive power per phase (VAR) */
+    float apparent_power_va[CURRENT_SENSOR_PHASES];  /**< Apparent power per phase (VA) */
+    float power_factor[CURRENT_SENSOR_PHASES];       /**< Power factor per phase */
+    float total_active_power_w;              /**< Total active power (W) */
+    float total_reactive_power_var;          /**< Total reactive power (VAR) */
+    float total_apparent_power_va;           /**< Total apparent power (VA) */
+    float total_power_factor;                /**< Total power factor */
+    float frequency_hz;                      /**< Line frequency (Hz) */
+    uint32_t sample_count;                   /**< Samples per phase analysed */
+    uint32_t timestamp;                      /**< Data timestamp */
+} current_three_phase_data_t;
+
 /**
  * @brief Complete current sensor data
  */
@@ -181,6 +222,19 @@ bool current_sensor_stop_acquisition(void);
  */
 bool current_sensor_read_data(current_sensor_data_t *data, uint32_t timeout_ms);
 
+/**
+ * @brief Read a synchronous three-phase capture and analyse it
+ *
+ * The phases are converted in one ADC scan per sample instant. Voltages are
+ * not sampled, so the powers use the nominal voltage and the assumed
+ * displacement power factor.
+ *
+ * @param data Pointer to three-phase data to fill
+ * @param timeout_ms Acquisition timeout in milliseconds
+ * @return true if the capture was analysed, false otherwise
+ */
+bool current_sensor_read_three_phase(current_three_phase_data_t *data, uint32_t timeout_ms);
+
 /**
  * @brief Get current sensor status
  */
@@ -202,6 +256,22 @@ bool current_sensor_calibrate(void);
 bool current_sensor_analyze_harmonics(const int16_t *current_samples, uint32_t sample_count,
                                     uint32_t sampling_rate, current_harmonic_data_t *harmonic_data);
 
+/**
+ * @brief Get the line frequency tracked by the harmonic analysis PLL
+ *
+ * @param frequency_hz Pointer to store the tracked frequency
+ * @return true if the PLL is locked, false otherwise
+ */
+bool current_sensor_get_line_frequency(float *frequency_hz);
+
+/**
+ * @brief Set the known shaft speed used by the current signature analysis
+ *
+ * @param speed_rpm Shaft speed in rpm (0 = estimate slip from the current spectrum)
+ * @return true if the speed was set, false otherwise
+ */
+bool current_sensor_set_motor_speed(float speed_rpm);
+
 /**
  * @brief Analyze power quality
  */
@@ -28,6 +28,11 @@ static bool sensor_initialized = false;
 /* Measurement data buffers */
 static uint32_t measurement_count = 0;
 
+/* Tach output for vibration order tracking */
+static proximity_tach_callback_t tach_callback = NULL;
+static uint16_t tach_counts_per_pulse = 1;
+static volatile uint16_t tach_count_accumulator = 0;
+
 /* Sensor constants */
 #define INDUCTIVE_SENSING_DISTANCE_MM    12.0f       /* 12mm sensing distance */
 #define CAPACITIVE_SENSING_DISTANCE_MM   8.0f        /* 8mm sensing distance */
@@ -216,6 +221,22 @@ static bool quadrature_encoder_read(int32_t *position_counts, float *position_mm
     return true;
 }
 
+/**
+ * @brief Forward encoder edges to the tach consumer
+ */
+static void quadrature_encoder_emit_tach(uint32_t timestamp_us) {
+    proximity_tach_callback_t callback = tach_callback;
+    if (!callback) {
+        return;
+    }
+
+    /* Decimate encoder counts down to the configured pulse rate */
+    if (++tach_count_accumulator >= tach_counts_per_pulse) {
+        tach_count_accumulator = 0;
+        callback(timestamp_us);
+    }
+}
+
 /**
  * @brief Initialize magnetic sensors (reed switches)
  */
@@ -616,6 +637,32 @@ bool proximity_position_sensor_init(const proximity_position_sensor_config_t *co
     return true;
 }
 
+/**
+ * @brief Route quadrature encoder edges to a tachometer consumer
+ */
+bool proximity_position_sensor_set_tach_callback(proximity_tach_callback_t callback,
+                                                uint16_t counts_per_pulse) {
+    if (callback && counts_per_pulse == 0) {
+        return false;
+    }
+
+    /* Disable before changing the divider so the ISR never sees a mixed state */
+    tach_callback = NULL;
+    tach_counts_per_pulse = counts_per_pulse;
+    tach_count_accumulator = 0;
+    tach_callback = callback;
+
+    return true;
+}
+
+/**
+ * @brief Encoder timer input-capture handler
+ */
+void proximity_position_sensor_encoder_capture_isr(uint32_t timestamp_us) {
+    /* Position is counted by the timer in encoder mode; only edge timing is needed here */
+    quadrature_encoder_emit_tach(timestamp_us);
+}
+
 /**
  * @brief Deinitialize proximity position sensor
  */
@@ -28,8 +28,30 @@ typedef struct {
     uint32_t timestamp;
 } proximity_position_sensor_data_t;
 
+/**
+ * @brief Tach pulse callback, invoked from interrupt context with the capture time
+ */
+typedef void (*proximity_tach_callback_t)(uint32_t timestamp_us);
+
 bool proximity_position_sensor_init(const proximity_position_sensor_config_t *config);
 bool proximity_position_sensor_read_data(proximity_position_sensor_data_t *data, uint32_t timeout_ms);
 const esocore_sensor_capabilities_t *proximity_position_sensor_get_capabilities(void);
 
+/**
+ * @brief Route quadrature encoder edges to a tachometer consumer
+ *
+ * @param callback Callback receiving one timestamp per tach pulse, NULL to disable
+ * @param counts_per_pulse Encoder counts per emitted tach pulse
+ * @return true if callback configured successfully, false otherwise
+ */
+bool proximity_position_sensor_set_tach_callback(proximity_tach_callback_t callback,
+                                                uint16_t counts_per_pulse);
+
+/**
+ * @brief Encoder timer input-capture handler
+ *
+ * @param timestamp_us Capture timestamp of the encoder edge in microseconds
+ */
+void proximity_position_sensor_encoder_capture_isr(uint32_t timestamp_us);
+
 #endif /* PROXIMITY_POSITION_SENSOR_H */
@@ -0,0 +1,515 @@
+/**
+ * @file vibration_order_tracking.c
+ * @brief Tachometer-Driven Order Tracking Implementation
+ *
+ * This file contains the computed order tracking stage of the vibration
+ * sensor. Tach pulse times are interpolated with a three-pulse quadratic
+ * angle model, vibration samples are interpolated with a four-point cubic
+ * (Catmull-Rom) kernel, and each completed angle-domain record is windowed
+ * and transformed into an order spectrum.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#include "vibration_order_tracking.h"
+#include "../../common/dsp/dsp_fft.h"
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Private Data Structures
+ * ============================================================================ */
+
+static vibration_order_tracking_config_t tracking_config;
+static vibration_order_tracking_status_t tracking_status;
+static bool tracking_initialized = false;
+
+/* Tach pulse ring buffer (head written by the capture ISR, tail by processing) */
+static volatile uint32_t pulse_buffer[ORDER_TRACKING_MAX_TACH_PULSES];
+static volatile uint16_t pulse_head = 0;
+static uint16_t pulse_tail = 0;
+static volatile uint32_t pulses_dropped = 0;
+
+/* Resampling state */
+static float target_angle = 0.0f;           /* Next sample angle, in pulses relative to pulse_tail */
+static float angle_step = 0.0f;             /* Pulses per angle-domain sample */
+
+/* Raw sample delay line, addressed by a running sample index */
+static float delay_line[ORDER_TRACKING_DELAY_SAMPLES];
+static uint32_t samples_written = 0;        /* Index of the next sample to be written */
+static uint32_t delay_valid_from = 0;       /* Oldest index belonging to the continuous stream */
+static uint32_t expected_block_start_us = 0;
+
+/* Angle-domain record */
+static float angle_record[ORDER_TRACKING_MAX_SAMPLES];
+static uint16_t record_size = 0;
+static uint16_t record_fill = 0;
+static uint32_t record_start_us = 0;
+static float record_min_rpm = 0.0f;
+static float record_max_rpm = 0.0f;
+
+/* ============================================================================
+ * Tach Pulse Buffer
+ * ============================================================================ */
+
+/**
+ * @brief Number of pulses buffered and not yet consumed
+ */
+static uint16_t pulses_available(void) {
+    return (uint16_t)((pulse_head + ORDER_TRACKING_MAX_TACH_PULSES - pulse_tail) %
+                      ORDER_TRACKING_MAX_TACH_PULSES);
+}
+
+/**
+ * @brief Timestamp of the pulse at an offset from the tail
+ */
+static uint32_t pulse_at(uint16_t offset) {
+    return pulse_buffer[(pulse_tail + offset) % ORDER_TRACKING_MAX_TACH_PULSES];
+}
+
+/**
+ * @brief Release the oldest buffered pulse
+ */
+static void pulse_release(void) {
+    pulse_tail = (uint16_t)((pulse_tail + 1) % ORDER_TRACKING_MAX_TACH_PULSES);
+}
+
+/* ============================================================================
+ * Resampling Helpers
+ * ============================================================================ */
+
+/**
+ * @brief Access a raw sample by running index
+ */
+static float delay_sample(uint32_t index) {
+    return delay_line[index & (ORDER_TRACKING_DELAY_SAMPLES - 1)];
+}
+
+/**
+ * @brief Four-point Catmull-Rom interpolation at fractional position f
+ */
+static float interpolate_cubic(float p0, float p1, float p2, float p3, float f) {
+    return p1 + 0.5f * f * (p2 - p0 + f * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3 +
+                                          f * (3.0f * (p1 - p2) + p3 - p0)));
+}
+
+/**
+ * @brief Abandon the partial angle-domain record
+ */
+static void record_discard(void) {
+    if (record_fill > 0) {
+        tracking_status.records_discarded++;
+    }
+    record_fill = 0;
+}
+
+/**
+ * @brief Append one angle-domain sample to the current record
+ */
+static void record_append(float value, uint32_t timestamp_us, float speed_rpm) {
+    if (record_fill == 0) {
+        record_start_us = timestamp_us;
+        record_min_rpm = speed_rpm;
+        record_max_rpm = speed_rpm;
+    } else {
+        record_min_rpm = fminf(record_min_rpm, speed_rpm);
+        record_max_rpm = fmaxf(record_max_rpm, speed_rpm);
+    }
+
+    angle_record[record_fill++] = value;
+}
+
+/**
+ * @brief Window the completed record and compute its order spectrum
+ */
+static bool record_compute_spectrum(uint32_t end_timestamp_us, vibration_order_spectrum_t *spectrum) {
+    /* Hanning window generated by rotation to avoid a per-sample cosf() */
+    float step = (float)(2.0 * M_PI) / (float)(record_size - 1);
+    float cos_step = cosf(step);
+    float sin_step = sinf(step);
+    float c = 1.0f;
+    float s = 0.0f;
+
+    for (uint16_t i = 0; i < record_size; i++) {
+        angle_record[i] *= 0.5f * (1.0f - c);
+        float next_c = c * cos_step - s * sin_step;
+        s = s * cos_step + c * sin_step;
+        c = next_c;
+    }
+
+    if (!dsp_fft_magnitude(angle_record, spectrum->order_amplitudes, angle_record, record_size)) {
+        return false;
+    }
+
+    spectrum->num_bins = record_size / 2;
+    spectrum->order_resolution = 1.0f / (float)tracking_config.revolutions_per_spectrum;
+    spectrum->dominant_order = 0.0f;
+    spectrum->dominant_amplitude = 0.0f;
+
+    /* Compensate the Hanning coherent gain and locate the dominant order */
+    for (uint16_t i = 0; i < spectrum->num_bins; i++) {
+        spectrum->order_amplitudes[i] *= 2.0f;
+        if (i > 0 && spectrum->order_amplitudes[i] > spectrum->dominant_amplitude) {
+            spectrum->dominant_amplitude = spectrum->order_amplitudes[i];
+            spectrum->dominant_order = (float)i * spectrum->order_resolution;
+        }
+    }
+
+    float span_us = (float)(end_timestamp_us - record_start_us);
+    float revolutions = (float)(record_size - 1) / (float)tracking_config.samples_per_revolution;
+
+    spectrum->mean_speed_rpm = (span_us > 0.0f) ? revolutions * 60.0e6f / span_us : 0.0f;
+    spectrum->min_speed_rpm = record_min_rpm;
+    spectrum->max_speed_rpm = record_max_rpm;
+    spectrum->start_timestamp_us = record_start_us;
+    spectrum->end_timestamp_us = end_timestamp_us;
+
+    return true;
+}
+
+/**
+ * @brief Append a block to the raw sample delay line
+ */
+static void delay_line_write(const float *samples, uint16_t num_samples) {
+    for (uint16_t i = 0; i < num_samples; i++) {
+        delay_line[samples_written & (ORDER_TRACKING_DELAY_SAMPLES - 1)] = samples[i];
+        samples_written++;
+    }
+}
+
+/* ============================================================================
+ * Fault Order Helpers
+ * ============================================================================ */
+
+/**
+ * @brief Convert a shaft order to frequency at the record's mean speed
+ */
+static float order_to_hz(const vibration_order_spectrum_t *spectrum, float order) {
+    return order * spectrum->mean_speed_rpm / 60.0f;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+/**
+ * @brief Initialize order tracking
+ */
+bool vibration_order_tracking_init(const vibration_order_tracking_config_t *config) {
+    if (!config || config->pulses_per_revolution == 0 || config->revolutions_per_spectrum == 0) {
+        return false;
+    }
+
+    uint32_t size = (uint32_t)config->samples_per_revolution * config->revolutions_per_spectrum;
+    if (!dsp_fft_is_valid_size(size) || size > ORDER_TRACKING_MAX_SAMPLES) {
+        return false;
+    }
+
+    if (config->max_speed_rpm <= config->min_speed_rpm || config->measurement_axis >= VIBRATION_SENSOR_AXES) {
+        return false;
+    }
+
+    tracking_config = *config;
+    record_size = (uint16_t)size;
+    angle_step = (float)config->pulses_per_revolution / (float)config->samples_per_revolution;
+
+    dsp_fft_init();
+
+    tracking_initialized = true;
+    return vibration_order_tracking_reset();
+}
+
+/**
+ * @brief Reset tracking state
+ */
+bool vibration_order_tracking_reset(void) {
+    if (!tracking_initialized) {
+        return false;
+    }
+
+    pulse_tail = pulse_head;
+    pulses_dropped = 0;
+    target_angle = 0.0f;
+    delay_valid_from = samples_written;
+    record_fill = 0;
+
+    memset(&tracking_status, 0, sizeof(tracking_status));
+
+    return true;
+}
+
+/**
+ * @brief Record a tach pulse
+ */
+void vibration_order_tracking_add_tach_pulse(uint32_t timestamp_us) {
+    if (!tracking_initialized) {
+        return;
+    }
+
+    uint16_t next_head = (uint16_t)((pulse_head + 1) % ORDER_TRACKING_MAX_TACH_PULSES);
+    if (next_head == pulse_tail) {
+        pulses_dropped++;
+        return;
+    }
+
+    pulse_buffer[pulse_head] = timestamp_us;
+    pulse_head = next_head;
+}
+
+/**
+ * @brief Resample a vibration block to the angle domain
+ */
+bool vibration_order_tracking_process(const float *samples, uint16_t num_samples,
+                                      uint32_t first_sample_us, float sample_period_us,
+                                      vibration_order_spectrum_t *spectrum, bool *spectrum_ready) {
+    if (!tracking_initialized || !samples || !spectrum || !spectrum_ready ||
+        num_samples == 0 || sample_period_us <= 0.0f) {
+        return false;
+    }
+
+    *spectrum_ready = false;
+
+    /* A gap in the sample stream invalidates everything held in the delay line */
+    if (samples_written != delay_valid_from) {
+        float gap_us = (float)(int32_t)(first_sample_us - expected_block_start_us);
+        if (fabsf(gap_us) > 0.5f * sample_period_us) {
+            delay_valid_from = samples_written;
+            record_discard();
+        }
+    }
+
+    uint32_t block_start_index = samples_written;
+    delay_line_write(samples, num_samples);
+
+    if (samples_written - delay_valid_from > ORDER_TRACKING_DELAY_SAMPLES) {
+        delay_valid_from = samples_written - ORDER_TRACKING_DELAY_SAMPLES;
+    }
+
+    /* Interpolation needs one sample before and two after the target position */
+    float min_position = (float)(int32_t)(delay_valid_from + 1U - block_start_index);
+    float max_position = (float)num_samples - 2.0f;
+    float min_interval_us = 60.0e6f / (tracking_config.max_speed_rpm *
+                                       (float)tracking_config.pulses_per_revolution);
+    float max_interval_us = 60.0e6f / (tracking_config.min_speed_rpm *
+                                       (float)tracking_config.pulses_per_revolution);
+
+    while (true) {
+        uint16_t k = (uint16_t)target_angle;
+        if ((uint16_t)(k + 1) >= pulses_available()) {
+            break; /* Wait for the next tach pulse */
+        }
+
+        /* Pulse times relative to the first sample of this block */
+        float t_k = (float)(int32_t)(pulse_at(k) - first_sample_us);
+        float t_next = (float)(int32_t)(pulse_at((uint16_t)(k + 1)) - first_sample_us);
+        float interval_us = t_next - t_k;
+
+        /* Speed outside limits: abandon the record and skip the interval */
+        if (interval_us < min_interval_us || interval_us > max_interval_us) {
+            tracking_status.tracking_locked = false;
+            record_discard();
+            target_angle = (float)(k + 1);
+        } else {
+            float speed_rpm = 60.0e6f / (interval_us * (float)tracking_config.pulses_per_revolution);
+            float x = target_angle - (float)k;
+            float t;
+
+            tracking_status.tracking_locked = true;
+            tracking_status.current_speed_rpm = speed_rpm;
+
+            /* Quadratic angle model through three pulses when the previous one is kept */
+            if (k >= 1) {
+                float t_prev = (float)(int32_t)(pulse_at((uint16_t)(k - 1)) - first_sample_us);
+                t = t_k + 0.5f * x * (t_next - t_prev) + 0.5f * x * x * (t_prev - 2.0f * t_k + t_next);
+            } else {
+                t = t_k + x * interval_us;
+            }
+
+            /* Sample position relative to the start of this block */
+            float position = t / sample_period_us;
+            if (position >= max_position) {
+                break; /* Needs samples from the next block */
+            }
+
+            if (position < min_position) {
+                /* Angle lies before the retained data; restart the record */
+                record_discard();
+            } else {
+                int32_t i = (int32_t)floorf(position);
+                float f = position - (float)i;
+                uint32_t index = block_start_index + (uint32_t)i;
+                float value = interpolate_cubic(delay_sample(index - 1U), delay_sample(index),
+                                                delay_sample(index + 1U), delay_sample(index + 2U), f);
+                uint32_t timestamp_us = first_sample_us + (uint32_t)(int32_t)t;
+
+                record_append(value, timestamp_us, speed_rpm);
+
+                if (record_fill >= record_size) {
+                    if (!record_compute_spectrum(timestamp_us, spectrum)) {
+                        record_fill = 0;
+                        return false;
+                    }
+                    *spectrum_ready = true;
+                    tracking_status.spectra_completed++;
+                    record_fill = 0;
+                }
+            }
+
+            target_angle += angle_step;
+        }
+
+        /* Keep one pulse behind the target for the quadratic model */
+        while (target_angle >= 2.0f) {
+            pulse_release();
+            target_angle -= 1.0f;
+        }
+    }
+
+    expected_block_start_us = first_sample_us + (uint32_t)((float)num_samples * sample_period_us + 0.5f);
+
+    return true;
+}
+
+/**
+ * @brief Get amplitude at an arbitrary order
+ */
+float vibration_order_tracking_get_amplitude(const vibration_order_spectrum_t *spectrum, float order) {
+    if (!spectrum || spectrum->order_resolution <= 0.0f || order < 0.0f) {
+        return 0.0f;
+    }
+
+    int32_t centre = (int32_t)(order / spectrum->order_resolution + 0.5f);
+    float amplitude = 0.0f;
+
+    for (int32_t i = centre - 1; i <= centre + 1; i++) {
+        if (i >= 0 && i < (int32_t)spectrum->num_bins) {
+            amplitude = fmaxf(amplitude, spectrum->order_amplitudes[i]);
+        }
+    }
+
+    return amplitude;
+}
+
+/**
+ * @brief Analyze bearing condition from an order spectrum
+ */
+bool vibration_order_tracking_analyze_bearing(const vibration_order_spectrum_t *spectrum,
+                                              uint8_t balls, float pitch_diameter_mm,
+                                              float ball_diameter_mm, float contact_angle_deg,
+                                              vibration_bearing_analysis_t *bearing_analysis) {
+    if (!spectrum || !bearing_analysis || balls == 0 ||
+        pitch_diameter_mm <= 0.0f || ball_diameter_mm <= 0.0f) {
+        return false;
+    }
+
+    /* Defect frequencies per shaft revolution (orders) */
+    float ratio = (ball_diameter_mm / pitch_diameter_mm) * cosf(contact_angle_deg * (float)M_PI / 180.0f);
+    float bpfo = (float)balls * 0.5f * (1.0f - ratio);
+    float bpfi = (float)balls * 0.5f * (1.0f + ratio);
+    float ftf = 0.5f * (1.0f - ratio);
+    float bsf = (pitch_diameter_mm / (2.0f * ball_diameter_mm)) * (1.0f - ratio * ratio);
+
+    bearing_analysis->bpfo_amplitude = vibration_order_tracking_get_amplitude(spectrum, bpfo);
+    bearing_analysis->bpf_i_amplitude = vibration_order_tracking_get_amplitude(spectrum, bpfi);
+    bearing_analysis->ftf_amplitude = vibration_order_tracking_get_amplitude(spectrum, ftf);
+    bearing_analysis->bsf_amplitude = vibration_order_tracking_get_amplitude(spectrum, bsf);
+
+    float max_fault_amplitude = fmaxf(fmaxf(bearing_analysis->bpfo_amplitude, bearing_analysis->bpf_i_amplitude),
+                                      fmaxf(bearing_analysis->ftf_amplitude, bearing_analysis->bsf_amplitude));
+
+    /* Same detection threshold as the fixed-speed analysis */
+    if (max_fault_amplitude > 1.0f) {
+        float fault_order;
+
+        bearing_analysis->bearing_fault_detected = true;
+
+        if (bearing_analysis->bpfo_amplitude == max_fault_amplitude) {
+            bearing_analysis->fault_type = 0; /* Outer race */
+            fault_order = bpfo;
+        } else if (bearing_analysis->bpf_i_amplitude == max_fault_amplitude) {
+            bearing_analysis->fault_type = 1; /* Inner race */
+            fault_order = bpfi;
+        } else if (bearing_analysis->bsf_amplitude == max_fault_amplitude) {
+            bearing_analysis->fault_type = 2; /* Balls */
+            fault_order = bsf;
+        } else {
+            bearing_analysis->fault_type = 3; /* Cage */
+            fault_order = ftf;
+        }
+
+        bearing_analysis->fault_frequency_hz = (uint16_t)order_to_hz(spectrum, fault_order);
+        bearing_analysis->fault_severity = fminf(max_fault_amplitude / 5.0f, 1.0f);
+    } else {
+        bearing_analysis->bearing_fault_detected = false;
+        bearing_analysis->fault_severity = 0.0f;
+        bearing_analysis->fault_type = 0;
+        bearing_analysis->fault_frequency_hz = 0;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Analyze gear condition from an order spectrum
+ */
+bool vibration_order_tracking_analyze_gear(const vibration_order_spectrum_t *spectrum,
+                                           uint8_t num_teeth,
+                                           vibration_gear_analysis_t *gear_analysis) {
+    if (!spectrum || !gear_analysis || num_teeth == 0) {
+        return false;
+    }
+
+    /* Gear mesh sits at order num_teeth with sidebands one order either side */
+    float mesh_order = (float)num_teeth;
+    float carrier_amplitude = vibration_order_tracking_get_amplitude(spectrum, mesh_order);
+    float sideband_amplitude = fmaxf(vibration_order_tracking_get_amplitude(spectrum, mesh_order - 1.0f),
+                                     vibration_order_tracking_get_amplitude(spectrum, mesh_order + 1.0f));
+
+    gear_analysis->gear_mesh_frequency = order_to_hz(spectrum, mesh_order);
+    gear_analysis->sideband_amplitude = sideband_amplitude;
+    gear_analysis->modulation_index = (carrier_amplitude > 0.0f) ?
+                                      sideband_amplitude / carrier_amplitude : 0.0f;
+
+    if (carrier_amplitude > 0.0f && sideband_amplitude > carrier_amplitude * 0.1f) {
+        gear_analysis->gear_fault_detected = true;
+        gear_analysis->gear_wear_level = fminf(gear_analysis->modulation_index * 2.0f, 1.0f);
+    } else {
+        gear_analysis->gear_fault_detected = false;
+        gear_analysis->gear_wear_level = 0.0f;
+    }
+
+    gear_analysis->missing_teeth = (gear_analysis->modulation_index > 0.5f) ?
+                                   (uint8_t)(gear_analysis->modulation_index * 3.0f) : 0;
+
+    return true;
+}
+
+/**
+ * @brief Get the order tracking configuration
+ */
+bool vibration_order_tracking_get_config(vibration_order_tracking_config_t *config) {
+    if (!tracking_initialized || !config) {
+        return false;
+    }
+
+    *config = tracking_config;
+    return true;
+}
+
+/**
+ * @brief Get order tracking status
+ */
+bool vibration_order_tracking_get_status(vibration_order_tracking_status_t *status) {
+    if (!tracking_initialized || !status) {
+        return false;
+    }
+
+    tracking_status.pending_pulses = pulses_available();
+    tracking_status.record_fill = record_fill;
+    tracking_status.pulses_dropped = pulses_dropped;
+
+    *status = tracking_status;
+    return true;
+}
@@ -0,0 +1,192 @@
+/**
+ * @file vibration_order_tracking.h
+ * @brief Tachometer-Driven Order Tracking for Vibration Analysis
+ *
+ * This header defines the computed order tracking stage of the vibration
+ * sensor. Vibration blocks sampled at a constant rate are resampled to
+ * constant shaft-angle increments using tachometer or encoder pulse
+ * timestamps, and the angle-domain signal is transformed into an order
+ * spectrum. Shaft-synchronous components (imbalance, bearing defect orders,
+ * gear mesh) then stay on fixed bins while a variable-speed drive ramps.
+ *
+ * Tach pulses and vibration samples must share the same microsecond
+ * timebase (normally the free-running capture timer). Raw samples are held
+ * in a delay line until the pulse after them arrives, so the delay line must
+ * cover one pulse interval at the lowest tracked speed:
+ * sample_rate * 60 / (min_speed_rpm * pulses_per_revolution) samples.
+ *
+ * @author EsoCore Development Team
+ * @copyright Copyright © 2025 Newmatik. All rights reserved.
+ * @license Apache License, Version 2.0
+ */
+
+#ifndef VIBRATION_ORDER_TRACKING_H
+#define VIBRATION_ORDER_TRACKING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "vibration_sensor.h"
+
+/* ============================================================================
+ * Order Tracking Configuration
+ * ============================================================================ */
+
+#define ORDER_TRACKING_MAX_TACH_PULSES     128   /* Tach pulse ring buffer depth */
+#define ORDER_TRACKING_MAX_SAMPLES         1024  /* Angle-domain samples per spectrum */
+#define ORDER_TRACKING_MAX_BINS            (ORDER_TRACKING_MAX_SAMPLES / 2)
+#define ORDER_TRACKING_DELAY_SAMPLES       2048  /* Raw samples held until bracketed by pulses (power of 2) */
+
+/* ============================================================================
+ * Order Tracking Data Types
+ * ============================================================================ */
+
+/**
+ * @brief Order tracking configuration
+ */
+typedef struct {
+    uint16_t pulses_per_revolution;         /**< Tach/encoder pulses per shaft revolution */
+    uint16_t samples_per_revolution;        /**< Angle-domain samples per revolution (power of 2) */
+    uint16_t revolutions_per_spectrum;      /**< Revolutions per order spectrum (power of 2) */
+    float min_speed_rpm;                    /**< Below this speed tracking is suspended */
+    float max_speed_rpm;                    /**< Above this speed pulses are treated as glitches */
+    uint8_t measurement_axis;               /**< Axis resampled by the vibration driver (0=X, 1=Y, 2=Z) */
+    uint8_t bearing_balls;                  /**< Rolling elements of the tracked bearing (0 = no bearing analysis) */
+    float bearing_pitch_diameter_mm;        /**< Bearing pitch diameter in mm */
+    float bearing_ball_diameter_mm;         /**< Rolling element diameter in mm */
+    float bearing_contact_angle_deg;        /**< Bearing contact angle in degrees */
+    uint8_t gear_teeth;                     /**< Teeth of the gear on the tracked shaft (0 = no gear analysis) */
+} vibration_order_tracking_config_t;
+
+/**
+ * @brief Order spectrum produced from one angle-domain record
+ */
+typedef struct {
+    float order_amplitudes[ORDER_TRACKING_MAX_BINS]; /**< Amplitude per order bin */
+    uint16_t num_bins;                      /**< Number of valid bins */
+    float order_resolution;                 /**< Orders per bin (1 / revolutions) */
+    float dominant_order;                   /**< Order with the largest amplitude */
+    float dominant_amplitude;               /**< Amplitude at the dominant order */
+    float mean_speed_rpm;                   /**< Mean shaft speed over the record */
+    float min_speed_rpm;                    /**< Minimum shaft speed over the record */
+    float max_speed_rpm;                    /**< Maximum shaft speed over the record */
+    uint32_t start_timestamp_us;            /**< Time of the first angle-domain sample */
+    uint32_t end_timestamp_us;              /**< Time of the last angle-domain sample */
+} vibration_order_spectrum_t;
+
+/**
+ * @brief Order tracking status
+ */
+typedef struct {
+    bool tracking_locked;                   /**< Shaft speed within configured limits */
+    float current_speed_rpm;                /**< Speed from the latest pulse interval */
+    uint16_t pending_pulses;                /**< Pulses buffered and not yet consumed */
+    uint16_t record_fill;                   /**< Angle-domain samples in the current record */
+    uint32_t spectra_completed;             /**< Order spectra produced */
+    uint32_t pulses_dropped;                /**< Pulses lost to buffer overflow or glitches */
+    uint32_t records_discarded;             /**< Records abandoned due to speed loss */
+} vibration_order_tracking_status_t;
+
+/* ============================================================================
+ * Function Prototypes
+ * ============================================================================ */
+
+/**
+ * @brief Initialize order tracking
+ *
+ * @param config Pointer to order tracking configuration
+ * @return true if initialization successful, false otherwise
+ */
+bool vibration_order_tracking_init(const vibration_order_tracking_config_t *config);
+
+/**
+ * @brief Reset tracking state, dropping buffered pulses and the partial record
+ *
+ * @return true if reset successful, false otherwise
+ */
+bool vibration_order_tracking_reset(void);
+
+/**
+ * @brief Record a tach pulse
+ *
+ * Safe to call from the timer capture interrupt; the signature matches
+ * proximity_tach_callback_t so the encoder driver can feed it directly.
+ *
+ * @param timestamp_us Pulse capture time in microseconds
+ */
+void vibration_order_tracking_add_tach_pulse(uint32_t timestamp_us);
+
+/**
+ * @brief Resample a vibration block to the angle domain
+ *
+ * Samples whose angle is not yet bracketed by tach pulses are carried over to
+ * the next call, so blocks may be passed as soon as they are acquired.
+ *
+ * @param samples Acceleration samples at a constant rate
+ * @param num_samples Number of samples in the block
+ * @param first_sample_us Timestamp of samples[0] in microseconds
+ * @param sample_period_us Sample period in microseconds
+ * @param spectrum Pointer to spectrum structure filled when a record completes
+ * @param spectrum_ready Set to true if spectrum was filled by this call
+ * @return true if processing successful, false otherwise
+ */
+bool vibration_order_tracking_process(const float *samples, uint16_t num_samples,
+                                      uint32_t first_sample_us, float sample_period_us,
+                                      vibration_order_spectrum_t *spectrum, bool *spectrum_ready);
+
+/**
+ * @brief Get amplitude at an arbitrary order
+ *
+ * @param spectrum Pointer to order spectrum
+ * @param order Shaft order to evaluate
+ * @return Largest amplitude within one bin of the requested order
+ */
+float vibration_order_tracking_get_amplitude(const vibration_order_spectrum_t *spectrum, float order);
+
+/**
+ * @brief Analyze bearing condition from an order spectrum
+ *
+ * Bearing defect orders depend only on geometry, so the analysis is valid at
+ * any shaft speed covered by the record.
+ *
+ * @param spectrum Pointer to order spectrum
+ * @param balls Number of rolling elements
+ * @param pitch_diameter_mm Bearing pitch diameter in mm
+ * @param ball_diameter_mm Rolling element diameter in mm
+ * @param contact_angle_deg Contact angle in degrees
+ * @param bearing_analysis Pointer to analysis result structure
+ * @return true if analysis successful, false otherwise
+ */
+bool vibration_order_tracking_analyze_bearing(const vibration_order_spectrum_t *spectrum,
+                                              uint8_t balls, float pitch_diameter_mm,
+                                              float ball_diameter_mm, float contact_angle_deg,
+                                              vibration_bearing_analysis_t *bearing_analysis);
+
+/**
+ * @brief Analyze gear condition from an order spectrum
+ *
+ * @param spectrum Pointer to order spectrum
+ * @param num_teeth Number of teeth on the gear mounted on the tracked shaft
+ * @param gear_analysis Pointer to analysis result structure
+ * @return true if analysis successful, false otherwise
+ */
+bool vibration_order_tracking_analyze_gear(const vibration_order_spectrum_t *spectrum,
+                                           uint8_t num_teeth,
+                                           vibration_gear_analysis_t *gear_analysis);
+
+/**
+ * @brief Get the order tracking configuration
+ *
+ * @param config Pointer to configuration structure to fill
+ * @return true if order tracking is initialized, false otherwise
+ */
+bool vibration_order_tracking_get_config(vibration_order_tracking_config_t *config);
+
+/**
+ * @brief Get order tracking status
+ *
+ * @param status Pointer to status structure to fill
+ * @return true if status retrieved successfully, false otherwise
+ */
+bool vibration_order_tracking_get_status(vibration_order_tracking_status_t *status);
+
+#endif /* VIBRATION_ORDER_TRACKING_H */
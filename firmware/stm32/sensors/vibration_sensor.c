@@ -11,6 +11,10 @@
  */
 
 #include "vibration_sensor.h"
+#include "vibration_order_tracking.h"
+#include "../../common/dsp/dsp_fft.h"
+#include "../../common/dsp/dsp_features.h"
+#include "../../common/dsp/dsp_integrate.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -24,15 +28,69 @@ static vibration_sensor_config_t sensor_config;
 static vibration_sensor_status_t sensor_status;
 static bool sensor_initialized = false;
 
-/* Data buffers */
-static vibration_raw_data_t raw_data_buffer[VIBRATION_SENSOR_MAX_SAMPLES];
-static uint32_t buffer_index = 0;
-static bool buffer_full = false;
+/* DMA ping-pong buffer: interleaved x, y, z frames as the FIFO delivers them, one block per half */
+static vibration_sample_t dma_buffer[2][VIBRATION_SENSOR_BLOCK_SIZE * VIBRATION_SENSOR_AXES];
+static volatile bool dma_half_ready[2] = {false, false};
+static volatile uint32_t dma_half_timestamp[2] = {0, 0};
+static volatile uint8_t dma_filling_half = 0;       /* Half the DMA is writing */
+static volatile uint32_t dma_overruns = 0;          /* Blocks overwritten before processing */
+static uint8_t next_block_half = 0;                 /* Half holding the next block to process */
+static uint32_t simulation_frame = 0;               /* Placeholder signal phase */
+static uint32_t simulation_time_us = 0;             /* Placeholder microsecond timer */
+
+/* Latest raw block, one contiguous array per axis */
+static vibration_block_t raw_block;
+
+/* Millisecond clock extended from the block timestamps, wrapping at 2^32 ms */
+static bool block_clock_started = false;
+static uint32_t block_clock_last_us = 0;            /* Timestamp the clock last advanced to */
+static uint32_t block_clock_ms = 0;
+static uint32_t block_clock_remainder_us = 0;       /* Microseconds not yet counted in block_clock_ms */
+
+/* Event-triggered capture fed with every raw block */
+static sensor_capture_t *attached_capture = NULL;
+
+/* Adaptive rate controller fed with the axis activity of every block */
+static sensor_rate_controller_t *attached_rate_controller = NULL;
+
+/* Order-domain results of the latest record while the tach is locked */
+static vibration_order_spectrum_t order_spectrum;
+static vibration_bearing_analysis_t order_bearing_analysis;
+static vibration_gear_analysis_t order_gear_analysis;
+static bool order_bearing_valid = false;
+static bool order_gear_valid = false;
+
+/* Converted and filtered axis blocks */
+static float axis_blocks[VIBRATION_SENSOR_AXES][VIBRATION_SENSOR_BLOCK_SIZE];
+
+/* Analysis captures: one fills while the other stays published */
+static float capture_buffers[2][VIBRATION_SENSOR_BLOCK_SIZE];
+static uint8_t capture_index = 0;                   /* Buffer being filled */
+static uint16_t capture_fill = 0;                   /* Samples in the buffer being filled */
+static uint8_t capture_axis = 0;                    /* Axis feeding the buffer being filled */
+static bool capture_valid = false;                  /* A complete capture has been published */
+
+/* Sequence number of the last capture published to the feature store */
+static uint32_t capture_sequence = 0;
+
+/* Transform of the latest capture, reused by every block until the next one */
+static vibration_fft_data_t capture_fft;
+static uint32_t capture_fft_sequence = 0;           /* Capture the transform belongs to */
+static bool capture_fft_valid = false;
 
 /* FFT working buffers */
 static float fft_input_buffer[VIBRATION_SENSOR_FFT_SIZE];
 static float fft_output_buffer[VIBRATION_SENSOR_FFT_SIZE];
 
+/* Per-axis filters, designed at configuration time */
+static dsp_biquad_cascade_t axis_filters[VIBRATION_SENSOR_AXES];
+static dsp_fir_decimator_t axis_decimators[VIBRATION_SENSOR_AXES];
+static bool decimation_enabled = false;
+
+/* Streaming velocity/displacement integrators, one per axis */
+static dsp_integrator_t axis_integrators[VIBRATION_SENSOR_AXES];
+static bool integrators_valid = false;
+
 /* Window functions for FFT */
 static float hanning_window[VIBRATION_SENSOR_FFT_SIZE];
 static float hamming_window[VIBRATION_SENSOR_FFT_SIZE];
@@ -69,23 +127,75 @@ static bool accelerometer_hw_init(uint8_t accelerometer_type) {
 }
 
 /**
- * @brief Read accelerometer data
+ * @brief Start streaming accelerometer frames into the ping-pong buffer
+ */
+static bool accelerometer_hw_start_stream(vibration_sample_t *buffer, uint32_t num_frames) {
+    /* TODO: Implement hardware-specific streaming */
+    /* This would typically involve:
+     * - Setting the FIFO watermark and enabling its interrupt
+     * - Draining the FIFO by SPI/I2C DMA on each watermark interrupt
+     * - Running the DMA in circular mode over num_frames frames of x, y, z
+     *   (VIBRATION_SENSOR_SAMPLE_BITS wide) with half- and full-transfer
+     *   interrupts that
+     *   call vibration_sensor_dma_half_complete_isr() and
+     *   vibration_sensor_dma_complete_isr()
+     */
+    (void)buffer;
+    (void)num_frames;
+    return true;
+}
+
+/**
+ * @brief Stop streaming accelerometer frames
+ */
+static void accelerometer_hw_stop_stream(void) {
+    /* TODO: Implement hardware-specific stream stop */
+    /* This would typically involve:
+     * - Disabling the FIFO watermark interrupt
+     * - Aborting the DMA transfer
+     * - Flushing the FIFO
+     */
+}
+
+/**
+ * @brief Wait for the DMA to complete a block
  */
-static bool accelerometer_hw_read_data(vibration_raw_data_t *data) {
-    /* TODO: Implement hardware-specific data reading */
+static bool accelerometer_hw_wait_block(uint32_t timeout_ms) {
+    /* TODO: Implement hardware-specific wait */
     /* This would typically involve:
-     * - Reading X, Y, Z axis data from registers
-     * - Reading temperature data
-     * - Applying any hardware-specific corrections
+     * - Sleeping (WFI or an RTOS event) until a DMA transfer interrupt
+     * - Giving up after timeout_ms
      */
 
-    /* Placeholder data for simulation */
-    data->x_axis_raw = (int32_t)(sinf((float)buffer_index * 0.1f) * 1000);
-    data->y_axis_raw = (int32_t)(cosf((float)buffer_index * 0.1f) * 1000);
-    data->z_axis_raw = 16384; /* 1g in 14-bit, 4g range */
-    data->timestamp = 0; /* TODO: Get actual timestamp */
-    data->temperature_celsius = 25;
+    /* Placeholder: fill the half the DMA is writing and raise its interrupt */
+    uint8_t half = dma_filling_half;
+    vibration_sample_t *frame = dma_buffer[half];
+    for (uint32_t n = 0; n < VIBRATION_SENSOR_BLOCK_SIZE; n++, frame += VIBRATION_SENSOR_AXES) {
+        float phase = (float)simulation_frame++ * 0.1f;
+        frame[0] = (vibration_sample_t)(sinf(phase) * 1000);
+        frame[1] = (vibration_sample_t)(cosf(phase) * 1000);
+        frame[2] = 16384; /* 1g in 14-bit, 4g range */
+    }
+
+    /* Stamp the last frame, one block period after the previous one */
+    uint32_t rate = sensor_config.base_config.sample_rate_hz;
+    if (rate > 0) {
+        simulation_time_us += (uint32_t)(((uint64_t)VIBRATION_SENSOR_BLOCK_SIZE * 1000000U) / rate);
+    }
+    if (half == 0) {
+        vibration_sensor_dma_half_complete_isr(simulation_time_us);
+    } else {
+        vibration_sensor_dma_complete_isr(simulation_time_us);
+    }
+    return true;
+}
 
+/**
+ * @brief Read accelerometer temperature
+ */
+static bool accelerometer_hw_read_temperature(int16_t *temperature_celsius) {
+    /* TODO: Implement hardware-specific temperature reading */
+    *temperature_celsius = 25;
     return true;
 }
 
@@ -179,26 +289,15 @@ static void fft_apply_window(float *data, uint16_t size, uint8_t window_type) {
 }
 
 /**
- * @brief Simplified FFT implementation (Radix-2 Cooley-Tukey)
+ * @brief FFT amplitude spectrum (radix-2 real FFT)
  */
 static bool fft_calculate(float *input, float *output, uint16_t size) {
     if (size != VIBRATION_SENSOR_FFT_SIZE) {
         return false;
     }
 
-    /* TODO: Implement full FFT algorithm */
-    /* This is a placeholder - real implementation would use:
-     * - Bit-reversal permutation
-     * - Radix-2 butterfly operations
-     * - Complex arithmetic
-     */
-
-    /* Placeholder: Copy input to output with some processing */
-    for (uint16_t i = 0; i < size / 2; i++) {
-        output[i] = fabsf(input[i * 2]) + fabsf(input[i * 2 + 1]);
-    }
-
-    return true;
+    /* Output holds size floats, enough to serve as the transform scratch */
+    return dsp_fft_magnitude(input, output, output, size);
 }
 
 /**
@@ -284,25 +383,20 @@ static void bearing_calculate_fault_frequencies(float shaft_speed_rpm,
 /**
  * @brief Analyze bearing condition
  */
-static void bearing_analyze_condition(const vibration_fft_data_t *fft_data,
+static void bearing_analyze_condition(const float *spectrum, uint16_t num_bins, float bin_width_hz,
                                     vibration_bearing_analysis_t *analysis,
-                                    float bpfo, float bpfi, float ftf, float bsf,
-                                    uint32_t sampling_rate) {
-    /* Convert fault frequencies to FFT bin indices */
-    uint16_t bpfo_bin = (uint16_t)(bpfo * (float)VIBRATION_SENSOR_FFT_SIZE / (float)sampling_rate);
-    uint16_t bpfi_bin = (uint16_t)(bpfi * (float)VIBRATION_SENSOR_FFT_SIZE / (float)sampling_rate);
-    uint16_t ftf_bin = (uint16_t)(ftf * (float)VIBRATION_SENSOR_FFT_SIZE / (float)sampling_rate);
-    uint16_t bsf_bin = (uint16_t)(bsf * (float)VIBRATION_SENSOR_FFT_SIZE / (float)sampling_rate);
+                                    float bpfo, float bpfi, float ftf, float bsf) {
+    /* Convert fault frequencies to spectrum bin indices */
+    uint16_t bpfo_bin = (uint16_t)(bpfo / bin_width_hz);
+    uint16_t bpfi_bin = (uint16_t)(bpfi / bin_width_hz);
+    uint16_t ftf_bin = (uint16_t)(ftf / bin_width_hz);
+    uint16_t bsf_bin = (uint16_t)(bsf / bin_width_hz);
 
     /* Extract amplitudes at fault frequencies */
-    analysis->bpfo_amplitude = (bpfo_bin < VIBRATION_SENSOR_FFT_SIZE / 2) ?
-                              fft_data->frequency_bins[bpfo_bin] : 0.0f;
-    analysis->bpfi_amplitude = (bpfi_bin < VIBRATION_SENSOR_FFT_SIZE / 2) ?
-                              fft_data->frequency_bins[bpfi_bin] : 0.0f;
-    analysis->ftf_amplitude = (ftf_bin < VIBRATION_SENSOR_FFT_SIZE / 2) ?
-                             fft_data->frequency_bins[ftf_bin] : 0.0f;
-    analysis->bsf_amplitude = (bsf_bin < VIBRATION_SENSOR_FFT_SIZE / 2) ?
-                             fft_data->frequency_bins[bsf_bin] : 0.0f;
+    analysis->bpfo_amplitude = (bpfo_bin < num_bins) ? spectrum[bpfo_bin] : 0.0f;
+    analysis->bpfi_amplitude = (bpfi_bin < num_bins) ? spectrum[bpfi_bin] : 0.0f;
+    analysis->ftf_amplitude = (ftf_bin < num_bins) ? spectrum[ftf_bin] : 0.0f;
+    analysis->bsf_amplitude = (bsf_bin < num_bins) ? spectrum[bsf_bin] : 0.0f;
 
     /* Determine fault type and severity */
     float max_fault_amplitude = fmaxf(fmaxf(analysis->bpfo_amplitude, analysis->bpfi_amplitude),
@@ -342,30 +436,27 @@ static void bearing_analyze_condition(const vibration_fft_data_t *fft_data,
 /**
  * @brief Analyze gear condition
  */
-static void gear_analyze_condition(const vibration_fft_data_t *fft_data,
+static void gear_analyze_condition(const float *spectrum, uint16_t num_bins, float bin_width_hz,
                                  vibration_gear_analysis_t *analysis,
-                                 uint8_t num_teeth, float shaft_speed_rpm,
-                                 uint32_t sampling_rate) {
+                                 uint8_t num_teeth, float shaft_speed_rpm) {
     float shaft_speed_hz = shaft_speed_rpm / 60.0f;
     float gear_mesh_frequency = shaft_speed_hz * (float)num_teeth;
 
     analysis->gear_mesh_frequency = gear_mesh_frequency;
 
     /* Find gear mesh frequency bin */
-    uint16_t mesh_bin = (uint16_t)(gear_mesh_frequency * (float)VIBRATION_SENSOR_FFT_SIZE /
-                                 (float)sampling_rate);
+    uint16_t mesh_bin = (uint16_t)(gear_mesh_frequency / bin_width_hz);
 
-    if (mesh_bin < VIBRATION_SENSOR_FFT_SIZE / 2) {
+    if (mesh_bin < num_bins) {
         /* Check sidebands around mesh frequency */
-        uint16_t sideband_bin = (uint16_t)((gear_mesh_frequency - shaft_speed_hz) *
-                                         (float)VIBRATION_SENSOR_FFT_SIZE / (float)sampling_rate);
+        uint16_t sideband_bin = (uint16_t)((gear_mesh_frequency - shaft_speed_hz) / bin_width_hz);
 
-        if (sideband_bin < VIBRATION_SENSOR_FFT_SIZE / 2) {
-            analysis->sideband_amplitude = fft_data->frequency_bins[sideband_bin];
+        if (sideband_bin < num_bins) {
+            analysis->sideband_amplitude = spectrum[sideband_bin];
         }
 
         /* Calculate modulation index */
-        float carrier_amplitude = fft_data->frequency_bins[mesh_bin];
+        float carrier_amplitude = spectrum[mesh_bin];
         if (carrier_amplitude > 0) {
             analysis->modulation_index = analysis->sideband_amplitude / carrier_amplitude;
         } else {
@@ -396,6 +487,452 @@ static void gear_analyze_condition(const vibration_fft_data_t *fft_data,
     }
 }
 
+/* ============================================================================
+ * Shared Feature Store
+ * ============================================================================ */
+
+/**
+ * @brief Sample rate of the filtered axis blocks
+ */
+static uint32_t vibration_output_rate(void) {
+    uint32_t fs = sensor_config.base_config.sample_rate_hz;
+    return decimation_enabled ? fs / sensor_config.decimation_factor : fs;
+}
+
+/**
+ * @brief Get the spectrum used by bearing and gear analysis
+ *
+ * @return true if a published capture has a cached spectrum, false until one exists
+ */
+static bool vibration_get_analysis_spectrum(const float **spectrum, uint16_t *num_bins, float *bin_width_hz) {
+    uint8_t sensor_id = sensor_config.base_config.sensor_id;
+    uint32_t capture_seq;
+
+    /* The cached spectrum of the latest capture: all analyses share one transform */
+    if (!dsp_feature_get_latest(sensor_id, &capture_seq)) {
+        return false;
+    }
+    *spectrum = dsp_feature_get_spectrum(sensor_id, capture_seq, num_bins, bin_width_hz);
+    return *spectrum && *bin_width_hz > 0.0f;
+}
+
+/* ============================================================================
+ * Filtering
+ * ============================================================================ */
+
+#define DECIMATION_CUTOFF             0.4f  /* Anti-alias -6 dB point per output rate */
+
+/**
+ * @brief Design the high-pass and low-pass sections of a configuration
+ */
+static bool vibration_filter_design(const vibration_sensor_config_t *config, dsp_biquad_coeffs_t *coeffs,
+                                    uint8_t *num_stages) {
+    float fs = (float)config->base_config.sample_rate_hz;
+    uint8_t stages = 0, added;
+
+    *num_stages = 0;
+    if (config->enable_high_pass_filter) {
+        if (!dsp_butterworth_design(DSP_FILTER_HIGHPASS, VIBRATION_FILTER_ORDER, config->high_pass_cutoff_hz,
+                                    fs, &coeffs[stages], &added)) {
+            return false;
+        }
+        stages += added;
+    }
+    if (config->enable_low_pass_filter) {
+        if (!dsp_butterworth_design(DSP_FILTER_LOWPASS, VIBRATION_FILTER_ORDER, config->low_pass_cutoff_hz,
+                                    fs, &coeffs[stages], &added)) {
+            return false;
+        }
+        stages += added;
+    }
+
+    *num_stages = stages;
+    return true;
+}
+
+/**
+ * @brief Design the per-axis cascades and decimators for the configuration
+ */
+static bool vibration_design_filters(void) {
+    dsp_biquad_coeffs_t coeffs[DSP_BIQUAD_MAX_STAGES];
+    uint8_t num_stages;
+
+    decimation_enabled = false;
+    if (!vibration_filter_design(&sensor_config, coeffs, &num_stages)) {
+        return false;
+    }
+    for (uint8_t axis = 0; axis < VIBRATION_SENSOR_AXES; axis++) {
+        if (!dsp_biquad_cascade_init(&axis_filters[axis], coeffs, num_stages)) {
+            return false;
+        }
+    }
+
+    uint8_t factor = sensor_config.decimation_factor;
+    if (factor <= 1) {
+        return true;
+    }
+    if (factor > VIBRATION_DECIMATION_MAX) {
+        return false;
+    }
+
+    float taps[VIBRATION_DECIMATION_TAPS];
+    float fs = (float)sensor_config.base_config.sample_rate_hz;
+    if (!dsp_fir_design_lowpass(taps, VIBRATION_DECIMATION_TAPS, DECIMATION_CUTOFF * fs / (float)factor, fs)) {
+        return false;
+    }
+    for (uint8_t axis = 0; axis < VIBRATION_SENSOR_AXES; axis++) {
+        if (!dsp_fir_decimator_init(&axis_decimators[axis], taps, VIBRATION_DECIMATION_TAPS, factor)) {
+            return false;
+        }
+    }
+    decimation_enabled = true;
+    return true;
+}
+
+/* ============================================================================
+ * Velocity Integration
+ * ============================================================================ */
+
+#define MM_PER_M                      1000.0f
+#define INTEGRATION_CHUNK             64    /* Samples per pass of the non-spectral path */
+
+/**
+ * @brief Severity band for a sample rate (acceleration in m/s² to mm/s, mm)
+ */
+static bool vibration_severity_band(uint32_t sample_rate_hz, dsp_integrate_band_t *band) {
+    band->sample_rate_hz = (float)sample_rate_hz;
+    band->low_hz = VIBRATION_SEVERITY_LOW_HZ;
+    band->high_hz = fminf(VIBRATION_SEVERITY_HIGH_HZ, 0.5f * (float)sample_rate_hz);
+    band->scale = MM_PER_M;
+    return band->high_hz > band->low_hz;
+}
+
+/**
+ * @brief Design the per-axis streaming integrators for the configured rate
+ */
+static void vibration_design_integrators(void) {
+    dsp_integrate_band_t band;
+
+    integrators_valid = false;
+    if (!sensor_config.enable_streaming_integration ||
+        !vibration_severity_band(vibration_output_rate(), &band)) {
+        return;
+    }
+
+    for (uint8_t axis = 0; axis < VIBRATION_SENSOR_AXES; axis++) {
+        if (!dsp_integrator_init(&axis_integrators[axis], &band)) {
+            return;
+        }
+    }
+    integrators_valid = true;
+}
+
+/**
+ * @brief Severity from the cached spectrum of a published capture
+ */
+static bool vibration_cached_severity(uint8_t sensor_id, uint32_t capture_seq, uint32_t sampling_rate_hz,
+                                      float *velocity_rms, float *displacement_rms) {
+    uint16_t num_bins;
+    float bin_width_hz;
+    const float *spectrum = dsp_feature_get_spectrum(sensor_id, capture_seq, &num_bins, &bin_width_hz);
+    if (!spectrum) {
+        return false;
+    }
+
+    dsp_integrate_band_t band;
+    uint32_t rate = (bin_width_hz > 0.0f) ? (uint32_t)lroundf(bin_width_hz * (float)(2U * num_bins)) :
+                    sampling_rate_hz;
+    if (!vibration_severity_band(rate, &band)) {
+        return false;
+    }
+    if (!(bin_width_hz > 0.0f)) {
+        bin_width_hz = (float)rate / (float)(2U * num_bins);
+    }
+
+    return dsp_integrate_spectrum_rms(&band, spectrum, num_bins, bin_width_hz, DSP_INTEGRATE_HANNING_ENBW,
+                                      velocity_rms, displacement_rms);
+}
+
+/**
+ * @brief Integrate a block once or twice over the severity band
+ */
+static bool vibration_integrate(const float *acceleration_data, float *output_data, uint32_t data_length,
+                                uint32_t sampling_rate_hz, dsp_integrate_order_t order) {
+    dsp_integrate_band_t band;
+
+    if (!acceleration_data || !output_data || data_length == 0 ||
+        !vibration_severity_band(sampling_rate_hz, &band)) {
+        return false;
+    }
+
+    /* Whole block in the frequency domain: no drift, exact band limits */
+    if (data_length <= VIBRATION_SENSOR_FFT_SIZE && dsp_fft_is_valid_size(data_length)) {
+        return dsp_integrate_spectral(&band, order, acceleration_data, output_data, fft_output_buffer,
+                                      (uint16_t)data_length, NULL);
+    }
+
+    /* Otherwise a streaming integrator that starts at rest */
+    dsp_integrator_t integrator;
+    float velocity[INTEGRATION_CHUNK];
+    if (!dsp_integrator_init(&integrator, &band)) {
+        return false;
+    }
+
+    for (uint32_t offset = 0; offset < data_length; offset += INTEGRATION_CHUNK) {
+        uint32_t count = data_length - offset;
+        if (count > INTEGRATION_CHUNK) {
+            count = INTEGRATION_CHUNK;
+        }
+        float *displacement = (order == DSP_INTEGRATE_DISPLACEMENT) ? &output_data[offset] : NULL;
+        dsp_integrator_process(&integrator, &acceleration_data[offset], velocity, displacement, count,
+                               NULL, NULL);
+        if (!displacement) {
+            memcpy(&output_data[offset], velocity, count * sizeof(float));
+        }
+    }
+
+    return true;
+}
+
+/* ============================================================================
+ * Block Processing
+ * ============================================================================ */
+
+/**
+ * @brief Hand a completed DMA half to processing (interrupt context)
+ */
+static void vibration_dma_block_complete(uint8_t half, uint32_t timestamp_us) {
+    /* Still pending: processing fell a whole buffer behind and the block was overwritten */
+    if (dma_half_ready[half]) {
+        dma_overruns++;
+    }
+    dma_half_timestamp[half] = timestamp_us;
+    dma_half_ready[half] = true;
+    dma_filling_half = half ^ 1;
+}
+
+/**
+ * @brief Split one DMA half into the per-axis arrays of the raw block
+ */
+static void vibration_unpack_block(uint8_t half) {
+    const vibration_sample_t *frames = dma_buffer[half];
+    uint32_t rate = sensor_config.base_config.sample_rate_hz;
+
+    /* One axis at a time: strided reads, contiguous writes */
+    for (uint8_t axis = 0; axis < VIBRATION_SENSOR_AXES; axis++) {
+        const vibration_sample_t *in = &frames[axis];
+        vibration_sample_t *out = raw_block.samples[axis];
+        for (uint32_t n = 0; n < VIBRATION_SENSOR_BLOCK_SIZE; n++) {
+            out[n] = in[n * VIBRATION_SENSOR_AXES];
+        }
+    }
+
+    /* The interrupt stamps the last frame; the block carries the first */
+    raw_block.num_frames = VIBRATION_SENSOR_BLOCK_SIZE;
+    raw_block.sample_period_ns = (rate > 0) ? 1000000000U / rate : 0;
+    raw_block.timestamp_us = dma_half_timestamp[half] -
+                             (uint32_t)(((uint64_t)(VIBRATION_SENSOR_BLOCK_SIZE - 1) *
+                                         raw_block.sample_period_ns) / 1000U);
+}
+
+/**
+ * @brief Advance the millisecond clock to a block timestamp
+ *
+ * The microsecond timestamps wrap after about 71.6 minutes; blocks arrive
+ * far more often, so the wrapping difference is always the elapsed time.
+ */
+static uint32_t vibration_block_time_ms(uint32_t timestamp_us) {
+    if (!block_clock_started) {
+        block_clock_started = true;
+        block_clock_last_us = timestamp_us;
+        block_clock_ms = timestamp_us / 1000U;
+        block_clock_remainder_us = timestamp_us % 1000U;
+        return block_clock_ms;
+    }
+
+    uint32_t elapsed_us = (timestamp_us - block_clock_last_us) + block_clock_remainder_us;
+    block_clock_last_us = timestamp_us;
+    block_clock_ms += elapsed_us / 1000U;
+    block_clock_remainder_us = elapsed_us % 1000U;
+    return block_clock_ms;
+}
+
+/**
+ * @brief Block statistics and velocity per axis
+ *
+ * @return Axis with the largest RMS acceleration
+ */
+static uint8_t vibration_block_statistics(uint32_t count, vibration_processed_data_t *processed) {
+    float rms[VIBRATION_SENSOR_AXES], peak[VIBRATION_SENSOR_AXES];
+    float velocity[VIBRATION_SENSOR_AXES] = {0.0f, 0.0f, 0.0f};
+    float displacement[VIBRATION_SENSOR_AXES] = {0.0f, 0.0f, 0.0f};
+    uint8_t loudest = 0;
+
+    for (uint8_t axis = 0; axis < VIBRATION_SENSOR_AXES; axis++) {
+        const float *x = axis_blocks[axis];
+        float sum = 0.0f, square = 0.0f;
+        for (uint32_t n = 0; n < count; n++) {
+            sum += x[n];
+        }
+        float mean = sum / (float)count;
+
+        /* AC statistics: gravity and offset do not count as vibration */
+        float max_dev = 0.0f;
+        for (uint32_t n = 0; n < count; n++) {
+            float d = x[n] - mean;
+            square += d * d;
+            max_dev = fmaxf(max_dev, fabsf(d));
+        }
+        rms[axis] = sqrtf(square / (float)count);
+        peak[axis] = max_dev;
+        if (rms[axis] > rms[loudest]) {
+            loudest = axis;
+        }
+
+        /* The scratch outputs are only needed for their RMS */
+        if (integrators_valid) {
+            dsp_integrator_process(&axis_integrators[axis], x, fft_input_buffer, fft_output_buffer, count,
+                                   &velocity[axis], &displacement[axis]);
+        }
+    }
+
+    memset(processed, 0, sizeof(vibration_processed_data_t));
+    processed->x_axis_acceleration = rms[0];
+    processed->y_axis_acceleration = rms[1];
+    processed->z_axis_acceleration = rms[2];
+    processed->x_axis_velocity = velocity[0];
+    processed->y_axis_velocity = velocity[1];
+    processed->z_axis_velocity = velocity[2];
+    processed->x_axis_displacement = displacement[0];
+    processed->y_axis_displacement = displacement[1];
+    processed->z_axis_displacement = displacement[2];
+    processed->rms_acceleration = sqrtf(rms[0] * rms[0] + rms[1] * rms[1] + rms[2] * rms[2]);
+    processed->peak_acceleration = fmaxf(fmaxf(peak[0], peak[1]), peak[2]);
+    processed->crest_factor = (rms[loudest] > 0.0f) ? peak[loudest] / rms[loudest] : 0.0f;
+
+    return loudest;
+}
+
+/**
+ * @brief Append filtered samples to the analysis capture
+ *
+ * @return true if the capture completed and was published
+ */
+static bool vibration_fill_capture(uint32_t count, uint8_t loudest) {
+    /* A capture follows one axis from start to end */
+    if (capture_fill == 0) {
+        capture_axis = loudest;
+    }
+
+    uint32_t space = VIBRATION_SENSOR_BLOCK_SIZE - capture_fill;
+    uint32_t copy = (count < space) ? count : space;
+    memcpy(&capture_buffers[capture_index][capture_fill], axis_blocks[capture_axis], copy * sizeof(float));
+    capture_fill += (uint16_t)copy;
+    if (capture_fill < VIBRATION_SENSOR_BLOCK_SIZE) {
+        return false;
+    }
+
+    capture_fill = 0;
+    if (!vibration_sensor_publish_capture(capture_buffers[capture_index], VIBRATION_SENSOR_BLOCK_SIZE, NULL)) {
+        return false;
+    }
+    capture_index ^= 1;
+    capture_valid = true;
+    return true;
+}
+
+/**
+ * @brief Spectral analysis of the latest capture
+ */
+static void vibration_analyze_capture(vibration_sensor_data_t *data) {
+    vibration_processed_data_t *processed = &data->processed_data;
+
+    memset(&data->fft_data, 0, sizeof(vibration_fft_data_t));
+    memset(&data->bearing_analysis, 0, sizeof(vibration_bearing_analysis_t));
+    memset(&data->gear_analysis, 0, sizeof(vibration_gear_analysis_t));
+    if (!capture_valid) {
+        return;
+    }
+
+    /* Transform each capture once; the buffer not being filled holds the latest */
+    if (capture_fft_sequence != capture_sequence) {
+        capture_fft_sequence = capture_sequence;
+        capture_fft_valid = vibration_sensor_perform_fft(capture_buffers[capture_index ^ 1],
+                                                         VIBRATION_SENSOR_BLOCK_SIZE, &capture_fft);
+        if (capture_fft_valid) {
+            sensor_status.fft_calculations++;
+        }
+    }
+    if (capture_fft_valid) {
+        data->fft_data = capture_fft;
+    }
+
+    /* Severity, bearing and gear analysis read the capture's cached spectrum */
+    vibration_cached_severity(sensor_config.base_config.sensor_id, capture_sequence, vibration_output_rate(),
+                              &processed->velocity_rms, &processed->displacement_rms);
+    vibration_sensor_analyze_bearing(processed, &data->bearing_analysis, NULL);
+    vibration_sensor_analyze_gear(processed, &data->gear_analysis, NULL);
+}
+
+/**
+ * @brief Order tracking of the filtered block when a tach reference is configured
+ *
+ * Order spectra stay sharp through speed ramps, so while the tracker is
+ * locked their bearing and gear results replace the fixed-speed ones.
+ */
+static void vibration_track_orders(uint32_t count, vibration_sensor_data_t *data) {
+    vibration_order_tracking_config_t tracking;
+    vibration_order_tracking_status_t status;
+    if (!vibration_order_tracking_get_config(&tracking)) {
+        return;
+    }
+
+    bool spectrum_ready = false;
+    float sample_period_us = 1.0e6f / (float)vibration_output_rate();
+    vibration_order_tracking_process(axis_blocks[tracking.measurement_axis], (uint16_t)count,
+                                     raw_block.timestamp_us, sample_period_us, &order_spectrum, &spectrum_ready);
+    if (spectrum_ready) {
+        order_bearing_valid = vibration_order_tracking_analyze_bearing(
+            &order_spectrum, tracking.bearing_balls, tracking.bearing_pitch_diameter_mm,
+            tracking.bearing_ball_diameter_mm, tracking.bearing_contact_angle_deg, &order_bearing_analysis);
+        order_gear_valid = vibration_order_tracking_analyze_gear(&order_spectrum, tracking.gear_teeth,
+                                                                 &order_gear_analysis);
+    }
+
+    /* Results of a record taken before the tach was lost no longer describe the machine */
+    if (!vibration_order_tracking_get_status(&status) || !status.tracking_locked) {
+        order_bearing_valid = false;
+        order_gear_valid = false;
+    }
+
+    if (order_bearing_valid) {
+        data->bearing_analysis = order_bearing_analysis;
+    }
+    if (order_gear_valid) {
+        data->gear_analysis = order_gear_analysis;
+    }
+}
+
+/**
+ * @brief Let the attached controller pick the rate for the next blocks
+ */
+static void vibration_adapt_rate(const vibration_processed_data_t *processed, uint32_t now_ms) {
+    if (!attached_rate_controller) {
+        return;
+    }
+
+    /* Activity is the block AC mean square per axis, after filtering */
+    sensor_rate_update(attached_rate_controller, 0, processed->x_axis_acceleration * processed->x_axis_acceleration);
+    sensor_rate_update(attached_rate_controller, 1, processed->y_axis_acceleration * processed->y_axis_acceleration);
+    sensor_rate_update(attached_rate_controller, 2, processed->z_axis_acceleration * processed->z_axis_acceleration);
+
+    bool rate_changed = false;
+    uint32_t rate_hz = sensor_rate_evaluate(attached_rate_controller, now_ms, &rate_changed);
+    if (rate_changed && !vibration_sensor_set_sampling_rate(rate_hz)) {
+        sensor_rate_sync(attached_rate_controller, sensor_config.base_config.sample_rate_hz);
+    }
+}
+
 /* ============================================================================
  * Public API Implementation
  * ============================================================================ */
@@ -421,8 +958,17 @@ bool vibration_sensor_init(const vibration_sensor_config_t *config) {
         return false;
     }
 
-    /* Initialize FFT windows */
+    /* Initialize FFT windows and twiddle table */
     fft_init_windows();
+    dsp_fft_init();
+    dsp_feature_init();
+    capture_sequence = 0;
+    capture_fft_sequence = 0;
+    capture_fft_valid = false;
+    if (!vibration_design_filters()) {
+        return false;
+    }
+    vibration_design_integrators();
 
     /* Initialize status */
     memset(&sensor_status, 0, sizeof(vibration_sensor_status_t));
@@ -466,7 +1012,18 @@ bool vibration_sensor_configure(const vibration_sensor_config_t *config) {
         return false;
     }
 
+    /* Validate the filter design before taking over the configuration */
+    dsp_biquad_coeffs_t coeffs[DSP_BIQUAD_MAX_STAGES];
+    uint8_t num_stages;
+    if (!vibration_filter_design(config, coeffs, &num_stages)) {
+        return false;
+    }
+
     sensor_config = *config;
+    if (!vibration_design_filters()) {
+        return false;
+    }
+    vibration_design_integrators();
 
     /* Apply hardware configuration */
     return accelerometer_hw_configure(&sensor_config);
@@ -480,14 +1037,33 @@ bool vibration_sensor_start_acquisition(void) {
         return false;
     }
 
-    /* Reset buffer */
-    buffer_index = 0;
-    buffer_full = false;
+    /* Reset the ping-pong buffer and the analysis capture */
+    dma_half_ready[0] = false;
+    dma_half_ready[1] = false;
+    dma_filling_half = 0;
+    dma_overruns = 0;
+    next_block_half = 0;
+    capture_fill = 0;
+    raw_block.num_frames = 0;
+
+    /* A new acquisition is not continuous with the last one */
+    for (uint8_t axis = 0; axis < VIBRATION_SENSOR_AXES; axis++) {
+        dsp_biquad_cascade_reset(&axis_filters[axis]);
+        dsp_fir_decimator_reset(&axis_decimators[axis]);
+        dsp_integrator_reset(&axis_integrators[axis]);
+    }
+
+    if (!accelerometer_hw_start_stream(&dma_buffer[0][0], 2 * VIBRATION_SENSOR_BLOCK_SIZE)) {
+        return false;
+    }
 
     /* Update status */
     sensor_status.base_status.current_mode = ESOCORE_MODE_ACTIVE;
     sensor_status.base_status.is_initialized = true;
+    sensor_status.data_buffer_full = false;
     sensor_status.samples_collected = 0;
+    sensor_status.blocks_processed = 0;
+    sensor_status.block_overruns = 0;
 
     return true;
 }
@@ -500,67 +1076,95 @@ bool vibration_sensor_stop_acquisition(void) {
         return false;
     }
 
+    accelerometer_hw_stop_stream();
+
     /* Update status */
     sensor_status.base_status.current_mode = ESOCORE_MODE_STANDBY;
 
     return true;
 }
 
+/**
+ * @brief DMA half-transfer complete handler
+ */
+void vibration_sensor_dma_half_complete_isr(uint32_t timestamp_us) {
+    vibration_dma_block_complete(0, timestamp_us);
+}
+
+/**
+ * @brief DMA transfer complete handler
+ */
+void vibration_sensor_dma_complete_isr(uint32_t timestamp_us) {
+    vibration_dma_block_complete(1, timestamp_us);
+}
+
 /**
  * @brief Read vibration sensor data
  */
 bool vibration_sensor_read_data(vibration_sensor_data_t *data, uint32_t timeout_ms) {
-    if (!sensor_initialized || !data) {
+    if (!sensor_initialized || !data ||
+        sensor_status.base_status.current_mode != ESOCORE_MODE_ACTIVE) {
         return false;
     }
 
-    /* Read raw data */
-    if (!accelerometer_hw_read_data(&data->raw_data)) {
+    /* Blocks are taken in order, the DMA keeps filling the other half meanwhile */
+    uint8_t half = next_block_half;
+    if (!dma_half_ready[half] && !accelerometer_hw_wait_block(timeout_ms)) {
         return false;
     }
-
-    /* Convert to engineering units */
-    if (!vibration_sensor_convert_units(&data->raw_data, &data->processed_data, &sensor_config)) {
+    if (!dma_half_ready[half]) {
         return false;
     }
-
-    /* Apply filtering if enabled */
-    if (sensor_config.enable_high_pass_filter || sensor_config.enable_low_pass_filter) {
-        float temp_data[3] = {data->processed_data.x_axis_acceleration,
-                            data->processed_data.y_axis_acceleration,
-                            data->processed_data.z_axis_acceleration};
-
-        if (!vibration_sensor_apply_filtering(temp_data, temp_data, 3, &sensor_config)) {
-            return false;
-        }
-
-        data->processed_data.x_axis_acceleration = temp_data[0];
-        data->processed_data.y_axis_acceleration = temp_data[1];
-        data->processed_data.z_axis_acceleration = temp_data[2];
+    sensor_status.data_buffer_full = dma_half_ready[half ^ 1];
+
+    /* Unpack to the per-axis raw block, then release the half as early as possible */
+    uint32_t block_end_us = dma_half_timestamp[half];
+    vibration_unpack_block(half);
+    dma_half_ready[half] = false;
+    next_block_half = half ^ 1;
+    uint32_t block_ms = vibration_block_time_ms(raw_block.timestamp_us);
+
+    /* Raw counts go to the pre-trigger ring before any processing */
+#if VIBRATION_SENSOR_SAMPLE_BITS <= 16
+    if (attached_capture) {
+        const int16_t *channels[VIBRATION_SENSOR_AXES] = {raw_block.samples[0], raw_block.samples[1],
+                                                          raw_block.samples[2]};
+        sensor_capture_process(attached_capture, channels, raw_block.num_frames, block_ms);
+    }
+#endif
+
+    /* The last frame stands as the raw reading */
+    uint32_t last = VIBRATION_SENSOR_BLOCK_SIZE - 1;
+    data->raw_data.x_axis_raw = raw_block.samples[0][last];
+    data->raw_data.y_axis_raw = raw_block.samples[1][last];
+    data->raw_data.z_axis_raw = raw_block.samples[2][last];
+    data->raw_data.timestamp = block_end_us;
+    if (!accelerometer_hw_read_temperature(&data->raw_data.temperature_celsius)) {
+        data->raw_data.temperature_celsius = (int16_t)sensor_status.current_temperature;
     }
 
-    /* Perform FFT analysis */
-    float fft_input[3] = {data->processed_data.x_axis_acceleration,
-                         data->processed_data.y_axis_acceleration,
-                         data->processed_data.z_axis_acceleration};
+    float *axes[VIBRATION_SENSOR_AXES] = {axis_blocks[0], axis_blocks[1], axis_blocks[2]};
+    vibration_sensor_convert_block(&raw_block, axes, &sensor_config);
 
-    if (!vibration_sensor_perform_fft(fft_input, 3, &data->fft_data)) {
-        return false;
+    /* Filter (and decimate) each axis with state carried across blocks; a block spans
+       several decimation periods, so every axis yields samples */
+    uint32_t count = VIBRATION_SENSOR_BLOCK_SIZE;
+    for (uint8_t axis = 0; axis < VIBRATION_SENSOR_AXES; axis++) {
+        vibration_sensor_filter_axis(axis, axis_blocks[axis], axis_blocks[axis], VIBRATION_SENSOR_BLOCK_SIZE,
+                                     &count);
     }
 
-    /* Perform bearing analysis (placeholder parameters) */
-    vibration_bearing_analysis_t bearing_analysis = {0};
-    vibration_sensor_analyze_bearing(&data->processed_data, &bearing_analysis, NULL);
-    data->bearing_analysis = bearing_analysis;
-
-    /* Perform gear analysis (placeholder parameters) */
-    vibration_gear_analysis_t gear_analysis = {0};
-    vibration_sensor_analyze_gear(&data->processed_data, &gear_analysis, NULL);
-    data->gear_analysis = gear_analysis;
+    /* Time-domain statistics every block, spectral analysis on the latest capture */
+    uint8_t loudest = vibration_block_statistics(count, &data->processed_data);
+    data->processed_data.timestamp = data->raw_data.timestamp;
+    vibration_fill_capture(count, loudest);
+    vibration_analyze_capture(data);
+    vibration_track_orders(count, data);
+    vibration_adapt_rate(&data->processed_data, block_ms);
 
     /* Calculate overall condition */
     data->overall_condition = vibration_sensor_calculate_condition(
-        &data->processed_data, &bearing_analysis, &gear_analysis);
+        &data->processed_data, &data->bearing_analysis, &data->gear_analysis);
 
     /* Generate condition description */
     if (data->overall_condition >= 90) {
@@ -576,12 +1180,67 @@ bool vibration_sensor_read_data(vibration_sensor_data_t *data, uint32_t timeout_
     }
 
     /* Update status */
-    sensor_status.samples_collected++;
+    sensor_status.samples_collected += VIBRATION_SENSOR_BLOCK_SIZE;
+    sensor_status.blocks_processed++;
+    sensor_status.block_overruns = dma_overruns;
     sensor_status.current_temperature = data->raw_data.temperature_celsius;
 
     return true;
 }
 
+/**
+ * @brief Get the latest raw block
+ */
+bool vibration_sensor_get_raw_block(vibration_block_t *block) {
+    if (!sensor_initialized || !block || raw_block.num_frames == 0) {
+        return false;
+    }
+
+    *block = raw_block;
+    return true;
+}
+
+/**
+ * @brief Feed every raw block to an event-triggered capture
+ */
+bool vibration_sensor_attach_capture(sensor_capture_t *capture) {
+    if (!sensor_initialized) {
+        return false;
+    }
+#if VIBRATION_SENSOR_SAMPLE_BITS > 16
+    if (capture) {
+        return false;
+    }
+#endif
+    if (capture && capture->config.num_channels != VIBRATION_SENSOR_AXES) {
+        return false;
+    }
+    if (capture && !sensor_capture_set_rate(capture, sensor_config.base_config.sample_rate_hz)) {
+        return false;
+    }
+
+    attached_capture = capture;
+    return true;
+}
+
+/**
+ * @brief Let a controller adapt the sampling rate to the vibration activity
+ */
+bool vibration_sensor_attach_rate_controller(sensor_rate_controller_t *controller) {
+    if (!sensor_initialized) {
+        return false;
+    }
+    if (controller && controller->config.num_channels != VIBRATION_SENSOR_AXES) {
+        return false;
+    }
+
+    attached_rate_controller = controller;
+    if (controller) {
+        sensor_rate_sync(controller, sensor_config.base_config.sample_rate_hz);
+    }
+    return true;
+}
+
 /**
  * @brief Get vibration sensor status
  */
@@ -659,7 +1318,31 @@ bool vibration_sensor_perform_fft(const float *input_data, uint32_t data_length,
     }
 
     /* Calculate frequency domain parameters */
-    fft_calculate_parameters(fft_output_buffer, fft_result, sensor_config.base_config.sampling_rate_hz);
+    fft_calculate_parameters(fft_output_buffer, fft_result, vibration_output_rate());
+
+    return true;
+}
+
+/**
+ * @brief Publish a capture to the shared feature store
+ */
+bool vibration_sensor_publish_capture(const float *samples, uint16_t num_samples,
+                                     uint32_t *capture_seq) {
+    if (!sensor_initialized || !samples) {
+        return false;
+    }
+
+    uint32_t seq = capture_sequence + 1;
+
+    if (!dsp_feature_publish(sensor_config.base_config.sensor_id, seq, samples, num_samples,
+                             (float)vibration_output_rate())) {
+        return false;
+    }
+
+    capture_sequence = seq;
+    if (capture_seq) {
+        *capture_seq = seq;
+    }
 
     return true;
 }
@@ -687,19 +1370,18 @@ bool vibration_sensor_analyze_bearing(const vibration_processed_data_t *vibratio
                                      ball_diameter_mm, contact_angle_deg,
                                      &bpfo, &bpfi, &ftf, &bsf);
 
-    /* Perform FFT analysis for bearing fault detection */
-    vibration_fft_data_t fft_data;
-    float acceleration_data = sqrtf(vibration_data->x_axis_acceleration * vibration_data->x_axis_acceleration +
-                                  vibration_data->y_axis_acceleration * vibration_data->y_axis_acceleration +
-                                  vibration_data->z_axis_acceleration * vibration_data->z_axis_acceleration);
+    /* Get the spectrum for bearing fault detection */
+    const float *spectrum;
+    uint16_t num_bins;
+    float bin_width_hz;
 
-    if (!vibration_sensor_perform_fft(&acceleration_data, 1, &fft_data)) {
+    if (!vibration_get_analysis_spectrum(&spectrum, &num_bins, &bin_width_hz)) {
         return false;
     }
 
     /* Analyze bearing condition */
-    bearing_analyze_condition(&fft_data, bearing_analysis, bpfo, bpfi, ftf, bsf,
-                            sensor_config.base_config.sampling_rate_hz);
+    bearing_analyze_condition(spectrum, num_bins, bin_width_hz, bearing_analysis,
+                            bpfo, bpfi, ftf, bsf);
 
     return true;
 }
@@ -718,19 +1400,18 @@ bool vibration_sensor_analyze_gear(const vibration_processed_data_t *vibration_d
     uint8_t num_teeth = 20;
     float shaft_speed_rpm = 1800.0f;
 
-    /* Perform FFT analysis for gear fault detection */
-    vibration_fft_data_t fft_data;
-    float acceleration_data = sqrtf(vibration_data->x_axis_acceleration * vibration_data->x_axis_acceleration +
-                                  vibration_data->y_axis_acceleration * vibration_data->y_axis_acceleration +
-                                  vibration_data->z_axis_acceleration * vibration_data->z_axis_acceleration);
+    /* Get the spectrum for gear fault detection */
+    const float *spectrum;
+    uint16_t num_bins;
+    float bin_width_hz;
 
-    if (!vibration_sensor_perform_fft(&acceleration_data, 1, &fft_data)) {
+    if (!vibration_get_analysis_spectrum(&spectrum, &num_bins, &bin_width_hz)) {
         return false;
     }
 
     /* Analyze gear condition */
-    gear_analyze_condition(&fft_data, gear_analysis, num_teeth, shaft_speed_rpm,
-                         sensor_config.base_config.sampling_rate_hz);
+    gear_analyze_condition(spectrum, num_bins, bin_width_hz, gear_analysis,
+                         num_teeth, shaft_speed_rpm);
 
     return true;
 }
@@ -743,16 +1424,14 @@ uint8_t vibration_sensor_calculate_condition(const vibration_processed_data_t *v
                                            const vibration_gear_analysis_t *gear_analysis) {
     float condition_score = 100.0f;
 
-    /* Factor in RMS acceleration */
-    float rms_acceleration = sqrtf(vibration_data->x_axis_acceleration * vibration_data->x_axis_acceleration +
-                                 vibration_data->y_axis_acceleration * vibration_data->y_axis_acceleration +
-                                 vibration_data->z_axis_acceleration * vibration_data->z_axis_acceleration);
+    /* Factor in severity: band-limited velocity RMS against the ISO 10816 zones */
+    float velocity_rms = vibration_data->velocity_rms;
 
-    if (rms_acceleration > VIBRATION_THRESHOLD_CRITICAL) {
+    if (velocity_rms > VIBRATION_THRESHOLD_CRITICAL) {
         condition_score -= 40.0f;
-    } else if (rms_acceleration > VIBRATION_THRESHOLD_WARNING) {
+    } else if (velocity_rms > VIBRATION_THRESHOLD_WARNING) {
         condition_score -= 20.0f;
-    } else if (rms_acceleration > VIBRATION_THRESHOLD_GOOD) {
+    } else if (velocity_rms > VIBRATION_THRESHOLD_GOOD) {
         condition_score -= 10.0f;
     }
 
@@ -822,19 +1501,60 @@ bool vibration_sensor_convert_units(const vibration_raw_data_t *raw_data,
         processed_data->crest_factor = 0.0f;
     }
 
-    /* Placeholder for velocity and displacement calculation */
+    /* Velocity and displacement need sample history; the integrators fill them */
     processed_data->x_axis_velocity = 0.0f;
     processed_data->y_axis_velocity = 0.0f;
     processed_data->z_axis_velocity = 0.0f;
     processed_data->x_axis_displacement = 0.0f;
     processed_data->y_axis_displacement = 0.0f;
     processed_data->z_axis_displacement = 0.0f;
+    processed_data->velocity_rms = 0.0f;
+    processed_data->displacement_rms = 0.0f;
 
     processed_data->timestamp = raw_data->timestamp;
 
     return true;
 }
 
+/**
+ * @brief Convert a raw block to engineering units
+ */
+bool vibration_sensor_convert_block(const vibration_block_t *block, float *const *axes,
+                                  const vibration_sensor_config_t *config) {
+    if (!block || !axes || !config || block->num_frames > VIBRATION_SENSOR_BLOCK_SIZE) {
+        return false;
+    }
+
+    float scale_factor = config->sensitivity_mg_per_lsb / 1000.0f * 9.81f; /* Convert mg to m/s² */
+    int32_t offsets[VIBRATION_SENSOR_AXES] = {0, 0, 0};
+    float scales[VIBRATION_SENSOR_AXES] = {scale_factor, scale_factor, scale_factor};
+
+    if (calibration_data.valid) {
+        offsets[0] = calibration_data.x_offset;
+        offsets[1] = calibration_data.y_offset;
+        offsets[2] = calibration_data.z_offset;
+        scales[0] *= calibration_data.x_scale;
+        scales[1] *= calibration_data.y_scale;
+        scales[2] *= calibration_data.z_scale;
+    }
+
+    /* (raw - offset) * scale as one multiply-add per sample over a contiguous array */
+    for (uint8_t axis = 0; axis < VIBRATION_SENSOR_AXES; axis++) {
+        const vibration_sample_t *in = block->samples[axis];
+        float *out = axes[axis];
+        if (!out) {
+            return false;
+        }
+        const float scale = scales[axis];
+        const float bias = -(float)offsets[axis] * scale;
+        for (uint32_t n = 0; n < block->num_frames; n++) {
+            out[n] = (float)in[n] * scale + bias;
+        }
+    }
+
+    return true;
+}
+
 /**
  * @brief Apply digital filtering
  */
@@ -844,16 +1564,34 @@ bool vibration_sensor_apply_filtering(const float *input_data, float *output_dat
         return false;
     }
 
-    /* TODO: Implement digital filtering (high-pass, low-pass) */
-    /* This would typically involve:
-     * - IIR or FIR filter implementation
-     * - Filter coefficient calculation
-     * - Sample-by-sample processing
-     */
+    dsp_biquad_coeffs_t coeffs[DSP_BIQUAD_MAX_STAGES];
+    dsp_biquad_cascade_t cascade;
+    uint8_t num_stages;
 
-    /* Placeholder: Copy input to output */
-    memcpy(output_data, input_data, data_length * sizeof(float));
+    if (!vibration_filter_design(config, coeffs, &num_stages) ||
+        !dsp_biquad_cascade_init(&cascade, coeffs, num_stages)) {
+        return false;
+    }
 
+    dsp_biquad_cascade_process(&cascade, input_data, output_data, data_length);
+    return true;
+}
+
+/**
+ * @brief Filter a continuous block of one axis
+ */
+bool vibration_sensor_filter_axis(uint8_t axis, const float *input_data, float *output_data,
+                                uint32_t data_length, uint32_t *output_length) {
+    if (!sensor_initialized || axis >= VIBRATION_SENSOR_AXES || !input_data || !output_data ||
+        !output_length) {
+        return false;
+    }
+
+    dsp_biquad_cascade_process(&axis_filters[axis], input_data, output_data, data_length);
+
+    *output_length = decimation_enabled ?
+                     dsp_fir_decimator_process(&axis_decimators[axis], output_data, output_data, data_length) :
+                     data_length;
     return true;
 }
 
@@ -949,7 +1687,30 @@ bool vibration_sensor_set_sampling_rate(uint32_t sampling_rate_hz) {
         return false;
     }
 
-    sensor_config.base_config.sampling_rate_hz = sampling_rate_hz;
+    /* The filter cutoffs must stay below the new Nyquist frequency */
+    vibration_sensor_config_t candidate = sensor_config;
+    dsp_biquad_coeffs_t coeffs[DSP_BIQUAD_MAX_STAGES];
+    uint8_t num_stages;
+    candidate.base_config.sample_rate_hz = sampling_rate_hz;
+    if (!vibration_filter_design(&candidate, coeffs, &num_stages)) {
+        return false;
+    }
+
+    /* The attached capture moves first: it refuses while a capture is being collected or
+       awaits upload, and the sensor then stays at the rate its samples were taken at */
+    if (attached_capture && !sensor_capture_set_rate(attached_capture, sampling_rate_hz)) {
+        return false;
+    }
+
+    sensor_config.base_config.sample_rate_hz = sampling_rate_hz;
+    if (!vibration_design_filters()) {
+        return false;
+    }
+    vibration_design_integrators();
+
+    /* Samples taken at the old rate must not end up in a capture analysed at the new one */
+    capture_fill = 0;
+    capture_valid = false;
     return accelerometer_hw_configure(&sensor_config);
 }
 
@@ -973,8 +1734,12 @@ bool vibration_sensor_clear_buffer(void) {
         return false;
     }
 
-    buffer_index = 0;
-    buffer_full = false;
+    /* Pending blocks are dropped; the DMA keeps streaming into the ping-pong buffer */
+    dma_half_ready[0] = false;
+    dma_half_ready[1] = false;
+    next_block_half = dma_filling_half;
+    capture_fill = 0;
+    sensor_status.data_buffer_full = false;
     sensor_status.samples_collected = 0;
 
     return true;
@@ -1011,35 +1776,75 @@ bool vibration_sensor_check_saturation(uint8_t *saturation_flags) {
  */
 bool vibration_sensor_calculate_velocity(const float *acceleration_data, float *velocity_data,
                                        uint32_t data_length, uint32_t sampling_rate_hz) {
-    if (!acceleration_data || !velocity_data || data_length == 0) {
+    return vibration_integrate(acceleration_data, velocity_data, data_length, sampling_rate_hz,
+                               DSP_INTEGRATE_VELOCITY);
+}
+
+/**
+ * @brief Calculate displacement from acceleration
+ */
+bool vibration_sensor_calculate_displacement(const float *acceleration_data, float *displacement_data,
+                                           uint32_t data_length, uint32_t sampling_rate_hz) {
+    return vibration_integrate(acceleration_data, displacement_data, data_length, sampling_rate_hz,
+                               DSP_INTEGRATE_DISPLACEMENT);
+}
+
+/**
+ * @brief Calculate band-limited velocity and displacement RMS of a block
+ */
+bool vibration_sensor_calculate_severity(const float *acceleration_data, uint32_t data_length,
+                                       uint32_t sampling_rate_hz, float *velocity_rms,
+                                       float *displacement_rms) {
+    if (!acceleration_data || !velocity_rms || data_length == 0) {
         return false;
     }
 
-    /* TODO: Implement numerical integration for velocity calculation */
-    /* This would typically involve trapezoidal integration */
+    /* A published capture already has its windowed spectrum cached */
+    uint8_t sensor_id;
+    uint32_t capture_seq;
+    if (data_length <= UINT16_MAX &&
+        dsp_feature_find(acceleration_data, (uint16_t)data_length, &sensor_id, &capture_seq) &&
+        vibration_cached_severity(sensor_id, capture_seq, sampling_rate_hz, velocity_rms, displacement_rms)) {
+        return true;
+    }
 
-    /* Placeholder: Simple differentiation (incorrect but for demo) */
-    for (uint32_t i = 1; i < data_length; i++) {
-        velocity_data[i] = velocity_data[i-1] + acceleration_data[i] / (float)sampling_rate_hz;
+    dsp_integrate_band_t band;
+    if (data_length > VIBRATION_SENSOR_FFT_SIZE || !dsp_fft_is_valid_size(data_length) ||
+        !vibration_severity_band(sampling_rate_hz, &band)) {
+        return false;
     }
 
-    return true;
+    /* Same Hanning spectrum as the feature store, so both paths agree */
+    float mean = 0.0f;
+    for (uint32_t i = 0; i < data_length; i++) {
+        mean += acceleration_data[i];
+    }
+    mean /= (float)data_length;
+    for (uint32_t i = 0; i < data_length; i++) {
+        float window = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * (float)i / (float)data_length);
+        fft_input_buffer[i] = (acceleration_data[i] - mean) * window * 2.0f;
+    }
+    if (!dsp_fft_magnitude(fft_input_buffer, fft_output_buffer, fft_output_buffer, (uint16_t)data_length)) {
+        return false;
+    }
+
+    return dsp_integrate_spectrum_rms(&band, fft_output_buffer, (uint16_t)(data_length / 2),
+                                      (float)sampling_rate_hz / (float)data_length,
+                                      DSP_INTEGRATE_HANNING_ENBW, velocity_rms, displacement_rms);
 }
 
 /**
- * @brief Calculate displacement from acceleration
+ * @brief Integrate a continuous block of one axis
  */
-bool vibration_sensor_calculate_displacement(const float *acceleration_data, float *displacement_data,
-                                           uint32_t data_length, uint32_t sampling_rate_hz) {
-    if (!acceleration_data || !displacement_data || data_length == 0) {
+bool vibration_sensor_integrate_stream(uint8_t axis, const float *acceleration_data, float *velocity_data,
+                                     float *displacement_data, uint32_t data_length,
+                                     float *velocity_rms) {
+    if (!sensor_initialized || !integrators_valid || axis >= VIBRATION_SENSOR_AXES) {
         return false;
     }
 
-    /* TODO: Implement double integration for displacement calculation */
-
-    /* Placeholder */
-    memset(displacement_data, 0, data_length * sizeof(float));
-    return true;
+    return dsp_integrator_process(&axis_integrators[axis], acceleration_data, velocity_data,
+                                  displacement_data, data_length, velocity_rms, NULL);
 }
 
 /**
@@ -16,6 +16,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "../../common/sensors/sensor_interface.h"
+#include "../../common/sensors/sensor_capture.h"
+#include "../../common/sensors/sensor_rate.h"
 
 /* ============================================================================
  * Vibration Sensor Configuration
@@ -24,14 +26,29 @@
 #define VIBRATION_SENSOR_AXES              3
 #define VIBRATION_SENSOR_MAX_SAMPLES       1024
 #define VIBRATION_SENSOR_FFT_SIZE          512
+#define VIBRATION_SENSOR_BLOCK_SIZE        VIBRATION_SENSOR_FFT_SIZE /* Frames per DMA half-buffer */
 #define VIBRATION_SENSOR_SAMPLE_RATE_MAX   10000
 #define VIBRATION_SENSOR_SAMPLE_RATE_MIN   10
 
-/* Vibration thresholds (in mm/s² RMS) */
+/* Raw sample width: 16 for 16-bit parts (BMI088), 32 for 20-bit parts (ADXL355) */
+#ifndef VIBRATION_SENSOR_SAMPLE_BITS
+#define VIBRATION_SENSOR_SAMPLE_BITS       16
+#endif
+
+/* Vibration severity thresholds (velocity in mm/s RMS, ISO 10816 band) */
 #define VIBRATION_THRESHOLD_GOOD           2.5f
 #define VIBRATION_THRESHOLD_WARNING        7.1f
 #define VIBRATION_THRESHOLD_CRITICAL       18.0f
 
+/* Filtering */
+#define VIBRATION_FILTER_ORDER             4     /* Butterworth order of the high-pass and low-pass */
+#define VIBRATION_DECIMATION_MAX           8     /* Largest capture decimation factor */
+#define VIBRATION_DECIMATION_TAPS          47    /* Anti-alias FIR taps ahead of decimation */
+
+/* Severity band for velocity and displacement (ISO 10816) */
+#define VIBRATION_SEVERITY_LOW_HZ          10.0f
+#define VIBRATION_SEVERITY_HIGH_HZ         1000.0f
+
 /* ============================================================================
  * Vibration Data Types
  * ============================================================================ */
@@ -50,6 +67,8 @@ typedef struct {
     float low_pass_cutoff_hz;               /**< Low-pass filter cutoff frequency */
     bool enable_temperature_compensation;   /**< Enable temperature compensation */
     uint8_t fft_window_type;                /**< FFT window type (0=Hanning, 1=Hamming, 2=Blackman) */
+    bool enable_streaming_integration;      /**< Integrate each axis continuously to velocity/displacement */
+    uint8_t decimation_factor;              /**< Decimate filtered blocks by this factor (0 or 1 = off) */
 } vibration_sensor_config_t;
 
 /**
@@ -63,22 +82,46 @@ typedef struct {
     int16_t temperature_celsius;            /**< Sensor temperature */
 } vibration_raw_data_t;
 
+/**
+ * @brief Raw accelerometer sample
+ */
+#if VIBRATION_SENSOR_SAMPLE_BITS > 16
+typedef int32_t vibration_sample_t;
+#else
+typedef int16_t vibration_sample_t;
+#endif
+
+/**
+ * @brief Raw block of frames, one contiguous array per axis
+ *
+ * Frame n was sampled at timestamp_us + n * sample_period_ns / 1000. At
+ * 16 bits a frame takes 6 bytes, against 20 for vibration_raw_data_t.
+ */
+typedef struct {
+    vibration_sample_t samples[VIBRATION_SENSOR_AXES][VIBRATION_SENSOR_BLOCK_SIZE]; /**< Raw samples per axis */
+    uint32_t timestamp_us;                  /**< Timestamp of the first frame */
+    uint32_t sample_period_ns;              /**< Time between frames */
+    uint16_t num_frames;                    /**< Valid frames per axis */
+} vibration_block_t;
+
 /**
  * @brief Processed vibration data
  */
 typedef struct {
-    float x_axis_acceleration;              /**< X-axis acceleration in m/s² */
-    float y_axis_acceleration;              /**< Y-axis acceleration in m/s² */
-    float z_axis_acceleration;              /**< Z-axis acceleration in m/s² */
-    float x_axis_velocity;                  /**< X-axis velocity in mm/s */
-    float y_axis_velocity;                  /**< Y-axis velocity in mm/s */
-    float z_axis_velocity;                  /**< Z-axis velocity in mm/s */
-    float x_axis_displacement;              /**< X-axis displacement in mm */
-    float y_axis_displacement;              /**< Y-axis displacement in mm */
-    float z_axis_displacement;              /**< Z-axis displacement in mm */
-    float rms_acceleration;                 /**< RMS acceleration magnitude */
-    float peak_acceleration;                /**< Peak acceleration magnitude */
-    float crest_factor;                     /**< Crest factor */
+    float x_axis_acceleration;              /**< X-axis acceleration in m/s² (block AC RMS) */
+    float y_axis_acceleration;              /**< Y-axis acceleration in m/s² (block AC RMS) */
+    float z_axis_acceleration;              /**< Z-axis acceleration in m/s² (block AC RMS) */
+    float x_axis_velocity;                  /**< X-axis velocity in mm/s (block RMS, streaming integration) */
+    float y_axis_velocity;                  /**< Y-axis velocity in mm/s (block RMS, streaming integration) */
+    float z_axis_velocity;                  /**< Z-axis velocity in mm/s (block RMS, streaming integration) */
+    float x_axis_displacement;              /**< X-axis displacement in mm (block RMS, streaming integration) */
+    float y_axis_displacement;              /**< Y-axis displacement in mm (block RMS, streaming integration) */
+    float z_axis_displacement;              /**< Z-axis displacement in mm (block RMS, streaming integration) */
+    float velocity_rms;                     /**< Band-limited velocity RMS in mm/s (severity) */
+    float displacement_rms;                 /**< Band-limited displacement RMS in mm */
+    float rms_acceleration;                 /**< RMS acceleration magnitude (vector sum of the axis RMS) */
+    float peak_acceleration;                /**< Largest axis peak about the block mean */
+    float crest_factor;                     /**< Crest factor of the axis with the largest RMS */
     uint32_t timestamp;                     /**< Processing timestamp */
 } vibration_processed_data_t;
 
@@ -141,8 +184,10 @@ typedef struct {
 typedef struct {
     esocore_sensor_status_t base_status;    /**< Base sensor status */
     bool accelerometer_ready;               /**< Accelerometer is ready */
-    bool data_buffer_full;                  /**< Data buffer is full */
+    bool data_buffer_full;                  /**< Both DMA halves were pending at the last read */
     uint32_t samples_collected;             /**< Number of samples collected */
+    uint32_t blocks_processed;              /**< Number of DMA blocks processed */
+    uint32_t block_overruns;                /**< DMA blocks overwritten before processing */
     uint32_t fft_calculations;              /**< Number of FFT calculations performed */
     float current_temperature;              /**< Current sensor temperature */
     uint8_t saturation_flags;               /**< Saturation flags for each axis */
@@ -193,12 +238,77 @@ bool vibration_sensor_stop_acquisition(void);
 /**
  * @brief Read vibration sensor data
  *
+ * Processes the next block of VIBRATION_SENSOR_BLOCK_SIZE frames the DMA
+ * completed, waiting for it if necessary, while the DMA fills the other
+ * half of the ping-pong buffer. Each block is converted, filtered and
+ * reduced to per-axis statistics; the filtered axis with the largest RMS
+ * is appended to the analysis capture, and FFT, severity, bearing and gear
+ * results come from the latest complete capture (one capture per block
+ * unless decimation is enabled).
+ *
  * @param data Pointer to data structure to fill
  * @param timeout_ms Timeout in milliseconds
- * @return true if data read successfully, false otherwise
+ * @return true if a block was processed, false otherwise
  */
 bool vibration_sensor_read_data(vibration_sensor_data_t *data, uint32_t timeout_ms);
 
+/**
+ * @brief DMA half-transfer complete handler
+ *
+ * Called from the accelerometer DMA interrupt when the first half of the
+ * ping-pong buffer holds a complete block.
+ *
+ * @param timestamp_us Timestamp of the block's last frame
+ */
+void vibration_sensor_dma_half_complete_isr(uint32_t timestamp_us);
+
+/**
+ * @brief DMA transfer complete handler
+ *
+ * Called from the accelerometer DMA interrupt when the second half of the
+ * ping-pong buffer holds a complete block.
+ *
+ * @param timestamp_us Timestamp of the block's last frame
+ */
+void vibration_sensor_dma_complete_isr(uint32_t timestamp_us);
+
+/**
+ * @brief Get the latest raw block
+ *
+ * @param block Pointer to block to fill
+ * @return true if a block has been acquired since acquisition started, false otherwise
+ */
+bool vibration_sensor_get_raw_block(vibration_block_t *block);
+
+/**
+ * @brief Feed every raw block to an event-triggered capture
+ *
+ * The capture sees the X, Y and Z axes as channels 0-2 in raw counts and
+ * is processed right after each block is unpacked. Requires 16-bit
+ * samples. The capture takes the current sampling rate and follows every
+ * later change; the rate is held while a capture is collected or waits
+ * for upload.
+ *
+ * @param capture Pointer to an initialized three-channel capture (NULL to detach)
+ * @return true if the capture was attached or detached, false otherwise
+ */
+bool vibration_sensor_attach_capture(sensor_capture_t *capture);
+
+/**
+ * @brief Let a controller adapt the sampling rate to the vibration activity
+ *
+ * After every block the controller sees the AC mean square of the X, Y
+ * and Z axes, in (m/s²)², as the activity of channels 0-2, and a new rate
+ * is applied through vibration_sensor_set_sampling_rate(). The minimum
+ * rate must keep the filter cutoffs below Nyquist; a rate the sensor
+ * rejects, including any change while an attached capture is collected
+ * or waits for upload, is reported back to the controller.
+ *
+ * @param controller Pointer to an initialized three-channel controller (NULL to detach)
+ * @return true if the controller was attached or detached, false otherwise
+ */
+bool vibration_sensor_attach_rate_controller(sensor_rate_controller_t *controller);
+
 /**
  * @brief Get vibration sensor status
  *
@@ -232,9 +342,29 @@ bool vibration_sensor_calibrate(void);
 bool vibration_sensor_perform_fft(const float *input_data, uint32_t data_length,
                                  vibration_fft_data_t *fft_result);
 
+/**
+ * @brief Publish a sample block to the shared feature store
+ *
+ * Bearing and gear analysis then read the block's cached spectrum instead
+ * of transforming again, and other consumers (TinyML, telemetry) can fetch
+ * its statistics and band powers under the same capture sequence. The
+ * buffer is referenced, not copied, and must stay unchanged until the next
+ * publish.
+ *
+ * @param samples Sample block (single axis or magnitude, in m/s²)
+ * @param num_samples Number of samples
+ * @param capture_seq Pointer to store assigned capture sequence (may be NULL)
+ * @return true if capture published successfully, false otherwise
+ */
+bool vibration_sensor_publish_capture(const float *samples, uint16_t num_samples,
+                                     uint32_t *capture_seq);
+
 /**
  * @brief Analyze bearing condition from vibration data
  *
+ * Reads the spectrum of the latest capture published to the feature
+ * store; fails until a capture exists.
+ *
  * @param vibration_data Pointer to vibration data
  * @param bearing_analysis Pointer to analysis result structure
  * @param bearing_specs Pointer to bearing specifications
@@ -247,6 +377,9 @@ bool vibration_sensor_analyze_bearing(const vibration_processed_data_t *vibratio
 /**
  * @brief Analyze gear condition from vibration data
  *
+ * Reads the spectrum of the latest capture published to the feature
+ * store; fails until a capture exists.
+ *
  * @param vibration_data Pointer to vibration data
  * @param gear_analysis Pointer to analysis result structure
  * @param gear_specs Pointer to gear specifications
@@ -280,11 +413,29 @@ bool vibration_sensor_convert_units(const vibration_raw_data_t *raw_data,
                                   vibration_processed_data_t *processed_data,
                                   const vibration_sensor_config_t *config);
 
+/**
+ * @brief Convert a raw block to engineering units
+ *
+ * Applies the calibration offsets and scales and the sensitivity of config
+ * axis by axis.
+ *
+ * @param block Pointer to raw block
+ * @param axes Per-axis outputs in m/s² of block->num_frames floats [3]
+ * @param config Pointer to sensor configuration
+ * @return true if conversion successful, false otherwise
+ */
+bool vibration_sensor_convert_block(const vibration_block_t *block, float *const *axes,
+                                  const vibration_sensor_config_t *config);
+
 /**
  * @brief Apply digital filtering to vibration data
  *
+ * Designs the high-pass and low-pass Butterworth cascades of config and
+ * filters one self-contained block starting at rest. Continuous streams
+ * use vibration_sensor_filter_axis(), which keeps state between blocks.
+ *
  * @param input_data Input data array
- * @param output_data Output data array
+ * @param output_data Output data array (may equal input_data)
  * @param data_length Length of data arrays
  * @param config Pointer to sensor configuration
  * @return true if filtering successful, false otherwise
@@ -292,6 +443,23 @@ bool vibration_sensor_convert_units(const vibration_raw_data_t *raw_data,
 bool vibration_sensor_apply_filtering(const float *input_data, float *output_data,
                                     uint32_t data_length, const vibration_sensor_config_t *config);
 
+/**
+ * @brief Filter a continuous block of one axis
+ *
+ * Runs the axis' cascade designed at configuration time, then the
+ * anti-alias FIR decimator when decimation_factor is above 1. Filter state
+ * and decimation phase carry over between calls.
+ *
+ * @param axis Axis index (0=X, 1=Y, 2=Z)
+ * @param input_data Input data array
+ * @param output_data Output data array (may equal input_data)
+ * @param data_length Length of input data array
+ * @param output_length Pointer to store the number of output samples
+ * @return true if filtering successful, false otherwise
+ */
+bool vibration_sensor_filter_axis(uint8_t axis, const float *input_data, float *output_data,
+                                uint32_t data_length, uint32_t *output_length);
+
 /**
  * @brief Detect vibration anomalies
  *
@@ -338,6 +506,9 @@ bool vibration_sensor_enable_temperature_compensation(bool enable);
 /**
  * @brief Set sampling rate
  *
+ * An attached capture follows the new rate; a change is refused while it
+ * is collecting or waiting for upload.
+ *
  * @param sampling_rate_hz Sampling rate in Hz
  * @return true if sampling rate set successfully, false otherwise
  */
@@ -378,8 +549,13 @@ bool vibration_sensor_check_saturation(uint8_t *saturation_flags);
 /**
  * @brief Calculate vibration velocity from acceleration
  *
- * @param acceleration_data Acceleration data array
- * @param velocity_data Output velocity data array
+ * Blocks of a power-of-two length up to VIBRATION_SENSOR_FFT_SIZE are
+ * integrated in the frequency domain (divided by j*w inside the severity
+ * band); other lengths run through a high-pass-stabilised integrator that
+ * starts at rest, so its first samples carry the settling transient.
+ *
+ * @param acceleration_data Acceleration data array in m/s²
+ * @param velocity_data Output velocity data array in mm/s (may equal acceleration_data)
  * @param data_length Length of data arrays
  * @param sampling_rate_hz Sampling rate
  * @return true if calculation successful, false otherwise
@@ -390,8 +566,11 @@ bool vibration_sensor_calculate_velocity(const float *acceleration_data, float *
 /**
  * @brief Calculate vibration displacement from acceleration
  *
- * @param acceleration_data Acceleration data array
- * @param displacement_data Output displacement data array
+ * Double integration over the severity band, with the same choice of
+ * method as vibration_sensor_calculate_velocity().
+ *
+ * @param acceleration_data Acceleration data array in m/s²
+ * @param displacement_data Output displacement data array in mm (may equal acceleration_data)
  * @param data_length Length of data arrays
  * @param sampling_rate_hz Sampling rate
  * @return true if calculation successful, false otherwise
@@ -399,6 +578,43 @@ bool vibration_sensor_calculate_velocity(const float *acceleration_data, float *
 bool vibration_sensor_calculate_displacement(const float *acceleration_data, float *displacement_data,
                                            uint32_t data_length, uint32_t sampling_rate_hz);
 
+/**
+ * @brief Calculate band-limited velocity and displacement RMS of a block
+ *
+ * A block published with vibration_sensor_publish_capture() reuses its
+ * cached Hanning spectrum, so the severity costs one pass over the bins;
+ * other blocks of a power-of-two length up to VIBRATION_SENSOR_FFT_SIZE
+ * are transformed here.
+ *
+ * @param acceleration_data Acceleration data array in m/s²
+ * @param data_length Length of data array
+ * @param sampling_rate_hz Sampling rate
+ * @param velocity_rms Pointer to store velocity RMS in mm/s
+ * @param displacement_rms Pointer to store displacement RMS in mm (may be NULL)
+ * @return true if calculation successful, false otherwise
+ */
+bool vibration_sensor_calculate_severity(const float *acceleration_data, uint32_t data_length,
+                                       uint32_t sampling_rate_hz, float *velocity_rms,
+                                       float *displacement_rms);
+
+/**
+ * @brief Integrate a continuous block of one axis
+ *
+ * Uses the axis' streaming integrator, whose state carries over between
+ * calls. Requires enable_streaming_integration.
+ *
+ * @param axis Axis index (0=X, 1=Y, 2=Z)
+ * @param acceleration_data Acceleration data array in m/s²
+ * @param velocity_data Output velocity data array in mm/s (may equal acceleration_data)
+ * @param displacement_data Output displacement data array in mm (may be NULL)
+ * @param data_length Length of data arrays
+ * @param velocity_rms Pointer to store the block velocity RMS in mm/s (may be NULL)
+ * @return true if the block produced settled output, false otherwise
+ */
+bool vibration_sensor_integrate_stream(uint8_t axis, const float *acceleration_data, float *velocity_data,
+                                     float *displacement_data, uint32_t data_length,
+                                     float *velocity_rms);
+
 /**
  * @brief Export vibration data for analysis
  *
@@ -0,0 +1,283 @@
+#!/usr/bin/env python3
+"""
+TinyML Tree Ensemble Builder and Code Generator
+===============================================
+
+Builds tree ensemble blobs for the firmware TinyML engine and generates
+branchy C for a fixed ensemble.
+
+Features:
+- Pack a JSON ensemble description into the flat 8-byte-node blob format
+  loaded by tinyml_load_model() (see firmware/common/intelligence/tinyml_trees.h)
+- Read an existing blob back and check its checksum
+- Emit a standalone C predict function with the same semantics
+  (feature <= threshold goes left, NaN goes right)
+
+JSON format:
+    {
+      "num_features": 12,
+      "num_outputs": 1,
+      "aggregate": "sum",            # "sum" (boosting) or "mean" (forest)
+      "transform": "sigmoid",        # "none", "sigmoid" or "softmax"
+      "base_score": [0.0],
+      "trees": [
+        {"feature": 3, "threshold": 0.5,
+         "left": {"leaf": -0.2, "output": 0},
+         "right": {"leaf": 0.4}}     # "output" defaults to 0
+      ]
+    }
+
+Usage:
+    python tree_codegen.py model.json --blob model.bin
+    python tree_codegen.py model.json --c model_trees.c --name bearing_trees
+    python tree_codegen.py model.bin --c model_trees.c
+
+Arguments:
+    input               JSON ensemble description or existing .bin blob
+    --blob PATH         Write the packed blob
+    --c PATH            Write generated C
+    --name NAME         C function prefix (default: tree_ensemble)
+    --help              Show this help message
+
+Author: EsoCore Development Team
+"""
+
+import argparse
+import json
+import math
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+TREE_MAGIC = 0x45545345  # "ESTE"
+TREE_FORMAT_VERSION = 1
+TREE_LEAF = 0xFFFF
+MAX_FEATURES = 256
+MAX_OUTPUTS = 16
+MAX_DEPTH = 32
+
+HEADER_FORMAT = "<IHHIIHBBB3xI"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+NODE_FORMAT = "<HHf"
+NODE_SIZE = struct.calcsize(NODE_FORMAT)
+
+AGGREGATES = {"sum": 0, "mean": 1}
+TRANSFORMS = {"none": 0, "sigmoid": 1, "softmax": 2}
+
+
+class TreeEnsemble:
+    """Tree ensemble in the firmware's pre-order node layout"""
+
+    def __init__(self, num_features, num_outputs, aggregate, transform, base_score):
+        self.num_features = num_features
+        self.num_outputs = num_outputs
+        self.aggregate = aggregate
+        self.transform = transform
+        self.base_score = base_score
+        self.tree_roots = []
+        self.nodes = []  # (feature, right_or_output, value)
+
+    @classmethod
+    def from_json(cls, description):
+        """Build an ensemble from a JSON description"""
+        num_outputs = int(description.get("num_outputs", 1))
+        ensemble = cls(
+            num_features=int(description["num_features"]),
+            num_outputs=num_outputs,
+            aggregate=AGGREGATES[description.get("aggregate", "sum")],
+            transform=TRANSFORMS[description.get("transform", "none")],
+            base_score=[float(v) for v in description.get("base_score", [0.0] * num_outputs)],
+        )
+        for tree in description["trees"]:
+            ensemble.tree_roots.append(len(ensemble.nodes))
+            ensemble._append_tree(tree, 0)
+        ensemble.validate()
+        return ensemble
+
+    @classmethod
+    def from_blob(cls, data):
+        """Read an ensemble back from a packed blob"""
+        (magic, version, num_trees, total_size, num_nodes, num_features,
+         num_outputs, aggregate, transform, checksum) = struct.unpack_from(HEADER_FORMAT, data)
+        if magic != TREE_MAGIC or version != TREE_FORMAT_VERSION or total_size != len(data):
+            raise ValueError("not a tree ensemble blob of this format version")
+        if zlib.crc32(data[HEADER_SIZE:]) != checksum:
+            raise ValueError("blob checksum mismatch")
+
+        offset = HEADER_SIZE
+        base_score = list(struct.unpack_from(f"<{num_outputs}f", data, offset))
+        offset += 4 * num_outputs
+        ensemble = cls(num_features, num_outputs, aggregate, transform, base_score)
+        ensemble.tree_roots = list(struct.unpack_from(f"<{num_trees}I", data, offset))
+        offset += 4 * num_trees
+        ensemble.nodes = [struct.unpack_from(NODE_FORMAT, data, offset + i * NODE_SIZE)
+                          for i in range(num_nodes)]
+        ensemble.validate()
+        return ensemble
+
+    def _append_tree(self, node, depth):
+        """Append a tree in pre-order: split, left subtree, right subtree"""
+        if depth > MAX_DEPTH:
+            raise ValueError(f"tree deeper than {MAX_DEPTH}")
+
+        if "leaf" in node:
+            self.nodes.append((TREE_LEAF, int(node.get("output", 0)), float(node["leaf"])))
+            return
+
+        index = len(self.nodes)
+        self.nodes.append(None)
+        self._append_tree(node["left"], depth + 1)
+        right = len(self.nodes) - index
+        if right > 0xFFFF:
+            raise ValueError("left subtree too large for a 16-bit child offset")
+        self.nodes[index] = (int(node["feature"]), right, float(node["threshold"]))
+        self._append_tree(node["right"], depth + 1)
+
+    def validate(self):
+        """Apply the checks the firmware parser applies"""
+        if not 0 < self.num_features <= MAX_FEATURES:
+            raise ValueError(f"num_features must be 1..{MAX_FEATURES}")
+        if not 0 < self.num_outputs <= MAX_OUTPUTS:
+            raise ValueError(f"num_outputs must be 1..{MAX_OUTPUTS}")
+        if len(self.base_score) != self.num_outputs:
+            raise ValueError("base_score needs one value per output")
+        if not self.tree_roots:
+            raise ValueError("ensemble has no trees")
+        for feature, right, value in self.nodes:
+            if feature == TREE_LEAF:
+                if right >= self.num_outputs or not math.isfinite(value):
+                    raise ValueError("leaf output index out of range or leaf value not finite")
+            elif feature >= self.num_features or right < 2 or math.isnan(value):
+                raise ValueError("split feature out of range or bad child offset")
+
+    def to_blob(self):
+        """Pack the ensemble into the firmware blob format"""
+        body = struct.pack(f"<{self.num_outputs}f", *self.base_score)
+        body += struct.pack(f"<{len(self.tree_roots)}I", *self.tree_roots)
+        body += b"".join(struct.pack(NODE_FORMAT, *node) for node in self.nodes)
+        header = struct.pack(HEADER_FORMAT, TREE_MAGIC, TREE_FORMAT_VERSION, len(self.tree_roots),
+                             HEADER_SIZE + len(body), len(self.nodes), self.num_features,
+                             self.num_outputs, self.aggregate, self.transform, zlib.crc32(body))
+        return header + body
+
+    def to_c(self, name, source):
+        """Generate a branchy C predict function"""
+        lines = [
+            "/**",
+            f" * @file {name}.c",
+            f" * @brief Generated tree ensemble {name}",
+            " *",
+            f" * Generated by tools/tree_codegen.py from {source}; do not edit.",
+            f" * {len(self.tree_roots)} trees, {len(self.nodes)} nodes, "
+            f"{self.num_features} features, {self.num_outputs} outputs.",
+            " */",
+            "",
+            "#include <math.h>",
+            "",
+            f"#define {name.upper()}_NUM_FEATURES {self.num_features}",
+            f"#define {name.upper()}_NUM_OUTPUTS {self.num_outputs}",
+            "",
+            "/**",
+            " * @brief Evaluate the ensemble",
+            " *",
+            f" * @param features Input features [{self.num_features}]",
+            f" * @param outputs Outputs [{self.num_outputs}]",
+            " */",
+            f"void {name}_predict(const float *features, float *outputs) {{",
+            f"    float sums[{self.num_outputs}] = {{ 0 }};",
+            "",
+        ]
+        for tree, root in enumerate(self.tree_roots):
+            lines.append(f"    /* Tree {tree} */")
+            self._emit_node(root, 1, lines)
+        lines.append("")
+
+        scale = " / " + c_float(float(len(self.tree_roots))) if self.aggregate == 1 else ""
+        for output in range(self.num_outputs):
+            lines.append(f"    outputs[{output}] = {c_float(self.base_score[output])} + sums[{output}]{scale};")
+
+        if self.transform == 1:
+            lines.append(f"    for (int o = 0; o < {self.num_outputs}; o++) {{")
+            lines.append("        outputs[o] = 1.0f / (1.0f + expf(-outputs[o]));")
+            lines.append("    }")
+        elif self.transform == 2:
+            lines += [
+                "    float max_score = outputs[0];",
+                f"    for (int o = 1; o < {self.num_outputs}; o++) {{",
+                "        if (outputs[o] > max_score) {",
+                "            max_score = outputs[o];",
+                "        }",
+                "    }",
+                "    float total = 0.0f;",
+                f"    for (int o = 0; o < {self.num_outputs}; o++) {{",
+                "        outputs[o] = expf(outputs[o] - max_score);",
+                "        total += outputs[o];",
+                "    }",
+                f"    for (int o = 0; o < {self.num_outputs}; o++) {{",
+                "        outputs[o] /= total;",
+                "    }",
+            ]
+        lines.append("}")
+        return "\n".join(lines) + "\n"
+
+    def _emit_node(self, index, level, lines):
+        """Emit one node as nested if/else"""
+        indent = "    " * level
+        feature, right, value = self.nodes[index]
+        if feature == TREE_LEAF:
+            lines.append(f"{indent}sums[{right}] += {c_float(value)};")
+            return
+        lines.append(f"{indent}if (features[{feature}] <= {c_float(value)}) {{")
+        self._emit_node(index + 1, level + 1, lines)
+        lines.append(f"{indent}}} else {{")
+        self._emit_node(index + right, level + 1, lines)
+        lines.append(f"{indent}}}")
+
+
+def c_float(value):
+    """Format a value as the C float literal of its exact float32 value"""
+    value = struct.unpack("<f", struct.pack("<f", value))[0]
+    if math.isinf(value):
+        return "INFINITY" if value > 0 else "-INFINITY"
+    text = f"{value:.9g}"
+    if "." not in text and "e" not in text:
+        text += ".0"
+    return text + "f"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build TinyML tree ensemble blobs and generate C")
+    parser.add_argument("input", help="JSON ensemble description or existing .bin blob")
+    parser.add_argument("--blob", help="Write the packed blob")
+    parser.add_argument("--c", dest="c_path", help="Write generated C")
+    parser.add_argument("--name", default="tree_ensemble", help="C function prefix")
+    args = parser.parse_args()
+
+    input_path = Path(args.input)
+    try:
+        if input_path.suffix == ".json":
+            ensemble = TreeEnsemble.from_json(json.loads(input_path.read_text()))
+        else:
+            ensemble = TreeEnsemble.from_blob(input_path.read_bytes())
+    except (ValueError, KeyError, struct.error) as error:
+        print(f"❌ {input_path}: {error}", file=sys.stderr)
+        return 1
+
+    print(f"Ensemble: {len(ensemble.tree_roots)} trees, {len(ensemble.nodes)} nodes, "
+          f"{ensemble.num_features} features, {ensemble.num_outputs} outputs")
+
+    if args.blob:
+        blob = ensemble.to_blob()
+        Path(args.blob).write_bytes(blob)
+        print(f"Wrote {args.blob} ({len(blob)} bytes)")
+
+    if args.c_path:
+        Path(args.c_path).write_text(ensemble.to_c(args.name, input_path.name))
+        print(f"Wrote {args.c_path}")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())